@@ -5,46 +5,59 @@
 
 #pragma once
 
-#include <memory_resource>
+#include <algorithm>
+#include <span>
 
-#include <Kube/Core/AllocatedSmallVector.hpp>
+#include <Kube/Core/SmallVector.hpp>
 
 #include "Base.hpp"
 
 namespace kF::Lang
 {
     class AST;
+    class SyntaxTree;
 }
 
-class alignas_cacheline kF::Lang::AST
+/** @brief A compact AST node, owned by a SyntaxTree
+ *  Children are stored out of line in the tree's shared child array, leaves don't allocate anything */
+class alignas_half_cacheline kF::Lang::AST
 {
 public:
-    /** @brief Destruct and deallocate a node using memory pool */
-    struct Deleter
-    {
-        void operator()(AST * const ast) noexcept
-            { ast->~AST(); Deallocate(ast, sizeof(AST), alignof(AST)); }
-    };
-
     /** @brief Data union */
     using Data = union {
         OperatorType    operatorType { OperatorType::None };
         StatementType   statementType;
         ConstantType    constantType;
+        NameType        nameType;
     };
 
-    /** @brief An unique pointer using the custom deleter class */
-    using Ptr = std::unique_ptr<AST, Deleter>;
+    /** @brief Resolved slot of a name
+     *  'index' is the slot of the name within its scope or the name hash for members, types and externals
+     *  'depth' is the count of enclosing classes to walk up to reach a class member */
+    struct alignas_eighth_cacheline NameSlot
+    {
+        std::uint32_t index { 0u };
+        std::uint32_t depth { 0u };
+    };
 
+    /** @brief Index of a child */
+    using ChildIndex = std::uint32_t;
 
-    /** @brief Create a new AST node pointer */
-    [[nodiscard]] static inline Ptr Make(const Token *token, const TokenType type) noexcept
-        { return Ptr(new (Allocate(sizeof(AST), alignof(AST))) AST(token, type)); }
+    /** @brief Range of children */
+    using Children = std::span<AST *>;
 
-    /** @brief Create a new AST node pointer using a data type */
-    template<typename DataType>
-    [[nodiscard]] static inline Ptr Make(const Token *token, const TokenType type, const DataType data) noexcept
-        { return Ptr(new (Allocate(sizeof(AST), alignof(AST))) AST(token, type, data)); }
+    /** @brief Range of constant children */
+    using ConstChildren = std::span<const AST * const>;
+
+    /** @brief A pending node of an iterative traversal */
+    struct alignas_quarter_cacheline TraverseFrame
+    {
+        const AST *node { nullptr };
+        ChildIndex next { 0u };
+    };
+
+    /** @brief Count of traversal frames stored without allocation */
+    static constexpr std::size_t TraverseStackSize = Core::CacheLineSize * 8 / sizeof(TraverseFrame);
 
 
     /** @brief Destructor */
@@ -53,9 +66,6 @@ public:
     /** @brief Copy assignment */
     AST &operator=(const AST &other) noexcept = default;
 
-    /** @brief Move assignment */
-    AST &operator=(AST &&other) noexcept = default;
-
 
     /** @brief Get node's token */
     [[nodiscard]] const Token *token(void) const noexcept { return _token; }
@@ -67,8 +77,9 @@ public:
     [[nodiscard]] TokenType type(void) const noexcept { return _type; }
 
     /** @brief Retreive the list of children */
-    [[nodiscard]] auto &children(void) noexcept { return _children; }
-    [[nodiscard]] const auto &children(void) const noexcept { return _children; }
+    [[nodiscard]] Children children(void) noexcept { return Children(_children, _childrenCount); }
+    [[nodiscard]] ConstChildren children(void) const noexcept
+        { return ConstChildren(const_cast<const AST * const *>(_children), _childrenCount); }
 
     /** @brief Get binary type (unsafe if you don't check token type) */
     [[nodiscard]] OperatorType operatorType(void) const noexcept { return _data.operatorType; };
@@ -79,66 +90,92 @@ public:
     /** @brief Get constant type (unsafe if you don't check token type) */
     [[nodiscard]] ConstantType constantType(void) const noexcept { return _data.constantType; };
 
+    /** @brief Get resolved name type (unsafe if you don't check token type) */
+    [[nodiscard]] NameType nameType(void) const noexcept { return _data.nameType; };
 
-    /** @brief Dump the whole tree (debug purposes) */
-    void dump(const std::size_t level = 0u, const bool firstOperation = true) const noexcept;
+    /** @brief Get resolved name slot (unsafe if you don't check name type) */
+    [[nodiscard]] NameSlot nameSlot(void) const noexcept { return _slot; };
 
-    /** @brief Traverse the whole AST tree
-     *  @tparam Callback must take a constant reference to AST and return a boolean */
-    template<typename Callback>
-    void traverse(Callback &&callback) const noexcept_invocable(Callback, const AST &);
+    /** @brief Get the structural hash of the subtree
+     *  It only depends on kinds, data and literals so it is stable across formatting changes */
+    [[nodiscard]] HashedName hash(void) const noexcept { return _hash; }
 
-private:
-    /** @brief AST node allocator */
-    static inline std::pmr::synchronized_pool_resource _Pool {};
 
-    /** @brief Allocate memory using memory pool */
-    [[nodiscard]] static void *Allocate(const std::size_t bytes, const std::size_t alignment) noexcept
-        { return _Pool.allocate(bytes, alignment); }
+    /** @brief Set node's token */
+    void setToken(const Token *token) noexcept { _token = token; }
+
+    /** @brief Set node's token type and data */
+    template<typename DataType>
+    void setType(const TokenType type, const DataType data) noexcept;
 
-    /** @brief Deallocate memory using memory pool */
-    static void Deallocate(void * const data, const std::size_t bytes, const std::size_t alignment) noexcept
-        { _Pool.deallocate(data, bytes, alignment); }
+    /** @brief Erase a range of children, children are never reallocated */
+    void eraseChildren(const ChildIndex from, const ChildIndex to) noexcept;
 
+    /** @brief Shrink the children count, children are never reallocated */
+    void shrinkChildren(const ChildIndex count) noexcept { _childrenCount = count; }
+
+    /** @brief Update the structural hash of the node from its own data and its children hashes */
+    void updateHash(void) noexcept;
+
+    /** @brief Resolve a name node to a slot (unsafe if the node is not a name)
+     *  Name nodes never have children so the slot shares the children storage */
+    void resolve(const NameType type, const NameSlot slot) noexcept { _data.nameType = type; _slot = slot; }
+
+
+    /** @brief Dump the whole tree to the standard output (debug purposes) */
+    void dump(void) const;
+
+    /** @brief Traverse the whole AST tree in pre-order, using an explicit stack instead of recursion
+     *  @tparam Callback must take a constant reference to AST and return a boolean, false skips the node's children */
+    template<typename Callback>
+    void traverse(Callback &&callback) const noexcept_invocable(Callback, const AST &)
+        { Traverse(*this, std::forward<Callback>(callback), [](const AST &) noexcept {}); }
+    template<typename Callback>
+    void traverse(Callback &&callback) noexcept_invocable(Callback, AST &)
+        { Traverse(*this, std::forward<Callback>(callback), [](const AST &) noexcept {}); }
+
+    /** @brief Traverse the whole AST tree calling 'enter' in pre-order and 'leave' in post-order
+     *  @tparam Enter must take a constant reference to AST and return a boolean, false skips the node's children and its 'leave' call
+     *  @tparam Leave must take a constant reference to AST */
+    template<typename Enter, typename Leave>
+    void traverse(Enter &&enter, Leave &&leave) const
+        noexcept(std::is_nothrow_invocable_v<Enter, const AST &> && std::is_nothrow_invocable_v<Leave, const AST &>)
+        { Traverse(*this, std::forward<Enter>(enter), std::forward<Leave>(leave)); }
+    template<typename Enter, typename Leave>
+    void traverse(Enter &&enter, Leave &&leave)
+        noexcept(std::is_nothrow_invocable_v<Enter, AST &> && std::is_nothrow_invocable_v<Leave, AST &>)
+        { Traverse(*this, std::forward<Enter>(enter), std::forward<Leave>(leave)); }
+
+private:
+    const Token *_token { nullptr };
+    TokenType _type { TokenType::None };
+    Data _data {};
+    union {
+        AST **_children { nullptr };
+        NameSlot _slot;
+    };
+    ChildIndex _childrenCount { 0u };
+    HashedName _hash { 0u };
 
     /** @brief Constructor */
     AST(const Token *token, const TokenType type) noexcept : _token(token), _type(type) {}
 
     /** @brief Data constructor */
     template<typename DataType>
-    AST(const Token *token, const TokenType type, const DataType data) noexcept : _token(token), _type(type)
-    {
-        static_assert(
-            std::is_same_v<Data, DataType> ||
-            std::is_same_v<OperatorType, DataType> ||
-            std::is_same_v<StatementType, DataType> ||
-            std::is_same_v<ConstantType, DataType>,
-            "An AST token must have a valid data field"
-        );
-
-        if constexpr (std::is_same_v<OperatorType, DataType>)
-            _data.operatorType = data;
-        else if constexpr (std::is_same_v<StatementType, DataType>)
-            _data.statementType = data;
-        else if constexpr (std::is_same_v<ConstantType, DataType>)
-            _data.constantType = data;
-        else
-            _data = data;
-    }
+    AST(const Token *token, const TokenType type, const DataType data) noexcept : _token(token)
+        { setType(type, data); }
 
     /** @brief Copy constructor */
     AST(const AST &other) noexcept = default;
 
-    /** @brief Move constructor */
-    AST(AST &&other) noexcept = default;
+    /** @brief Traversal implementation, the constness of every node is the one of the root */
+    template<typename Node, typename Enter, typename Leave>
+    static void Traverse(Node &root, Enter &&enter, Leave &&leave)
+        noexcept(std::is_nothrow_invocable_v<Enter, Node &> && std::is_nothrow_invocable_v<Leave, Node &>);
 
-private:
-    const Token *_token;
-    TokenType _type;
-    Data _data {};
-    Core::AllocatedTinySmallVector<Ptr, 4, &Allocate, &Deallocate> _children {};
+    friend SyntaxTree;
 };
 
-static_assert_fit_cacheline(kF::Lang::AST);
+static_assert_fit_half_cacheline(kF::Lang::AST);
 
-#include "AST.ipp"
\ No newline at end of file
+#include "AST.ipp"
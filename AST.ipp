@@ -3,14 +3,74 @@
  * @ Description: Abstract Syntax Tree
  */
 
-#include <Kube/Core/AllocatedVector.hpp>
+template<typename DataType>
+inline void kF::Lang::AST::setType(const TokenType type, const DataType data) noexcept
+{
+    static_assert(
+        std::is_same_v<Data, DataType> ||
+        std::is_same_v<OperatorType, DataType> ||
+        std::is_same_v<StatementType, DataType> ||
+        std::is_same_v<ConstantType, DataType>,
+        "An AST token must have a valid data field"
+    );
+
+    _type = type;
+    if constexpr (std::is_same_v<OperatorType, DataType>)
+        _data.operatorType = data;
+    else if constexpr (std::is_same_v<StatementType, DataType>)
+        _data.statementType = data;
+    else if constexpr (std::is_same_v<ConstantType, DataType>)
+        _data.constantType = data;
+    else
+        _data = data;
+}
+
+inline void kF::Lang::AST::eraseChildren(const ChildIndex from, const ChildIndex to) noexcept
+{
+    std::copy(_children + to, _children + _childrenCount, _children + from);
+    _childrenCount -= to - from;
+}
+
+inline void kF::Lang::AST::updateHash(void) noexcept
+{
+    auto hash = HashCombine(static_cast<HashedName>(_type), static_cast<HashedName>(_data.operatorType));
+
+    if (_token)
+        hash = HashCombine(hash, Hash(_token->literal()));
+    for (const auto *child : children())
+        hash = HashCombine(hash, child->_hash);
+    _hash = hash;
+}
 
-template<typename Callback>
-void kF::Lang::AST::traverse(Callback &&callback) const noexcept_invocable(Callback, const kF::Lang::AST &)
+template<typename Node, typename Enter, typename Leave>
+inline void kF::Lang::AST::Traverse(Node &root, Enter &&enter, Leave &&leave)
+    noexcept(std::is_nothrow_invocable_v<Enter, Node &> && std::is_nothrow_invocable_v<Leave, Node &>)
 {
-    if (callback(*this)) {
-        for (const auto &child : children()) {
-            child->traverse(callback);
+    const auto get = [](const AST *node) -> Node & { return *const_cast<AST *>(node); };
+
+    if (!enter(root))
+        return;
+    else if (!root._childrenCount) {
+        leave(root);
+        return;
+    }
+
+    Core::TinySmallVector<TraverseFrame, TraverseStackSize> stack;
+    stack.push(TraverseFrame { node: &root, next: 0u });
+    while (!stack.empty()) {
+        auto &frame = stack.back();
+        if (frame.next == frame.node->_childrenCount) {
+            leave(get(frame.node));
+            stack.pop();
+            continue;
         }
+        auto &child = get(frame.node->_children[frame.next++]);
+        if (!enter(child))
+            continue;
+        // Leaves never reach the stack
+        else if (!child._childrenCount)
+            leave(child);
+        else
+            stack.push(TraverseFrame { node: &child, next: 0u });
     }
-}
\ No newline at end of file
+}
@@ -24,6 +24,10 @@ namespace kF::Lang
     /** @brief A file line's column index */
     using ColumnIndex = std::uint16_t;
 
+    /** @brief Combine a hash with another one, the result depends on the combination order */
+    [[nodiscard]] constexpr HashedName HashCombine(const HashedName seed, const HashedName value) noexcept
+        { return seed ^ (value + 0x9E3779B9u + (seed << 6u) + (seed >> 2u)); }
+
     /** @brief A token in a file */
     struct alignas_eighth_cacheline Token
     {
@@ -135,6 +139,9 @@ namespace kF::Lang
         RightParenthesis
     };
 
+    /** @brief Count of token types */
+    constexpr std::size_t TokenTypeCount = static_cast<std::size_t>(TokenType::RightParenthesis) + 1u;
+
     /** @brief All types of operators */
     enum class OperatorType : std::uint32_t {
         None,
@@ -183,6 +190,9 @@ namespace kF::Lang
         TernaryElse
     };
 
+    /** @brief Count of operator types */
+    constexpr std::size_t OperatorTypeCount = static_cast<std::size_t>(OperatorType::TernaryElse) + 1u;
+
     /** @brief Check if an operator is unary */
     [[nodiscard]] inline bool IsUnary(const OperatorType type) noexcept
     { return static_cast<std::uint32_t>(type) >= static_cast<std::uint32_t>(OperatorType::Not) &&
@@ -212,12 +222,29 @@ namespace kF::Lang
         Emit
     };
 
+    /** @brief Count of statement types */
+    constexpr std::size_t StatementTypeCount = static_cast<std::size_t>(StatementType::Emit) + 1u;
+
+    /** @brief All kinds of resolved names */
+    enum class NameType : std::uint32_t {
+        None,
+        Local,
+        Parameter,
+        Property,
+        Signal,
+        Function,
+        Type,
+        Member,
+        External
+    };
+
     /** @brief All types of constants */
     enum class ConstantType : std::uint32_t {
         None,
         Numeric,
         Char,
-        Literal
+        Literal,
+        Boolean
     };
 
     struct alignas_quarter_cacheline TokenDescriptor
@@ -0,0 +1,551 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: BatchProcesser
+ */
+
+#include <algorithm>
+
+#include "BatchProcesser.hpp"
+#include "StackProcesser.hpp"
+#include "Processer.hpp"
+
+#if KUBE_INTERPRETER_AVX2
+# include <immintrin.h>
+#endif
+
+using namespace kF;
+using namespace kF::Lang::Processer;
+
+namespace kF::Lang
+{
+    /** @brief Name of the processing function used by errors */
+    constexpr auto Where = "Lang::BatchProcesser::process";
+
+    /** @brief Check if an operation is a comparison, comparisons output booleans */
+    template<OpCode Code>
+    constexpr bool IsComparison = Code >= OpCode::Equal && Code <= OpCode::LighterEqual;
+
+    /** @brief Get the generic operation of a quickened instruction, batches unbox their operands on their own */
+    [[nodiscard]] constexpr OpCode Generic(const OpCode code) noexcept
+    {
+        switch (code) {
+        case OpCode::IntegerAddition:
+        case OpCode::FloatingAddition:
+            return OpCode::Addition;
+        case OpCode::IntegerSubstraction:
+        case OpCode::FloatingSubstraction:
+            return OpCode::Substraction;
+        case OpCode::IntegerMultiplication:
+        case OpCode::FloatingMultiplication:
+            return OpCode::Multiplication;
+        case OpCode::IntegerAdditionInteger:
+            return OpCode::AdditionInteger;
+        case OpCode::IntegerSubstractionInteger:
+            return OpCode::SubstractionInteger;
+        case OpCode::IntegerMultiplicationInteger:
+            return OpCode::MultiplicationInteger;
+        default:
+            return code;
+        }
+    }
+
+    /** @brief Compute an operation on a lane */
+    template<OpCode Code, typename Value>
+    [[nodiscard]] inline auto Compute(const Value lhs, const Value rhs) noexcept
+    {
+        if constexpr (Code == OpCode::Addition)
+            return lhs + rhs;
+        else if constexpr (Code == OpCode::Substraction)
+            return lhs - rhs;
+        else if constexpr (Code == OpCode::Multiplication)
+            return lhs * rhs;
+        else if constexpr (Code == OpCode::Division)
+            return lhs / rhs;
+        else if constexpr (Code == OpCode::Modulo)
+            return lhs % rhs;
+        else if constexpr (Code == OpCode::Equal)
+            return static_cast<std::int64_t>(lhs == rhs);
+        else if constexpr (Code == OpCode::Different)
+            return static_cast<std::int64_t>(lhs != rhs);
+        else if constexpr (Code == OpCode::Greater)
+            return static_cast<std::int64_t>(lhs > rhs);
+        else if constexpr (Code == OpCode::GreaterEqual)
+            return static_cast<std::int64_t>(lhs >= rhs);
+        else if constexpr (Code == OpCode::Lighter)
+            return static_cast<std::int64_t>(lhs < rhs);
+        else
+            return static_cast<std::int64_t>(lhs <= rhs);
+    }
+
+#if KUBE_INTERPRETER_AVX2
+    /** @brief Check once if the processor supports AVX2 */
+    [[nodiscard]] inline bool HasAvx2(void) noexcept
+    {
+        static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+
+        return supported;
+    }
+
+    /** @brief Ordered predicates of floating comparisons, 'Different' is unordered as the scalar operator */
+    template<OpCode Code>
+    constexpr int FloatingPredicate =
+        Code == OpCode::Equal ? _CMP_EQ_OQ :
+        Code == OpCode::Different ? _CMP_NEQ_UQ :
+        Code == OpCode::Greater ? _CMP_GT_OQ :
+        Code == OpCode::GreaterEqual ? _CMP_GE_OQ :
+        Code == OpCode::Lighter ? _CMP_LT_OQ : _CMP_LE_OQ;
+
+    /** @brief Compute an operation on 4 floating lanes per iteration, returns the count of computed lanes
+     *  Comparisons output 0 or 1 in each lane, as the scalar operations */
+    template<OpCode Code, typename Output>
+    __attribute__((target("avx2"))) std::uint32_t Kernel(Output *output, const double *lhs, const double *rhs, const std::uint32_t count) noexcept
+    {
+        std::uint32_t i = 0u;
+
+        for (; i + 4u <= count; i += 4u) {
+            const auto a = _mm256_loadu_pd(lhs + i);
+            const auto b = _mm256_loadu_pd(rhs + i);
+            if constexpr (IsComparison<Code>) {
+                const auto mask = _mm256_castpd_si256(_mm256_cmp_pd(a, b, FloatingPredicate<Code>));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(output + i), _mm256_and_si256(mask, _mm256_set1_epi64x(1)));
+            } else if constexpr (Code == OpCode::Addition)
+                _mm256_storeu_pd(output + i, _mm256_add_pd(a, b));
+            else if constexpr (Code == OpCode::Substraction)
+                _mm256_storeu_pd(output + i, _mm256_sub_pd(a, b));
+            else if constexpr (Code == OpCode::Multiplication)
+                _mm256_storeu_pd(output + i, _mm256_mul_pd(a, b));
+            else
+                _mm256_storeu_pd(output + i, _mm256_div_pd(a, b));
+        }
+        return i;
+    }
+
+    /** @brief Compute an operation on 4 integer lanes per iteration, returns the count of computed lanes
+     *  AVX2 has no 64 bits integer multiplication nor division, they are left to the scalar loop */
+    template<OpCode Code>
+    __attribute__((target("avx2"))) std::uint32_t Kernel(std::int64_t *output, const std::int64_t *lhs, const std::int64_t *rhs, const std::uint32_t count) noexcept
+    {
+        std::uint32_t i = 0u;
+
+        if constexpr (Code != OpCode::Multiplication && Code != OpCode::Division && Code != OpCode::Modulo) {
+            const auto one = _mm256_set1_epi64x(1);
+            for (; i + 4u <= count; i += 4u) {
+                const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs + i));
+                const auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rhs + i));
+                __m256i result;
+                if constexpr (Code == OpCode::Addition)
+                    result = _mm256_add_epi64(a, b);
+                else if constexpr (Code == OpCode::Substraction)
+                    result = _mm256_sub_epi64(a, b);
+                else if constexpr (Code == OpCode::Equal)
+                    result = _mm256_and_si256(_mm256_cmpeq_epi64(a, b), one);
+                else if constexpr (Code == OpCode::Different)
+                    result = _mm256_andnot_si256(_mm256_cmpeq_epi64(a, b), one);
+                else if constexpr (Code == OpCode::Greater)
+                    result = _mm256_and_si256(_mm256_cmpgt_epi64(a, b), one);
+                else if constexpr (Code == OpCode::GreaterEqual)
+                    result = _mm256_andnot_si256(_mm256_cmpgt_epi64(b, a), one);
+                else if constexpr (Code == OpCode::Lighter)
+                    result = _mm256_and_si256(_mm256_cmpgt_epi64(b, a), one);
+                else
+                    result = _mm256_andnot_si256(_mm256_cmpgt_epi64(a, b), one);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(output + i), result);
+            }
+        }
+        return i;
+    }
+#endif
+
+    /** @brief Compute an operation over every lane, 'output' may be 'lhs'
+     *  Lanes left by the AVX2 kernel, or all of them on other processors, run on scalars */
+    template<OpCode Code, typename Output, typename Value>
+    inline void Map(Output *output, const Value *lhs, const Value *rhs, const std::uint32_t count) noexcept
+    {
+        std::uint32_t i = 0u;
+
+#if KUBE_INTERPRETER_AVX2
+        if (HasAvx2()) [[likely]]
+            i = Kernel<Code>(output, lhs, rhs, count);
+#endif
+        for (; i < count; ++i)
+            output[i] = Compute<Code>(lhs[i], rhs[i]);
+    }
+}
+
+Lang::BatchProcesser &Lang::BatchProcesser::Local(void) noexcept
+{
+    thread_local BatchProcesser processer;
+
+    return processer;
+}
+
+bool Lang::BatchProcesser::IsVectorizable(const Expression &expression) noexcept
+{
+    const auto * const code = reinterpret_cast<const std::byte *>(expression.data());
+
+    // Expressions that don't branch are ended by their first return
+    for (const auto *it = code; it < code + expression.size(); ) {
+        const auto &instruction = As<Instruction>(it);
+        const auto opCode = Observe(instruction.code);
+        it += InstructionSize(instruction, opCode);
+        switch (Generic(opCode)) {
+        case OpCode::PushBoolean:
+        case OpCode::PushInteger:
+        case OpCode::PushFloating:
+        case OpCode::Pop:
+        case OpCode::Duplicate:
+        case OpCode::PushParameter:
+        case OpCode::PushProperty:
+        case OpCode::PushExternal:
+        case OpCode::Not:
+        case OpCode::Minus:
+        case OpCode::ToBoolean:
+        case OpCode::Addition:
+        case OpCode::Substraction:
+        case OpCode::Multiplication:
+        case OpCode::Division:
+        case OpCode::Modulo:
+        case OpCode::Equal:
+        case OpCode::Different:
+        case OpCode::Greater:
+        case OpCode::GreaterEqual:
+        case OpCode::Lighter:
+        case OpCode::LighterEqual:
+        case OpCode::AdditionInteger:
+        case OpCode::SubstractionInteger:
+        case OpCode::MultiplicationInteger:
+            break;
+        case OpCode::Return:
+            return true;
+        default:
+            return false;
+        }
+    }
+    return false;
+}
+
+Lang::BatchProcesser::BatchProcesser(const std::size_t columnCount)
+{
+    _columns.resize(columnCount);
+}
+
+void Lang::BatchProcesser::process(const Expression &expression, Object * const * const *instances, Var * const *args,
+        const std::uint32_t count, Var *results)
+{
+    if (!IsVectorizable(expression)) [[unlikely]] {
+        processScalar(expression, instances, args, count, results);
+        return;
+    }
+
+    // The immediate operand of superinstructions takes the column above the operand stack
+    if (const auto columnCount = expression.stackSize() + 1u; columnCount > _columns.size()) [[unlikely]]
+        _columns.resize(columnCount);
+
+    for (std::uint32_t first = 0u; first < count; first += LaneCount) {
+        const auto laneCount = std::min(LaneCount, count - first);
+        const auto chunkArgs = args ? args + first : nullptr;
+        if (processChunk(expression, instances + first, chunkArgs, laneCount, results + first)) [[likely]]
+            _vectorizedCount += laneCount;
+        else
+            processScalar(expression, instances + first, chunkArgs, laneCount, results + first);
+    }
+}
+
+bool Lang::BatchProcesser::processChunk(const Expression &expression, Object * const * const *instances, Var * const *args,
+        const std::uint32_t count, Var *results)
+{
+    Column *sp = _columns.data();
+    const auto *it = reinterpret_cast<const std::byte *>(expression.data());
+
+    const auto fill = [&sp, count](const LaneType type, const std::int64_t value) {
+        sp->type = type;
+        std::fill_n(sp->integers, count, value);
+        ++sp;
+    };
+    const auto binary = [&sp, count](const OpCode code) {
+        const auto success = Binary(code, sp[-2], sp[-1], count);
+        --sp;
+        return success;
+    };
+    const auto immediate = [&sp, &it, count](const OpCode code) {
+        sp->type = LaneType::Integer;
+        std::fill_n(sp->integers, count, As<ImmediateInstruction>(it).integer);
+        return Binary(code, sp[-1], *sp, count);
+    };
+
+    // Each instruction is dispatched once for every lane, a lane that can't be unboxed fails the whole chunk
+    while (true) {
+        const auto &instruction = As<Instruction>(it);
+        switch (Generic(Observe(instruction.code))) {
+        // Constants
+        case OpCode::PushBoolean:
+            fill(LaneType::Boolean, static_cast<bool>(instruction.argument));
+            it += sizeof(Instruction);
+            break;
+        case OpCode::PushInteger:
+            fill(LaneType::Integer, As<ImmediateInstruction>(it).integer);
+            it += sizeof(ImmediateInstruction);
+            break;
+        case OpCode::PushFloating:
+            sp->type = LaneType::Floating;
+            std::fill_n(sp->floatings, count, As<ImmediateInstruction>(it).floating);
+            ++sp;
+            it += sizeof(ImmediateInstruction);
+            break;
+
+        // Operand stack
+        case OpCode::Pop:
+            --sp;
+            it += sizeof(Instruction);
+            break;
+        case OpCode::Duplicate:
+            sp->type = sp[-1].type;
+            std::copy_n(sp[-1].integers, count, sp->integers);
+            ++sp;
+            it += sizeof(Instruction);
+            break;
+
+        // Variables
+        case OpCode::PushParameter:
+            for (std::uint32_t lane = 0u; lane < count; ++lane) {
+                if (!Unbox(*sp, lane, args[lane][instruction.argument]))
+                    return false;
+            }
+            ++sp;
+            it += sizeof(Instruction);
+            break;
+        case OpCode::PushProperty:
+        {
+            const auto &member = As<MemberInstruction>(it);
+            auto &cache = expression.cacheAt(member.cache);
+            for (std::uint32_t lane = 0u; lane < count; ++lane) {
+                auto &instance = *instances[lane][member.depth];
+                if (!Unbox(*sp, lane, GetVar(instance, FindData(Where, cache, instance, member.name), member.name)))
+                    return false;
+            }
+            ++sp;
+            it += sizeof(MemberInstruction);
+            break;
+        }
+        case OpCode::PushExternal:
+        {
+            const auto &member = As<MemberInstruction>(it);
+            auto &cache = expression.externalCacheAt(member.cache);
+            for (std::uint32_t lane = 0u; lane < count; ++lane) {
+                Meta::Data data;
+                auto &instance = FindExternalData(Where, cache, instances[lane], member.name, data);
+                if (!Unbox(*sp, lane, GetVar(instance, data, member.name)))
+                    return false;
+            }
+            ++sp;
+            it += sizeof(MemberInstruction);
+            break;
+        }
+
+        // Unary
+        case OpCode::Not:
+        case OpCode::Minus:
+        case OpCode::ToBoolean:
+            if (!Unary(instruction.code, sp[-1], count))
+                return false;
+            it += sizeof(Instruction);
+            break;
+
+        // Binary
+        case OpCode::Addition:
+        case OpCode::Substraction:
+        case OpCode::Multiplication:
+        case OpCode::Division:
+        case OpCode::Modulo:
+        case OpCode::Equal:
+        case OpCode::Different:
+        case OpCode::Greater:
+        case OpCode::GreaterEqual:
+        case OpCode::Lighter:
+        case OpCode::LighterEqual:
+            if (!binary(Generic(Observe(instruction.code))))
+                return false;
+            it += sizeof(Instruction);
+            break;
+
+        // Superinstructions
+        case OpCode::AdditionInteger:
+            if (!immediate(OpCode::Addition))
+                return false;
+            it += sizeof(ImmediateInstruction);
+            break;
+        case OpCode::SubstractionInteger:
+            if (!immediate(OpCode::Substraction))
+                return false;
+            it += sizeof(ImmediateInstruction);
+            break;
+        case OpCode::MultiplicationInteger:
+            if (!immediate(OpCode::Multiplication))
+                return false;
+            it += sizeof(ImmediateInstruction);
+            break;
+
+        case OpCode::Return:
+            for (std::uint32_t lane = 0u; lane < count; ++lane)
+                results[lane] = Box(sp[-1], lane);
+            return true;
+
+        default:
+            return false;
+        }
+    }
+}
+
+void Lang::BatchProcesser::processScalar(const Expression &expression, Object * const * const *instances, Var * const *args,
+        const std::uint32_t count, Var *results)
+{
+    auto &processer = StackProcesser::Local();
+
+    for (std::uint32_t i = 0u; i < count; ++i)
+        results[i] = processer.process(expression, instances[i], args ? args[i] : nullptr);
+    _scalarCount += count;
+}
+
+bool Lang::BatchProcesser::Unary(const OpCode code, Column &column, const std::uint32_t count) noexcept
+{
+    const auto isFloating = column.type == LaneType::Floating;
+
+    switch (code) {
+    case OpCode::Not:
+        if (isFloating) {
+            for (std::uint32_t i = 0u; i < count; ++i)
+                column.integers[i] = column.floatings[i] == 0.0;
+        } else {
+            for (std::uint32_t i = 0u; i < count; ++i)
+                column.integers[i] = !column.integers[i];
+        }
+        column.type = LaneType::Boolean;
+        return true;
+    case OpCode::ToBoolean:
+        if (isFloating) {
+            for (std::uint32_t i = 0u; i < count; ++i)
+                column.integers[i] = column.floatings[i] != 0.0;
+        } else {
+            for (std::uint32_t i = 0u; i < count; ++i)
+                column.integers[i] = column.integers[i] != 0;
+        }
+        column.type = LaneType::Boolean;
+        return true;
+    case OpCode::Minus:
+        if (column.type == LaneType::Boolean)
+            return false;
+        else if (isFloating) {
+            for (std::uint32_t i = 0u; i < count; ++i)
+                column.floatings[i] = -column.floatings[i];
+        } else {
+            for (std::uint32_t i = 0u; i < count; ++i)
+                column.integers[i] = -column.integers[i];
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+template<Lang::OpCode Code>
+void Lang::BatchProcesser::Apply(Column &lhs, const Column &rhs, const std::uint32_t count) noexcept
+{
+    // Comparisons of floatings output integers in place of their left operand
+    if (lhs.type != LaneType::Floating)
+        Map<Code>(lhs.integers, lhs.integers, rhs.integers, count);
+    else if constexpr (IsComparison<Code>)
+        Map<Code>(lhs.integers, lhs.floatings, rhs.floatings, count);
+    else if constexpr (Code != OpCode::Modulo)
+        Map<Code>(lhs.floatings, lhs.floatings, rhs.floatings, count);
+    if constexpr (IsComparison<Code>)
+        lhs.type = LaneType::Boolean;
+}
+
+bool Lang::BatchProcesser::Binary(const OpCode code, Column &lhs, Column &rhs, const std::uint32_t count) noexcept
+{
+    // Booleans are only compared to booleans, mixed numbers are computed as floatings
+    if (lhs.type == LaneType::Boolean || rhs.type == LaneType::Boolean) {
+        if (lhs.type != rhs.type || (code != OpCode::Equal && code != OpCode::Different))
+            return false;
+    } else if (lhs.type != rhs.type) {
+        auto &integers = lhs.type == LaneType::Integer ? lhs : rhs;
+        for (std::uint32_t i = 0u; i < count; ++i)
+            integers.floatings[i] = static_cast<double>(integers.integers[i]);
+        integers.type = LaneType::Floating;
+    }
+
+    const auto isFloating = lhs.type == LaneType::Floating;
+    switch (code) {
+    case OpCode::Addition:
+        Apply<OpCode::Addition>(lhs, rhs, count);
+        return true;
+    case OpCode::Substraction:
+        Apply<OpCode::Substraction>(lhs, rhs, count);
+        return true;
+    case OpCode::Multiplication:
+        Apply<OpCode::Multiplication>(lhs, rhs, count);
+        return true;
+    case OpCode::Division:
+    case OpCode::Modulo:
+        // Integer divisions by zero and floating modulos are left to the stack processer
+        if (isFloating ? code == OpCode::Modulo : std::find(rhs.integers, rhs.integers + count, 0) != rhs.integers + count)
+            return false;
+        else if (code == OpCode::Division)
+            Apply<OpCode::Division>(lhs, rhs, count);
+        else
+            Apply<OpCode::Modulo>(lhs, rhs, count);
+        return true;
+    case OpCode::Equal:
+        Apply<OpCode::Equal>(lhs, rhs, count);
+        return true;
+    case OpCode::Different:
+        Apply<OpCode::Different>(lhs, rhs, count);
+        return true;
+    case OpCode::Greater:
+        Apply<OpCode::Greater>(lhs, rhs, count);
+        return true;
+    case OpCode::GreaterEqual:
+        Apply<OpCode::GreaterEqual>(lhs, rhs, count);
+        return true;
+    case OpCode::Lighter:
+        Apply<OpCode::Lighter>(lhs, rhs, count);
+        return true;
+    case OpCode::LighterEqual:
+        Apply<OpCode::LighterEqual>(lhs, rhs, count);
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool Lang::BatchProcesser::Unbox(Column &column, const std::uint32_t lane, const Var &value) noexcept
+{
+    LaneType type;
+
+    if (value.is<std::int64_t>()) {
+        type = LaneType::Integer;
+        column.integers[lane] = value.as<std::int64_t>();
+    } else if (value.is<double>()) {
+        type = LaneType::Floating;
+        column.floatings[lane] = value.as<double>();
+    } else if (value.is<bool>()) {
+        type = LaneType::Boolean;
+        column.integers[lane] = value.toBool();
+    } else
+        return false;
+    if (!lane)
+        column.type = type;
+    return column.type == type;
+}
+
+Var Lang::BatchProcesser::Box(const Column &column, const std::uint32_t lane) noexcept
+{
+    switch (column.type) {
+    case LaneType::Integer:
+        return Var(column.integers[lane]);
+    case LaneType::Floating:
+        return Var(column.floatings[lane]);
+    default:
+        return Var(static_cast<bool>(column.integers[lane]));
+    }
+}
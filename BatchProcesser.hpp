@@ -0,0 +1,120 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: BatchProcesser
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+
+#include "Expression.hpp"
+
+// Batches run AVX2 kernels on x86-64 processors supporting them, other targets run the same operations on scalars
+#if !defined(KUBE_INTERPRETER_AVX2)
+# if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !KUBE_INTERPRETER_DISABLE_AVX2
+#  define KUBE_INTERPRETER_AVX2 1
+# else
+#  define KUBE_INTERPRETER_AVX2 0
+# endif
+#endif
+
+namespace kF::Lang
+{
+    class BatchProcesser;
+}
+
+/** @brief The BatchProcesser executes a stack machine expression once per argument set, column by column
+ *  Argument sets are processed in chunks of 'LaneCount' lanes: each instruction is dispatched once per chunk,
+ *  every slot of the operand stack being a column holding the unboxed value of each lane
+ *  Only straight-line expressions over numbers are vectorized, others and chunks whose lanes don't share
+ *  a numeric type are evaluated set by set on the stack processer
+ *  Each thread owns a processer whose columns are preallocated once and reused by every batch */
+class alignas_cacheline kF::Lang::BatchProcesser
+{
+public:
+    /** @brief Count of argument sets evaluated together, the columns of a chunk fit in the L1 cache */
+    static constexpr std::uint32_t LaneCount = 256u;
+
+    /** @brief Count of columns preallocated by a processer */
+    static constexpr std::size_t DefaultColumnCount = 16u;
+
+
+    /** @brief Get the processer of the calling thread */
+    [[nodiscard]] static BatchProcesser &Local(void) noexcept;
+
+    /** @brief Check if an expression can be vectorized, it must not branch, call nor store */
+    [[nodiscard]] static bool IsVectorizable(const Expression &expression) noexcept;
+
+    /** @brief Construct a processer and preallocate its columns */
+    BatchProcesser(const std::size_t columnCount = DefaultColumnCount);
+
+    /** @brief Processers are not copyable */
+    BatchProcesser(const BatchProcesser &other) = delete;
+    BatchProcesser &operator=(const BatchProcesser &other) = delete;
+
+    /** @brief Destructor */
+    ~BatchProcesser(void) noexcept = default;
+
+
+    /** @brief Execute an expression once per argument set
+     *  'instances[i]' is the null terminated list of enclosing instances of the set 'i' and 'args[i]' its parameters
+     *  'args' may be null if the expression has no parameter, the result of the set 'i' is stored in 'results[i]' */
+    void process(const Expression &expression, Object * const * const *instances, Var * const *args,
+            const std::uint32_t count, Var *results);
+
+    /** @brief Get the count of argument sets evaluated column by column */
+    [[nodiscard]] std::uint64_t vectorizedCount(void) const noexcept { return _vectorizedCount; }
+
+    /** @brief Get the count of argument sets evaluated one by one */
+    [[nodiscard]] std::uint64_t scalarCount(void) const noexcept { return _scalarCount; }
+
+private:
+    /** @brief Type of the lanes of a column, booleans are stored as integers */
+    enum class LaneType : std::uint32_t {
+        Integer,
+        Floating,
+        Boolean
+    };
+
+    /** @brief A slot of the operand stack, holding the value of each lane */
+    struct Column
+    {
+        LaneType type { LaneType::Integer };
+        union {
+            std::int64_t integers[LaneCount];
+            double floatings[LaneCount];
+        };
+    };
+
+    // Cacheline 1
+    Core::Vector<Column> _columns {};
+    std::uint64_t _vectorizedCount { 0u };
+    std::uint64_t _scalarCount { 0u };
+
+    /** @brief Evaluate a chunk column by column, fails if a lane can't be unboxed or can't be computed on unboxed values */
+    [[nodiscard]] bool processChunk(const Expression &expression, Object * const * const *instances, Var * const *args,
+            const std::uint32_t count, Var *results);
+
+    /** @brief Evaluate argument sets one by one */
+    void processScalar(const Expression &expression, Object * const * const *instances, Var * const *args,
+            const std::uint32_t count, Var *results);
+
+
+    /** @brief Compute an unary operation in place, fails if it can't be computed on unboxed values */
+    [[nodiscard]] static bool Unary(const OpCode code, Column &column, const std::uint32_t count) noexcept;
+
+    /** @brief Compute a binary operation in place of 'lhs', fails if it can't be computed on unboxed values */
+    [[nodiscard]] static bool Binary(const OpCode code, Column &lhs, Column &rhs, const std::uint32_t count) noexcept;
+
+    /** @brief Compute a binary operation over operands of the same type */
+    template<OpCode Code>
+    static void Apply(Column &lhs, const Column &rhs, const std::uint32_t count) noexcept;
+
+    /** @brief Unbox the value of a lane, fails if it isn't a number or if the lanes of its column don't share its type */
+    [[nodiscard]] static bool Unbox(Column &column, const std::uint32_t lane, const Var &value) noexcept;
+
+    /** @brief Box the value of a lane */
+    [[nodiscard]] static Var Box(const Column &column, const std::uint32_t lane) noexcept;
+};
+
+static_assert_fit_cacheline(kF::Lang::BatchProcesser);
@@ -4,11 +4,21 @@
  */
 
 #include <iostream>
+#include <sstream>
 #include <cstddef>
+#include <iterator>
 
 #include <benchmark/benchmark.h>
 
-#include <Kube/Interpreter/Instruction.hpp>
+#include <Kube/Interpreter/Lexer.hpp>
+#include <Kube/Interpreter/Parser.hpp>
+#include <Kube/Interpreter/NameResolver.hpp>
+#include <Kube/Interpreter/Compiler.hpp>
+#include <Kube/Interpreter/StackProcesser.hpp>
+#include <Kube/Interpreter/RegisterCompiler.hpp>
+#include <Kube/Interpreter/RegisterProcesser.hpp>
+#include <Kube/Interpreter/ClosureCompiler.hpp>
+#include <Kube/Interpreter/ClosureProcesser.hpp>
 #include <Kube/Object/Object.hpp>
 #include <Kube/Core/Vector.hpp>
 
@@ -440,4 +450,100 @@ REGISTER_STACK_TEST(16)
 REGISTER_STACK_TEST(32)
 REGISTER_STACK_TEST(64)
 REGISTER_STACK_TEST(128)
-REGISTER_STACK_TEST(256)
\ No newline at end of file
+REGISTER_STACK_TEST(256)
+
+
+/* Expression
+    The library stack processer executing compiled expressions
+*/
+
+static void BenchExpression(benchmark::State &state)
+{
+    kF::Meta::Resolver::Clear();
+    kF::RegisterMetadata();
+
+    std::istringstream iss("MyObject { property x: value + 2; }");
+    const auto stack = kF::Lang::Lexer().run(0, iss, "Bench");
+    const auto tree = kF::Lang::Parser().run(0, &stack, "Bench");
+    kF::Lang::NameResolver().run(*tree, "Bench");
+    const auto units = kF::Lang::Compiler().run(*tree, "Bench");
+    const auto &expression = *units[0].expression;
+    auto obj = std::make_unique<MyObject>();
+    kF::Object *instances[] = { obj.get(), nullptr };
+
+    if (expression(instances, nullptr).as<int>() != 3)
+        throw std::logic_error("Expression: code is broken");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(expression(instances, nullptr));
+    }
+}
+BENCHMARK(BenchExpression);
+
+
+/* Machines
+    The stack machine, interpreted or translated into machine code, the register machine and the closure tree executing the same compiled corpus
+*/
+
+static constexpr auto MachineCorpus =
+    "MyObject {"
+    "  property x: value + 2;"
+    "  function arithmetic(a, b) { return a * b + a - b * 2 + (a + b) * (a - b); }"
+    "  function locals(a) { int x = a; int y = x * 2; int z = y + x; return x * y + z; }"
+    "  function loop(a) { int total = 0; int i = 0; while (i < a) { total += i; i += 1; } return total; }"
+    "}";
+
+static constexpr int MachineCorpusResults[] = { 3, 305, 560, 120 };
+
+template<typename Compiler, typename Processer>
+static void MachineBenchmarkGenerator(benchmark::State &state)
+{
+    kF::Meta::Resolver::Clear();
+    kF::RegisterMetadata();
+
+    std::istringstream iss(MachineCorpus);
+    const auto stack = kF::Lang::Lexer().run(0, iss, "Bench");
+    const auto tree = kF::Lang::Parser().run(0, &stack, "Bench");
+    kF::Lang::NameResolver().run(*tree, "Bench");
+    const auto units = Compiler().run(*tree, "Bench");
+    const auto index = static_cast<std::size_t>(state.range(0));
+    const auto &expression = *units[index].expression;
+    auto &processer = Processer::Local();
+    auto obj = std::make_unique<MyObject>();
+    kF::Object *instances[] = { obj.get(), nullptr };
+    kF::Var args[2] { kF::Var(16), kF::Var(3) };
+
+    if (processer.process(expression, instances, args).template as<int>() != MachineCorpusResults[index])
+        throw std::logic_error("Machine: code is broken");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(processer.process(expression, instances, args));
+    }
+}
+
+static void BenchStackMachine(benchmark::State &state)
+{
+    kF::Lang::StackProcesser::Local().setJitThreshold(kF::Lang::StackProcesser::NoJit);
+    MachineBenchmarkGenerator<kF::Lang::Compiler, kF::Lang::StackProcesser>(state);
+    kF::Lang::StackProcesser::Local().setJitThreshold(kF::Lang::StackProcesser::DefaultJitThreshold);
+}
+BENCHMARK(BenchStackMachine)->DenseRange(0, std::size(MachineCorpusResults) - 1);
+
+static void BenchStackMachineJit(benchmark::State &state)
+{
+    // Expressions are translated on their first execution, when the target supports it
+    kF::Lang::StackProcesser::Local().setJitThreshold(1u);
+    MachineBenchmarkGenerator<kF::Lang::Compiler, kF::Lang::StackProcesser>(state);
+    kF::Lang::StackProcesser::Local().setJitThreshold(kF::Lang::StackProcesser::DefaultJitThreshold);
+}
+BENCHMARK(BenchStackMachineJit)->DenseRange(0, std::size(MachineCorpusResults) - 1);
+
+static void BenchRegisterMachine(benchmark::State &state)
+{
+    MachineBenchmarkGenerator<kF::Lang::RegisterCompiler, kF::Lang::RegisterProcesser>(state);
+}
+BENCHMARK(BenchRegisterMachine)->DenseRange(0, std::size(MachineCorpusResults) - 1);
+
+static void BenchClosureMachine(benchmark::State &state)
+{
+    MachineBenchmarkGenerator<kF::Lang::ClosureCompiler, kF::Lang::ClosureProcesser>(state);
+}
+BENCHMARK(BenchClosureMachine)->DenseRange(0, std::size(MachineCorpusResults) - 1);
@@ -0,0 +1,320 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: BindingGraph
+ */
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+#include "BindingGraph.hpp"
+
+using namespace kF;
+
+Lang::BindingGraph::BindingIndex Lang::BindingGraph::add(Object &instance, const HashedName name, const Expression &expression, Object * const *instances)
+{
+    const auto data = instance.getMetaType().findData(name);
+    const auto property = findProperty(&instance, name);
+    const auto index = static_cast<BindingIndex>(_bindings.size());
+
+    if (!data) [[unlikely]]
+        Processer::ThrowUnknownName("Lang::BindingGraph::add", "property", name);
+    else if (_properties[property].writer != NoBinding) [[unlikely]]
+        throw std::logic_error("Lang::BindingGraph::add: Property is already bound");
+    _properties[property].writer = index;
+    _bindings.push(Binding {
+        expression: &expression,
+        instances: instances,
+        data: data,
+        property: property
+    });
+    markDirty(index);
+    return index;
+}
+
+void Lang::BindingGraph::invalidate(Object &instance, const HashedName name)
+{
+    const auto property = findProperty(&instance, name);
+
+    for (const auto reader : _properties[property].readers)
+        markDirty(reader);
+}
+
+void Lang::BindingGraph::update(void)
+{
+    _levelCount = 0u;
+    _taskCount = 0u;
+    if (_dirty.empty())
+        return;
+
+    const auto generation = ++_generation;
+    Core::TinyVector<BindingIndex> affected;
+    Core::TinyVector<BindingIndex> level;
+    Core::TinyVector<BindingIndex> next;
+
+    // Collect the dirty bindings and every binding depending on them, they are all evaluated
+    const auto visit = [this, generation, &affected](const BindingIndex index) {
+        auto &binding = _bindings[index];
+        if (binding.mark == generation)
+            return;
+        binding.mark = generation;
+        binding.pending = 0u;
+        binding.dirty = true;
+        affected.push(index);
+    };
+    for (const auto index : _dirty)
+        visit(index);
+    for (std::uint32_t i = 0u; i < affected.size(); ++i) {
+        for (const auto reader : _properties[_bindings[affected[i]].property].readers)
+            visit(reader);
+    }
+
+    // Bindings not evaluated are left dirty, on error as on loop
+    struct DirtyGuard
+    {
+        BindingGraph &graph;
+        const Core::TinyVector<BindingIndex> &affected;
+
+        ~DirtyGuard(void) noexcept
+        {
+            graph._dirty.clear();
+            for (const auto index : affected) {
+                if (graph._bindings[index].dirty)
+                    graph._dirty.push(index);
+            }
+        }
+    } guard { *this, affected };
+
+    // Each binding waits for the affected bindings whose property it reads, levels are evaluated by dependency depth
+    for (const auto index : affected) {
+        for (const auto reader : _properties[_bindings[index].property].readers)
+            ++_bindings[reader].pending;
+    }
+    for (const auto index : affected) {
+        if (!_bindings[index].pending)
+            level.push(index);
+    }
+    while (!level.empty()) {
+        ++_levelCount;
+        next.clear();
+        evaluateLevel(level, next, generation);
+        std::swap(level, next);
+    }
+    for (const auto index : affected) {
+        if (_bindings[index].dirty) [[unlikely]]
+            throw std::logic_error("Lang::BindingGraph::update: Binding loop detected");
+    }
+}
+
+Lang::BindingGraph::PropertyIndex Lang::BindingGraph::findProperty(Object * const instance, const HashedName name)
+{
+    const auto it = std::lower_bound(_propertyOrder.begin(), _propertyOrder.end(), PropertyDependency { instance, name },
+        [this](const PropertyIndex index, const PropertyDependency &key) {
+            const auto &property = _properties[index];
+            if (property.instance != key.instance)
+                return std::less<Object *>()(property.instance, key.instance);
+            return property.name < key.name;
+        }
+    );
+
+    if (it != _propertyOrder.end() && _properties[*it].instance == instance && _properties[*it].name == name)
+        return *it;
+    const auto index = static_cast<PropertyIndex>(_properties.size());
+    _properties.push(Property {
+        instance: instance,
+        name: name
+    });
+    _propertyOrder.insert(it, &index, &index + 1);
+    return index;
+}
+
+void Lang::BindingGraph::markDirty(const BindingIndex index)
+{
+    auto &binding = _bindings[index];
+
+    if (binding.dirty)
+        return;
+    binding.dirty = true;
+    _dirty.push(index);
+}
+
+void Lang::BindingGraph::evaluateLevel(const Core::TinyVector<BindingIndex> &level, Core::TinyVector<BindingIndex> &next, const std::uint32_t generation)
+{
+    ++_levelStamp;
+    _concurrent.clear();
+    _retries.clear();
+
+    // Bindings never evaluated may read any property of the level, they are evaluated once the others are written
+    // Recorded dependencies only hold the branches taken before, so a binding is evaluated by a task only if no name
+    // its expression may read is the name of a property written by the level
+    if (_scheduler && level.size() > _threshold) {
+        Core::TinyVector<HashedName> written;
+        for (const auto index : level)
+            written.push(_properties[_bindings[index].property].name);
+        std::sort(written.begin(), written.end());
+        const auto mayReadLevel = [&written](const Expression &expression) {
+            const auto accesses = expression.accesses();
+            return expression.accessesAny() || std::any_of(accesses.begin(), accesses.end(), [&written](const HashedName name) {
+                return std::binary_search(written.begin(), written.end(), name);
+            });
+        };
+        for (const auto index : level) {
+            if (_bindings[index].evaluated && !mayReadLevel(*_bindings[index].expression))
+                _concurrent.push(index);
+        }
+        if (!_concurrent.empty())
+            evaluateConcurrently(next, generation);
+    }
+    for (const auto index : level) {
+        if (_bindings[index].level != _levelStamp)
+            evaluate(index, next, generation);
+    }
+    for (const auto index : _retries)
+        evaluate(index, next, generation);
+}
+
+void Lang::BindingGraph::evaluateConcurrently(Core::TinyVector<BindingIndex> &next, const std::uint32_t generation)
+{
+    const auto instanceOf = [this](const BindingIndex index) { return _properties[_bindings[index].property].instance; };
+
+    // Bindings of the same object are packed in the same chunk so that no object is written by two tasks
+    std::sort(_concurrent.begin(), _concurrent.end(), [&instanceOf](const BindingIndex lhs, const BindingIndex rhs) {
+        return std::less<Object *>()(instanceOf(lhs), instanceOf(rhs));
+    });
+    std::uint32_t chunkCount = 0u;
+    for (std::uint32_t i = 0u; i < _concurrent.size(); ++i) {
+        if (!chunkCount || (_chunks[chunkCount - 1u].end - _chunks[chunkCount - 1u].begin >= _threshold
+                && instanceOf(_concurrent[i]) != instanceOf(_concurrent[i - 1u]))) {
+            if (chunkCount == _chunks.size())
+                _chunks.push(Chunk {});
+            _chunks[chunkCount++].begin = i;
+        }
+        _chunks[chunkCount - 1u].end = i + 1u;
+        _bindings[_concurrent[i]].level = _levelStamp;
+    }
+
+    const auto executeChunk = [this](Chunk &chunk) {
+        chunk.reads.clear();
+        chunk.readEnds.clear();
+        chunk.error = nullptr;
+        try {
+            for (auto i = chunk.begin; i != chunk.end; ++i) {
+                execute(_concurrent[i], chunk.reads);
+                chunk.readEnds.push(static_cast<std::uint32_t>(chunk.reads.size()));
+            }
+        } catch (...) {
+            chunk.error = std::current_exception();
+        }
+    };
+    if (chunkCount == 1u) {
+        // A single task is not worth scheduling
+        executeChunk(_chunks[0]);
+    } else {
+        _graph.clear();
+        for (std::uint32_t i = 0u; i < chunkCount; ++i) {
+            Flow::StaticFunc work;
+            work.prepare([&executeChunk, chunk = &_chunks[i]] { executeChunk(*chunk); });
+            _graph.emplace(std::move(work));
+        }
+        _taskCount += chunkCount;
+        _scheduler->schedule(_graph);
+        _graph.wait();
+    }
+
+    // Graph changes are applied once every task is done, in the order of the level whatever the order tasks were executed in
+    for (std::uint32_t i = 0u; i < chunkCount; ++i) {
+        const auto &chunk = _chunks[i];
+        std::uint32_t readBegin = 0u;
+        for (std::uint32_t j = 0u; j < chunk.readEnds.size(); ++j) {
+            commit(_concurrent[chunk.begin + j], chunk.reads.begin() + readBegin, chunk.reads.begin() + chunk.readEnds[j]);
+            readBegin = chunk.readEnds[j];
+        }
+    }
+    for (std::uint32_t i = 0u; i < chunkCount; ++i) {
+        if (_chunks[i].error) [[unlikely]]
+            std::rethrow_exception(_chunks[i].error);
+    }
+    for (const auto index : _concurrent) {
+        if (!release(index, next, generation)) {
+            _bindings[index].dirty = true;
+            _retries.push(index);
+        }
+    }
+}
+
+void Lang::BindingGraph::evaluate(const BindingIndex index, Core::TinyVector<BindingIndex> &next, const std::uint32_t generation)
+{
+    _bindings[index].level = 0u;
+    _reads.clear();
+    execute(index, _reads);
+    commit(index, _reads.begin(), _reads.end());
+    (void)release(index, next, generation);
+}
+
+void Lang::BindingGraph::execute(const BindingIndex index, PropertyDependencies &reads) const
+{
+    const auto &binding = _bindings[index];
+    Var value;
+
+    // Reads are recorded for this evaluation only
+    {
+        const Processer::DependencyRecord record(reads);
+        value = (*binding.expression)(binding.instances, nullptr);
+    }
+    _properties[binding.property].instance->setVar(binding.data, value);
+}
+
+void Lang::BindingGraph::commit(const BindingIndex index, const PropertyDependency * const begin, const PropertyDependency * const end)
+{
+    Core::TinyVector<PropertyIndex> dependencies;
+
+    ++_evaluationCount;
+    for (auto read = begin; read != end; ++read)
+        dependencies.push(findProperty(read->instance, read->name));
+    std::sort(dependencies.begin(), dependencies.end());
+    dependencies.erase(std::unique(dependencies.begin(), dependencies.end()), dependencies.end());
+
+    auto &binding = _bindings[index];
+    binding.dirty = false;
+    binding.evaluated = true;
+    if (std::equal(dependencies.begin(), dependencies.end(), binding.dependencies.begin(), binding.dependencies.end()))
+        return;
+    for (const auto dependency : binding.dependencies) {
+        auto &readers = _properties[dependency].readers;
+        readers.erase(readers.find(index));
+    }
+    for (const auto dependency : dependencies)
+        _properties[dependency].readers.push(index);
+    binding.dependencies = std::move(dependencies);
+}
+
+bool Lang::BindingGraph::release(const BindingIndex index, Core::TinyVector<BindingIndex> &next, const std::uint32_t generation)
+{
+    auto &binding = _bindings[index];
+    const auto concurrent = binding.level == _levelStamp;
+    bool retry = false;
+
+    // Dependencies are discovered by evaluations, a binding that read a dirty binding waits for it to be evaluated again
+    for (const auto dependency : binding.dependencies) {
+        const auto writer = _properties[dependency].writer;
+        if (writer == NoBinding || writer == index)
+            continue;
+        const auto &other = _bindings[writer];
+        if (other.dirty) {
+            binding.dirty = true;
+            ++binding.pending;
+        } else if (concurrent && other.level == _levelStamp)
+            retry = true;
+    }
+    if (binding.dirty)
+        return true;
+    else if (retry)
+        return false;
+    for (const auto reader : _properties[binding.property].readers) {
+        auto &other = _bindings[reader];
+        if (other.mark == generation && other.pending && !--other.pending)
+            next.push(reader);
+    }
+    return true;
+}
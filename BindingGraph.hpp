@@ -0,0 +1,164 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: BindingGraph
+ */
+
+#pragma once
+
+#include <exception>
+
+#include <Kube/Core/Vector.hpp>
+#include <Kube/Flow/Scheduler.hpp>
+
+#include "Expression.hpp"
+#include "Processer.hpp"
+
+namespace kF::Lang
+{
+    class BindingGraph;
+}
+
+/** @brief The BindingGraph keeps properties bound to expressions up to date
+ *  Every evaluation records the properties read by its expression, across objects, so each property knows its readers
+ *  Changing a property only marks the bindings reading it dirty, so changes of a frame are coalesced until the next update
+ *  An update re-evaluates the dirty bindings and the ones depending on them level by level of dependency depth, each at most once
+ *  With a scheduler, big levels are split into Flow tasks, bindings of the same object always being evaluated by the same task
+ *  Only bindings that can't read a property written by their level are evaluated by tasks, the others are evaluated by the calling thread
+ *  A property has at most one binding, bindings depending on themselves are detected as loops when updated
+ *  The graph is not thread safe, properties written by expressions must be invalidated by their writer */
+class alignas_cacheline kF::Lang::BindingGraph
+{
+public:
+    /** @brief Index of a binding */
+    using BindingIndex = std::uint32_t;
+
+    /** @brief Invalid binding index */
+    static constexpr BindingIndex NoBinding = ~static_cast<BindingIndex>(0u);
+
+    /** @brief Default count of bindings a task should evaluate */
+    static constexpr std::uint32_t DefaultThreshold = 256u;
+
+
+    /** @brief Constructor, levels are evaluated by the calling thread without scheduler */
+    BindingGraph(Flow::Scheduler * const scheduler = nullptr, const std::uint32_t threshold = DefaultThreshold) noexcept
+        : _scheduler(scheduler), _threshold(threshold ? threshold : 1u) {}
+
+    /** @brief Graphs are not copyable */
+    BindingGraph(const BindingGraph &other) = delete;
+    BindingGraph &operator=(const BindingGraph &other) = delete;
+
+    /** @brief Destructor */
+    ~BindingGraph(void) noexcept = default;
+
+
+    /** @brief Bind the property 'name' of 'instance' to an expression, the binding is dirty until the next update
+     *  'instances' is the null terminated list of enclosing instances of the expression, it must outlive the binding */
+    BindingIndex add(Object &instance, const HashedName name, const Expression &expression, Object * const *instances);
+
+    /** @brief Notify that a property changed, the bindings reading it become dirty */
+    void invalidate(Object &instance, const HashedName name);
+
+    /** @brief Re-evaluate every dirty binding and the bindings depending on them
+     *  Bindings evaluated concurrently must write distinct objects and their objects must tolerate concurrent accesses
+     *  Throws if they depend on each other, every binding involved in the loop is then left dirty */
+    void update(void);
+
+
+    /** @brief Get the count of bindings */
+    [[nodiscard]] std::uint32_t bindingCount(void) const noexcept { return static_cast<std::uint32_t>(_bindings.size()); }
+
+    /** @brief Get the count of dirty bindings */
+    [[nodiscard]] std::uint32_t dirtyCount(void) const noexcept { return static_cast<std::uint32_t>(_dirty.size()); }
+
+    /** @brief Get the count of evaluations since the graph was created */
+    [[nodiscard]] std::uint64_t evaluationCount(void) const noexcept { return _evaluationCount; }
+
+    /** @brief Get the count of levels evaluated by the last update */
+    [[nodiscard]] std::uint32_t levelCount(void) const noexcept { return _levelCount; }
+
+    /** @brief Get the count of tasks scheduled by the last update */
+    [[nodiscard]] std::uint32_t taskCount(void) const noexcept { return _taskCount; }
+
+private:
+    /** @brief Index of a property node */
+    using PropertyIndex = std::uint32_t;
+
+    /** @brief A bound property or a property read by a binding */
+    struct alignas_half_cacheline Property
+    {
+        Object *instance { nullptr };
+        HashedName name { 0u };
+        BindingIndex writer { NoBinding };
+        Core::TinyVector<BindingIndex> readers {};
+    };
+
+    /** @brief A property bound to an expression */
+    struct alignas_cacheline Binding
+    {
+        const Expression *expression { nullptr };
+        Object * const *instances { nullptr };
+        Meta::Data data {};
+        PropertyIndex property { 0u };
+        std::uint32_t mark { 0u }; // Update generation that last visited the binding
+        std::uint32_t pending { 0u }; // Count of bindings to evaluate before this one during an update
+        std::uint32_t level { 0u }; // Level that last evaluated the binding concurrently
+        bool dirty { false };
+        bool evaluated { false };
+        Core::TinyVector<PropertyIndex> dependencies {};
+    };
+
+    /** @brief A range of bindings of a level evaluated by a single task */
+    struct alignas_cacheline Chunk
+    {
+        std::uint32_t begin { 0u };
+        std::uint32_t end { 0u };
+        PropertyDependencies reads {};
+        Core::TinyVector<std::uint32_t> readEnds {}; // End of the reads of each evaluated binding
+        std::exception_ptr error {};
+    };
+
+    // Cacheline 1
+    Core::Vector<Property> _properties {};
+    Core::Vector<PropertyIndex> _propertyOrder {}; // Properties sorted by instance and name
+    Core::Vector<Binding> _bindings {};
+    Core::TinyVector<BindingIndex> _dirty {};
+    // Cacheline 2
+    PropertyDependencies _reads {};
+    std::uint64_t _evaluationCount { 0u };
+    std::uint32_t _generation { 0u };
+    std::uint32_t _levelStamp { 0u };
+    std::uint32_t _levelCount { 0u };
+    std::uint32_t _taskCount { 0u };
+    Flow::Scheduler *_scheduler { nullptr };
+    std::uint32_t _threshold { DefaultThreshold };
+    // Cacheline 3
+    Core::TinyVector<BindingIndex> _concurrent {};
+    Core::TinyVector<BindingIndex> _retries {};
+    Core::TinyVector<Chunk> _chunks {};
+    Flow::Graph _graph {};
+
+    /** @brief Find a property node, creates it if it doesn't exist */
+    [[nodiscard]] PropertyIndex findProperty(Object * const instance, const HashedName name);
+
+    /** @brief Mark a binding dirty */
+    void markDirty(const BindingIndex index);
+
+    /** @brief Evaluate every binding of a level, the bindings it releases are pushed to the next level */
+    void evaluateLevel(const Core::TinyVector<BindingIndex> &level, Core::TinyVector<BindingIndex> &next, const std::uint32_t generation);
+
+    /** @brief Evaluate the bindings of a level whose dependencies are known across Flow tasks */
+    void evaluateConcurrently(Core::TinyVector<BindingIndex> &next, const std::uint32_t generation);
+
+    /** @brief Evaluate a binding on the calling thread, then release its readers */
+    void evaluate(const BindingIndex index, Core::TinyVector<BindingIndex> &next, const std::uint32_t generation);
+
+    /** @brief Execute the expression of a binding, recording its reads, this function is thread safe */
+    void execute(const BindingIndex index, PropertyDependencies &reads) const;
+
+    /** @brief Replace the dependencies of an executed binding by its recorded reads */
+    void commit(const BindingIndex index, const PropertyDependency * const begin, const PropertyDependency * const end);
+
+    /** @brief Release the readers of an evaluated binding unless it read a binding that is still dirty
+     *  Returns false when it read a binding evaluated concurrently, it must then be evaluated again */
+    [[nodiscard]] bool release(const BindingIndex index, Core::TinyVector<BindingIndex> &next, const std::uint32_t generation);
+};
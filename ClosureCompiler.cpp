@@ -0,0 +1,421 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: ClosureCompiler
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "ClosureCompiler.hpp"
+
+using namespace kF;
+
+Lang::ClosureCompiler::Units Lang::ClosureCompiler::run(const SyntaxTree &tree, const std::string_view &context)
+{
+    Units units;
+
+    if (tree.empty()) [[unlikely]]
+        return units;
+    tree.root().traverse([this, &units, &context](const AST &node) {
+        switch (node.type()) {
+        case TokenType::Class:
+            return true;
+        case TokenType::Function:
+        case TokenType::Property:
+        case TokenType::Event:
+        case TokenType::Assignment:
+        {
+            auto &unit = units.push(Unit {
+                node: &node,
+                expression: compile(node, context)
+            });
+            if (node.type() == TokenType::Event && !Compiler::IsSignalEvent(node))
+                unit.condition = compilePredicate(node, context);
+            return false;
+        }
+        default:
+            return false;
+        }
+    });
+    return units;
+}
+
+Lang::Expression::Ptr Lang::ClosureCompiler::compile(const AST &member, const std::string_view &context)
+{
+    switch (member.type()) {
+    case TokenType::Function:
+    case TokenType::Event:
+        return compileBody(member, *member.children()[1], false, context);
+    case TokenType::Property:
+    case TokenType::Assignment:
+        return compileBody(member, *member.children()[0], true, context);
+    default:
+        throwError("compile", "Member has no body", member);
+    }
+}
+
+Lang::Expression::Ptr Lang::ClosureCompiler::compilePredicate(const AST &event, const std::string_view &context)
+{
+    if (event.type() != TokenType::Event || Compiler::IsSignalEvent(event)) [[unlikely]]
+        throwError("compilePredicate", "Member has no predicate", event);
+    return compileBody(event, *event.children()[0], true, context);
+}
+
+Lang::Expression::Ptr Lang::ClosureCompiler::compileBody(const AST &member, const AST &body, const bool isValue, const std::string_view &context)
+{
+    _context = context;
+    _nodes.clear();
+    _loops.clear();
+    _argumentDepth = 0u;
+    _maxArgumentDepth = 0u;
+    _frameSize = 0u;
+    _cacheCount = 0u;
+    _externalCacheCount = 0u;
+    _accesses.clear();
+
+    // The root is copied in the first node once compiled
+    emit(ClosureNode {});
+    const auto root = isValue ? compileValue(body) : compileBlock(body);
+    _nodes[0] = _nodes[root];
+    if (_frameSize + _maxArgumentDepth > std::numeric_limits<std::uint16_t>::max()) [[unlikely]]
+        throwError("compile", "Member body is too large", member);
+    return Expression::Ptr(Expression::Construct(
+        _nodes.data(),
+        static_cast<std::uint32_t>(_nodes.size()),
+        static_cast<std::uint16_t>(_frameSize),
+        static_cast<std::uint16_t>(_maxArgumentDepth),
+        _cacheCount,
+        _externalCacheCount,
+        &_accesses
+    ));
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::compileValue(const AST &body)
+{
+    const AST *value = &body;
+
+    if (body.type() == TokenType::Expression) {
+        if (body.children().size() != 1u)
+            return compileBlock(body);
+        value = body.children()[0];
+    }
+    switch (value->type()) {
+    case TokenType::Expression:
+    case TokenType::Local:
+    case TokenType::Statement:
+        return compileBlock(body);
+    default:
+        return visit(*value);
+    }
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::compileBlock(const AST &body)
+{
+    if (body.type() == TokenType::Expression)
+        return visit(body);
+    // A single statement is wrapped so that its value is discarded
+    return emit(ClosureNode {
+        evaluate: &Closure::Block,
+        first: visit(body)
+    });
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::compileArguments(const AST *arguments, std::uint32_t &count)
+{
+    Core::TinyVector<const AST *> list;
+
+    // Comas are left associative so arguments are collected from the last one
+    if (arguments) {
+        while (arguments->type() == TokenType::Operator && arguments->operatorType() == OperatorType::Coma) {
+            list.push(arguments->children()[1]);
+            arguments = arguments->children()[0];
+        }
+        list.push(arguments);
+    }
+    std::reverse(list.begin(), list.end());
+    count = static_cast<std::uint32_t>(list.size());
+
+    // Arguments are reserved before being evaluated, nested calls use the variables above them
+    _argumentDepth += count;
+    _maxArgumentDepth = std::max(_maxArgumentDepth, _argumentDepth);
+    const auto first = compileList(list.size(), [this, &list](const std::size_t index) { return visit(*list[index]); });
+    _argumentDepth -= count;
+    return first;
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::compileLoop(const AST &body, const bool isSwitch)
+{
+    _loops.push(Loop {
+        isSwitch: isSwitch
+    });
+    const auto index = visit(body);
+    _loops.pop();
+    return index;
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::emit(const ClosureNode &node)
+{
+    const auto index = static_cast<NodeIndex>(_nodes.size());
+
+    _nodes.push(node);
+    return index;
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::emitLiteral(const std::string_view &literal)
+{
+    ClosureNode node {
+        evaluate: &Closure::Literal,
+        first: static_cast<NodeIndex>(_nodes.size() + 1u)
+    };
+    node.operand.member.index = static_cast<std::uint32_t>(literal.size());
+    const auto index = emit(node);
+
+    // The characters are stored in the nodes following the literal
+    _nodes.resize(_nodes.size() + (literal.size() + sizeof(ClosureNode) - 1u) / sizeof(ClosureNode));
+    std::memcpy(static_cast<void *>(&_nodes[index + 1u]), literal.data(), literal.size());
+    return index;
+}
+
+void Lang::ClosureCompiler::throwError(const char * const where, const char * const what, const AST &node) const
+{
+    std::string error = std::string("Lang::ClosureCompiler::") + where + ": " + what + '\n';
+
+    if (const auto token = node.token(); token) {
+        error += "At symbol '" + std::string(token->literal()) + "' from " + std::string(_context)
+            + ":l" + std::to_string(token->line) + ":c" + std::to_string(token->column);
+    } else
+        error += "From " + std::string(_context);
+    throw std::logic_error(error);
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::handle(TokenTag<TokenType::Expression>, const AST &node)
+{
+    const auto children = node.children();
+
+    return emit(ClosureNode {
+        evaluate: &Closure::Block,
+        first: compileList(children.size(), [this, &children](const std::size_t index) { return visit(*children[index]); })
+    });
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::handle(TokenTag<TokenType::Local>, const AST &node)
+{
+    const auto children = node.children();
+    const auto slot = children[1]->nameSlot();
+    ClosureNode local {
+        evaluate: &Closure::Local,
+        first: visit(*children[2])
+    };
+
+    local.operand.member.index = slot.index;
+    _frameSize = std::max(_frameSize, slot.index + 1u);
+    return emit(local);
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::handle(TokenTag<TokenType::Name>, const AST &node)
+{
+    switch (node.nameType()) {
+    case NameType::Parameter:
+    case NameType::Local:
+    case NameType::Property:
+    case NameType::External:
+        return compileTarget(node, ClosureNode {}, []<typename Target>(std::type_identity<Target>) -> NodeEvaluator {
+            return &Closure::Load<Target>;
+        });
+    default:
+        throwError("handle", "Name can't be used as a value", node);
+    }
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::handle(TokenTag<TokenType::Constant>, const AST &node)
+{
+    if (node.constantType() == ConstantType::Char) {
+        const auto literal = node.literal();
+        if (literal.size() < 3u) [[unlikely]]
+            throwError("handle", "Invalid character constant", node);
+        auto character = literal[1];
+        if (character == '\\') {
+            switch (literal[2]) {
+            case 'n':
+                character = '\n';
+                break;
+            case 't':
+                character = '\t';
+                break;
+            case '0':
+                character = '\0';
+                break;
+            default:
+                character = literal[2];
+                break;
+            }
+        }
+        return emit(ClosureNode {
+            evaluate: &Closure::Integer,
+            operand: { integer: character }
+        });
+    }
+    const auto value = Optimizer::ParseConstant(node);
+    switch (value.kind) {
+    case Optimizer::ValueKind::Integer:
+        return emit(ClosureNode {
+            evaluate: &Closure::Integer,
+            operand: { integer: value.integer }
+        });
+    case Optimizer::ValueKind::Floating:
+        return emit(ClosureNode {
+            evaluate: &Closure::Floating,
+            operand: { floating: value.floating }
+        });
+    case Optimizer::ValueKind::Boolean:
+        return emit(ClosureNode {
+            evaluate: &Closure::Boolean,
+            operand: { integer: value.boolean }
+        });
+    case Optimizer::ValueKind::Literal:
+        return emitLiteral(value.literal);
+    default:
+        throwError("handle", "Invalid constant", node);
+    }
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::handle(StatementTag<StatementType::If>, const AST &node)
+{
+    const auto children = node.children();
+    auto size = children.size();
+    NodeIndex alternative = NoNode;
+
+    // Children are stored as (condition, body) pairs followed by an optional else body, each pair is the else of the previous one
+    if (size % 2u)
+        alternative = visit(*children[--size]);
+    while (size) {
+        size -= 2u;
+        const auto condition = visit(*children[size]);
+        alternative = emit(ClosureNode {
+            evaluate: &Closure::If,
+            first: condition,
+            second: visit(*children[size + 1u]),
+            third: alternative
+        });
+    }
+    return alternative;
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::handle(StatementTag<StatementType::While>, const AST &node)
+{
+    const auto children = node.children();
+    const auto condition = visit(*children[0]);
+
+    return emit(ClosureNode {
+        evaluate: &Closure::While,
+        first: condition,
+        second: compileLoop(*children[1], false)
+    });
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::handle(StatementTag<StatementType::For>, const AST &node)
+{
+    const auto children = node.children();
+    const auto initialization = visit(*children[0]);
+    const auto condition = visit(*children[1]);
+    const auto step = visit(*children[2]);
+
+    // The initialization runs once before the loop, in the same block
+    _nodes[initialization].next = emit(ClosureNode {
+        evaluate: &Closure::For,
+        first: condition,
+        second: step,
+        third: compileLoop(*children[3], false)
+    });
+    return emit(ClosureNode {
+        evaluate: &Closure::Block,
+        first: initialization
+    });
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::handle(StatementTag<StatementType::Switch>, const AST &node)
+{
+    const auto children = node.children();
+    const SwitchTable table(node);
+    Core::TinyVector<NodeIndex> matches;
+    const auto subject = visit(*children[0]);
+    const auto caseCount = (children.size() - 1u) / 2u;
+    const auto cases = compileList(caseCount, [this, &children, &matches](const std::size_t index) {
+        const auto value = visit(*children[1u + index * 2u]);
+        return matches.push(emit(ClosureNode {
+            first: value,
+            second: compileLoop(*children[2u + index * 2u], true)
+        }));
+    });
+    ClosureNode closure {
+        evaluate: &Closure::Switch,
+        first: subject,
+        second: cases,
+        third: children.size() % 2u ? NoNode : compileLoop(*children.back(), true)
+    };
+
+    // The cases are still compared one by one to subjects of another type than the keys of the table
+    if (table.kind() != SwitchTable::Kind::None) {
+        const auto &entries = table.entries();
+        closure.evaluate = table.kind() == SwitchTable::Kind::Dense ? &Closure::DenseSwitch
+            : table.kind() == SwitchTable::Kind::Sorted ? &Closure::SortedSwitch : &Closure::HashedSwitch;
+        closure.operand.member.index = emit(ClosureNode {
+            first: static_cast<NodeIndex>(entries.size()),
+            second: table.seed()
+        });
+        _nodes[closure.operand.member.index].operand.integer = table.base();
+        for (const auto &entry : entries) {
+            ClosureNode match {};
+            if (entry.caseIndex != SwitchTable::NoCase)
+                match = _nodes[matches[entry.caseIndex]];
+            match.next = NoNode;
+            match.operand.integer = entry.key;
+            emit(match);
+        }
+    }
+    return emit(closure);
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::handle(StatementTag<StatementType::Break>, const AST &node)
+{
+    if (_loops.empty()) [[unlikely]]
+        throwError("handle", "Break statement outside of a loop or a switch", node);
+    return emit(ClosureNode {
+        evaluate: &Closure::Break
+    });
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::handle(StatementTag<StatementType::Continue>, const AST &node)
+{
+    if (std::none_of(_loops.begin(), _loops.end(), [](const Loop &loop) { return !loop.isSwitch; })) [[unlikely]]
+        throwError("handle", "Continue statement outside of a loop", node);
+    return emit(ClosureNode {
+        evaluate: &Closure::Continue
+    });
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::handle(StatementTag<StatementType::Return>, const AST &node)
+{
+    return emit(ClosureNode {
+        evaluate: &Closure::Return,
+        first: visit(*node.children()[0])
+    });
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::handle(StatementTag<StatementType::Emit>, const AST &node)
+{
+    const auto &call = *node.children()[0];
+
+    if (call.type() != TokenType::Operator || call.operatorType() != OperatorType::Call
+            || call.children()[0]->type() != TokenType::Name || call.children()[0]->nameType() != NameType::Signal) [[unlikely]]
+        throwError("handle", "Only signals can be emitted", node);
+    return visit(call);
+}
+
+Lang::NodeIndex Lang::ClosureCompiler::handleDefault(const AST &node)
+{
+    throwError("handleDefault", "Node can't be compiled", node);
+}
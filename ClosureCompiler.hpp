@@ -0,0 +1,132 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: ClosureCompiler
+ */
+
+#pragma once
+
+#include "Compiler.hpp"
+#include "ClosureProcesser.hpp"
+
+namespace kF::Lang
+{
+    class ClosureCompiler;
+}
+
+/** @brief The ClosureCompiler lowers the bodies of a resolved syntax tree into closure expressions
+ *  Each syntax node becomes a node bound to the evaluation function of its exact kind, with its operands resolved:
+ *  slots, name hashes, inline caches and constants are stored in the node so that evaluation never inspects the tree
+ *  Every handler returns the index of the node it built, nodes are stored contiguously in the expression
+ *  The frame holds the locals followed by the arguments of the deepest call */
+class alignas_cacheline kF::Lang::ClosureCompiler : public Visitor<ClosureCompiler, NodeIndex>
+{
+public:
+    /** @brief Compiled members share the layout of the stack machine ones */
+    using Unit = Compiler::Unit;
+    using Units = Compiler::Units;
+
+    /** @brief Nodes under construction */
+    using Nodes = Core::Vector<ClosureNode>;
+
+
+    /** @brief Compile every member with a body of a syntax tree, the tree must be resolved */
+    [[nodiscard]] Units run(const SyntaxTree &tree, const std::string_view &context);
+
+    /** @brief Compile the body of a single member */
+    [[nodiscard]] Expression::Ptr compile(const AST &member, const std::string_view &context);
+
+    /** @brief Compile the condition of an event that is not connected to a signal into a predicate */
+    [[nodiscard]] Expression::Ptr compilePredicate(const AST &event, const std::string_view &context);
+
+private:
+    /** @brief A loop (or switch) being compiled */
+    struct Loop
+    {
+        bool isSwitch { false };
+    };
+
+    // Cacheline 1
+    std::string_view _context {};
+    Nodes _nodes {};
+    Core::TinyVector<Loop> _loops {};
+    std::uint32_t _argumentDepth { 0u };
+    std::uint32_t _maxArgumentDepth { 0u };
+    std::uint32_t _frameSize { 0u };
+    CacheIndex _cacheCount { 0u };
+    CacheIndex _externalCacheCount { 0u };
+    NameAccesses _accesses {};
+
+    friend Visitor<ClosureCompiler, NodeIndex>;
+
+    /** @brief Compile a body of a member into an expression */
+    [[nodiscard]] Expression::Ptr compileBody(const AST &member, const AST &body, const bool isValue, const std::string_view &context);
+
+    /** @brief Compile a body whose value is returned when it holds a single expression */
+    [[nodiscard]] NodeIndex compileValue(const AST &body);
+
+    /** @brief Compile a body that returns nothing unless it uses a return statement */
+    [[nodiscard]] NodeIndex compileBlock(const AST &body);
+
+    /** @brief Compile a list of nodes linked by 'next' and evaluated in order, returns the first one */
+    template<typename Compile>
+    [[nodiscard]] NodeIndex compileList(const std::size_t count, Compile &&compile);
+
+    /** @brief Compile the arguments of a call, returns the first one and sets their count */
+    [[nodiscard]] NodeIndex compileArguments(const AST *arguments, std::uint32_t &count);
+
+    /** @brief Compile an access (read, assignment or step) to an assignable name or member
+     *  'bind' gets the target type as a 'std::type_identity' and returns the evaluation function of the access */
+    template<typename Bind>
+    [[nodiscard]] NodeIndex compileTarget(const AST &target, ClosureNode node, Bind &&bind);
+
+    /** @brief Compile a loop (or switch) body */
+    [[nodiscard]] NodeIndex compileLoop(const AST &body, const bool isSwitch);
+
+
+    /** @brief Append a node */
+    NodeIndex emit(const ClosureNode &node);
+
+    /** @brief Append a literal constant */
+    NodeIndex emitLiteral(const std::string_view &literal);
+
+    /** @brief Allocate an inline cache */
+    [[nodiscard]] CacheIndex nextCache(void) noexcept { return _cacheCount++; }
+
+    /** @brief Allocate an external cache */
+    [[nodiscard]] CacheIndex nextExternalCache(void) noexcept { return _externalCacheCount++; }
+
+    /** @brief Record an access to a named member through a target, loads read its name while stores may trigger any access */
+    template<typename Target>
+    void recordAccess(const ClosureNode &node) noexcept;
+
+    /** @brief Throw a compilation error on a node */
+    [[noreturn]] void throwError(const char * const where, const char * const what, const AST &node) const;
+
+
+    /** @brief Blocks, locals and leaves */
+    NodeIndex handle(TokenTag<TokenType::Expression>, const AST &node);
+    NodeIndex handle(TokenTag<TokenType::Local>, const AST &node);
+    NodeIndex handle(TokenTag<TokenType::Name>, const AST &node);
+    NodeIndex handle(TokenTag<TokenType::Constant>, const AST &node);
+
+    /** @brief Operators */
+    template<OperatorType Type>
+    NodeIndex handle(OperatorTag<Type>, const AST &node);
+
+    /** @brief Statements */
+    NodeIndex handle(StatementTag<StatementType::If>, const AST &node);
+    NodeIndex handle(StatementTag<StatementType::While>, const AST &node);
+    NodeIndex handle(StatementTag<StatementType::For>, const AST &node);
+    NodeIndex handle(StatementTag<StatementType::Switch>, const AST &node);
+    NodeIndex handle(StatementTag<StatementType::Break>, const AST &node);
+    NodeIndex handle(StatementTag<StatementType::Continue>, const AST &node);
+    NodeIndex handle(StatementTag<StatementType::Return>, const AST &node);
+    NodeIndex handle(StatementTag<StatementType::Emit>, const AST &node);
+
+    /** @brief Any other node can't be compiled */
+    NodeIndex handleDefault(const AST &node);
+};
+
+static_assert_fit_cacheline(kF::Lang::ClosureCompiler);
+
+#include "ClosureCompiler.ipp"
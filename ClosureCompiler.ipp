@@ -0,0 +1,228 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: ClosureCompiler
+ */
+
+#include <type_traits>
+
+#include "Optimizer.hpp"
+
+namespace kF::Lang::Closure
+{
+    /** @brief Make the operation of an arithmetic, comparison or bitwise operation code, void if there is none */
+    template<OpCode Code>
+    [[nodiscard]] constexpr auto MakeOperation(void) noexcept
+    {
+        if constexpr (Code == OpCode::Not)                  return std::logical_not<>();
+        else if constexpr (Code == OpCode::Minus)           return std::negate<>();
+        else if constexpr (Code == OpCode::BitReverse)      return std::bit_not<>();
+        else if constexpr (Code == OpCode::Addition)        return std::plus<>();
+        else if constexpr (Code == OpCode::Substraction)    return std::minus<>();
+        else if constexpr (Code == OpCode::Multiplication)  return std::multiplies<>();
+        else if constexpr (Code == OpCode::Division)        return std::divides<>();
+        else if constexpr (Code == OpCode::Modulo)          return std::modulus<>();
+        else if constexpr (Code == OpCode::Equal)           return std::equal_to<>();
+        else if constexpr (Code == OpCode::Different)       return std::not_equal_to<>();
+        else if constexpr (Code == OpCode::Greater)         return std::greater<>();
+        else if constexpr (Code == OpCode::GreaterEqual)    return std::greater_equal<>();
+        else if constexpr (Code == OpCode::Lighter)         return std::less<>();
+        else if constexpr (Code == OpCode::LighterEqual)    return std::less_equal<>();
+        else if constexpr (Code == OpCode::BitAnd)          return std::bit_and<>();
+        else if constexpr (Code == OpCode::BitOr)           return std::bit_or<>();
+        else if constexpr (Code == OpCode::BitXor)          return std::bit_xor<>();
+        else                                                return;
+    }
+
+    /** @brief Operation of an operator (compound assignments included) */
+    template<OperatorType Type>
+    using Operation = decltype(MakeOperation<GetOperatorOpCode(Type)>());
+}
+
+template<typename Compile>
+inline kF::Lang::NodeIndex kF::Lang::ClosureCompiler::compileList(const std::size_t count, Compile &&compile)
+{
+    NodeIndex first = NoNode;
+    NodeIndex last = NoNode;
+
+    for (std::size_t i = 0u; i < count; ++i) {
+        const auto index = compile(i);
+        if (last != NoNode)
+            _nodes[last].next = index;
+        else
+            first = index;
+        last = index;
+    }
+    return first;
+}
+
+template<typename Target>
+inline void kF::Lang::ClosureCompiler::recordAccess(const ClosureNode &node) noexcept
+{
+    if (node.evaluate == &Closure::Load<Target>)
+        _accesses.read(node.operand.member.name);
+    else
+        _accesses.accessAny();
+}
+
+template<typename Bind>
+inline kF::Lang::NodeIndex kF::Lang::ClosureCompiler::compileTarget(const AST &target, ClosureNode node, Bind &&bind)
+{
+    if (target.type() == TokenType::Name) {
+        const auto slot = target.nameSlot();
+        switch (target.nameType()) {
+        case NameType::Parameter:
+            node.evaluate = bind(std::type_identity<Closure::ParameterTarget>());
+            node.operand.member.index = slot.index;
+            break;
+        case NameType::Local:
+            node.evaluate = bind(std::type_identity<Closure::LocalTarget>());
+            node.operand.member.index = slot.index;
+            break;
+        case NameType::Property:
+            node.evaluate = bind(std::type_identity<Closure::PropertyTarget>());
+            node.third = slot.depth;
+            node.operand.member.name = Hash(target.literal());
+            node.operand.member.index = nextCache();
+            recordAccess<Closure::PropertyTarget>(node);
+            break;
+        case NameType::External:
+            node.evaluate = bind(std::type_identity<Closure::ExternalTarget>());
+            node.operand.member.name = slot.index;
+            node.operand.member.index = nextExternalCache();
+            recordAccess<Closure::ExternalTarget>(node);
+            break;
+        default:
+            throwError("compileTarget", "Name is not assignable", target);
+        }
+    } else if (target.type() == TokenType::Operator && target.operatorType() == OperatorType::Dot) {
+        const auto &member = *target.children()[1];
+        if (member.type() != TokenType::Name) [[unlikely]]
+            throwError("compileTarget", "Invalid member access", target);
+        node.evaluate = bind(std::type_identity<Closure::MemberTarget>());
+        node.first = visit(*target.children()[0]);
+        node.operand.member.name = member.nameSlot().index;
+        node.operand.member.index = nextCache();
+        recordAccess<Closure::MemberTarget>(node);
+    } else
+        throwError("compileTarget", "Expression is not assignable", target);
+    return emit(node);
+}
+
+template<kF::Lang::OperatorType Type>
+inline kF::Lang::NodeIndex kF::Lang::ClosureCompiler::handle(OperatorTag<Type>, const AST &node)
+{
+    using Operation = Closure::Operation<Type>;
+
+    const auto children = node.children();
+
+    if constexpr (Type == OperatorType::Not || Type == OperatorType::Minus || Type == OperatorType::BitReverse) {
+        return emit(ClosureNode {
+            evaluate: &Closure::Unary<Operation>,
+            first: visit(*children[0])
+        });
+    } else if constexpr (Type == OperatorType::Increment || Type == OperatorType::Decrement
+            || Type == OperatorType::IncrementSuffix || Type == OperatorType::DecrementSuffix) {
+        constexpr bool IsIncrement = Type == OperatorType::Increment || Type == OperatorType::IncrementSuffix;
+        constexpr bool IsSuffix = Type == OperatorType::IncrementSuffix || Type == OperatorType::DecrementSuffix;
+        return compileTarget(*children[0], ClosureNode {}, []<typename Target>(std::type_identity<Target>) -> NodeEvaluator {
+            return &Closure::Step<Target, IsIncrement, IsSuffix>;
+        });
+    } else if constexpr (Type == OperatorType::And || Type == OperatorType::Or) {
+        const auto lhs = visit(*children[0]);
+        return emit(ClosureNode {
+            evaluate: Type == OperatorType::And ? &Closure::And : &Closure::Or,
+            first: lhs,
+            second: visit(*children[1])
+        });
+    } else if constexpr (Type == OperatorType::Assign || (Type >= OperatorType::AdditionAssign && Type <= OperatorType::BitXorAssign)) {
+        using Assignment = std::conditional_t<Type == OperatorType::Assign, Closure::Replace, Operation>;
+        return compileTarget(*children[0], ClosureNode { second: visit(*children[1]) }, []<typename Target>(std::type_identity<Target>) -> NodeEvaluator {
+            return &Closure::Assign<Target, Assignment>;
+        });
+    } else if constexpr (!std::is_void_v<Operation>) {
+        const auto &rhs = *children[1];
+        const auto lhs = visit(*children[0]);
+        // Integer constants are bound to the node instead of being evaluated
+        if (rhs.type() == TokenType::Constant && rhs.constantType() != ConstantType::Char) {
+            if (const auto value = Optimizer::ParseConstant(rhs); value.kind == Optimizer::ValueKind::Integer) {
+                return emit(ClosureNode {
+                    evaluate: &Closure::BinaryInteger<Operation>,
+                    first: lhs,
+                    operand: { integer: value.integer }
+                });
+            }
+        }
+        return emit(ClosureNode {
+            evaluate: &Closure::Binary<Operation>,
+            first: lhs,
+            second: visit(rhs)
+        });
+    } else if constexpr (Type == OperatorType::Coma) {
+        const auto lhs = visit(*children[0]);
+        return emit(ClosureNode {
+            evaluate: &Closure::Coma,
+            first: lhs,
+            second: visit(*children[1])
+        });
+    } else if constexpr (Type == OperatorType::Dot) {
+        // Method calls are parsed as a dot whose right hand side is a call
+        const auto &member = *children[1];
+        if (member.type() == TokenType::Name) {
+            return compileTarget(node, ClosureNode {}, []<typename Target>(std::type_identity<Target>) -> NodeEvaluator {
+                return &Closure::Load<Target>;
+            });
+        } else if (member.type() == TokenType::Operator && member.operatorType() == OperatorType::Call
+                && member.children()[0]->type() == TokenType::Name) {
+            const auto arguments = member.children();
+            const auto object = visit(*children[0]);
+            std::uint32_t count = 0u;
+            ClosureNode call {
+                evaluate: &Closure::CallMember,
+                first: object,
+                second: compileArguments(arguments.size() > 1u ? arguments[1] : nullptr, count)
+            };
+            call.third = count;
+            call.operand.member.name = arguments[0]->nameSlot().index;
+            _accesses.accessAny();
+            return emit(call);
+        } else [[unlikely]]
+            throwError("handle", "Invalid member access", node);
+    } else if constexpr (Type == OperatorType::Call) {
+        const auto &callee = *children[0];
+        if (callee.type() != TokenType::Name) [[unlikely]]
+            throwError("handle", "Expression is not callable", node);
+        const auto slot = callee.nameSlot();
+        std::uint32_t count = 0u;
+        ClosureNode call {
+            first: compileArguments(children.size() > 1u ? children[1] : nullptr, count)
+        };
+        call.third = count;
+        _accesses.accessAny();
+        switch (callee.nameType()) {
+        case NameType::Function:
+        case NameType::Signal:
+            call.evaluate = callee.nameType() == NameType::Function ? &Closure::CallFunction : &Closure::Emit;
+            call.operand.member.name = Hash(callee.literal());
+            call.operand.member.index = slot.depth;
+            break;
+        case NameType::External:
+            call.evaluate = &Closure::CallExternal;
+            call.operand.member.name = slot.index;
+            call.operand.member.index = nextExternalCache();
+            break;
+        default:
+            throwError("handle", "Variable is not callable", callee);
+        }
+        return emit(call);
+    } else if constexpr (Type == OperatorType::TernaryIf) {
+        const auto condition = visit(*children[0]);
+        const auto lhs = visit(*children[1]);
+        return emit(ClosureNode {
+            evaluate: &Closure::Ternary,
+            first: condition,
+            second: lhs,
+            third: visit(*children[2])
+        });
+    } else
+        return handleDefault(node);
+}
@@ -0,0 +1,59 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: ClosureProcesser
+ */
+
+#include <stdexcept>
+
+#include "ClosureProcesser.hpp"
+
+using namespace kF;
+
+Lang::ClosureProcesser &Lang::ClosureProcesser::Local(void) noexcept
+{
+    thread_local ClosureProcesser processer;
+
+    return processer;
+}
+
+Var Lang::ClosureProcesser::process(const Expression &expression, Object * const *instances, Var *args)
+{
+    const auto base = _top;
+    const auto top = base + expression.frameSize() + expression.stackSize();
+
+    // Variables can only grow when no frame is running as frames reference their arguments by address
+    if (top > _stack.size()) [[unlikely]] {
+        if (base) [[unlikely]]
+            throw std::logic_error("Lang::ClosureProcesser::process: Stack overflow");
+        _stack.resize(top);
+    }
+    _top = top;
+
+    Var * const locals = _stack.data() + base;
+
+    // The frame is released on return as on error
+    struct FrameGuard
+    {
+        ClosureProcesser &processer;
+        Var * const locals;
+        const std::uint32_t base;
+        const std::uint32_t top;
+
+        ~FrameGuard(void) noexcept { Processer::Release(locals, locals + (top - base)); processer._top = base; }
+    } guard { *this, locals, base, top };
+
+    ClosureFrame frame {
+        nodes: reinterpret_cast<const ClosureNode *>(expression.data()),
+        locals: locals,
+        top: locals + expression.frameSize(),
+        args: args,
+        instances: instances,
+        expression: &expression
+    };
+    const auto &root = frame.nodes[0];
+    auto value = root.evaluate(root, frame);
+
+    if (frame.flow == ClosureFlow::Return)
+        return std::move(frame.result);
+    return value;
+}
@@ -0,0 +1,131 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: ClosureProcesser
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+
+#include "Expression.hpp"
+
+namespace kF::Lang
+{
+    class ClosureProcesser;
+    struct ClosureNode;
+    struct ClosureFrame;
+
+    /** @brief Index of a node in a closure expression */
+    using NodeIndex = std::uint32_t;
+
+    /** @brief Invalid node index */
+    constexpr NodeIndex NoNode = ~static_cast<NodeIndex>(0u);
+
+    /** @brief Function evaluating a node, statements return void */
+    using NodeEvaluator = Var(*)(const ClosureNode &node, ClosureFrame &frame);
+
+    /** @brief Pending control flow of a frame, set by statements and consumed by the loop, switch or body they leave */
+    enum class ClosureFlow : std::uint32_t {
+        None,
+        Break,
+        Continue,
+        Return
+    };
+}
+
+/** @brief Node of a closure expression, a pre-bound callable made of its evaluation function and resolved operands
+ *  Nodes are stored contiguously, node 0 being the root, children are referenced by index and lists are linked by 'next'
+ *  The meaning of the operands depends on the evaluation function, 'integer', 'floating' and 'member' being the fields of 'operand':
+ *      Constants: 'integer' or 'floating', literals hold the node where their bytes start in 'first' and their length in 'member.index'
+ *      Operators: their operands in 'first' and 'second', binary operators on an integer constant hold it in 'integer'
+ *      Parameter / Local: the slot index in 'member.index'
+ *      Property: the name hash, the inline cache in 'member.index' and the depth in 'third'
+ *      External: the name hash and the external cache in 'member'
+ *      Member access: the object in 'first', the name hash and the inline cache in 'member'
+ *      Assignments and steps: the target operands as above and the assigned value in 'second'
+ *      Calls: the first argument in 'first' ('second' for members), the argument count in 'third' and the depth (external cache for externals) in 'member.index'
+ *      Blocks: the first statement in 'first'
+ *      Locals: the initial value in 'first' and the slot index in 'member.index'
+ *      If / Ternary: the condition, the body and the optional else in 'first', 'second' and 'third'
+ *      While: the condition and the body in 'first' and 'second'
+ *      For: the condition, the step and the body in 'first', 'second' and 'third', its initialization being a statement before it
+ *      Switch: the subject, the first case and the optional default in 'first', 'second' and 'third', switches dispatched
+ *          through a table hold it in 'member.index'
+ *      Switch table: the entry count and the seed of hashed tables in 'first' and 'second', the key of the first entry in 'integer',
+ *          followed by its entries holding their key in 'integer', their compared value and body in 'first' and 'second'
+ *          (empty entries have no compared value)
+ *      Case: the compared value and the body in 'first' and 'second'
+ *      Return: the returned value in 'first' */
+struct alignas_half_cacheline kF::Lang::ClosureNode
+{
+    NodeEvaluator evaluate { nullptr };
+    NodeIndex first { NoNode };
+    NodeIndex second { NoNode };
+    NodeIndex third { NoNode };
+    NodeIndex next { NoNode };
+    union {
+        std::int64_t integer;
+        double floating;
+        struct {
+            HashedName name;
+            std::uint32_t index;
+        } member;
+    } operand { integer: 0 };
+};
+
+static_assert_fit_half_cacheline(kF::Lang::ClosureNode);
+
+/** @brief Frame of a running closure expression */
+struct alignas_cacheline kF::Lang::ClosureFrame
+{
+    const ClosureNode *nodes { nullptr };
+    Var *locals { nullptr };
+    Var *top { nullptr }; // First free variable, used for call arguments
+    Var *args { nullptr };
+    Object * const *instances { nullptr };
+    const Expression *expression { nullptr };
+    ClosureFlow flow { ClosureFlow::None };
+    Var result {};
+};
+
+/** @brief The ClosureProcesser executes expressions produced by the ClosureCompiler
+ *  Each node calls the evaluation functions of its children directly, there is no instruction dispatch
+ *  Each thread owns a processer whose variables are preallocated once and reused by every call, nested calls included
+ *  A call frame is made of the expression's locals followed by room for the arguments of its calls */
+class alignas_cacheline kF::Lang::ClosureProcesser
+{
+public:
+    /** @brief Count of variables preallocated in a processer */
+    static constexpr std::size_t DefaultStackSize = 4096u;
+
+
+    /** @brief Get the processer of the calling thread */
+    [[nodiscard]] static ClosureProcesser &Local(void) noexcept;
+
+    /** @brief Construct a processer and preallocate its variables */
+    ClosureProcesser(const std::size_t stackSize = DefaultStackSize) { _stack.resize(stackSize); }
+
+    /** @brief Processers are not copyable */
+    ClosureProcesser(const ClosureProcesser &other) = delete;
+    ClosureProcesser &operator=(const ClosureProcesser &other) = delete;
+
+    /** @brief Destructor */
+    ~ClosureProcesser(void) noexcept = default;
+
+
+    /** @brief Execute an expression
+     *  'instances' is a null terminated list of the instance of each enclosing class, innermost first
+     *  'args' holds the parameters of the expression */
+    [[nodiscard]] Var process(const Expression &expression, Object * const *instances, Var *args);
+
+    /** @brief Get the count of variables used by running frames */
+    [[nodiscard]] std::uint32_t stackSize(void) const noexcept { return _top; }
+
+private:
+    Core::Vector<Var> _stack {};
+    std::uint32_t _top { 0u };
+};
+
+static_assert_fit_cacheline(kF::Lang::ClosureProcesser);
+
+#include "ClosureProcesser.ipp"
@@ -0,0 +1,383 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: ClosureProcesser
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+#include "Processer.hpp"
+
+/** @brief Evaluation functions bound to closure nodes by the ClosureCompiler */
+namespace kF::Lang::Closure
+{
+    /** @brief Name of the processing function used by errors */
+    constexpr auto Where = "Lang::ClosureProcesser::process";
+
+    /** @brief Marker of an assignment that doesn't read its previous value */
+    struct Replace {};
+
+    /** @brief Evaluate a node */
+    [[nodiscard]] inline Var Evaluate(ClosureFrame &frame, const NodeIndex index)
+    {
+        const auto &node = frame.nodes[index];
+        return node.evaluate(node, frame);
+    }
+
+    /** @brief Evaluate a statement, returns true if the control flow leaves the current block */
+    [[nodiscard]] inline bool Execute(ClosureFrame &frame, const NodeIndex index)
+    {
+        (void)Evaluate(frame, index);
+        return frame.flow != ClosureFlow::None;
+    }
+
+
+    /** @brief Targets of reads and assignments, they resolve their variable once when constructed */
+    struct ParameterTarget
+    {
+        Var &slot;
+
+        ParameterTarget(const ClosureNode &node, ClosureFrame &frame) noexcept : slot(frame.args[node.operand.member.index]) {}
+
+        [[nodiscard]] Var load(void) const { return Var::Assign(slot); }
+        void store(const Var &value) const { slot.assign(value); }
+    };
+
+    struct LocalTarget
+    {
+        Var &slot;
+
+        LocalTarget(const ClosureNode &node, ClosureFrame &frame) noexcept : slot(frame.locals[node.operand.member.index]) {}
+
+        [[nodiscard]] Var load(void) const { return Var::Assign(slot); }
+        void store(const Var &value) const { slot.assign(value); }
+    };
+
+    struct PropertyTarget
+    {
+        Object &instance;
+        HashedName name;
+        Meta::Data data;
+
+        PropertyTarget(const ClosureNode &node, ClosureFrame &frame)
+            : instance(*frame.instances[node.third])
+            , name(node.operand.member.name)
+            , data(Processer::FindData(Where, frame.expression->cacheAt(node.operand.member.index), instance, node.operand.member.name)) {}
+
+        [[nodiscard]] Var load(void) const { return Processer::GetVar(instance, data, name); }
+        void store(const Var &value) const { instance.setVar(data, value); }
+    };
+
+    struct ExternalTarget
+    {
+        HashedName name;
+        Meta::Data data {};
+        Object &instance;
+
+        ExternalTarget(const ClosureNode &node, ClosureFrame &frame)
+            : name(node.operand.member.name)
+            , instance(Processer::FindExternalData(Where, frame.expression->externalCacheAt(node.operand.member.index), frame.instances, node.operand.member.name, data)) {}
+
+        [[nodiscard]] Var load(void) const { return Processer::GetVar(instance, data, name); }
+        void store(const Var &value) const { instance.setVar(data, value); }
+    };
+
+    struct MemberTarget
+    {
+        Object &instance;
+        HashedName name;
+        Meta::Data data;
+
+        MemberTarget(const ClosureNode &node, ClosureFrame &frame)
+            : instance(*Evaluate(frame, node.first).as<Object *>())
+            , name(node.operand.member.name)
+            , data(Processer::FindData(Where, frame.expression->cacheAt(node.operand.member.index), instance, node.operand.member.name)) {}
+
+        [[nodiscard]] Var load(void) const { return Processer::GetVar(instance, data, name); }
+        void store(const Var &value) const { instance.setVar(data, value); }
+    };
+
+
+    /** @brief Constants */
+    inline Var Void(const ClosureNode &, ClosureFrame &) { return Var(); }
+
+    inline Var Boolean(const ClosureNode &node, ClosureFrame &) { return Var(static_cast<bool>(node.operand.integer)); }
+
+    inline Var Integer(const ClosureNode &node, ClosureFrame &) { return Var(node.operand.integer); }
+
+    inline Var Floating(const ClosureNode &node, ClosureFrame &) { return Var(node.operand.floating); }
+
+    inline Var Literal(const ClosureNode &node, ClosureFrame &frame)
+        { return Var(std::string(reinterpret_cast<const char *>(frame.nodes + node.first), node.operand.member.index)); }
+
+    /** @brief Variables */
+    template<typename Target>
+    inline Var Load(const ClosureNode &node, ClosureFrame &frame) { return Target(node, frame).load(); }
+
+    template<typename Target, typename Operation>
+    inline Var Assign(const ClosureNode &node, ClosureFrame &frame)
+    {
+        const Target target(node, frame);
+        Var value;
+
+        if constexpr (std::is_same_v<Operation, Replace>)
+            value = Evaluate(frame, node.second);
+        else {
+            const auto previous = target.load();
+            value = Operation()(previous, Evaluate(frame, node.second));
+        }
+        target.store(value);
+        return value;
+    }
+
+    template<typename Target, bool IsIncrement, bool IsSuffix>
+    inline Var Step(const ClosureNode &node, ClosureFrame &frame)
+    {
+        const Target target(node, frame);
+        auto previous = target.load();
+        auto value = IsIncrement ? previous + Var(static_cast<std::int64_t>(1)) : previous - Var(static_cast<std::int64_t>(1));
+
+        target.store(value);
+        return IsSuffix ? std::move(previous) : std::move(value);
+    }
+
+    /** @brief Operators, the left hand side is always evaluated first */
+    template<typename Operation>
+    inline Var Unary(const ClosureNode &node, ClosureFrame &frame) { return Operation()(Evaluate(frame, node.first)); }
+
+    inline Var ToBoolean(const ClosureNode &node, ClosureFrame &frame) { return Var(Evaluate(frame, node.first).toBool()); }
+
+    template<typename Operation>
+    inline Var Binary(const ClosureNode &node, ClosureFrame &frame)
+    {
+        const auto lhs = Evaluate(frame, node.first);
+        return Operation()(lhs, Evaluate(frame, node.second));
+    }
+
+    template<typename Operation>
+    inline Var BinaryInteger(const ClosureNode &node, ClosureFrame &frame)
+        { return Operation()(Evaluate(frame, node.first), Var(node.operand.integer)); }
+
+    inline Var And(const ClosureNode &node, ClosureFrame &frame)
+        { return Var(Evaluate(frame, node.first).toBool() && Evaluate(frame, node.second).toBool()); }
+
+    inline Var Or(const ClosureNode &node, ClosureFrame &frame)
+        { return Var(Evaluate(frame, node.first).toBool() || Evaluate(frame, node.second).toBool()); }
+
+    inline Var Coma(const ClosureNode &node, ClosureFrame &frame)
+    {
+        (void)Evaluate(frame, node.first);
+        return Evaluate(frame, node.second);
+    }
+
+    inline Var Ternary(const ClosureNode &node, ClosureFrame &frame)
+        { return Evaluate(frame, Evaluate(frame, node.first).toBool() ? node.second : node.third); }
+
+    /** @brief Calls, arguments are evaluated into the free variables of the frame */
+    [[nodiscard]] inline Var *EvaluateArguments(const ClosureNode &node, ClosureFrame &frame, const NodeIndex first)
+    {
+        Var * const arguments = frame.top;
+        auto *argument = arguments;
+
+        frame.top += node.third;
+        for (auto index = first; index != NoNode; index = frame.nodes[index].next)
+            *argument++ = Evaluate(frame, index);
+        return arguments;
+    }
+
+    [[nodiscard]] inline Var Invoke(ClosureFrame &frame, const Meta::Function &function, Object &instance, Var * const arguments)
+    {
+        Var result = function.invoke(&instance, arguments);
+
+        Processer::Release(arguments, frame.top);
+        frame.top = arguments;
+        return result;
+    }
+
+    inline Var CallFunction(const ClosureNode &node, ClosureFrame &frame)
+    {
+        auto &instance = *frame.instances[node.operand.member.index];
+        const auto function = Processer::FindFunction(Where, instance, node.operand.member.name);
+        return Invoke(frame, function, instance, EvaluateArguments(node, frame, node.first));
+    }
+
+    inline Var CallExternal(const ClosureNode &node, ClosureFrame &frame)
+    {
+        Meta::Function function;
+        auto &instance = Processer::FindExternalFunction(Where, frame.expression->externalCacheAt(node.operand.member.index), frame.instances, node.operand.member.name, function);
+        return Invoke(frame, function, instance, EvaluateArguments(node, frame, node.first));
+    }
+
+    inline Var CallMember(const ClosureNode &node, ClosureFrame &frame)
+    {
+        auto &object = *Evaluate(frame, node.first).as<Object *>();
+        const auto arguments = EvaluateArguments(node, frame, node.second);
+        return Invoke(frame, Processer::FindFunction(Where, object, node.operand.member.name), object, arguments);
+    }
+
+    inline Var Emit(const ClosureNode &node, ClosureFrame &frame)
+    {
+        auto &instance = *frame.instances[node.operand.member.index];
+        const auto arguments = EvaluateArguments(node, frame, node.first);
+
+        instance.emitSignal(Processer::FindSignal(Where, instance, node.operand.member.name), arguments, node.third);
+        Processer::Release(arguments, frame.top);
+        frame.top = arguments;
+        return Var();
+    }
+
+    /** @brief Statements */
+    inline Var Block(const ClosureNode &node, ClosureFrame &frame)
+    {
+        for (auto index = node.first; index != NoNode && !Execute(frame, index); index = frame.nodes[index].next);
+        return Var();
+    }
+
+    inline Var Local(const ClosureNode &node, ClosureFrame &frame)
+    {
+        frame.locals[node.operand.member.index] = Evaluate(frame, node.first);
+        return Var();
+    }
+
+    inline Var If(const ClosureNode &node, ClosureFrame &frame)
+    {
+        if (Evaluate(frame, node.first).toBool())
+            (void)Evaluate(frame, node.second);
+        else if (node.third != NoNode)
+            (void)Evaluate(frame, node.third);
+        return Var();
+    }
+
+    /** @brief Consume the control flow left by the body of a loop, returns true if the loop must stop */
+    [[nodiscard]] inline bool LeaveLoop(ClosureFrame &frame) noexcept
+    {
+        switch (frame.flow) {
+        case ClosureFlow::Break:
+            frame.flow = ClosureFlow::None;
+            return true;
+        case ClosureFlow::Continue:
+            frame.flow = ClosureFlow::None;
+            return false;
+        default:
+            return true;
+        }
+    }
+
+    inline Var While(const ClosureNode &node, ClosureFrame &frame)
+    {
+        while (Evaluate(frame, node.first).toBool()) {
+            if (Execute(frame, node.second) && LeaveLoop(frame))
+                break;
+        }
+        return Var();
+    }
+
+    inline Var For(const ClosureNode &node, ClosureFrame &frame)
+    {
+        for (; Evaluate(frame, node.first).toBool(); (void)Evaluate(frame, node.second)) {
+            if (Execute(frame, node.third) && LeaveLoop(frame))
+                break;
+        }
+        return Var();
+    }
+
+    /** @brief Find the body of the case of a switch matching its subject by comparing it to each case, or its default */
+    [[nodiscard]] inline NodeIndex MatchCase(const ClosureNode &node, ClosureFrame &frame, const Var &subject)
+    {
+        for (auto index = node.second; index != NoNode; index = frame.nodes[index].next) {
+            const auto &match = frame.nodes[index];
+            if ((subject == Evaluate(frame, match.first)).toBool())
+                return match.second;
+        }
+        return node.third;
+    }
+
+    /** @brief Get the body of an entry of the table of a switch, the entry count stands for its default */
+    [[nodiscard]] inline NodeIndex EntryCase(const ClosureNode &node, const ClosureFrame &frame, const std::uint32_t entry) noexcept
+    {
+        const auto &table = frame.nodes[node.operand.member.index];
+        if (entry == table.first)
+            return node.third;
+        const auto &match = frame.nodes[node.operand.member.index + 1u + entry];
+        return match.first != NoNode ? match.second : node.third;
+    }
+
+    /** @brief Run the body of the matching case of a switch */
+    inline Var RunCase(ClosureFrame &frame, const NodeIndex body)
+    {
+        // Continue statements are left to the enclosing loop
+        if (body != NoNode && Execute(frame, body) && frame.flow == ClosureFlow::Break)
+            frame.flow = ClosureFlow::None;
+        return Var();
+    }
+
+    inline Var Switch(const ClosureNode &node, ClosureFrame &frame)
+    {
+        const auto subject = Evaluate(frame, node.first);
+        return RunCase(frame, MatchCase(node, frame, subject));
+    }
+
+    /** @brief Switches dispatched through a table, subjects of another type than the keys are compared to each case */
+    inline Var DenseSwitch(const ClosureNode &node, ClosureFrame &frame)
+    {
+        const auto subject = Evaluate(frame, node.first);
+        const auto &table = frame.nodes[node.operand.member.index];
+        if (!subject.is<std::int64_t>()) [[unlikely]]
+            return RunCase(frame, MatchCase(node, frame, subject));
+        const auto offset = static_cast<std::uint64_t>(subject.as<std::int64_t>()) - static_cast<std::uint64_t>(table.operand.integer);
+        return RunCase(frame, EntryCase(node, frame, offset < table.first ? static_cast<std::uint32_t>(offset) : table.first));
+    }
+
+    inline Var SortedSwitch(const ClosureNode &node, ClosureFrame &frame)
+    {
+        const auto subject = Evaluate(frame, node.first);
+        const auto &table = frame.nodes[node.operand.member.index];
+        if (!subject.is<std::int64_t>()) [[unlikely]]
+            return RunCase(frame, MatchCase(node, frame, subject));
+        const auto key = subject.as<std::int64_t>();
+        const auto entries = &table + 1;
+        const auto it = std::lower_bound(entries, entries + table.first, key,
+            [](const ClosureNode &entry, const std::int64_t key) { return entry.operand.integer < key; });
+        const auto entry = it != entries + table.first && it->operand.integer == key ? static_cast<std::uint32_t>(it - entries) : table.first;
+        return RunCase(frame, EntryCase(node, frame, entry));
+    }
+
+    inline Var HashedSwitch(const ClosureNode &node, ClosureFrame &frame)
+    {
+        const auto subject = Evaluate(frame, node.first);
+        const auto &table = frame.nodes[node.operand.member.index];
+        if (!subject.is<std::string>()) [[unlikely]]
+            return RunCase(frame, MatchCase(node, frame, subject));
+        const auto &string = subject.as<std::string>();
+        auto entry = HashedEntry(Hash(std::string_view(string)), table.second, table.first);
+        const auto literal = (&table)[1u + entry].first;
+
+        // Different literals may share an entry
+        if (literal == NoNode || frame.nodes[literal].operand.member.index != string.size()
+                || std::memcmp(frame.nodes + frame.nodes[literal].first, string.data(), string.size()))
+            entry = table.first;
+        return RunCase(frame, EntryCase(node, frame, entry));
+    }
+
+    inline Var Break(const ClosureNode &, ClosureFrame &frame)
+    {
+        frame.flow = ClosureFlow::Break;
+        return Var();
+    }
+
+    inline Var Continue(const ClosureNode &, ClosureFrame &frame)
+    {
+        frame.flow = ClosureFlow::Continue;
+        return Var();
+    }
+
+    inline Var Return(const ClosureNode &node, ClosureFrame &frame)
+    {
+        frame.result = Evaluate(frame, node.first);
+        frame.flow = ClosureFlow::Return;
+        return Var();
+    }
+}
@@ -0,0 +1,384 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: ColumnStorage
+ */
+
+#include <functional>
+#include <string>
+
+#include "Optimizer.hpp"
+#include "ColumnStorage.hpp"
+
+using namespace kF;
+
+Lang::ColumnStorage::ColumnIndex Lang::ColumnStorage::findColumn(const HashedName name) const noexcept
+{
+    const auto it = std::find_if(_columns.begin(), _columns.end(), [name](const Column &column) { return column.name == name; });
+
+    if (it == _columns.end())
+        return NoColumn;
+    return static_cast<ColumnIndex>(std::distance(_columns.begin(), it));
+}
+
+Lang::ColumnStorage::ColumnIndex Lang::ColumnStorage::addColumn(const HashedName name, const ColumnType type)
+{
+    const auto index = static_cast<ColumnIndex>(_columns.size());
+
+    if (findColumn(name) != NoColumn) [[unlikely]]
+        throw std::logic_error("Lang::ColumnStorage::addColumn: Column already exists");
+    auto &column = _columns.push(Column {
+        name: name,
+        type: type
+    });
+    if (type == ColumnType::Integer)
+        column.integers.resize(_rowCount, 0);
+    else
+        column.floatings.resize(_rowCount, 0.0);
+    return index;
+}
+
+std::uint32_t Lang::ColumnStorage::addRows(const std::uint32_t count)
+{
+    const auto first = _rowCount;
+
+    _rowCount += count;
+    for (auto &column : _columns) {
+        if (column.type == ColumnType::Integer)
+            column.integers.resize(_rowCount, 0);
+        else
+            column.floatings.resize(_rowCount, 0.0);
+    }
+    return first;
+}
+
+Var Lang::ColumnStorage::get(const ColumnIndex column, const std::uint32_t row) const
+{
+    const auto &values = _columns[column];
+
+    if (values.type == ColumnType::Integer)
+        return Var(values.integers[row]);
+    return Var(values.floatings[row]);
+}
+
+void Lang::ColumnStorage::set(const ColumnIndex column, const std::uint32_t row, const Var &value)
+{
+    auto &values = _columns[column];
+
+    if (values.type == ColumnType::Integer)
+        values.integers[row] = value.is<double>() ? static_cast<std::int64_t>(value.as<double>()) : value.as<std::int64_t>();
+    else
+        values.floatings[row] = value.is<double>() ? value.as<double>() : static_cast<double>(value.as<std::int64_t>());
+}
+
+void Lang::ColumnStorage::bind(const AST &member)
+{
+    const auto target = findColumn(Hash(member.literal()));
+
+    if (member.type() != TokenType::Property && member.type() != TokenType::Assignment) [[unlikely]]
+        ThrowError("Member is not a property", member);
+    else if (target == NoColumn) [[unlikely]]
+        ThrowError("Property has no column", member);
+    else if (std::any_of(_bindings.begin(), _bindings.end(), [target](const Binding &binding) { return binding.target == target; })) [[unlikely]]
+        ThrowError("Property is already bound", member);
+
+    Binding binding {
+        target: target
+    };
+    const auto result = compile(binding, *member.children()[0]);
+    const auto type = _columns[target].type;
+
+    // The last operation writes the column directly when it already computes its type
+    if (!result.isColumn && result.type == type && !binding.operations.empty()
+            && binding.operations.back().destination.index == result.index) {
+        binding.operations.back().destination = Operand {
+            index: target,
+            type: type,
+            isColumn: true
+        };
+    } else {
+        binding.operations.push(Operation {
+            code: result.type == type ? ColumnCode::Copy : ColumnCode::Convert,
+            destination: Operand {
+                index: target,
+                type: type,
+                isColumn: true
+            },
+            lhs: result
+        });
+    }
+    if (binding.reads.find(target) != binding.reads.end()) [[unlikely]]
+        ThrowError("Property can't be bound to itself", member);
+    _bindings.push(std::move(binding));
+    _ordered = false;
+}
+
+void Lang::ColumnStorage::update(void)
+{
+    if (!_ordered)
+        sortBindings();
+    for (const auto index : _order)
+        run(_bindings[index]);
+}
+
+Lang::ColumnStorage::Operand Lang::ColumnStorage::compile(Binding &binding, const AST &node)
+{
+    switch (node.type()) {
+    case TokenType::Expression:
+        if (node.children().size() != 1u) [[unlikely]]
+            ThrowError("Blocks can't be evaluated over columns", node);
+        return compile(binding, *node.children()[0]);
+    case TokenType::Constant:
+    {
+        const auto value = Optimizer::ParseConstant(node);
+        Constant constant {
+            temporary: static_cast<std::uint32_t>(binding.temporaries.size())
+        };
+        ColumnType type = ColumnType::Integer;
+        switch (value.kind) {
+        case Optimizer::ValueKind::Integer:
+            constant.integer = value.integer;
+            break;
+        case Optimizer::ValueKind::Boolean:
+            constant.integer = value.boolean;
+            break;
+        case Optimizer::ValueKind::Floating:
+            constant.floating = value.floating;
+            type = ColumnType::Floating;
+            break;
+        default:
+            ThrowError("Only numeric constants can be evaluated over columns", node);
+        }
+        binding.constants.push(constant);
+        binding.temporaries.push(Column {
+            type: type
+        });
+        return Operand {
+            index: constant.temporary,
+            type: type
+        };
+    }
+    case TokenType::Name:
+    {
+        const auto column = findColumn(Hash(node.literal()));
+        if ((node.nameType() != NameType::Property && node.nameType() != NameType::External)
+                || (node.nameType() == NameType::Property && node.nameSlot().depth) || column == NoColumn) [[unlikely]]
+            ThrowError("Only properties stored in columns can be evaluated over columns", node);
+        if (binding.reads.find(column) == binding.reads.end())
+            binding.reads.push(column);
+        return Operand {
+            index: column,
+            type: _columns[column].type,
+            isColumn: true
+        };
+    }
+    case TokenType::Operator:
+        break;
+    default:
+        ThrowError("Node can't be evaluated over columns", node);
+    }
+
+    const auto children = node.children();
+    switch (const auto type = node.operatorType(); type) {
+    case OperatorType::Minus:
+    {
+        const auto operand = compile(binding, *children[0]);
+        return emit(binding, ColumnCode::Minus, operand.type, operand, Operand {});
+    }
+    case OperatorType::Not:
+    {
+        const auto operand = compile(binding, *children[0]);
+        return emit(binding, ColumnCode::Not, ColumnType::Integer, operand, Operand {});
+    }
+    case OperatorType::Addition:
+    case OperatorType::Substraction:
+    case OperatorType::Multiplication:
+    case OperatorType::Division:
+    case OperatorType::Modulo:
+    case OperatorType::Equal:
+    case OperatorType::Different:
+    case OperatorType::Greater:
+    case OperatorType::GreaterEqual:
+    case OperatorType::Lighter:
+    case OperatorType::LighterEqual:
+    case OperatorType::And:
+    case OperatorType::Or:
+    {
+        auto lhs = compile(binding, *children[0]);
+        auto rhs = compile(binding, *children[1]);
+        // Mixed operands are computed as floatings, as by the processers
+        const auto operandType = lhs.type == ColumnType::Floating || rhs.type == ColumnType::Floating ? ColumnType::Floating : ColumnType::Integer;
+        if (type == OperatorType::Modulo && operandType == ColumnType::Floating) [[unlikely]]
+            ThrowError("Modulo of floatings can't be evaluated over columns", node);
+        lhs = convert(binding, lhs, operandType);
+        rhs = convert(binding, rhs, operandType);
+        // Operator types and column codes share their order from the addition
+        static_assert(static_cast<std::uint32_t>(OperatorType::Or) - static_cast<std::uint32_t>(OperatorType::Addition)
+            == static_cast<std::uint32_t>(ColumnCode::Or) - static_cast<std::uint32_t>(ColumnCode::Addition));
+        const auto code = static_cast<ColumnCode>(static_cast<std::uint32_t>(ColumnCode::Addition)
+            + static_cast<std::uint32_t>(type) - static_cast<std::uint32_t>(OperatorType::Addition));
+        const auto isArithmetic = static_cast<std::uint32_t>(code) <= static_cast<std::uint32_t>(ColumnCode::Modulo);
+        return emit(binding, code, isArithmetic ? operandType : ColumnType::Integer, lhs, rhs);
+    }
+    default:
+        ThrowError("Operator can't be evaluated over columns", node);
+    }
+}
+
+Lang::ColumnStorage::Operand Lang::ColumnStorage::emit(Binding &binding, const ColumnCode code, const ColumnType type, const Operand lhs, const Operand rhs)
+{
+    const Operand destination {
+        index: static_cast<std::uint32_t>(binding.temporaries.size()),
+        type: type
+    };
+
+    binding.temporaries.push(Column {
+        type: type
+    });
+    binding.operations.push(Operation {
+        code: code,
+        destination: destination,
+        lhs: lhs,
+        rhs: rhs
+    });
+    return destination;
+}
+
+Lang::ColumnStorage::Operand Lang::ColumnStorage::convert(Binding &binding, const Operand operand, const ColumnType type)
+{
+    if (operand.type == type)
+        return operand;
+    return emit(binding, ColumnCode::Convert, type, operand, Operand {});
+}
+
+void Lang::ColumnStorage::sortBindings(void)
+{
+    Core::TinyVector<std::uint32_t> pending;
+    Core::TinyVector<std::uint32_t> writers;
+
+    // Each binding waits for the bindings writing the columns it reads
+    writers.resize(_columns.size(), ~0u);
+    for (std::uint32_t i = 0u; i < _bindings.size(); ++i)
+        writers[_bindings[i].target] = i;
+    pending.resize(_bindings.size(), 0u);
+    for (std::uint32_t i = 0u; i < _bindings.size(); ++i) {
+        for (const auto column : _bindings[i].reads)
+            pending[i] += writers[column] != ~0u;
+    }
+    _order.clear();
+    for (std::uint32_t i = 0u; i < _bindings.size(); ++i) {
+        if (!pending[i])
+            _order.push(i);
+    }
+    for (std::uint32_t i = 0u; i < _order.size(); ++i) {
+        const auto target = _bindings[_order[i]].target;
+        for (std::uint32_t j = 0u; j < _bindings.size(); ++j) {
+            if (_bindings[j].reads.find(target) != _bindings[j].reads.end() && !--pending[j])
+                _order.push(j);
+        }
+    }
+    if (_order.size() != _bindings.size()) [[unlikely]] {
+        _order.clear();
+        throw std::logic_error("Lang::ColumnStorage::update: Binding loop detected");
+    }
+    _ordered = true;
+}
+
+void Lang::ColumnStorage::run(Binding &binding)
+{
+    // Temporaries are only resized and constants only filled when the row count changed
+    if (binding.rowCount != _rowCount) {
+        binding.rowCount = _rowCount;
+        for (auto &temporary : binding.temporaries) {
+            if (temporary.type == ColumnType::Integer)
+                temporary.integers.resize(_rowCount, 0);
+            else
+                temporary.floatings.resize(_rowCount, 0.0);
+        }
+        for (const auto &constant : binding.constants) {
+            auto &temporary = binding.temporaries[constant.temporary];
+            if (temporary.type == ColumnType::Integer)
+                std::fill(temporary.integers.begin(), temporary.integers.end(), constant.integer);
+            else
+                std::fill(temporary.floatings.begin(), temporary.floatings.end(), constant.floating);
+        }
+    }
+
+    for (const auto &operation : binding.operations) {
+        auto &output = columnOf(binding, operation.destination);
+        auto &input = columnOf(binding, operation.lhs);
+        switch (operation.code) {
+        case ColumnCode::Copy:
+            if (operation.destination.type == ColumnType::Integer)
+                std::copy_n(input.integers.begin(), _rowCount, output.integers.begin());
+            else
+                std::copy_n(input.floatings.begin(), _rowCount, output.floatings.begin());
+            break;
+        case ColumnCode::Convert:
+            if (operation.destination.type == ColumnType::Integer)
+                Map(output.integers.data(), input.floatings.data(), _rowCount, [](const double value) { return value; });
+            else
+                Map(output.floatings.data(), input.integers.data(), _rowCount, [](const std::int64_t value) { return value; });
+            break;
+        case ColumnCode::Minus:
+            if (operation.destination.type == ColumnType::Integer)
+                Map(output.integers.data(), input.integers.data(), _rowCount, std::negate<>());
+            else
+                Map(output.floatings.data(), input.floatings.data(), _rowCount, std::negate<>());
+            break;
+        case ColumnCode::Not:
+            if (operation.lhs.type == ColumnType::Integer)
+                Map(output.integers.data(), input.integers.data(), _rowCount, std::logical_not<>());
+            else
+                Map(output.integers.data(), input.floatings.data(), _rowCount, std::logical_not<>());
+            break;
+        case ColumnCode::Addition:
+            runBinary(binding, operation, std::plus<>());
+            break;
+        case ColumnCode::Substraction:
+            runBinary(binding, operation, std::minus<>());
+            break;
+        case ColumnCode::Multiplication:
+            runBinary(binding, operation, std::multiplies<>());
+            break;
+        case ColumnCode::Division:
+            runBinary(binding, operation, std::divides<>());
+            break;
+        case ColumnCode::Modulo:
+            runBinary(binding, operation, [](const std::int64_t lhs, const std::int64_t rhs) { return lhs % rhs; });
+            break;
+        case ColumnCode::Equal:
+            runBinary(binding, operation, std::equal_to<>());
+            break;
+        case ColumnCode::Different:
+            runBinary(binding, operation, std::not_equal_to<>());
+            break;
+        case ColumnCode::Greater:
+            runBinary(binding, operation, std::greater<>());
+            break;
+        case ColumnCode::GreaterEqual:
+            runBinary(binding, operation, std::greater_equal<>());
+            break;
+        case ColumnCode::Lighter:
+            runBinary(binding, operation, std::less<>());
+            break;
+        case ColumnCode::LighterEqual:
+            runBinary(binding, operation, std::less_equal<>());
+            break;
+        case ColumnCode::And:
+            runBinary(binding, operation, [](const auto lhs, const auto rhs) { return (lhs != 0) & (rhs != 0); });
+            break;
+        case ColumnCode::Or:
+            runBinary(binding, operation, [](const auto lhs, const auto rhs) { return (lhs != 0) | (rhs != 0); });
+            break;
+        }
+    }
+}
+
+void Lang::ColumnStorage::ThrowError(const char * const what, const AST &node)
+{
+    std::string error = std::string("Lang::ColumnStorage::bind: ") + what;
+
+    if (const auto token = node.token(); token)
+        error += "\nAt symbol '" + std::string(token->literal()) + "' l" + std::to_string(token->line) + ":c" + std::to_string(token->column);
+    throw std::logic_error(error);
+}
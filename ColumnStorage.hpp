@@ -0,0 +1,202 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: ColumnStorage
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+#include <Kube/Object/Object.hpp>
+
+#include "AST.hpp"
+
+namespace kF::Lang
+{
+    class ColumnStorage;
+}
+
+/** @brief The ColumnStorage holds the numeric properties of many instances of one class, one contiguous column per property
+ *  Instances are rows, their properties are read and written through a column and a row instead of an object
+ *  Bindings are compiled into column programs: each operation runs as a loop over every row, on unboxed values
+ *  so that the compiler can vectorize it, instead of interpreting the binding once per instance
+ *  Only arithmetic, comparisons and logic over constants and columns of the storage can be bound */
+class alignas_cacheline kF::Lang::ColumnStorage
+{
+public:
+    /** @brief Index of a column */
+    using ColumnIndex = std::uint32_t;
+
+    /** @brief Invalid column index */
+    static constexpr ColumnIndex NoColumn = ~static_cast<ColumnIndex>(0u);
+
+    /** @brief Type of the values of a column */
+    enum class ColumnType : std::uint32_t {
+        Integer,
+        Floating
+    };
+
+    /** @brief Operations of column programs */
+    enum class ColumnCode : std::uint32_t {
+        Copy,
+        Convert,
+        Minus,
+        Not,
+        Addition,
+        Substraction,
+        Multiplication,
+        Division,
+        Modulo,
+        Equal,
+        Different,
+        Greater,
+        GreaterEqual,
+        Lighter,
+        LighterEqual,
+        And,
+        Or
+    };
+
+    /** @brief Values of a column or of a temporary of a column program, only the vector of its type is used */
+    struct alignas_half_cacheline Column
+    {
+        HashedName name { 0u };
+        ColumnType type { ColumnType::Integer };
+        Core::Vector<std::int64_t> integers {};
+        Core::Vector<double> floatings {};
+
+        /** @brief Get the values of the column */
+        template<typename Type>
+        [[nodiscard]] Type *data(void) noexcept;
+    };
+
+
+    /** @brief Default constructor */
+    ColumnStorage(void) noexcept = default;
+
+    /** @brief Storages are not copyable */
+    ColumnStorage(const ColumnStorage &other) = delete;
+    ColumnStorage &operator=(const ColumnStorage &other) = delete;
+
+    /** @brief Destructor */
+    ~ColumnStorage(void) noexcept = default;
+
+
+    /** @brief Get the count of rows */
+    [[nodiscard]] std::uint32_t rowCount(void) const noexcept { return _rowCount; }
+
+    /** @brief Get the count of columns */
+    [[nodiscard]] std::uint32_t columnCount(void) const noexcept { return static_cast<std::uint32_t>(_columns.size()); }
+
+    /** @brief Get the count of bindings */
+    [[nodiscard]] std::uint32_t bindingCount(void) const noexcept { return static_cast<std::uint32_t>(_bindings.size()); }
+
+    /** @brief Find a column by name, returns NoColumn if it doesn't exist */
+    [[nodiscard]] ColumnIndex findColumn(const HashedName name) const noexcept;
+
+    /** @brief Get the values of a column */
+    template<typename Type>
+    [[nodiscard]] Type *data(const ColumnIndex column) noexcept { return _columns[column].data<Type>(); }
+
+
+    /** @brief Add a column, existing rows are zero initialized */
+    ColumnIndex addColumn(const HashedName name, const ColumnType type);
+
+    /** @brief Add zero initialized rows, returns the index of the first one */
+    std::uint32_t addRows(const std::uint32_t count);
+
+    /** @brief Read the value of a row */
+    [[nodiscard]] Var get(const ColumnIndex column, const std::uint32_t row) const;
+
+    /** @brief Write the value of a row, it is converted to the type of the column */
+    void set(const ColumnIndex column, const std::uint32_t row, const Var &value);
+
+
+    /** @brief Bind a property member to its column, its body must only use constants and columns of the storage
+     *  Throws if the body can't be evaluated over columns */
+    void bind(const AST &member);
+
+    /** @brief Evaluate every binding over every row, bindings are evaluated after the ones they read
+     *  Throws if bindings depend on each other */
+    void update(void);
+
+private:
+    /** @brief An operand of a column program operation */
+    struct alignas_eighth_cacheline Operand
+    {
+        std::uint32_t index { 0u };
+        ColumnType type { ColumnType::Integer };
+        bool isColumn { false }; // Columns of the storage, or temporaries of the program
+    };
+
+    /** @brief An operation of a column program, it runs over every row */
+    struct alignas_half_cacheline Operation
+    {
+        ColumnCode code { ColumnCode::Copy };
+        Operand destination {};
+        Operand lhs {};
+        Operand rhs {};
+    };
+
+    /** @brief A constant of a column program, its temporary is only filled when the row count changes */
+    struct alignas_quarter_cacheline Constant
+    {
+        std::uint32_t temporary { 0u };
+        std::int64_t integer { 0 };
+        double floating { 0.0 };
+    };
+
+    /** @brief A column computed by a column program */
+    struct alignas_cacheline Binding
+    {
+        ColumnIndex target { 0u };
+        std::uint32_t rowCount { 0u }; // Count of rows the temporaries are sized for
+        Core::TinyVector<ColumnIndex> reads {};
+        Core::TinyVector<Operation> operations {};
+        Core::TinyVector<Constant> constants {};
+        Core::Vector<Column> temporaries {};
+    };
+
+    // Cacheline 1
+    Core::Vector<Column> _columns {};
+    Core::Vector<Binding> _bindings {};
+    Core::TinyVector<std::uint32_t> _order {}; // Bindings sorted by dependencies
+    std::uint32_t _rowCount { 0u };
+    bool _ordered { true };
+
+    /** @brief Compile a node of a binding body, returns the operand holding its value */
+    [[nodiscard]] Operand compile(Binding &binding, const AST &node);
+
+    /** @brief Emit an operation into a new temporary, returns the temporary, unary operations ignore 'rhs' */
+    Operand emit(Binding &binding, const ColumnCode code, const ColumnType type, const Operand lhs, const Operand rhs);
+
+    /** @brief Convert an operand to a type */
+    [[nodiscard]] Operand convert(Binding &binding, const Operand operand, const ColumnType type);
+
+    /** @brief Sort bindings so that each one is evaluated after the ones it reads */
+    void sortBindings(void);
+
+    /** @brief Run every operation of a binding */
+    void run(Binding &binding);
+
+    /** @brief Get the values of an operand */
+    [[nodiscard]] Column &columnOf(Binding &binding, const Operand operand) noexcept
+        { return operand.isColumn ? _columns[operand.index] : binding.temporaries[operand.index]; }
+
+    /** @brief Run a binary operation over every row */
+    template<typename Operator>
+    void runBinary(Binding &binding, const Operation &operation, Operator &&op);
+
+    /** @brief Apply an operator to every row of one or two inputs */
+    template<typename Output, typename Input, typename Operator>
+    static void Map(Output * __restrict output, const Input * __restrict input, const std::uint32_t count, Operator &&op) noexcept;
+    template<typename Output, typename Input, typename Operator>
+    static void Map(Output * __restrict output, const Input * __restrict lhs, const Input * __restrict rhs,
+            const std::uint32_t count, Operator &&op) noexcept;
+
+    /** @brief Throw an error on a node of a binding */
+    [[noreturn]] static void ThrowError(const char * const what, const AST &node);
+};
+
+static_assert_fit_cacheline(kF::Lang::ColumnStorage);
+
+#include "ColumnStorage.ipp"
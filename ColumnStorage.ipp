@@ -0,0 +1,51 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: ColumnStorage
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+template<typename Type>
+inline Type *kF::Lang::ColumnStorage::Column::data(void) noexcept
+{
+    if constexpr (std::is_same_v<Type, double>)
+        return floatings.data();
+    else
+        return integers.data();
+}
+
+template<typename Operator>
+inline void kF::Lang::ColumnStorage::runBinary(Binding &binding, const Operation &operation, Operator &&op)
+{
+    auto &output = columnOf(binding, operation.destination);
+    auto &lhs = columnOf(binding, operation.lhs);
+    auto &rhs = columnOf(binding, operation.rhs);
+
+    // Operands share their type, comparisons and logic output integers
+    if (operation.lhs.type == ColumnType::Integer) {
+        if ((operation.code == ColumnCode::Division || operation.code == ColumnCode::Modulo)
+                && std::find(rhs.integers.begin(), rhs.integers.end(), 0) != rhs.integers.end()) [[unlikely]]
+            throw std::logic_error("Lang::ColumnStorage::update: Integer division by zero");
+        Map(output.integers.data(), lhs.integers.data(), rhs.integers.data(), _rowCount, op);
+    } else if (operation.destination.type == ColumnType::Integer)
+        Map(output.integers.data(), lhs.floatings.data(), rhs.floatings.data(), _rowCount, op);
+    else
+        Map(output.floatings.data(), lhs.floatings.data(), rhs.floatings.data(), _rowCount, op);
+}
+
+template<typename Output, typename Input, typename Operator>
+inline void kF::Lang::ColumnStorage::Map(Output * __restrict output, const Input * __restrict input, const std::uint32_t count, Operator &&op) noexcept
+{
+    for (std::uint32_t i = 0u; i < count; ++i)
+        output[i] = static_cast<Output>(op(input[i]));
+}
+
+template<typename Output, typename Input, typename Operator>
+inline void kF::Lang::ColumnStorage::Map(Output * __restrict output, const Input * __restrict lhs, const Input * __restrict rhs,
+        const std::uint32_t count, Operator &&op) noexcept
+{
+    for (std::uint32_t i = 0u; i < count; ++i)
+        output[i] = static_cast<Output>(op(lhs[i], rhs[i]));
+}
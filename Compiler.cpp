@@ -0,0 +1,677 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Compiler
+ */
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "Compiler.hpp"
+#include "Optimizer.hpp"
+
+using namespace kF;
+
+Lang::Compiler::Units Lang::Compiler::run(const SyntaxTree &tree, const std::string_view &context)
+{
+    Units units;
+
+    if (tree.empty()) [[unlikely]]
+        return units;
+    tree.root().traverse([this, &units, &context](const AST &node) {
+        switch (node.type()) {
+        case TokenType::Class:
+            return true;
+        case TokenType::Function:
+        case TokenType::Property:
+        case TokenType::Event:
+        case TokenType::Assignment:
+        {
+            auto &unit = units.push(Unit {
+                node: &node,
+                expression: compile(node, context)
+            });
+            if (node.type() == TokenType::Event && !IsSignalEvent(node))
+                unit.condition = compilePredicate(node, context);
+            return false;
+        }
+        default:
+            return false;
+        }
+    });
+    return units;
+}
+
+Lang::Expression::Ptr Lang::Compiler::compile(const AST &member, const std::string_view &context)
+{
+    switch (member.type()) {
+    case TokenType::Function:
+    case TokenType::Event:
+        return compileBody(member, *member.children()[1], false, context);
+    case TokenType::Property:
+    case TokenType::Assignment:
+        return compileBody(member, *member.children()[0], true, context);
+    default:
+        throwError("compile", "Member has no body", member);
+    }
+}
+
+Lang::Expression::Ptr Lang::Compiler::compilePredicate(const AST &event, const std::string_view &context)
+{
+    if (event.type() != TokenType::Event || IsSignalEvent(event)) [[unlikely]]
+        throwError("compilePredicate", "Member has no predicate", event);
+    return compileBody(event, *event.children()[0], true, context);
+}
+
+bool Lang::Compiler::IsSignalEvent(const AST &event) noexcept
+{
+    const auto &condition = *event.children()[0];
+
+    return condition.type() == TokenType::Name && condition.nameType() == NameType::Signal;
+}
+
+Lang::Expression::Ptr Lang::Compiler::compileBody(const AST &member, const AST &body, const bool isValue, const std::string_view &context)
+{
+    _context = context;
+    _bytecode.clear();
+    _jumps.clear();
+    _loops.clear();
+    _stackDepth = 0u;
+    _maxStackDepth = 0u;
+    _frameSize = 0u;
+    _recent.fill(NoByteIndex);
+    _barrier = 0u;
+    _cacheCount = 0u;
+    _externalCacheCount = 0u;
+    _accesses.clear();
+
+    if (isValue)
+        compileValue(body);
+    else
+        compileBlock(body);
+    if (_frameSize > std::numeric_limits<std::uint16_t>::max() || _maxStackDepth > std::numeric_limits<std::uint16_t>::max()) [[unlikely]]
+        throwError("compile", "Member body is too large", member);
+    return Expression::Ptr(Expression::Construct(
+        _bytecode.data(),
+        static_cast<std::uint32_t>(_bytecode.size()),
+        static_cast<std::uint16_t>(_frameSize),
+        static_cast<std::uint16_t>(_maxStackDepth),
+        _cacheCount,
+        _externalCacheCount,
+        &_accesses
+    ));
+}
+
+void Lang::Compiler::compileValue(const AST &body)
+{
+    const AST *value = &body;
+
+    if (body.type() == TokenType::Expression) {
+        if (body.children().size() != 1u) {
+            compileBlock(body);
+            return;
+        }
+        value = body.children()[0];
+    }
+    switch (value->type()) {
+    case TokenType::Expression:
+    case TokenType::Local:
+    case TokenType::Statement:
+        compileBlock(body);
+        break;
+    default:
+        visit(*value);
+        emit(OpCode::Return);
+        break;
+    }
+}
+
+void Lang::Compiler::compileBlock(const AST &body)
+{
+    compileStatement(body);
+    emit(OpCode::PushVoid);
+    emit(OpCode::Return);
+}
+
+void Lang::Compiler::compileStatement(const AST &node)
+{
+    visit(node);
+    switch (node.type()) {
+    case TokenType::Expression:
+    case TokenType::Local:
+    case TokenType::Statement:
+        break;
+    default:
+        emit(OpCode::Pop);
+        break;
+    }
+}
+
+Lang::ByteIndex Lang::Compiler::compileCondition(const AST &condition)
+{
+    visit(condition);
+    return emit(OpCode::JumpIfFalse);
+}
+
+std::uint16_t Lang::Compiler::compileArguments(const AST *arguments)
+{
+    if (!arguments)
+        return 0u;
+    else if (arguments->type() == TokenType::Operator && arguments->operatorType() == OperatorType::Coma) {
+        // Comas are left associative so the last argument is always the right hand side
+        const auto count = compileArguments(arguments->children()[0]);
+        visit(*arguments->children()[1]);
+        return static_cast<std::uint16_t>(count + 1u);
+    }
+    visit(*arguments);
+    return 1u;
+}
+
+void Lang::Compiler::compileStore(const AST &target)
+{
+    const auto slot = target.nameSlot();
+
+    switch (target.nameType()) {
+    case NameType::Parameter:
+        emit(OpCode::StoreParameter, slot.index);
+        break;
+    case NameType::Local:
+        emit(OpCode::StoreLocal, slot.index);
+        break;
+    case NameType::Property:
+        emit(MemberInstruction {
+            code: OpCode::StoreProperty,
+            name: Hash(target.literal()),
+            cache: _cacheCount++,
+            depth: static_cast<std::uint16_t>(slot.depth)
+        });
+        break;
+    case NameType::External:
+        emit(MemberInstruction {
+            code: OpCode::StoreExternal,
+            name: slot.index,
+            cache: _externalCacheCount++
+        });
+        break;
+    default:
+        throwError("compileStore", "Name is not assignable", target);
+    }
+}
+
+Lang::ByteIndex Lang::Compiler::emit(const OpCode code, const std::uint32_t argument)
+{
+    const auto byteIndex = nextByteIndex();
+
+    _bytecode.push(Instruction {
+        code: code,
+        argument: argument
+    });
+    record(byteIndex);
+    switch (code) {
+    case OpCode::PushVoid:
+    case OpCode::PushBoolean:
+    case OpCode::PushLiteral:
+    case OpCode::Duplicate:
+    case OpCode::PushParameter:
+    case OpCode::PushLocal:
+        pushDepth();
+        break;
+    case OpCode::Pop:
+    case OpCode::JumpIfFalse:
+    case OpCode::JumpIfTrueOrPop:
+    case OpCode::JumpIfFalseOrPop:
+    case OpCode::Return:
+        popDepth();
+        break;
+    default:
+        // Binary operators pop two operands and push their result
+        if (code >= OpCode::Addition && code <= OpCode::BitXor)
+            popDepth();
+        break;
+    }
+    return fuse(byteIndex);
+}
+
+Lang::ByteIndex Lang::Compiler::emit(const ImmediateInstruction &instruction)
+{
+    const auto byteIndex = emitUnits(instruction);
+
+    pushDepth();
+    return byteIndex;
+}
+
+Lang::ByteIndex Lang::Compiler::emit(const MemberInstruction &instruction)
+{
+    const auto byteIndex = emitUnits(instruction);
+
+    // Stores and calls may trigger any access
+    if (instruction.code == OpCode::PushProperty || instruction.code == OpCode::PushExternal || instruction.code == OpCode::GetMember)
+        _accesses.read(instruction.name);
+    else
+        _accesses.accessAny();
+    switch (instruction.code) {
+    case OpCode::PushProperty:
+    case OpCode::PushExternal:
+        pushDepth();
+        break;
+    case OpCode::SetMember:
+        popDepth();
+        break;
+    case OpCode::CallMember:
+        // The object is consumed with the arguments
+        popDepth(instruction.argumentCount);
+        break;
+    case OpCode::CallFunction:
+    case OpCode::CallExternal:
+    case OpCode::Emit:
+        popDepth(instruction.argumentCount);
+        pushDepth();
+        break;
+    default:
+        break;
+    }
+    return byteIndex;
+}
+
+void Lang::Compiler::emitLiteral(const std::string_view &literal)
+{
+    emit(OpCode::PushLiteral, static_cast<std::uint32_t>(literal.size()));
+    const auto unitIndex = _bytecode.size();
+    _bytecode.resize(unitIndex + LiteralUnitCount(static_cast<std::uint32_t>(literal.size())));
+    std::memcpy(static_cast<void *>(&_bytecode[unitIndex]), literal.data(), literal.size());
+}
+
+Lang::ByteIndex Lang::Compiler::emitTable(const SwitchTable &table)
+{
+    const auto code = table.kind() == SwitchTable::Kind::Dense ? OpCode::JumpTable
+        : table.kind() == SwitchTable::Kind::Sorted ? OpCode::JumpSorted : OpCode::JumpHashed;
+    const TableInstruction instruction {
+        code: code,
+        count: static_cast<std::uint32_t>(table.entries().size()),
+        seed: table.seed(),
+        base: table.base()
+    };
+    const auto byteIndex = emitUnits(instruction);
+
+    // Targets and keys are appended as raw units
+    _bytecode.resize(_bytecode.size() + (TableSize(instruction, code != OpCode::JumpTable) - sizeof(TableInstruction)) / sizeof(Instruction));
+    return byteIndex;
+}
+
+void Lang::Compiler::patchTable(const ByteIndex instruction, const SwitchTable &table, const Core::TinyVector<ByteIndex> &values,
+        const Core::TinyVector<ByteIndex> &bodies, const ByteIndex defaultTarget) noexcept
+{
+    auto &header = reinterpret_cast<TableInstruction &>(_bytecode[instruction / sizeof(Instruction)]);
+    const auto targets = const_cast<ByteIndex *>(TableTargets(header));
+    const auto keys = const_cast<std::int64_t *>(TableKeys(header));
+    const auto &entries = table.entries();
+
+    header.defaultTarget = defaultTarget;
+    for (auto index = 0u; index < entries.size(); ++index) {
+        const auto caseIndex = entries[index].caseIndex;
+        targets[index] = caseIndex == SwitchTable::NoCase ? defaultTarget : bodies[caseIndex];
+        if (header.code == OpCode::JumpSorted)
+            keys[index] = entries[index].key;
+        else if (header.code == OpCode::JumpHashed)
+            keys[index] = caseIndex == SwitchTable::NoCase ? -1 : static_cast<std::int64_t>(values[caseIndex]);
+    }
+}
+
+void Lang::Compiler::patchJump(const ByteIndex jump) noexcept
+{
+    _bytecode[jump / sizeof(Instruction)].argument = jumpTarget();
+}
+
+Lang::ByteIndex Lang::Compiler::fuse(const ByteIndex instruction) noexcept
+{
+    const auto unitAt = [this](const ByteIndex byteIndex) -> Instruction & { return _bytecode[byteIndex / sizeof(Instruction)]; };
+    const auto drop = [this](const ByteIndex from) { _bytecode.resize(from / sizeof(Instruction)); };
+    const auto previous = _recent[1];
+    const auto before = _recent[2];
+    const auto code = unitAt(instruction).code;
+
+    // Only the first instruction of a fused sequence may be a jump target
+    if (previous == NoByteIndex || previous < _barrier)
+        return instruction;
+    switch (code) {
+    case OpCode::Addition:
+    case OpCode::Substraction:
+    case OpCode::Multiplication:
+        if (unitAt(previous).code != OpCode::PushInteger)
+            break;
+        unitAt(previous).code = code == OpCode::Addition ? OpCode::AdditionInteger
+            : code == OpCode::Substraction ? OpCode::SubstractionInteger : OpCode::MultiplicationInteger;
+        drop(instruction);
+        _recent = { previous, before, NoByteIndex };
+        return previous;
+    case OpCode::JumpIfFalse:
+    {
+        const auto comparison = unitAt(previous).code;
+        if (comparison < OpCode::Equal || comparison > OpCode::LighterEqual)
+            break;
+        unitAt(previous) = Instruction {
+            code: static_cast<OpCode>(static_cast<std::uint32_t>(OpCode::JumpUnlessEqual)
+                + static_cast<std::uint32_t>(comparison) - static_cast<std::uint32_t>(OpCode::Equal)),
+            argument: unitAt(instruction).argument
+        };
+        drop(instruction);
+        _recent = { previous, before, NoByteIndex };
+        return previous;
+    }
+    case OpCode::StoreLocal:
+    {
+        if (before == NoByteIndex || before < _barrier || unitAt(before).code != OpCode::PushLocal
+                || unitAt(before).argument != unitAt(instruction).argument)
+            break;
+        // Adding or substracting an integer constant of one is the same as incrementing
+        const auto operation = unitAt(previous).code;
+        std::int64_t immediate = 0;
+        if (operation == OpCode::AdditionInteger || operation == OpCode::SubstractionInteger)
+            std::memcpy(&immediate, &unitAt(previous + sizeof(Instruction)), sizeof(immediate));
+        const bool isIncrement = operation == OpCode::Increment || (operation == OpCode::AdditionInteger && immediate == 1);
+        const bool isDecrement = operation == OpCode::Decrement || (operation == OpCode::SubstractionInteger && immediate == 1);
+        if (!isIncrement && !isDecrement)
+            break;
+        unitAt(before).code = isIncrement ? OpCode::IncrementLocal : OpCode::DecrementLocal;
+        drop(previous);
+        _recent = { before, NoByteIndex, NoByteIndex };
+        return before;
+    }
+    default:
+        break;
+    }
+    return instruction;
+}
+
+void Lang::Compiler::pushDepth(const std::uint32_t count) noexcept
+{
+    _stackDepth += count;
+    _maxStackDepth = std::max(_maxStackDepth, _stackDepth);
+}
+
+void Lang::Compiler::openLoop(const bool isSwitch, const ByteIndex continueTarget)
+{
+    _loops.push(Loop {
+        continueTarget: continueTarget,
+        isSwitch: isSwitch
+    });
+}
+
+void Lang::Compiler::closeLoop(void) noexcept
+{
+    const auto loop = static_cast<std::uint16_t>(_loops.size() - 1u);
+    const auto end = jumpTarget();
+    const auto continueTarget = _loops.back().continueTarget;
+    auto out = _jumps.begin();
+
+    // Jumps of outer loops are kept in order
+    for (const auto &jump : _jumps) {
+        if (jump.loop == loop)
+            _bytecode[jump.instruction / sizeof(Instruction)].argument = jump.isBreak ? end : continueTarget;
+        else
+            *out++ = jump;
+    }
+    _jumps.erase(out, _jumps.end());
+    _loops.pop();
+}
+
+void Lang::Compiler::throwError(const char * const where, const char * const what, const AST &node) const
+{
+    std::string error = std::string("Lang::Compiler::") + where + ": " + what + '\n';
+
+    if (const auto token = node.token(); token) {
+        error += "At symbol '" + std::string(token->literal()) + "' from " + std::string(_context)
+            + ":l" + std::to_string(token->line) + ":c" + std::to_string(token->column);
+    } else
+        error += "From " + std::string(_context);
+    throw std::logic_error(error);
+}
+
+void Lang::Compiler::handle(TokenTag<TokenType::Expression>, const AST &node)
+{
+    for (const auto *child : node.children())
+        compileStatement(*child);
+}
+
+void Lang::Compiler::handle(TokenTag<TokenType::Local>, const AST &node)
+{
+    const auto children = node.children();
+    const auto slot = children[1]->nameSlot();
+
+    visit(*children[2]);
+    emit(OpCode::StoreLocal, slot.index);
+    emit(OpCode::Pop);
+    _frameSize = std::max(_frameSize, slot.index + 1u);
+}
+
+void Lang::Compiler::handle(TokenTag<TokenType::Name>, const AST &node)
+{
+    const auto slot = node.nameSlot();
+
+    switch (node.nameType()) {
+    case NameType::Parameter:
+        emit(OpCode::PushParameter, slot.index);
+        break;
+    case NameType::Local:
+        emit(OpCode::PushLocal, slot.index);
+        break;
+    case NameType::Property:
+        emit(MemberInstruction {
+            code: OpCode::PushProperty,
+            name: Hash(node.literal()),
+            cache: _cacheCount++,
+            depth: static_cast<std::uint16_t>(slot.depth)
+        });
+        break;
+    case NameType::External:
+        emit(MemberInstruction {
+            code: OpCode::PushExternal,
+            name: slot.index,
+            cache: _externalCacheCount++
+        });
+        break;
+    default:
+        throwError("handle", "Name can't be used as a value", node);
+    }
+}
+
+void Lang::Compiler::handle(TokenTag<TokenType::Constant>, const AST &node)
+{
+    if (node.constantType() == ConstantType::Char) {
+        const auto literal = node.literal();
+        if (literal.size() < 3u) [[unlikely]]
+            throwError("handle", "Invalid character constant", node);
+        auto character = literal[1];
+        if (character == '\\') {
+            switch (literal[2]) {
+            case 'n':
+                character = '\n';
+                break;
+            case 't':
+                character = '\t';
+                break;
+            case '0':
+                character = '\0';
+                break;
+            default:
+                character = literal[2];
+                break;
+            }
+        }
+        emit(ImmediateInstruction {
+            code: OpCode::PushInteger,
+            integer: character
+        });
+        return;
+    }
+    const auto value = Optimizer::ParseConstant(node);
+    switch (value.kind) {
+    case Optimizer::ValueKind::Integer:
+        emit(ImmediateInstruction {
+            code: OpCode::PushInteger,
+            integer: value.integer
+        });
+        break;
+    case Optimizer::ValueKind::Floating:
+        emit(ImmediateInstruction {
+            code: OpCode::PushFloating,
+            floating: value.floating
+        });
+        break;
+    case Optimizer::ValueKind::Boolean:
+        emit(OpCode::PushBoolean, value.boolean);
+        break;
+    case Optimizer::ValueKind::Literal:
+        emitLiteral(value.literal);
+        break;
+    default:
+        throwError("handle", "Invalid constant", node);
+    }
+}
+
+void Lang::Compiler::handle(StatementTag<StatementType::If>, const AST &node)
+{
+    const auto children = node.children();
+    Core::TinyVector<ByteIndex> ends;
+
+    // Children are stored as (condition, body) pairs followed by an optional else body
+    for (auto i = 0u; i < children.size();) {
+        if (i + 1 < children.size()) {
+            const auto jump = compileCondition(*children[i]);
+            compileStatement(*children[i + 1]);
+            if (i + 2 < children.size())
+                ends.push(emit(OpCode::Jump));
+            patchJump(jump);
+            i += 2;
+        } else {
+            compileStatement(*children[i]);
+            ++i;
+        }
+    }
+    for (const auto end : ends)
+        patchJump(end);
+}
+
+void Lang::Compiler::handle(StatementTag<StatementType::While>, const AST &node)
+{
+    const auto children = node.children();
+    const auto begin = jumpTarget();
+
+    openLoop(false, begin);
+    const auto jump = compileCondition(*children[0]);
+    compileStatement(*children[1]);
+    emit(OpCode::Jump, begin);
+    patchJump(jump);
+    closeLoop();
+}
+
+void Lang::Compiler::handle(StatementTag<StatementType::For>, const AST &node)
+{
+    const auto children = node.children();
+
+    compileStatement(*children[0]);
+    const auto begin = jumpTarget();
+    openLoop(false);
+    const auto jump = compileCondition(*children[1]);
+    compileStatement(*children[3]);
+    _loops.back().continueTarget = jumpTarget();
+    compileStatement(*children[2]);
+    emit(OpCode::Jump, begin);
+    patchJump(jump);
+    closeLoop();
+}
+
+void Lang::Compiler::handle(StatementTag<StatementType::Switch>, const AST &node)
+{
+    const auto children = node.children();
+    const SwitchTable table(node);
+    Core::TinyVector<ByteIndex> ends;
+    Core::TinyVector<ByteIndex> values;
+    Core::TinyVector<ByteIndex> bodies;
+    auto defaultTarget = NoByteIndex;
+
+    // The tested value stays on the stack until a case matches
+    // A table pops it and jumps past the compare of its case, values of another type are compared one case at a time
+    visit(*children[0]);
+    const auto dispatch = table.kind() != SwitchTable::Kind::None ? emitTable(table) : NoByteIndex;
+    openLoop(true);
+    for (auto i = 1u; i < children.size();) {
+        if (i + 1 < children.size()) {
+            emit(OpCode::Duplicate);
+            values.push(nextByteIndex());
+            visit(*children[i]);
+            emit(OpCode::Equal);
+            const auto jump = emit(OpCode::JumpIfFalse);
+            emit(OpCode::Pop);
+            bodies.push(jumpTarget());
+            compileStatement(*children[i + 1]);
+            ends.push(emit(OpCode::Jump));
+            patchJump(jump);
+            pushDepth();
+            i += 2;
+        } else {
+            emit(OpCode::Pop);
+            defaultTarget = jumpTarget();
+            compileStatement(*children[i]);
+            ++i;
+        }
+    }
+    if (defaultTarget == NoByteIndex) {
+        emit(OpCode::Pop);
+        defaultTarget = jumpTarget();
+    }
+    for (const auto end : ends)
+        patchJump(end);
+    if (dispatch != NoByteIndex)
+        patchTable(dispatch, table, values, bodies, defaultTarget);
+    closeLoop();
+}
+
+void Lang::Compiler::handle(StatementTag<StatementType::Break>, const AST &node)
+{
+    if (_loops.empty()) [[unlikely]]
+        throwError("handle", "Break statement outside of a loop or a switch", node);
+    _jumps.push(PendingJump {
+        instruction: emit(OpCode::Jump),
+        loop: static_cast<std::uint16_t>(_loops.size() - 1u),
+        isBreak: true
+    });
+}
+
+void Lang::Compiler::handle(StatementTag<StatementType::Continue>, const AST &node)
+{
+    auto loop = _loops.size();
+
+    while (loop && _loops[loop - 1u].isSwitch)
+        --loop;
+    if (!loop) [[unlikely]]
+        throwError("handle", "Continue statement outside of a loop", node);
+    _jumps.push(PendingJump {
+        instruction: emit(OpCode::Jump),
+        loop: static_cast<std::uint16_t>(loop - 1u),
+        isBreak: false
+    });
+}
+
+void Lang::Compiler::handle(StatementTag<StatementType::Return>, const AST &node)
+{
+    visit(*node.children()[0]);
+    emit(OpCode::Return);
+}
+
+void Lang::Compiler::handle(StatementTag<StatementType::Emit>, const AST &node)
+{
+    const auto &call = *node.children()[0];
+
+    if (call.type() != TokenType::Operator || call.operatorType() != OperatorType::Call
+            || call.children()[0]->type() != TokenType::Name || call.children()[0]->nameType() != NameType::Signal) [[unlikely]]
+        throwError("handle", "Only signals can be emitted", node);
+    visit(call);
+    emit(OpCode::Pop);
+}
+
+void Lang::Compiler::handleDefault(const AST &node)
+{
+    throwError("handleDefault", "Node can't be compiled", node);
+}
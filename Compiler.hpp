@@ -0,0 +1,188 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Compiler
+ */
+
+#pragma once
+
+#include <array>
+
+#include <Kube/Core/Vector.hpp>
+
+#include "SyntaxTree.hpp"
+#include "Visitor.hpp"
+#include "Expression.hpp"
+#include "SwitchTable.hpp"
+
+namespace kF::Lang
+{
+    class Compiler;
+}
+
+/** @brief The Compiler lowers the bodies of a resolved syntax tree into stack machine expressions
+ *  Functions, properties, events and assignments are each compiled into their own expression
+ *  Every expression node pushes a single value on the operand stack while statements leave it unchanged
+ *  Frequent instruction sequences are fused into superinstructions as they are emitted, never across a jump target */
+class alignas_cacheline kF::Lang::Compiler : public Visitor<Compiler>
+{
+public:
+    /** @brief A compiled member of a class */
+    struct alignas_half_cacheline Unit
+    {
+        const AST *node { nullptr };
+        Expression::Ptr expression {};
+        Expression::Ptr condition {}; // Predicate of an event that is not connected to a signal
+    };
+
+    /** @brief A list of compiled members */
+    using Units = Core::TinyVector<Unit>;
+
+    /** @brief Instruction stream under construction */
+    using Bytecode = Core::Vector<Instruction>;
+
+
+    /** @brief Compile every member with a body of a syntax tree, the tree must be resolved */
+    [[nodiscard]] Units run(const SyntaxTree &tree, const std::string_view &context);
+
+    /** @brief Compile the body of a single member */
+    [[nodiscard]] Expression::Ptr compile(const AST &member, const std::string_view &context);
+
+    /** @brief Compile the condition of an event that is not connected to a signal into a predicate */
+    [[nodiscard]] Expression::Ptr compilePredicate(const AST &event, const std::string_view &context);
+
+    /** @brief Check if an event is connected to a signal, its condition is then a signal name */
+    [[nodiscard]] static bool IsSignalEvent(const AST &event) noexcept;
+
+private:
+    /** @brief A break or continue waiting for its loop to be closed */
+    struct alignas_eighth_cacheline PendingJump
+    {
+        ByteIndex instruction { 0u };
+        std::uint16_t loop { 0u };
+        bool isBreak { false };
+    };
+
+    /** @brief A loop (or switch) being compiled */
+    struct alignas_eighth_cacheline Loop
+    {
+        ByteIndex continueTarget { 0u };
+        bool isSwitch { false };
+    };
+
+    // Cacheline 1
+    std::string_view _context {};
+    Bytecode _bytecode {};
+    Core::TinyVector<PendingJump> _jumps {};
+    Core::TinyVector<Loop> _loops {};
+    std::uint32_t _stackDepth { 0u };
+    std::uint32_t _maxStackDepth { 0u };
+    std::uint32_t _frameSize { 0u };
+    // Cacheline 2
+    std::array<ByteIndex, 3> _recent {}; // Byte index of the last emitted instructions, most recent first
+    ByteIndex _barrier { 0u }; // Last jump target, instructions before it can't be fused
+    CacheIndex _cacheCount { 0u };
+    CacheIndex _externalCacheCount { 0u };
+    NameAccesses _accesses {};
+
+    friend Visitor<Compiler>;
+
+    /** @brief Compile a body of a member into an expression */
+    [[nodiscard]] Expression::Ptr compileBody(const AST &member, const AST &body, const bool isValue, const std::string_view &context);
+
+    /** @brief Compile a body whose value is returned when it holds a single expression */
+    void compileValue(const AST &body);
+
+    /** @brief Compile a body that returns nothing unless it uses a return statement */
+    void compileBlock(const AST &body);
+
+    /** @brief Compile a statement or an expression whose value is discarded */
+    void compileStatement(const AST &node);
+
+    /** @brief Compile a condition followed by a jump taken when it is false, returns the byte index of the jump */
+    [[nodiscard]] ByteIndex compileCondition(const AST &condition);
+
+    /** @brief Compile the arguments of a call, returns their count */
+    [[nodiscard]] std::uint16_t compileArguments(const AST *arguments);
+
+    /** @brief Compile a store of the value on top of the stack into an assignable name */
+    void compileStore(const AST &target);
+
+    /** @brief Compile an assignment whose value is computed by 'value' which may push the previous value first */
+    template<typename Value>
+    void compileAssignment(const AST &target, const bool loadTarget, Value &&value);
+
+
+    /** @brief Emit an instruction and update the stack depth */
+    ByteIndex emit(const OpCode code, const std::uint32_t argument = 0u);
+    ByteIndex emit(const ImmediateInstruction &instruction);
+    ByteIndex emit(const MemberInstruction &instruction);
+    void emitLiteral(const std::string_view &literal);
+
+    /** @brief Emit the table instruction of a switch, its targets are patched once its cases are compiled */
+    ByteIndex emitTable(const SwitchTable &table);
+
+    /** @brief Patch the targets of a table instruction out of the byte index of the value and of the body of each case */
+    void patchTable(const ByteIndex instruction, const SwitchTable &table, const Core::TinyVector<ByteIndex> &values,
+            const Core::TinyVector<ByteIndex> &bodies, const ByteIndex defaultTarget) noexcept;
+
+    /** @brief Append the units of a wide instruction */
+    template<typename Type>
+    ByteIndex emitUnits(const Type &instruction);
+
+    /** @brief Get the byte index of the next instruction */
+    [[nodiscard]] ByteIndex nextByteIndex(void) const noexcept
+        { return static_cast<ByteIndex>(_bytecode.size() * sizeof(Instruction)); }
+
+    /** @brief Get the byte index of the next instruction and forbid fusing instructions across it */
+    [[nodiscard]] ByteIndex jumpTarget(void) noexcept { return _barrier = nextByteIndex(); }
+
+    /** @brief Make a jump target the next instruction */
+    void patchJump(const ByteIndex jump) noexcept;
+
+    /** @brief Record an emitted instruction */
+    void record(const ByteIndex instruction) noexcept { _recent = { instruction, _recent[0], _recent[1] }; }
+
+    /** @brief Try to fuse the last emitted instruction with the previous ones, returns the byte index of the resulting instruction */
+    ByteIndex fuse(const ByteIndex instruction) noexcept;
+
+    /** @brief Update the stack depth */
+    void pushDepth(const std::uint32_t count = 1u) noexcept;
+    void popDepth(const std::uint32_t count = 1u) noexcept { _stackDepth -= count; }
+
+    /** @brief Open a loop, 'continueTarget' may be set later */
+    void openLoop(const bool isSwitch, const ByteIndex continueTarget = 0u);
+
+    /** @brief Close the last loop and patch its pending jumps */
+    void closeLoop(void) noexcept;
+
+    /** @brief Throw a compilation error on a node */
+    [[noreturn]] void throwError(const char * const where, const char * const what, const AST &node) const;
+
+
+    /** @brief Blocks, locals and leaves */
+    void handle(TokenTag<TokenType::Expression>, const AST &node);
+    void handle(TokenTag<TokenType::Local>, const AST &node);
+    void handle(TokenTag<TokenType::Name>, const AST &node);
+    void handle(TokenTag<TokenType::Constant>, const AST &node);
+
+    /** @brief Operators */
+    template<OperatorType Type>
+    void handle(OperatorTag<Type>, const AST &node);
+
+    /** @brief Statements */
+    void handle(StatementTag<StatementType::If>, const AST &node);
+    void handle(StatementTag<StatementType::While>, const AST &node);
+    void handle(StatementTag<StatementType::For>, const AST &node);
+    void handle(StatementTag<StatementType::Switch>, const AST &node);
+    void handle(StatementTag<StatementType::Break>, const AST &node);
+    void handle(StatementTag<StatementType::Continue>, const AST &node);
+    void handle(StatementTag<StatementType::Return>, const AST &node);
+    void handle(StatementTag<StatementType::Emit>, const AST &node);
+
+    /** @brief Any other node can't be compiled */
+    void handleDefault(const AST &node);
+};
+
+static_assert_fit_double_cacheline(kF::Lang::Compiler);
+
+#include "Compiler.ipp"
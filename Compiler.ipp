@@ -0,0 +1,186 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Compiler
+ */
+
+#include <cstring>
+
+namespace kF::Lang
+{
+    /** @brief Get the operation code of an arithmetic, comparison or bitwise operator (compound assignments included) */
+    [[nodiscard]] constexpr OpCode GetOperatorOpCode(const OperatorType type) noexcept
+    {
+        switch (type) {
+        case OperatorType::Not:                     return OpCode::Not;
+        case OperatorType::Minus:                   return OpCode::Minus;
+        case OperatorType::BitReverse:              return OpCode::BitReverse;
+        case OperatorType::Addition:
+        case OperatorType::AdditionAssign:          return OpCode::Addition;
+        case OperatorType::Substraction:
+        case OperatorType::SubstractionAssign:      return OpCode::Substraction;
+        case OperatorType::Multiplication:
+        case OperatorType::MultiplicationAssign:    return OpCode::Multiplication;
+        case OperatorType::Division:
+        case OperatorType::DivisionAssign:          return OpCode::Division;
+        case OperatorType::Modulo:
+        case OperatorType::ModuloAssign:            return OpCode::Modulo;
+        case OperatorType::Equal:                   return OpCode::Equal;
+        case OperatorType::Different:               return OpCode::Different;
+        case OperatorType::Greater:                 return OpCode::Greater;
+        case OperatorType::GreaterEqual:            return OpCode::GreaterEqual;
+        case OperatorType::Lighter:                 return OpCode::Lighter;
+        case OperatorType::LighterEqual:            return OpCode::LighterEqual;
+        case OperatorType::BitAnd:
+        case OperatorType::BitAndAssign:            return OpCode::BitAnd;
+        case OperatorType::BitOr:
+        case OperatorType::BitOrAssign:             return OpCode::BitOr;
+        case OperatorType::BitXor:
+        case OperatorType::BitXorAssign:            return OpCode::BitXor;
+        default:                                    return OpCode::None;
+        }
+    }
+}
+
+template<typename Type>
+inline kF::Lang::ByteIndex kF::Lang::Compiler::emitUnits(const Type &instruction)
+{
+    static_assert(sizeof(Type) % sizeof(Instruction) == 0u, "Lang::Compiler::emitUnits: Instruction must be made of whole units");
+
+    const auto byteIndex = nextByteIndex();
+    const auto unitIndex = _bytecode.size();
+
+    _bytecode.resize(unitIndex + sizeof(Type) / sizeof(Instruction));
+    std::memcpy(static_cast<void *>(&_bytecode[unitIndex]), &instruction, sizeof(Type));
+    record(byteIndex);
+    return byteIndex;
+}
+
+template<typename Value>
+inline void kF::Lang::Compiler::compileAssignment(const AST &target, const bool loadTarget, Value &&value)
+{
+    if (target.type() == TokenType::Name) {
+        if (loadTarget)
+            visit(target);
+        value();
+        compileStore(target);
+    } else if (target.type() == TokenType::Operator && target.operatorType() == OperatorType::Dot) {
+        const auto &member = *target.children()[1];
+        if (member.type() != TokenType::Name) [[unlikely]]
+            throwError("compileAssignment", "Invalid member access", target);
+        visit(*target.children()[0]);
+        if (loadTarget) {
+            emit(OpCode::Duplicate);
+            emit(MemberInstruction {
+                code: OpCode::GetMember,
+                name: member.nameSlot().index,
+                cache: _cacheCount++
+            });
+        }
+        value();
+        emit(MemberInstruction {
+            code: OpCode::SetMember,
+            name: member.nameSlot().index,
+            cache: _cacheCount++
+        });
+    } else
+        throwError("compileAssignment", "Expression is not assignable", target);
+}
+
+template<kF::Lang::OperatorType Type>
+inline void kF::Lang::Compiler::handle(OperatorTag<Type>, const AST &node)
+{
+    const auto children = node.children();
+
+    if constexpr (Type == OperatorType::Not || Type == OperatorType::Minus || Type == OperatorType::BitReverse) {
+        visit(*children[0]);
+        emit(GetOperatorOpCode(Type));
+    } else if constexpr (Type == OperatorType::Increment || Type == OperatorType::Decrement) {
+        compileAssignment(*children[0], true, [this] {
+            emit(Type == OperatorType::Increment ? OpCode::Increment : OpCode::Decrement);
+        });
+    } else if constexpr (Type == OperatorType::IncrementSuffix || Type == OperatorType::DecrementSuffix) {
+        // The previous value is recomputed from the stored one
+        compileAssignment(*children[0], true, [this] {
+            emit(Type == OperatorType::IncrementSuffix ? OpCode::Increment : OpCode::Decrement);
+        });
+        emit(Type == OperatorType::IncrementSuffix ? OpCode::Decrement : OpCode::Increment);
+    } else if constexpr (Type == OperatorType::And || Type == OperatorType::Or) {
+        visit(*children[0]);
+        const auto jump = emit(Type == OperatorType::And ? OpCode::JumpIfFalseOrPop : OpCode::JumpIfTrueOrPop);
+        visit(*children[1]);
+        patchJump(jump);
+        emit(OpCode::ToBoolean);
+    } else if constexpr (Type == OperatorType::Assign) {
+        compileAssignment(*children[0], false, [this, &children] { visit(*children[1]); });
+    } else if constexpr (Type >= OperatorType::AdditionAssign && Type <= OperatorType::BitXorAssign) {
+        compileAssignment(*children[0], true, [this, &children] {
+            visit(*children[1]);
+            emit(GetOperatorOpCode(Type));
+        });
+    } else if constexpr (GetOperatorOpCode(Type) != OpCode::None) {
+        visit(*children[0]);
+        visit(*children[1]);
+        emit(GetOperatorOpCode(Type));
+    } else if constexpr (Type == OperatorType::Coma) {
+        visit(*children[0]);
+        emit(OpCode::Pop);
+        visit(*children[1]);
+    } else if constexpr (Type == OperatorType::Dot) {
+        // Method calls are parsed as a dot whose right hand side is a call
+        const auto &member = *children[1];
+        visit(*children[0]);
+        if (member.type() == TokenType::Name) {
+            emit(MemberInstruction {
+                code: OpCode::GetMember,
+                name: member.nameSlot().index,
+                cache: _cacheCount++
+            });
+        } else if (member.type() == TokenType::Operator && member.operatorType() == OperatorType::Call
+                && member.children()[0]->type() == TokenType::Name) {
+            const auto arguments = member.children();
+            emit(MemberInstruction {
+                code: OpCode::CallMember,
+                name: arguments[0]->nameSlot().index,
+                argumentCount: compileArguments(arguments.size() > 1u ? arguments[1] : nullptr)
+            });
+        } else [[unlikely]]
+            throwError("handle", "Invalid member access", node);
+    } else if constexpr (Type == OperatorType::Call) {
+        const auto &callee = *children[0];
+        const auto *arguments = children.size() > 1u ? children[1] : nullptr;
+        if (callee.type() != TokenType::Name) [[unlikely]]
+            throwError("handle", "Expression is not callable", node);
+        const auto slot = callee.nameSlot();
+        switch (callee.nameType()) {
+        case NameType::Function:
+        case NameType::Signal:
+            emit(MemberInstruction {
+                code: callee.nameType() == NameType::Function ? OpCode::CallFunction : OpCode::Emit,
+                name: Hash(callee.literal()),
+                depth: static_cast<std::uint16_t>(slot.depth),
+                argumentCount: compileArguments(arguments)
+            });
+            break;
+        case NameType::External:
+            emit(MemberInstruction {
+                code: OpCode::CallExternal,
+                name: slot.index,
+                cache: _externalCacheCount++,
+                argumentCount: compileArguments(arguments)
+            });
+            break;
+        default:
+            throwError("handle", "Variable is not callable", callee);
+        }
+    } else if constexpr (Type == OperatorType::TernaryIf) {
+        const auto jump = compileCondition(*children[0]);
+        visit(*children[1]);
+        const auto end = emit(OpCode::Jump);
+        // Only one branch is evaluated
+        popDepth();
+        patchJump(jump);
+        visit(*children[2]);
+        patchJump(end);
+    } else
+        handleDefault(node);
+}
@@ -49,7 +49,8 @@ Lang::DirectoryIndex Lang::DirectoryManager::discoverDirectory(const std::string
         _fileNames.push(filename.c_str());
         _fileDirectories.push(dirIndex);
         _fileStacks.push();
-        _fileNodes.push();
+        _fileTrees.push();
+        _fileUnits.push();
     }
     return dirIndex;
 }
@@ -10,7 +10,8 @@
 #include <Kube/Core/String.hpp>
 
 #include "TokenStack.hpp"
-#include "AST.hpp"
+#include "SyntaxTree.hpp"
+#include "Compiler.hpp"
 
 namespace kF::Lang
 {
@@ -40,9 +41,13 @@ public:
     [[nodiscard]] TokenStack &fileStack(const FileIndex fileIndex) noexcept { return _fileStacks[fileIndex]; }
     [[nodiscard]] const TokenStack &fileStack(const FileIndex fileIndex) const noexcept { return _fileStacks[fileIndex]; }
 
-    /** @brief Get a file's node */
-    [[nodiscard]] AST::Ptr &fileNode(const FileIndex fileIndex) noexcept { return _fileNodes[fileIndex]; }
-    [[nodiscard]] const AST::Ptr &fileNode(const FileIndex fileIndex) const noexcept { return _fileNodes[fileIndex]; }
+    /** @brief Get a file's syntax tree */
+    [[nodiscard]] SyntaxTree::Ptr &fileTree(const FileIndex fileIndex) noexcept { return _fileTrees[fileIndex]; }
+    [[nodiscard]] const SyntaxTree::Ptr &fileTree(const FileIndex fileIndex) const noexcept { return _fileTrees[fileIndex]; }
+
+    /** @brief Get a file's compiled members */
+    [[nodiscard]] Compiler::Units &fileUnits(const FileIndex fileIndex) noexcept { return _fileUnits[fileIndex]; }
+    [[nodiscard]] const Compiler::Units &fileUnits(const FileIndex fileIndex) const noexcept { return _fileUnits[fileIndex]; }
 
     /** @brief Get the list of files in a directory */
     [[nodiscard]] const auto &directoryPath(const DirectoryIndex dirIndex) const noexcept { return _directoryPaths[dirIndex]; }
@@ -56,7 +61,8 @@ private:
     Core::TinyVector<Core::TinyString> _fileNames;
     Core::TinyVector<DirectoryIndex> _fileDirectories;
     Core::TinyVector<TokenStack> _fileStacks;
-    Core::TinyVector<AST::Ptr> _fileNodes;
+    Core::TinyVector<SyntaxTree::Ptr> _fileTrees;
+    Core::TinyVector<Compiler::Units> _fileUnits;
 
     // Directories
     Core::TinyVector<Core::TinyString> _directoryPaths;
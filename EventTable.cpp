@@ -0,0 +1,112 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: EventTable
+ */
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "EventTable.hpp"
+
+using namespace kF;
+
+Lang::EventTable::EventTable(const AST &classNode, const Compiler::Units &units)
+{
+    Core::TinyVector<std::pair<SignalIndex, const Expression *>> connections;
+    auto unit = units.begin();
+
+    if (classNode.type() != TokenType::Class) [[unlikely]]
+        throw std::logic_error("Lang::EventTable::EventTable: Node is not a class");
+    for (const auto *child : classNode.children()) {
+        if (child->type() == TokenType::Signal) {
+            _signals.push(Hash(child->literal()));
+            continue;
+        } else if (child->type() != TokenType::Event)
+            continue;
+        // Units are compiled in pre-order, as the children of the class
+        while (unit != units.end() && unit->node != child)
+            ++unit;
+        if (unit == units.end()) [[unlikely]]
+            throw std::logic_error("Lang::EventTable::EventTable: Event is not compiled");
+        if (!Compiler::IsSignalEvent(*child)) {
+            _predicates.push(Predicate {
+                condition: unit->condition.get(),
+                body: unit->expression.get()
+            });
+            continue;
+        }
+        const auto slot = child->children()[0]->nameSlot();
+        if (slot.depth) [[unlikely]]
+            throw std::logic_error("Lang::EventTable::EventTable: Events can't be connected to signals of enclosing classes");
+        connections.push(slot.index, unit->expression.get());
+    }
+
+    // Connections are sorted by signal, events of the same signal keep their declaration order
+    _offsets.resize(_signals.size() + 1u, 0u);
+    for (const auto &connection : connections)
+        ++_offsets[connection.first + 1u];
+    for (std::uint32_t i = 1u; i < _offsets.size(); ++i)
+        _offsets[i] += _offsets[i - 1u];
+    _slots.resize(connections.size(), nullptr);
+    Core::TinyVector<std::uint32_t> cursors;
+    cursors.insert(cursors.end(), _offsets.begin(), _offsets.end() - 1u);
+    for (const auto &connection : connections)
+        _slots[cursors[connection.first]++] = connection.second;
+}
+
+Lang::EventTable::SignalIndex Lang::EventTable::findSignal(const HashedName name) const noexcept
+{
+    const auto it = _signals.find(name);
+
+    if (it == _signals.end())
+        return NoSignal;
+    return static_cast<SignalIndex>(std::distance(_signals.begin(), it));
+}
+
+Lang::EventTable::State Lang::EventTable::makeState(void) const
+{
+    State state;
+
+    state.resize(_predicates.size());
+    return state;
+}
+
+void Lang::EventTable::invalidate(State &state, const Object &instance, const HashedName name) const noexcept
+{
+    for (auto &predicate : state) {
+        if (predicate.dirty)
+            continue;
+        predicate.dirty = std::any_of(predicate.dependencies.begin(), predicate.dependencies.end(),
+            [&instance, name](const PropertyDependency &dependency) {
+                return dependency.instance == &instance && dependency.name == name;
+            }
+        );
+    }
+}
+
+std::uint32_t Lang::EventTable::update(State &state, Object * const *instances) const
+{
+    std::uint32_t count = 0u;
+
+    for (std::uint32_t i = 0u; i < _predicates.size(); ++i) {
+        auto &predicate = state[i];
+        if (!predicate.dirty)
+            continue;
+        Var value;
+        predicate.dependencies.clear();
+        {
+            const Processer::DependencyRecord record(predicate.dependencies);
+            value = (*_predicates[i].condition)(instances, nullptr);
+        }
+        predicate.dirty = false;
+        // The body only runs when the predicate changes from false to true
+        const auto previous = predicate.value;
+        predicate.value = value.toBool();
+        if (!previous && predicate.value) {
+            (void)(*_predicates[i].body)(instances, nullptr);
+            ++count;
+        }
+    }
+    return count;
+}
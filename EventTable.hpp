@@ -0,0 +1,101 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: EventTable
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+
+#include "Compiler.hpp"
+#include "Processer.hpp"
+
+namespace kF::Lang
+{
+    class EventTable;
+}
+
+/** @brief The EventTable dispatches the events of a class, it is shared by every instance of the class
+ *  Events connected to a signal of their class are stored in a flat slot table indexed by signal, in declaration order,
+ *  so an emission only walks a contiguous range of expressions
+ *  Other events are guarded by a predicate, it is only evaluated again once a property it read changed
+ *  and the body of its event runs each time the predicate becomes true
+ *  The compiled units must outlive the table */
+class alignas_cacheline kF::Lang::EventTable
+{
+public:
+    /** @brief Index of a signal in the declaration order of its class */
+    using SignalIndex = std::uint32_t;
+
+    /** @brief Invalid signal index */
+    static constexpr SignalIndex NoSignal = ~static_cast<SignalIndex>(0u);
+
+    /** @brief State of a predicate for an instance */
+    struct alignas_half_cacheline PredicateState
+    {
+        PropertyDependencies dependencies {};
+        bool value { false };
+        bool dirty { true };
+    };
+
+    /** @brief State of every predicate of an instance */
+    using State = Core::TinyVector<PredicateState>;
+
+
+    /** @brief Build the table of a class from its compiled units */
+    EventTable(const AST &classNode, const Compiler::Units &units);
+
+    /** @brief Tables are not copyable */
+    EventTable(const EventTable &other) = delete;
+    EventTable &operator=(const EventTable &other) = delete;
+
+    /** @brief Destructor */
+    ~EventTable(void) noexcept = default;
+
+
+    /** @brief Get the count of signals of the class */
+    [[nodiscard]] std::uint32_t signalCount(void) const noexcept { return static_cast<std::uint32_t>(_signals.size()); }
+
+    /** @brief Get the count of events connected to a signal */
+    [[nodiscard]] std::uint32_t slotCount(const SignalIndex signal) const noexcept { return _offsets[signal + 1u] - _offsets[signal]; }
+
+    /** @brief Get the count of events guarded by a predicate */
+    [[nodiscard]] std::uint32_t predicateCount(void) const noexcept { return static_cast<std::uint32_t>(_predicates.size()); }
+
+    /** @brief Find the index of a signal, returns NoSignal if the class doesn't declare it */
+    [[nodiscard]] SignalIndex findSignal(const HashedName name) const noexcept;
+
+
+    /** @brief Run every event connected to a signal of an instance
+     *  'instances' is the null terminated list of enclosing instances of the emitter, 'args' are forwarded to each event */
+    void emit(const SignalIndex signal, Object * const *instances, Var *args) const;
+
+
+    /** @brief Create the state of the predicates of an instance, every predicate is dirty */
+    [[nodiscard]] State makeState(void) const;
+
+    /** @brief Notify that a property changed, the predicates of an instance reading it become dirty */
+    void invalidate(State &state, const Object &instance, const HashedName name) const noexcept;
+
+    /** @brief Evaluate the dirty predicates of an instance and run the events whose predicate became true
+     *  Returns the count of events that ran */
+    std::uint32_t update(State &state, Object * const *instances) const;
+
+private:
+    /** @brief An event guarded by a predicate */
+    struct alignas_quarter_cacheline Predicate
+    {
+        const Expression *condition { nullptr };
+        const Expression *body { nullptr };
+    };
+
+    // Cacheline 1
+    Core::Vector<std::uint32_t> _offsets {}; // Range of the slots of each signal, followed by the end of the last one
+    Core::Vector<const Expression *> _slots {};
+    Core::Vector<HashedName> _signals {};
+    Core::Vector<Predicate> _predicates {};
+};
+
+static_assert_fit_cacheline(kF::Lang::EventTable);
+
+#include "EventTable.ipp"
@@ -0,0 +1,13 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: EventTable
+ */
+
+inline void kF::Lang::EventTable::emit(const SignalIndex signal, Object * const *instances, Var *args) const
+{
+    const auto *slot = _slots.begin() + _offsets[signal];
+    const auto * const end = _slots.begin() + _offsets[signal + 1u];
+
+    for (; slot != end; ++slot)
+        (void)(**slot)(instances, args);
+}
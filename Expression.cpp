@@ -0,0 +1,38 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Expression
+ */
+
+#include "Expression.hpp"
+
+#if KUBE_INTERPRETER_CLOSURES
+# include "ClosureProcesser.hpp"
+#elif KUBE_INTERPRETER_REGISTER_MACHINE
+# include "RegisterProcesser.hpp"
+#else
+# include "BatchProcesser.hpp"
+# include "StackProcesser.hpp"
+#endif
+
+using namespace kF;
+
+Var Lang::Expression::operator()(Object * const *instances, Var *args) const
+{
+#if KUBE_INTERPRETER_CLOSURES
+    return ClosureProcesser::Local().process(*this, instances, args);
+#elif KUBE_INTERPRETER_REGISTER_MACHINE
+    return RegisterProcesser::Local().process(*this, instances, args);
+#else
+    return StackProcesser::Local().process(*this, instances, args);
+#endif
+}
+
+void Lang::Expression::operator()(Object * const * const *instances, Var * const *args, const std::uint32_t count, Var *results) const
+{
+#if KUBE_INTERPRETER_CLOSURES || KUBE_INTERPRETER_REGISTER_MACHINE
+    for (std::uint32_t i = 0u; i < count; ++i)
+        results[i] = (*this)(instances[i], args ? args[i] : nullptr);
+#else
+    BatchProcesser::Local().process(*this, instances, args, count, results);
+#endif
+}
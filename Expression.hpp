@@ -5,18 +5,53 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <memory_resource>
+#include <span>
+
+#include <Kube/Core/Vector.hpp>
+#include <Kube/Object/Object.hpp>
 
 #include "Instructions.hpp"
+#include "InlineCache.hpp"
+#include "ExternalCache.hpp"
 #include "TokenStack.hpp"
 
 namespace kF::Lang
 {
     class Expression;
+    struct JitCode;
+    struct NameAccesses;
 
     using ExpressionPtr = Expression *;
+
+    /** @brief Release the machine code of an expression */
+    void ReleaseJitCode(JitCode * const code) noexcept;
 }
 
+/** @brief Names of the properties a member body may read, gathered by compilers whatever branch reads them
+ *  Stores, calls and emissions may access any property, they make the body access every name */
+struct kF::Lang::NameAccesses
+{
+    Core::TinyVector<HashedName> names {};
+    bool any { false };
+
+    /** @brief Forget every access */
+    void clear(void) noexcept { names.clear(); any = false; }
+
+    /** @brief Record a read of a name */
+    void read(const HashedName name)
+    {
+        if (!any && std::find(names.begin(), names.end(), name) == names.end())
+            names.push(name);
+    }
+
+    /** @brief Record an access that may involve any name */
+    void accessAny(void) noexcept { names.clear(); any = true; }
+};
+
 /** @brief An expression is an opaque accesser that implement execution of expressions
  *  You should call 'Construct' static member function to create a pointer to expression
  *
@@ -24,62 +59,172 @@ namespace kF::Lang
  *  Once built cannot be nor moved as its pointer is where is the data
  *
  *  Why such an obscure pattern ? Because it removes a level of indirection when calling a slot
+ *
+ *  The instructions are followed by the inline caches of the expression, at the next cacheline boundary, then by its external caches
+ *  and by the names it may read
  * */
 class kF::Lang::Expression
 {
 public:
-    /** @brief Build an expression out of an */
-    [[nodiscard]] static inline ExpressionPtr Construct(void);
+    /** @brief Deleter releasing an expression */
+    struct Deleter
+    {
+        void operator()(const ExpressionPtr instance) const noexcept { Release(instance); }
+    };
+
+    /** @brief An unique pointer to an expression */
+    using Ptr = std::unique_ptr<Expression, Deleter>;
+
+    /** @brief Access count of expressions that may access any property */
+    static constexpr std::uint32_t AnyAccess = ~static_cast<std::uint32_t>(0u);
+
+
+    /** @brief Build an expression out of an instruction stream of either machine (or out of closure nodes)
+     *  'frameSize' is the count of local slots and 'stackSize' the maximum depth of the operand stack
+     *  (or the count of temporary registers, or of call arguments for closures)
+     *  'accesses' are the names the expression may read, an expression built without them may access any property */
+    template<typename Unit>
+    [[nodiscard]] static inline ExpressionPtr Construct(const Unit * const instructions, const std::uint32_t instructionCount,
+            const std::uint16_t frameSize, const std::uint16_t stackSize, const std::uint32_t cacheCount = 0u, const std::uint32_t externalCacheCount = 0u,
+            const NameAccesses * const accesses = nullptr) noexcept;
 
     /** @brief Release an expression aquired before with 'Construct' */
-    [[nodiscard]] static inline void Release(const ExpressionPtr instance) noexcept
-        { Deallocate(instance, instance->size()); }
+    static inline void Release(const ExpressionPtr instance) noexcept
+    {
+        if (instance->_jitCode)
+            ReleaseJitCode(instance->_jitCode);
+        Deallocate(instance, AllocationSize(instance->size(), instance->cacheCount(), instance->externalCacheCount(), instance->_accessCount));
+    }
 
     /** @brief Default destructor, does nothing */
     ~Expression(void) noexcept = default;
 
-    /** @brief Get the self allocation size */
+    /** @brief Get the size of the instructions in bytes */
     [[nodiscard]] std::size_t size(void) const noexcept { return _size; }
 
-    /** @brief Execute the expression */
-    Var operator()(Var *args) const;
+    /** @brief Get the count of local slots used by the expression */
+    [[nodiscard]] std::uint16_t frameSize(void) const noexcept { return _frameSize; }
+
+    /** @brief Get the maximum depth of the operand stack */
+    [[nodiscard]] std::uint16_t stackSize(void) const noexcept { return _stackSize; }
+
+    /** @brief Get the count of inline caches */
+    [[nodiscard]] std::uint32_t cacheCount(void) const noexcept { return _cacheCount; }
+
+    /** @brief Access an inline cache, caches are updated by constant expressions as they are executed */
+    [[nodiscard]] InlineCache &cacheAt(const CacheIndex index) const noexcept
+        { return reinterpret_cast<InlineCache *>(const_cast<std::byte *>(rawData()) + CacheOffset(_size))[index]; }
+
+    /** @brief Get the count of external caches */
+    [[nodiscard]] std::uint32_t externalCacheCount(void) const noexcept { return _externalCacheCount; }
+
+    /** @brief Access an external cache, updated like inline caches */
+    [[nodiscard]] ExternalCache &externalCacheAt(const CacheIndex index) const noexcept
+    {
+        return reinterpret_cast<ExternalCache *>(const_cast<std::byte *>(rawData()) + CacheOffset(_size)
+            + _cacheCount * sizeof(InlineCache))[index];
+    }
+
+    /** @brief Check if the expression may access any property, in which case it has no list of accessed names */
+    [[nodiscard]] bool accessesAny(void) const noexcept { return _accessCount == AnyAccess; }
+
+    /** @brief Get the sorted names of the properties the expression may read, stored after its external caches */
+    [[nodiscard]] std::span<const HashedName> accesses(void) const noexcept
+    {
+        return std::span<const HashedName>(reinterpret_cast<const HashedName *>(rawData() + CacheOffset(_size)
+            + _cacheCount * sizeof(InlineCache) + _externalCacheCount * sizeof(ExternalCache)), accessesAny() ? 0u : _accessCount);
+    }
+
+    /** @brief Get the machine code compiled for the expression, null until it gets hot */
+    [[nodiscard]] const JitCode *jitCode(void) const noexcept
+        { return std::atomic_ref(_jitCode).load(std::memory_order_acquire); }
+
+    /** @brief Count an execution, returns true once the count reaches 'threshold'
+     *  Concurrent executions may be lost as the count is only a heuristic */
+    [[nodiscard]] bool heat(const std::uint32_t threshold) const noexcept
+    {
+        std::atomic_ref hotness(_hotness);
+        const auto count = hotness.load(std::memory_order_relaxed) + 1u;
+        hotness.store(count, std::memory_order_relaxed);
+        return count == threshold;
+    }
+
+    /** @brief Attach machine code to the expression, fails if another thread attached its own before */
+    [[nodiscard]] bool attachJitCode(JitCode * const code) const noexcept
+    {
+        JitCode *expected = nullptr;
+        return std::atomic_ref(_jitCode).compare_exchange_strong(expected, code, std::memory_order_acq_rel);
+    }
+
+    /** @brief Execute the expression on the processer of the calling thread
+     *  The stack processer is used unless the library is built with 'KUBE_INTERPRETER_REGISTER_MACHINE' or 'KUBE_INTERPRETER_CLOSURES'
+     *  'instances' is a null terminated list of the instance of each enclosing class, innermost first */
+    Var operator()(Object * const *instances, Var *args) const;
+
+    /** @brief Execute the expression once per argument set, 'instances[i]' and 'args[i]' being the instances and the parameters of the set 'i'
+     *  Stack machine expressions are evaluated by the batch processer, other machines evaluate the sets one by one
+     *  'args' may be null if the expression has no parameter, the result of the set 'i' is stored in 'results[i]' */
+    void operator()(Object * const * const *instances, Var * const *args, const std::uint32_t count, Var *results) const;
+
+
+    /** @brief Get the internal node data (itself) as node */
+    [[nodiscard]] const Instruction *data(void) const noexcept
+        { return reinterpret_cast<const Instruction *>(rawData()); }
+
+    /** @brief Access a node at byte index */
+    [[nodiscard]] const Instruction *at(const ByteIndex byteIndex) const noexcept
+        { return reinterpret_cast<const Instruction *>(rawData() + byteIndex); }
 
 private:
-    std::size_t _size { 0u }; // Used to deallocate 'this' instance
+    std::uint32_t _size { 0u }; // Used to deallocate 'this' instance
+    std::uint16_t _frameSize { 0u };
+    std::uint16_t _stackSize { 0u };
+    std::uint32_t _cacheCount { 0u };
+    mutable std::uint32_t _hotness { 0u };
+    mutable JitCode *_jitCode { nullptr };
+    std::uint32_t _externalCacheCount { 0u };
+    std::uint32_t _accessCount { AnyAccess };
 
     static inline std::pmr::synchronized_pool_resource _Allocator {};
 
     /** @brief Construct an expression so it occupies a given size in bytes */
-    Expression(const std::size_t size) noexcept
-        : _size(size) {}
+    Expression(const std::uint32_t size, const std::uint16_t frameSize, const std::uint16_t stackSize,
+            const std::uint32_t cacheCount, const std::uint32_t externalCacheCount, const std::uint32_t accessCount) noexcept
+        : _size(size), _frameSize(frameSize), _stackSize(stackSize), _cacheCount(cacheCount), _externalCacheCount(externalCacheCount)
+        , _accessCount(accessCount) {}
+
+
+    /** @brief Get the offset of the inline caches from the instructions */
+    [[nodiscard]] static constexpr std::size_t CacheOffset(const std::size_t size) noexcept
+        { return ((kF::Core::CacheLineHalfSize + size + kF::Core::CacheLineSize - 1u) & ~(kF::Core::CacheLineSize - 1u)) - kF::Core::CacheLineHalfSize; }
+
+    /** @brief Get the allocation size of an expression, without its header */
+    [[nodiscard]] static constexpr std::size_t AllocationSize(const std::size_t size, const std::uint32_t cacheCount,
+            const std::uint32_t externalCacheCount, const std::uint32_t accessCount) noexcept
+    {
+        const auto nameCount = accessCount == AnyAccess ? 0u : accessCount;
+        return cacheCount || externalCacheCount || nameCount
+            ? CacheOffset(size) + cacheCount * sizeof(InlineCache) + externalCacheCount * sizeof(ExternalCache) + nameCount * sizeof(HashedName)
+            : size;
+    }
 
 
     /** @brief Get the internal node data (itself) as raw data */
     [[nodiscard]] std::byte *rawData(void) noexcept
-        { return reinterpret_cast<std::byte *>(this) + kF::Core::CacheLineEighthSize; }
+        { return reinterpret_cast<std::byte *>(this) + kF::Core::CacheLineHalfSize; }
     [[nodiscard]] const std::byte *rawData(void) const noexcept
-        { return reinterpret_cast<const std::byte *>(this) + kF::Core::CacheLineEighthSize; }
-
-    /** @brief Get the internal node data (itself) as node */
-    [[nodiscard]] Instruction *data(void) noexcept
-        { return reinterpret_cast<Instruction *>(rawData()); }
-    [[nodiscard]] const Instruction *data(void) const noexcept
-        { return reinterpret_cast<const Instruction *>(rawData()); }
-
-    /** @brief Access a node at byte index */
-    [[nodiscard]] Instruction *at(const ByteIndex byteIndex) noexcept
-        { return reinterpret_cast<Instruction *>(rawData() + byteIndex); }
-    [[nodiscard]] const Instruction *at(const ByteIndex byteIndex) const noexcept
-        { return reinterpret_cast<const Instruction *>(rawData() + byteIndex); }
+        { return reinterpret_cast<const std::byte *>(this) + kF::Core::CacheLineHalfSize; }
 
 
     /** @brief Allocate using the allocator */
     [[nodiscard]] static inline void *Allocate(const std::size_t size) noexcept
-        { return _Allocator.allocate(size + sizeof(std::size_t), kF::Core::CacheLineSize); }
+        { return _Allocator.allocate(size + kF::Core::CacheLineHalfSize, kF::Core::CacheLineSize); }
 
     /** @brief Allocate using the allocator */
     static inline void Deallocate(void *data, const std::size_t size) noexcept
-        { _Allocator.deallocate(data, size + sizeof(std::size_t), kF::Core::CacheLineSize); }
+        { _Allocator.deallocate(data, size + kF::Core::CacheLineHalfSize, kF::Core::CacheLineSize); }
 };
 
+static_assert(sizeof(kF::Lang::Expression) == kF::Core::CacheLineHalfSize, "Expression header must fit before its instructions");
+
 #include "Expression.ipp"
@@ -0,0 +1,31 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Expression
+ */
+
+#include <cstring>
+
+template<typename Unit>
+inline kF::Lang::ExpressionPtr kF::Lang::Expression::Construct(const Unit * const instructions, const std::uint32_t instructionCount,
+        const std::uint16_t frameSize, const std::uint16_t stackSize, const std::uint32_t cacheCount, const std::uint32_t externalCacheCount,
+        const NameAccesses * const accesses) noexcept
+{
+    static_assert(sizeof(Unit) % sizeof(Instruction) == 0u, "Lang::Expression::Construct: Units must be made of whole instructions");
+
+    const auto size = static_cast<std::uint32_t>(instructionCount * sizeof(Unit));
+    const auto accessCount = !accesses || accesses->any ? AnyAccess : static_cast<std::uint32_t>(accesses->names.size());
+    const auto instance = new (Allocate(AllocationSize(size, cacheCount, externalCacheCount, accessCount)))
+        Expression(size, frameSize, stackSize, cacheCount, externalCacheCount, accessCount);
+
+    std::memcpy(instance->rawData(), instructions, size);
+    for (CacheIndex index = 0u; index < cacheCount; ++index)
+        new (&instance->cacheAt(index)) InlineCache();
+    for (CacheIndex index = 0u; index < externalCacheCount; ++index)
+        new (&instance->externalCacheAt(index)) ExternalCache();
+    if (accessCount != AnyAccess) {
+        const auto names = const_cast<HashedName *>(instance->accesses().data());
+        std::copy(accesses->names.begin(), accesses->names.end(), names);
+        std::sort(names, names + accessCount);
+    }
+    return instance;
+}
@@ -0,0 +1,63 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: ExternalCache
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include <Kube/Object/Object.hpp>
+
+#include "Base.hpp"
+
+namespace kF::Lang
+{
+    class ExternalCache;
+}
+
+/** @brief Inline cache attached to an external access or call, which resolves a name through the chain of enclosing instances
+ *  Each entry remembers the types of the instances walked until the name was found, their depth and what was resolved
+ *  A hit costs one type comparison per walked instance instead of one meta lookup per instance
+ *  Entries are written once, like the ones of InlineCache, and names found deeper than 'MaxDepth' are resolved on each access */
+class alignas_cacheline kF::Lang::ExternalCache
+{
+public:
+    /** @brief Count of instance chains remembered by a cache */
+    static constexpr std::size_t EntryCount = 2u;
+
+    /** @brief Maximum count of instances walked by a cached resolution */
+    static constexpr std::uint32_t MaxDepth = 3u;
+
+
+    /** @brief Find the innermost instance having a data, returns null if none has it */
+    [[nodiscard]] inline Object *findData(Object * const *instances, const HashedName name, Meta::Data &data);
+
+    /** @brief Find the innermost instance having a function, returns null if none has it */
+    [[nodiscard]] inline Object *findFunction(Object * const *instances, const HashedName name, Meta::Function &function);
+
+private:
+    /** @brief Walked count of an entry being written */
+    static constexpr std::uint32_t Busy = ~static_cast<std::uint32_t>(0u);
+
+    /** @brief A cached chain of types and what was resolved at its end, an empty entry has no walked instance */
+    struct alignas_half_cacheline Entry
+    {
+        std::atomic<std::uint32_t> walked { 0u };
+        std::array<HashedName, MaxDepth> types {};
+        Meta::Data data {};
+        Meta::Function function {};
+    };
+
+    std::array<Entry, EntryCount> _entries {};
+
+
+    /** @brief Find the innermost instance resolving a name, 'Member' is the resolved entry field */
+    template<auto Member, typename Resolved, typename Resolve>
+    [[nodiscard]] inline Object *find(Object * const *instances, Resolved &resolved, Resolve &&resolve);
+};
+
+static_assert_fit_cacheline(kF::Lang::ExternalCache);
+
+#include "ExternalCache.ipp"
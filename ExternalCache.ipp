@@ -0,0 +1,55 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: ExternalCache
+ */
+
+inline kF::Object *kF::Lang::ExternalCache::findData(Object * const *instances, const HashedName name, Meta::Data &data)
+{
+    return find<&Entry::data>(instances, data, [name](const Meta::Type &type) { return type.findData(name); });
+}
+
+inline kF::Object *kF::Lang::ExternalCache::findFunction(Object * const *instances, const HashedName name, Meta::Function &function)
+{
+    return find<&Entry::function>(instances, function, [name](const Meta::Type &type) { return type.findFunction(name); });
+}
+
+template<auto Member, typename Resolved, typename Resolve>
+inline kF::Object *kF::Lang::ExternalCache::find(Object * const *instances, Resolved &resolved, Resolve &&resolve)
+{
+    // Hit if the walked instances have the types of an entry
+    for (auto &entry : _entries) {
+        const auto walked = entry.walked.load(std::memory_order_acquire);
+        if (!walked || walked == Busy)
+            continue;
+        auto index = 0u;
+        while (index != walked && instances[index] && instances[index]->getMetaType().typeID() == entry.types[index])
+            ++index;
+        if (index == walked) [[likely]] {
+            resolved = entry.*Member;
+            return instances[walked - 1u];
+        }
+    }
+
+    // Walk the instances, then claim an empty entry, the entry is published after its types and what was resolved
+    std::array<HashedName, MaxDepth> types;
+    for (auto index = 0u; instances[index]; ++index) {
+        const auto type = instances[index]->getMetaType();
+        if (index < MaxDepth)
+            types[index] = type.typeID();
+        if (resolved = resolve(type); !resolved)
+            continue;
+        if (index >= MaxDepth)
+            return instances[index];
+        for (auto &entry : _entries) {
+            std::uint32_t expected = 0u;
+            if (entry.walked.load(std::memory_order_relaxed) || !entry.walked.compare_exchange_strong(expected, Busy, std::memory_order_acq_rel))
+                continue;
+            entry.types = types;
+            entry.*Member = resolved;
+            entry.walked.store(index + 1u, std::memory_order_release);
+            break;
+        }
+        return instances[index];
+    }
+    return nullptr;
+}
@@ -0,0 +1,93 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Formatter entry point
+ */
+
+#include <charconv>
+#include <fstream>
+#include <iostream>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <Kube/Interpreter/Lexer.hpp>
+#include <Kube/Interpreter/Parser.hpp>
+#include <Kube/Interpreter/Formatter.hpp>
+
+static const char *Usage =
+"Usage: ./kl-format [Flags] FilePath...\n"
+"\n"
+"Arguments (flags must be before file paths):\n"
+"  Flags:\n"
+"    -h: Show this menu\n"
+"    -i: Format files in place instead of writing to the standard output (files holding comments are refused)\n"
+"    -t: Indent with tabulations\n"
+"    -w Width: Count of indentation characters per level (default: 2)\n"
+"  FilePath:\n"
+"    The .kl files to format\n";
+
+using namespace kF;
+
+int main(int ac, const char *av[])
+{
+    try {
+        Lang::Formatter::Options options;
+        bool inPlace = false;
+        auto i = 1;
+
+        for (; i < ac && av[i][0] == '-'; ++i) {
+            auto arg = std::string_view(av[i]);
+            if (arg == "-h") {
+                std::cout << Usage << std::endl;
+                return 0;
+            } else if (arg == "-i")
+                inPlace = true;
+            else if (arg == "-t") {
+                options.indentChar = '\t';
+                options.indentWidth = 1u;
+            } else if (arg == "-w" && i + 1 < ac) {
+                const auto width = std::string_view(av[++i]);
+                if (const auto res = std::from_chars(width.data(), width.data() + width.size(), options.indentWidth); res.ec != std::errc())
+                    throw std::logic_error("main: Invalid indentation width '" + std::string(width) + '\'');
+            } else
+                throw std::logic_error("main: Unknown argument '" + std::string(arg) + '\'');
+        }
+        if (i == ac)
+            throw std::logic_error("main: No file to format");
+
+        for (Lang::FileIndex file = 0u; i < ac; ++i, ++file) {
+            const std::string path(av[i]);
+            std::ifstream istream(path);
+            if (!istream)
+                throw std::logic_error("main: Cannot load file '" + path + '\'');
+            Lang::Lexer lexer;
+            Lang::Parser parser;
+            const auto stack = lexer.run(file, istream, path);
+            const auto tree = parser.run(file, &stack, path);
+            istream.close();
+            if (tree->empty())
+                continue;
+
+            if (!inPlace) {
+                Lang::Formatter(STDOUT_FILENO, options).format(parser.imports(), tree->root());
+                continue;
+            }
+            // Comments are not part of the tree, rewriting the file would lose them
+            if (lexer.commentCount())
+                throw std::logic_error("main: Cannot format file '" + path + "' in place as its comments would be lost");
+            // The whole file is formatted in memory before being truncated
+            Lang::Formatter::Buffer buffer;
+            Lang::Formatter(buffer, options).format(parser.imports(), tree->root());
+            const auto fd = ::open(path.c_str(), O_WRONLY | O_TRUNC);
+            if (fd < 0)
+                throw std::logic_error("main: Cannot open file '" + path + "' for writing");
+            Lang::Formatter formatter(fd, options);
+            formatter.write(std::string_view(buffer.data(), buffer.size()));
+            formatter.flush();
+            ::close(fd);
+        }
+    } catch (const std::exception &e) {
+        std::cout << "A critical error occured:\n" << e.what() << std::endl;
+        return 1;
+    }
+}
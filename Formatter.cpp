@@ -0,0 +1,341 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Formatter
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <unistd.h>
+
+#include "Formatter.hpp"
+
+using namespace kF;
+
+namespace kF::Lang
+{
+    /** @brief Check if a node is a statement that ends its own line */
+    [[nodiscard]] static bool IsCompoundStatement(const AST &node) noexcept
+    {
+        return node.type() == TokenType::Statement
+            && static_cast<std::uint32_t>(node.statementType()) < static_cast<std::uint32_t>(StatementType::Break);
+    }
+}
+
+void Lang::Formatter::format(const AST &root)
+{
+    visit(root, 0u, true);
+    flush();
+}
+
+void Lang::Formatter::flush(void)
+{
+    if (_fd < 0)
+        return;
+    const auto *data = _buffer->data();
+    std::size_t remaining = _buffer->size();
+    while (remaining) {
+        const auto written = ::write(_fd, data, remaining);
+        if (written < 0) [[unlikely]] {
+            if (errno == EINTR)
+                continue;
+            throw std::logic_error(std::string("Lang::Formatter::flush: Cannot write formatted output: ") + std::strerror(errno));
+        }
+        data += written;
+        remaining -= static_cast<std::size_t>(written);
+    }
+    _buffer->clear();
+}
+
+void Lang::Formatter::endOfExpression(const AST &node)
+{
+    if (const auto type = node.type(); (type == TokenType::Expression && node.children().size() == 1u && !IsCompoundStatement(*node.children()[0]))
+            || static_cast<std::uint32_t>(type) > static_cast<std::uint32_t>(TokenType::Expression))
+        write(";\n");
+    else
+        write('\n');
+}
+
+void Lang::Formatter::writeChildren(const AST &node, const std::uint32_t level, const std::string_view &separator)
+{
+    for (bool passed = false; const auto *child : node.children()) {
+        if (passed)
+            write(separator);
+        else
+            passed = true;
+        visit(*child, level, true);
+    }
+}
+
+void Lang::Formatter::writeBlock(const AST &node, const std::uint32_t level)
+{
+    if (node.children().empty()) {
+        write("{}");
+        return;
+    }
+    write("{\n");
+    for (const auto *child : node.children()) {
+        indent(level + 1);
+        visit(*child, level + 1, true);
+        if (!IsCompoundStatement(*child))
+            write(";\n");
+    }
+    indent(level);
+    write('}');
+}
+
+void Lang::Formatter::writeBranch(const AST &node, const std::uint32_t level)
+{
+    visit(node, level, true);
+    endOfExpression(node);
+}
+
+void Lang::Formatter::handle(TokenTag<TokenType::Class>, const AST &node, const std::uint32_t level, const bool)
+{
+    write(node.literal());
+    write(" {\n");
+    for (const auto *child : node.children()) {
+        indent(level + 1);
+        visit(*child, level + 1, true);
+    }
+    indent(level);
+    write("}\n");
+}
+
+void Lang::Formatter::handle(TokenTag<TokenType::Property>, const AST &node, const std::uint32_t level, const bool)
+{
+    write("property ");
+    write(node.literal());
+    write(": ");
+    writeBranch(*node.children()[0], level);
+}
+
+void Lang::Formatter::handle(TokenTag<TokenType::Signal>, const AST &node, const std::uint32_t level, const bool)
+{
+    write("signal ");
+    write(node.literal());
+    writeBranch(*node.children()[0], level);
+}
+
+void Lang::Formatter::handle(TokenTag<TokenType::Function>, const AST &node, const std::uint32_t level, const bool)
+{
+    write("function ");
+    write(node.literal());
+    visit(*node.children()[0], level, true);
+    // Function bodies are always blocks
+    write(' ');
+    writeBlock(*node.children()[1], level);
+    write('\n');
+}
+
+void Lang::Formatter::handle(TokenTag<TokenType::Event>, const AST &node, const std::uint32_t level, const bool)
+{
+    write("on ");
+    visit(*node.children()[0], level, true);
+    write(": ");
+    writeBranch(*node.children()[1], level);
+}
+
+void Lang::Formatter::handle(TokenTag<TokenType::Assignment>, const AST &node, const std::uint32_t level, const bool)
+{
+    write(node.literal());
+    write(": ");
+    writeBranch(*node.children()[0], level);
+}
+
+void Lang::Formatter::handle(TokenTag<TokenType::ParameterList>, const AST &node, const std::uint32_t level, const bool)
+{
+    write('(');
+    writeChildren(node, level, ", ");
+    write(')');
+}
+
+void Lang::Formatter::handle(TokenTag<TokenType::Expression>, const AST &node, const std::uint32_t level, const bool)
+{
+    const auto children = node.children();
+
+    if (children.size() == 1u && !IsCompoundStatement(*children[0]))
+        visit(*children[0], level, true);
+    else
+        writeBlock(node, level);
+}
+
+void Lang::Formatter::handle(TokenTag<TokenType::List>, const AST &node, const std::uint32_t level, const bool)
+{
+    write("[ ");
+    writeChildren(node, level, ", ");
+    write(" ]");
+}
+
+void Lang::Formatter::handle(TokenTag<TokenType::Local>, const AST &node, const std::uint32_t level, const bool)
+{
+    const auto children = node.children();
+
+    visit(*children[0], level, true);
+    write(' ');
+    visit(*children[1], level, true);
+    write(" = ");
+    visit(*children[2], level, true);
+}
+
+void Lang::Formatter::handle(TokenTag<TokenType::TemplateType>, const AST &node, const std::uint32_t level, const bool)
+{
+    write(node.literal());
+    write('<');
+    writeChildren(node, level, ", ");
+    write('>');
+}
+
+void Lang::Formatter::handle(TokenTag<TokenType::Operator>, const AST &node, const std::uint32_t level, const bool first)
+{
+    const auto type = node.operatorType();
+    const auto children = node.children();
+
+    if (!first)
+        write('(');
+    if (IsUnary(type)) {
+        if (type == OperatorType::IncrementSuffix || type == OperatorType::DecrementSuffix) {
+            visit(*children[0], level, false);
+            write(node.literal());
+        } else {
+            write(node.literal());
+            visit(*children[0], level, false);
+        }
+    } else if (IsBinary(type)) {
+        visit(*children[0], level, false);
+        if (type == OperatorType::Dot)
+            write(node.literal());
+        else {
+            write(' ');
+            write(node.literal());
+            write(' ');
+        }
+        visit(*children[1], level, false);
+    } else if (IsTerciary(type)) {
+        visit(*children[0], level, false);
+        write(' ');
+        write(node.literal());
+        write(' ');
+        visit(*children[1], level, false);
+        write(" : ");
+        visit(*children[2], level, false);
+    } else if (type == OperatorType::Call) {
+        visit(*children[0], level, false);
+        write('(');
+        if (children.size() > 1u)
+            visit(*children[1], level, false);
+        write(')');
+    } else
+        write("UNKNOWN OPERATOR");
+    if (!first)
+        write(')');
+}
+
+void Lang::Formatter::handle(StatementTag<StatementType::If>, const AST &node, const std::uint32_t level, const bool)
+{
+    const auto children = node.children();
+
+    // Children are stored as (condition, body) pairs followed by an optional else body
+    for (auto i = 0u; i < children.size();) {
+        if (i)
+            indent(level);
+        if (i + 1 < children.size()) {
+            write(i ? "else if (" : "if (");
+            visit(*children[i], level, true);
+            write(") ");
+            writeBranch(*children[i + 1], level);
+            i += 2;
+        } else {
+            write("else ");
+            writeBranch(*children[i], level);
+            ++i;
+        }
+    }
+}
+
+void Lang::Formatter::handle(StatementTag<StatementType::While>, const AST &node, const std::uint32_t level, const bool)
+{
+    write("while (");
+    visit(*node.children()[0], level, true);
+    write(") ");
+    writeBranch(*node.children()[1], level);
+}
+
+void Lang::Formatter::handle(StatementTag<StatementType::For>, const AST &node, const std::uint32_t level, const bool)
+{
+    const auto children = node.children();
+
+    write("for (");
+    visit(*children[0], level, true);
+    write("; ");
+    visit(*children[1], level, true);
+    write("; ");
+    visit(*children[2], level, true);
+    write(") ");
+    writeBranch(*children[3], level);
+}
+
+void Lang::Formatter::handle(StatementTag<StatementType::Switch>, const AST &node, const std::uint32_t level, const bool)
+{
+    const auto children = node.children();
+
+    write("switch (");
+    visit(*children[0], level, true);
+    write(") {\n");
+    // Children are stored as (case, body) pairs followed by an optional default body
+    for (auto i = 1u; i < children.size();) {
+        indent(level);
+        if (i + 1 < children.size()) {
+            write("case ");
+            visit(*children[i], level, true);
+            write(":\n");
+            indent(level + 1);
+            writeBranch(*children[i + 1], level + 1);
+            i += 2;
+        } else {
+            write("default:\n");
+            indent(level + 1);
+            writeBranch(*children[i], level + 1);
+            ++i;
+        }
+    }
+    indent(level);
+    write("}\n");
+}
+
+void Lang::Formatter::handle(StatementTag<StatementType::Break>, const AST &, const std::uint32_t, const bool)
+{
+    write("break");
+}
+
+void Lang::Formatter::handle(StatementTag<StatementType::Continue>, const AST &, const std::uint32_t, const bool)
+{
+    write("continue");
+}
+
+void Lang::Formatter::handle(StatementTag<StatementType::Return>, const AST &node, const std::uint32_t level, const bool)
+{
+    write("return ");
+    visit(*node.children()[0], level, true);
+}
+
+void Lang::Formatter::handle(StatementTag<StatementType::Emit>, const AST &node, const std::uint32_t level, const bool)
+{
+    write("emit ");
+    visit(*node.children()[0], level, true);
+}
+
+void Lang::Formatter::handleDefault(const AST &node, const std::uint32_t, const bool)
+{
+    switch (node.type()) {
+    case TokenType::Name:
+    case TokenType::Type:
+    case TokenType::Constant:
+        write(node.literal());
+        break;
+    default:
+        write("UNKNOWN TOKEN");
+        break;
+    }
+}
@@ -0,0 +1,121 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Formatter
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+
+#include "Visitor.hpp"
+
+namespace kF::Lang
+{
+    class Formatter;
+}
+
+/** @brief The Formatter prints an AST as source code into a growable byte buffer
+ *  The buffer is either provided by the caller or owned by the formatter and written to a file descriptor in large chunks */
+class alignas_cacheline kF::Lang::Formatter : public Visitor<Formatter, void, std::uint32_t, bool>
+{
+public:
+    /** @brief Output buffer */
+    using Buffer = Core::Vector<char>;
+
+    /** @brief Size from which an owned buffer is written to its file descriptor */
+    static constexpr std::size_t FlushSize = 64u * 1024u;
+
+    /** @brief Formatting options */
+    struct alignas_eighth_cacheline Options
+    {
+        std::uint32_t indentWidth { 2u };
+        char indentChar { ' ' };
+    };
+
+
+    /** @brief Construct a formatter writing into a caller buffer, the buffer is never flushed */
+    Formatter(Buffer &buffer) noexcept : Formatter(buffer, Options()) {}
+    Formatter(Buffer &buffer, const Options options) noexcept
+        : _buffer(&buffer), _options(options) {}
+
+    /** @brief Construct a formatter writing into a file descriptor */
+    Formatter(const int fd) noexcept : Formatter(fd, Options()) {}
+    Formatter(const int fd, const Options options) noexcept
+        : _buffer(&_ownedBuffer), _fd(fd), _options(options) {}
+
+    /** @brief Formatters are not copyable */
+    Formatter(const Formatter &other) = delete;
+    Formatter &operator=(const Formatter &other) = delete;
+
+    /** @brief Destructor */
+    ~Formatter(void) noexcept = default;
+
+
+    /** @brief Format a whole tree, then flush if writing into a file descriptor */
+    void format(const AST &root);
+
+    /** @brief Format the import paths of a file followed by its tree, then flush if writing into a file descriptor */
+    template<typename Imports>
+    void format(const Imports &imports, const AST &root);
+
+    /** @brief Write raw text */
+    void write(const std::string_view &text);
+    void write(const char character);
+
+    /** @brief Write every buffered byte into the file descriptor, if any */
+    void flush(void);
+
+private:
+    // Cacheline 1
+    Buffer *_buffer { nullptr };
+    int _fd { -1 };
+    Options _options {};
+    Buffer _ownedBuffer {};
+
+    friend Visitor<Formatter, void, std::uint32_t, bool>;
+
+    /** @brief Write the indentation of a given level */
+    void indent(const std::uint32_t level);
+
+    /** @brief Write the end of an expression */
+    void endOfExpression(const AST &node);
+
+    /** @brief Write each child of a node separated by a given text */
+    void writeChildren(const AST &node, const std::uint32_t level, const std::string_view &separator);
+
+    /** @brief Write an expression as a block, whatever its count of children */
+    void writeBlock(const AST &node, const std::uint32_t level);
+
+    /** @brief Write the body of a conditional branch, ending its line */
+    void writeBranch(const AST &node, const std::uint32_t level);
+
+
+    /** @brief Node handlers */
+    void handle(TokenTag<TokenType::Class>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(TokenTag<TokenType::Property>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(TokenTag<TokenType::Signal>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(TokenTag<TokenType::Function>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(TokenTag<TokenType::Event>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(TokenTag<TokenType::Assignment>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(TokenTag<TokenType::ParameterList>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(TokenTag<TokenType::Expression>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(TokenTag<TokenType::List>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(TokenTag<TokenType::Local>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(TokenTag<TokenType::TemplateType>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(TokenTag<TokenType::Operator>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(StatementTag<StatementType::If>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(StatementTag<StatementType::While>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(StatementTag<StatementType::For>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(StatementTag<StatementType::Switch>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(StatementTag<StatementType::Break>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(StatementTag<StatementType::Continue>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(StatementTag<StatementType::Return>, const AST &node, const std::uint32_t level, const bool first);
+    void handle(StatementTag<StatementType::Emit>, const AST &node, const std::uint32_t level, const bool first);
+
+    /** @brief Names, types and constants are written as is */
+    void handleDefault(const AST &node, const std::uint32_t level, const bool first);
+};
+
+static_assert_fit_cacheline(kF::Lang::Formatter);
+
+#include "Formatter.ipp"
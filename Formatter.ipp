@@ -0,0 +1,36 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Formatter
+ */
+
+inline void kF::Lang::Formatter::write(const std::string_view &text)
+{
+    _buffer->insert(_buffer->end(), text.begin(), text.end());
+    if (_fd >= 0 && _buffer->size() >= FlushSize) [[unlikely]]
+        flush();
+}
+
+inline void kF::Lang::Formatter::write(const char character)
+{
+    _buffer->push(character);
+    if (_fd >= 0 && _buffer->size() >= FlushSize) [[unlikely]]
+        flush();
+}
+
+template<typename Imports>
+inline void kF::Lang::Formatter::format(const Imports &imports, const AST &root)
+{
+    for (const auto &path : imports) {
+        write("import \"");
+        write(path.toStdView());
+        write("\"\n");
+    }
+    if (!imports.empty())
+        write('\n');
+    format(root);
+}
+
+inline void kF::Lang::Formatter::indent(const std::uint32_t level)
+{
+    _buffer->insert(_buffer->end(), level * _options.indentWidth, _options.indentChar);
+}
@@ -0,0 +1,53 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: InlineCache
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include <Kube/Object/Object.hpp>
+
+#include "Base.hpp"
+
+namespace kF::Lang
+{
+    class InlineCache;
+
+    /** @brief Index of an inline cache within an expression */
+    using CacheIndex = std::uint32_t;
+}
+
+/** @brief Polymorphic inline cache attached to a named data access instruction
+ *  Each entry remembers a type and the data resolved for it, a hit costs a type comparison and a load
+ *  Entries are written once so that expressions shared by several threads never observe a torn entry,
+ *  once every entry is taken the access is megamorphic and falls back to the resolver */
+class alignas_cacheline kF::Lang::InlineCache
+{
+public:
+    /** @brief Count of types remembered by a cache */
+    static constexpr std::size_t EntryCount = 4u;
+
+
+    /** @brief Find a data of an instance, returns an invalid data if it doesn't exist */
+    [[nodiscard]] inline Meta::Data findData(const Object &instance, const HashedName name);
+
+private:
+    /** @brief Type identifier of an entry being written */
+    static constexpr HashedName Busy = ~static_cast<HashedName>(0u);
+
+    /** @brief A cached type and its resolved data */
+    struct alignas_quarter_cacheline Entry
+    {
+        std::atomic<HashedName> type { 0u };
+        Meta::Data data {};
+    };
+
+    std::array<Entry, EntryCount> _entries {};
+};
+
+static_assert_fit_cacheline(kF::Lang::InlineCache);
+
+#include "InlineCache.ipp"
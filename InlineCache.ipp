@@ -0,0 +1,26 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: InlineCache
+ */
+
+inline kF::Meta::Data kF::Lang::InlineCache::findData(const Object &instance, const HashedName name)
+{
+    const auto type = instance.getMetaType();
+    const auto typeID = type.typeID();
+
+    for (auto &entry : _entries) {
+        auto cached = entry.type.load(std::memory_order_acquire);
+        if (cached == typeID) [[likely]]
+            return entry.data;
+        else if (cached)
+            continue;
+        // Claim the empty entry, the data is published before its type
+        const auto data = type.findData(name);
+        if (data && entry.type.compare_exchange_strong(cached, Busy, std::memory_order_acq_rel)) {
+            entry.data = data;
+            entry.type.store(typeID, std::memory_order_release);
+        }
+        return data;
+    }
+    return type.findData(name);
+}
@@ -0,0 +1,437 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Instructions
+ */
+
+#pragma once
+
+#include "Base.hpp"
+
+namespace kF::Lang
+{
+    /** @brief Index of a byte in an instruction stream */
+    using ByteIndex = std::uint32_t;
+
+    /** @brief Invalid byte index */
+    constexpr ByteIndex NoByteIndex = ~static_cast<ByteIndex>(0u);
+
+    /** @brief All operation codes of the stack machine
+     *  Each instruction pops its operands from the operand stack and pushes its result */
+    enum class OpCode : std::uint32_t {
+        None,
+
+        // Constants
+        PushVoid,
+        PushBoolean,
+        PushInteger,
+        PushFloating,
+        PushLiteral,
+
+        // Operand stack
+        Pop,
+        Duplicate,
+
+        // Variables, stores keep the stored value on the stack
+        PushParameter,
+        StoreParameter,
+        PushLocal,
+        StoreLocal,
+        PushProperty,
+        StoreProperty,
+        PushExternal,
+        StoreExternal,
+        GetMember,
+        SetMember,
+
+        // Unary
+        Not,
+        Minus,
+        BitReverse,
+        Increment,
+        Decrement,
+        ToBoolean,
+
+        // Binary
+        Addition,
+        Substraction,
+        Multiplication,
+        Division,
+        Modulo,
+        Equal,
+        Different,
+        Greater,
+        GreaterEqual,
+        Lighter,
+        LighterEqual,
+        BitAnd,
+        BitOr,
+        BitXor,
+
+        // Control flow
+        Jump,
+        JumpIfFalse,
+        JumpIfTrueOrPop,
+        JumpIfFalseOrPop,
+        JumpTable,
+        JumpSorted,
+        JumpHashed,
+
+        // Superinstructions, fused by the compiler out of frequent sequences
+        AdditionInteger,        // PushInteger, Addition
+        SubstractionInteger,    // PushInteger, Substraction
+        MultiplicationInteger,  // PushInteger, Multiplication
+        IncrementLocal,         // PushLocal, Increment, StoreLocal
+        DecrementLocal,         // PushLocal, Decrement, StoreLocal
+        JumpUnlessEqual,        // Equal, JumpIfFalse
+        JumpUnlessDifferent,    // Different, JumpIfFalse
+        JumpUnlessGreater,      // Greater, JumpIfFalse
+        JumpUnlessGreaterEqual, // GreaterEqual, JumpIfFalse
+        JumpUnlessLighter,      // Lighter, JumpIfFalse
+        JumpUnlessLighterEqual, // LighterEqual, JumpIfFalse
+
+        // Quickened, rewritten in place by the processer once the operand types of their generic instruction are observed
+        IntegerAddition,
+        IntegerSubstraction,
+        IntegerMultiplication,
+        IntegerAdditionInteger,
+        IntegerSubstractionInteger,
+        IntegerMultiplicationInteger,
+        IntegerJumpUnlessGreater,
+        IntegerJumpUnlessGreaterEqual,
+        IntegerJumpUnlessLighter,
+        IntegerJumpUnlessLighterEqual,
+        FloatingAddition,
+        FloatingSubstraction,
+        FloatingMultiplication,
+        FloatingJumpUnlessGreater,
+        FloatingJumpUnlessGreaterEqual,
+        FloatingJumpUnlessLighter,
+        FloatingJumpUnlessLighterEqual,
+
+        // Calls
+        CallFunction,
+        CallExternal,
+        CallMember,
+        Emit,
+        Return
+    };
+
+    /** @brief Count of operation codes */
+    constexpr std::size_t OpCodeCount = static_cast<std::size_t>(OpCode::Return) + 1u;
+
+    /** @brief Base unit of an instruction stream
+     *  The meaning of the argument depends on the operation code:
+     *      PushBoolean: the boolean value
+     *      PushLiteral: the length of the literal, which is stored in the following units
+     *      Parameter / Local: the slot index
+     *      Jumps (generic or quickened): the target byte index
+     *      IncrementLocal / DecrementLocal: the local slot index
+     *  Table jumps are wider, see TableInstruction */
+    struct alignas_eighth_cacheline Instruction
+    {
+        OpCode code { OpCode::None };
+        std::uint32_t argument { 0u };
+    };
+
+    static_assert_fit_eighth_cacheline(Instruction);
+
+    /** @brief Instruction holding a 64 bits immediate value (PushInteger, PushFloating and integer superinstructions) */
+    struct alignas_eighth_cacheline ImmediateInstruction
+    {
+        OpCode code { OpCode::None };
+        std::uint32_t reserved { 0u };
+        union {
+            std::int64_t integer { 0 };
+            double floating;
+        };
+    };
+
+    static_assert_fit_quarter_cacheline(ImmediateInstruction);
+
+    /** @brief Instruction accessing a named member
+     *  Property and function slots hold the depth of their class from the innermost one
+     *  Data accesses (PushProperty, StoreProperty, GetMember, SetMember) hold the index of their inline cache
+     *  External accesses and calls (PushExternal, StoreExternal, CallExternal) hold the index of their external cache
+     *  Member calls only use the name hash */
+    struct alignas_eighth_cacheline MemberInstruction
+    {
+        OpCode code { OpCode::None };
+        HashedName name { 0u };
+        std::uint32_t cache { 0u };
+        std::uint16_t depth { 0u };
+        std::uint16_t argumentCount { 0u };
+    };
+
+    static_assert_fit_quarter_cacheline(MemberInstruction);
+
+    /** @brief Instruction jumping to the entry of a table matching the value on top of the stack, which is popped
+     *  Values of another type than the keys of the table are left on the stack and the next instruction is executed
+     *  The header is followed by the target of each entry, padded to whole units, then by the keys of sorted and hashed tables
+     *      JumpTable: integer keys, the entry of a value is its offset from 'base'
+     *      JumpSorted: integer keys, sorted in ascending order
+     *      JumpHashed: literal keys, an entry holds the byte index of its literal instruction and is found by 'seed' (-1 if empty) */
+    struct alignas_eighth_cacheline TableInstruction
+    {
+        OpCode code { OpCode::None };
+        std::uint32_t count { 0u };
+        ByteIndex defaultTarget { 0u };
+        std::uint32_t seed { 0u };
+        std::int64_t base { 0 };
+    };
+
+    static_assert_fit_half_cacheline(TableInstruction);
+
+    /** @brief Get the count of instruction units used by a literal of a given length */
+    [[nodiscard]] constexpr std::uint32_t LiteralUnitCount(const std::uint32_t length) noexcept
+        { return (length + sizeof(Instruction) - 1u) / sizeof(Instruction); }
+
+    /** @brief Get the size in bytes of the targets of a table */
+    [[nodiscard]] constexpr std::uint32_t TableTargetsSize(const std::uint32_t count) noexcept
+        { return LiteralUnitCount(count * static_cast<std::uint32_t>(sizeof(ByteIndex))) * static_cast<std::uint32_t>(sizeof(Instruction)); }
+
+    /** @brief Get the size in bytes of a table instruction of any machine */
+    template<typename Table>
+    [[nodiscard]] constexpr std::uint32_t TableSize(const Table &table, const bool hasKeys) noexcept
+    {
+        return static_cast<std::uint32_t>(sizeof(Table)) + TableTargetsSize(table.count)
+            + (hasKeys ? table.count * static_cast<std::uint32_t>(sizeof(std::int64_t)) : 0u);
+    }
+
+    /** @brief Get the targets of a table instruction */
+    template<typename Table>
+    [[nodiscard]] inline const ByteIndex *TableTargets(const Table &table) noexcept
+        { return reinterpret_cast<const ByteIndex *>(&table + 1); }
+
+    /** @brief Get the keys of a sorted or hashed table instruction */
+    template<typename Table>
+    [[nodiscard]] inline const std::int64_t *TableKeys(const Table &table) noexcept
+        { return reinterpret_cast<const std::int64_t *>(reinterpret_cast<const std::byte *>(&table + 1) + TableTargetsSize(table.count)); }
+
+    /** @brief Get the entry of a hashed table where a literal hash is stored */
+    [[nodiscard]] constexpr std::uint32_t HashedEntry(const HashedName hash, const std::uint32_t seed, const std::uint32_t count) noexcept
+        { return static_cast<std::uint32_t>((static_cast<std::uint64_t>(hash) * seed) >> 32u) & (count - 1u); }
+
+    /** @brief Get the size in bytes of an instruction out of an operation code already read from it */
+    [[nodiscard]] constexpr std::uint32_t InstructionSize(const Instruction &instruction, const OpCode code) noexcept
+    {
+        switch (code) {
+        case OpCode::PushInteger:
+        case OpCode::PushFloating:
+        case OpCode::AdditionInteger:
+        case OpCode::SubstractionInteger:
+        case OpCode::MultiplicationInteger:
+        case OpCode::IntegerAdditionInteger:
+        case OpCode::IntegerSubstractionInteger:
+        case OpCode::IntegerMultiplicationInteger:
+            return sizeof(ImmediateInstruction);
+        case OpCode::PushLiteral:
+            return sizeof(Instruction) * (1u + LiteralUnitCount(instruction.argument));
+        case OpCode::PushProperty:
+        case OpCode::StoreProperty:
+        case OpCode::PushExternal:
+        case OpCode::StoreExternal:
+        case OpCode::GetMember:
+        case OpCode::SetMember:
+        case OpCode::CallFunction:
+        case OpCode::CallExternal:
+        case OpCode::CallMember:
+        case OpCode::Emit:
+            return sizeof(MemberInstruction);
+        case OpCode::JumpTable:
+        case OpCode::JumpSorted:
+        case OpCode::JumpHashed:
+            return TableSize(reinterpret_cast<const TableInstruction &>(instruction), code != OpCode::JumpTable);
+        default:
+            return sizeof(Instruction);
+        }
+    }
+
+    /** @brief Get the size in bytes of an instruction */
+    [[nodiscard]] constexpr std::uint32_t InstructionSize(const Instruction &instruction) noexcept
+        { return InstructionSize(instruction, instruction.code); }
+
+    /** @brief Index of a register in a frame */
+    using Register = std::uint16_t;
+
+    /** @brief Invalid register index */
+    constexpr Register NoRegister = ~static_cast<Register>(0u);
+
+    /** @brief All operation codes of the register machine
+     *  Registers are made of the frame's locals followed by its temporaries, operations read and write them directly */
+    enum class RegisterOpCode : std::uint16_t {
+        None,
+
+        // Loads and stores
+        Move,
+        LoadVoid,
+        LoadBoolean,
+        LoadInteger,
+        LoadFloating,
+        LoadLiteral,
+        LoadParameter,
+        StoreParameter,
+        LoadProperty,
+        StoreProperty,
+        LoadExternal,
+        StoreExternal,
+        GetMember,
+        SetMember,
+
+        // Unary
+        Not,
+        Minus,
+        BitReverse,
+        Increment,
+        Decrement,
+        ToBoolean,
+
+        // Binary
+        Addition,
+        Substraction,
+        Multiplication,
+        Division,
+        Modulo,
+        Equal,
+        Different,
+        Greater,
+        GreaterEqual,
+        Lighter,
+        LighterEqual,
+        BitAnd,
+        BitOr,
+        BitXor,
+
+        // Control flow
+        Jump,
+        JumpIfFalse,
+        JumpIfTrue,
+        JumpTable,
+        JumpSorted,
+        JumpHashed,
+
+        // Quickened, rewritten in place by the processer once the operand types of their generic instruction are observed
+        IntegerAddition,
+        IntegerSubstraction,
+        IntegerMultiplication,
+        IntegerGreater,
+        IntegerGreaterEqual,
+        IntegerLighter,
+        IntegerLighterEqual,
+        FloatingAddition,
+        FloatingSubstraction,
+        FloatingMultiplication,
+        FloatingGreater,
+        FloatingGreaterEqual,
+        FloatingLighter,
+        FloatingLighterEqual,
+
+        // Calls
+        CallFunction,
+        CallExternal,
+        CallMember,
+        Emit,
+        Return
+    };
+
+    /** @brief Count of register operation codes */
+    constexpr std::size_t RegisterOpCodeCount = static_cast<std::size_t>(RegisterOpCode::Return) + 1u;
+
+    /** @brief Three-address instruction of the register machine (moves, unary and binary operators) */
+    struct alignas_eighth_cacheline RegisterInstruction
+    {
+        RegisterOpCode code { RegisterOpCode::None };
+        Register output { NoRegister };
+        Register lhs { NoRegister };
+        Register rhs { NoRegister };
+    };
+
+    static_assert_fit_eighth_cacheline(RegisterInstruction);
+
+    /** @brief Register instruction with a 32 bits argument, its meaning is the same as in the stack machine
+     *  The register is read by stores, conditional jumps and returns and written by any other operation */
+    struct alignas_eighth_cacheline RegisterArgumentInstruction
+    {
+        RegisterOpCode code { RegisterOpCode::None };
+        Register reg { NoRegister };
+        std::uint32_t argument { 0u };
+    };
+
+    static_assert_fit_eighth_cacheline(RegisterArgumentInstruction);
+
+    /** @brief Register instruction holding a 64 bits immediate value (LoadInteger, LoadFloating) */
+    struct alignas_eighth_cacheline RegisterImmediateInstruction
+    {
+        RegisterOpCode code { RegisterOpCode::None };
+        Register output { NoRegister };
+        std::uint32_t reserved { 0u };
+        union {
+            std::int64_t integer { 0 };
+            double floating;
+        };
+    };
+
+    static_assert_fit_quarter_cacheline(RegisterImmediateInstruction);
+
+    /** @brief Register instruction accessing a named member
+     *  'value' is the loaded, stored or returned register
+     *  'arguments' is the first of 'argumentCount' consecutive registers, member calls expect their object just before it
+     *  Member accesses hold their object register in 'arguments', data accesses hold the index of their inline cache
+     *  and external accesses and calls the index of their external cache */
+    struct alignas_eighth_cacheline RegisterMemberInstruction
+    {
+        RegisterOpCode code { RegisterOpCode::None };
+        Register value { NoRegister };
+        HashedName name { 0u };
+        std::uint16_t depth { 0u };
+        std::uint16_t argumentCount { 0u };
+        Register arguments { NoRegister };
+        std::uint16_t cache { 0u };
+    };
+
+    static_assert_fit_quarter_cacheline(RegisterMemberInstruction);
+
+    /** @brief Register instruction jumping to the entry of a table matching the value of 'reg'
+     *  Its layout and its tables are the same as the ones of the stack machine, values of another type execute the next instruction */
+    struct alignas_eighth_cacheline RegisterTableInstruction
+    {
+        RegisterOpCode code { RegisterOpCode::None };
+        Register reg { NoRegister };
+        std::uint32_t count { 0u };
+        ByteIndex defaultTarget { 0u };
+        std::uint32_t seed { 0u };
+        std::int64_t base { 0 };
+    };
+
+    static_assert_fit_half_cacheline(RegisterTableInstruction);
+
+    /** @brief Get the size in bytes of a register instruction */
+    [[nodiscard]] constexpr std::uint32_t InstructionSize(const RegisterInstruction &instruction) noexcept
+    {
+        switch (instruction.code) {
+        case RegisterOpCode::LoadInteger:
+        case RegisterOpCode::LoadFloating:
+            return sizeof(RegisterImmediateInstruction);
+        case RegisterOpCode::LoadLiteral:
+            return sizeof(RegisterInstruction) * (1u + LiteralUnitCount(
+                reinterpret_cast<const RegisterArgumentInstruction &>(instruction).argument));
+        case RegisterOpCode::LoadProperty:
+        case RegisterOpCode::StoreProperty:
+        case RegisterOpCode::LoadExternal:
+        case RegisterOpCode::StoreExternal:
+        case RegisterOpCode::GetMember:
+        case RegisterOpCode::SetMember:
+        case RegisterOpCode::CallFunction:
+        case RegisterOpCode::CallExternal:
+        case RegisterOpCode::CallMember:
+        case RegisterOpCode::Emit:
+            return sizeof(RegisterMemberInstruction);
+        case RegisterOpCode::JumpTable:
+        case RegisterOpCode::JumpSorted:
+        case RegisterOpCode::JumpHashed:
+            return TableSize(reinterpret_cast<const RegisterTableInstruction &>(instruction),
+                instruction.code != RegisterOpCode::JumpTable);
+        default:
+            return sizeof(RegisterInstruction);
+        }
+    }
+}
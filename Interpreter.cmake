@@ -3,6 +3,7 @@ project(KubeInterpreter)
 get_filename_component(KubeInterpreterDir ${CMAKE_CURRENT_LIST_FILE} PATH)
 
 set(KubeInterpreterBinary KubeInterpreterApp)
+set(KubeFormatBinary kl-format)
 
 set(KubeInterpreterSources
     ${KubeInterpreterDir}/Base.hpp
@@ -19,12 +20,97 @@ set(KubeInterpreterSources
     ${KubeInterpreterDir}/AST.hpp
     ${KubeInterpreterDir}/AST.ipp
     ${KubeInterpreterDir}/AST.cpp
+    ${KubeInterpreterDir}/SyntaxTree.hpp
+    ${KubeInterpreterDir}/SyntaxTree.ipp
+    ${KubeInterpreterDir}/ParallelTraversal.hpp
+    ${KubeInterpreterDir}/ParallelTraversal.ipp
+    ${KubeInterpreterDir}/ParallelTraversal.cpp
+    ${KubeInterpreterDir}/Visitor.hpp
+    ${KubeInterpreterDir}/Visitor.ipp
+    ${KubeInterpreterDir}/Formatter.hpp
+    ${KubeInterpreterDir}/Formatter.ipp
+    ${KubeInterpreterDir}/Formatter.cpp
+    ${KubeInterpreterDir}/Optimizer.hpp
+    ${KubeInterpreterDir}/Optimizer.cpp
+    ${KubeInterpreterDir}/NameResolver.hpp
+    ${KubeInterpreterDir}/NameResolver.cpp
+    ${KubeInterpreterDir}/Instructions.hpp
+    ${KubeInterpreterDir}/InlineCache.hpp
+    ${KubeInterpreterDir}/InlineCache.ipp
+    ${KubeInterpreterDir}/ExternalCache.hpp
+    ${KubeInterpreterDir}/ExternalCache.ipp
+    ${KubeInterpreterDir}/Processer.hpp
+    ${KubeInterpreterDir}/SwitchTable.hpp
+    ${KubeInterpreterDir}/SwitchTable.cpp
+    ${KubeInterpreterDir}/Expression.hpp
+    ${KubeInterpreterDir}/Expression.ipp
+    ${KubeInterpreterDir}/Expression.cpp
+    ${KubeInterpreterDir}/Compiler.hpp
+    ${KubeInterpreterDir}/Compiler.ipp
+    ${KubeInterpreterDir}/Compiler.cpp
+    ${KubeInterpreterDir}/StackProcesser.hpp
+    ${KubeInterpreterDir}/StackProcesser.cpp
+    ${KubeInterpreterDir}/StackJit.hpp
+    ${KubeInterpreterDir}/StackJit.cpp
+    ${KubeInterpreterDir}/BatchProcesser.hpp
+    ${KubeInterpreterDir}/BatchProcesser.cpp
+    ${KubeInterpreterDir}/RegisterCompiler.hpp
+    ${KubeInterpreterDir}/RegisterCompiler.ipp
+    ${KubeInterpreterDir}/RegisterCompiler.cpp
+    ${KubeInterpreterDir}/RegisterProcesser.hpp
+    ${KubeInterpreterDir}/RegisterProcesser.cpp
+    ${KubeInterpreterDir}/ClosureCompiler.hpp
+    ${KubeInterpreterDir}/ClosureCompiler.ipp
+    ${KubeInterpreterDir}/ClosureCompiler.cpp
+    ${KubeInterpreterDir}/ClosureProcesser.hpp
+    ${KubeInterpreterDir}/ClosureProcesser.ipp
+    ${KubeInterpreterDir}/ClosureProcesser.cpp
+    ${KubeInterpreterDir}/BindingGraph.hpp
+    ${KubeInterpreterDir}/BindingGraph.cpp
+    ${KubeInterpreterDir}/EventTable.hpp
+    ${KubeInterpreterDir}/EventTable.ipp
+    ${KubeInterpreterDir}/EventTable.cpp
+    ${KubeInterpreterDir}/Prototype.hpp
+    ${KubeInterpreterDir}/Prototype.cpp
+    ${KubeInterpreterDir}/ColumnStorage.hpp
+    ${KubeInterpreterDir}/ColumnStorage.ipp
+    ${KubeInterpreterDir}/ColumnStorage.cpp
     ${KubeInterpreterDir}/Interpreter.hpp
     ${KubeInterpreterDir}/Interpreter.cpp
 )
 
 add_library(${PROJECT_NAME} ${KubeInterpreterSources})
 
+# Execute expressions on the register machine instead of the stack machine
+if(KF_INTERPRETER_REGISTER_MACHINE)
+    target_compile_definitions(${PROJECT_NAME} PUBLIC KUBE_INTERPRETER_REGISTER_MACHINE=1)
+endif()
+
+# Execute expressions as trees of closures instead of instruction streams (takes precedence over the register machine)
+if(KF_INTERPRETER_CLOSURES)
+    target_compile_definitions(${PROJECT_NAME} PUBLIC KUBE_INTERPRETER_CLOSURES=1)
+endif()
+
+# Dispatch instructions with a portable switch instead of computed gotos
+if(KF_INTERPRETER_SWITCH_DISPATCH)
+    target_compile_definitions(${PROJECT_NAME} PRIVATE KUBE_INTERPRETER_SWITCH_DISPATCH=1)
+endif()
+
+# Keep interpreting hot expressions instead of translating them into machine code
+if(KF_INTERPRETER_DISABLE_JIT)
+    target_compile_definitions(${PROJECT_NAME} PUBLIC KUBE_INTERPRETER_DISABLE_JIT=1)
+endif()
+
+# Evaluate batches on scalars instead of AVX2 kernels
+if(KF_INTERPRETER_DISABLE_AVX2)
+    target_compile_definitions(${PROJECT_NAME} PRIVATE KUBE_INTERPRETER_DISABLE_AVX2=1)
+endif()
+
+# Record executed instruction sequences to find superinstruction candidates
+if(KF_INTERPRETER_PROFILE)
+    target_compile_definitions(${PROJECT_NAME} PUBLIC KUBE_INTERPRETER_PROFILE=1)
+endif()
+
 target_link_libraries(${PROJECT_NAME}
 PUBLIC
     KubeObject
@@ -41,6 +127,14 @@ PUBLIC
     KubeInterpreter
 )
 
+# Add the formatter executable
+add_executable(${KubeFormatBinary} ${KubeInterpreterDir}/Format.cpp)
+
+target_link_libraries(${KubeFormatBinary}
+PUBLIC
+    KubeInterpreter
+)
+
 if(${KF_TESTS})
     include(${KubeInterpreterDir}/Tests/InterpreterTests.cmake)
 endif()
@@ -5,13 +5,20 @@
 
 #include <fstream>
 #include <filesystem>
-#include <iostream>
+
+#include <unistd.h>
 
 #include <Kube/Flow/Scheduler.hpp>
 
 #include "Interpreter.hpp"
 #include "Lexer.hpp"
 #include "Parser.hpp"
+#include "Optimizer.hpp"
+#include "NameResolver.hpp"
+#include "Compiler.hpp"
+#include "RegisterCompiler.hpp"
+#include "ClosureCompiler.hpp"
+#include "Formatter.hpp"
 
 using namespace kF;
 
@@ -49,16 +56,25 @@ namespace kF::Lang
     struct alignas_cacheline ParserWork
     {
         /** @brief Construct the parser worker instance */
-        ParserWork(Core::TinyString &&context_, const TokenStack *stack_, const FileIndex file_)
-            : context(std::move(context_)), stack(std::move(stack_)), file(file_) {}
+        ParserWork(Core::TinyString &&context_, const DirectoryManager *manager_, const FileIndex file_)
+            : context(std::move(context_)), manager(manager_), file(file_) {}
 
-        /** @brief Start parser */
+        /** @brief Start parser, then optimize, resolve and compile the resulting tree */
         void operator()(void)
         {
             try {
                 Parser parser;
-                node = parser.run(file, stack, context.toStdView());
-                imports = std::move(parser.imports());
+                // The stack is retreived at execution as the manager may reallocate it within notifications
+                tree = parser.run(file, &manager->fileStack(file), context.toStdView());
+                Optimizer().run(*tree);
+                NameResolver().run(*tree, context.toStdView());
+#if KUBE_INTERPRETER_CLOSURES
+                units = ClosureCompiler().run(*tree, context.toStdView());
+#elif KUBE_INTERPRETER_REGISTER_MACHINE
+                units = RegisterCompiler().run(*tree, context.toStdView());
+#else
+                units = Compiler().run(*tree, context.toStdView());
+#endif
             } catch (const std::exception &e) {
                 crash = true;
                 error = e.what();
@@ -66,10 +82,10 @@ namespace kF::Lang
         }
 
         Core::TinyString context;
-        Core::TinyVector<Core::TinyString> imports;
         Core::FlatString error;
-        const TokenStack *stack;
-        AST::Ptr node;
+        const DirectoryManager *manager;
+        SyntaxTree::Ptr tree;
+        Compiler::Units units;
         FileIndex file;
         bool crash = false;
     };
@@ -118,9 +134,22 @@ void Lang::Interpreter::preprocessFile(const std::string_view &path, const FileI
             throw std::logic_error(lexerWork->error.c_str());
 
         // On file lexed success
-        auto &fileStack = _directoryManager.fileStack(lexerWork->file) = std::move(lexerWork->stack);
+        _directoryManager.fileStack(lexerWork->file) = std::move(lexerWork->stack);
+
+        // Pre-scan imports and classes so dependencies are lexed concurrently with this file's parsing
+        ImportIndexes importIndexes;
+        Parser::ExtractImports(_directoryManager.fileStack(lexerWork->file), [this, &importIndexes](const std::string_view &import) {
+            importIndexes.push(_directoryManager.discoverDirectory(import));
+        });
+        // Discovering directories may have reallocated the file stack, it must be retreived again
+        Parser::ExtractClassNames(_directoryManager.fileStack(lexerWork->file),
+            [this, &importIndexes, fileDirectory = _directoryManager.fileDirectory(lexerWork->file)](const std::string_view &className) {
+                discoverClass(className, fileDirectory, importIndexes);
+            }
+        );
+
         auto &p = _toParser.push();
-        auto parserWork = new ParserWork(std::move(lexerWork->context), &fileStack, lexerWork->file);;
+        auto parserWork = new ParserWork(std::move(lexerWork->context), &_directoryManager, lexerWork->file);
 
         // Parser work node
         p.work.prepare<[](ParserWork *ptr) { delete ptr; }>(parserWork);
@@ -130,56 +159,44 @@ void Lang::Interpreter::preprocessFile(const std::string_view &path, const FileI
             if (parserWork->crash) [[unlikely]]
                 throw std::logic_error(parserWork->error.c_str());
 
+            // Add the parsed tree to the manager list
+            auto &tree = _directoryManager.fileTree(parserWork->file);
+            tree = std::move(parserWork->tree);
+            _directoryManager.fileUnits(parserWork->file) = std::move(parserWork->units);
 
-            // Add imports to directory manager
-            Core::TinySmallVector<DirectoryIndex, Core::CacheLineQuarterSize / sizeof(DirectoryIndex)> importIndexes;
-            importIndexes.reserve(parserWork->imports.size());
-            for (const auto &import : parserWork->imports) {
-                importIndexes.push(_directoryManager.discoverDirectory(import.toStdView()));
-            }
-
-            // Add the parsed node to the manager list
-            auto &node = _directoryManager.fileNode(parserWork->file);
-            node = std::move(parserWork->node);
-
-            // For each class within the file, check if it should be interpreted (using import scope)
-            node->traverse(
-                [this, &importIndexes, fileDirectory = _directoryManager.fileDirectory(parserWork->file)](const AST &node) {
-                    if (node.type() != TokenType::Class) [[likely]]
-                        return false;
-
-                    const auto className = node.literal();
-                    const auto directoryClassSearch = [this, &className](const auto dirIndex) {
-                        for (const auto file : _directoryManager.directoryFiles(dirIndex)) {
-                            if (_directoryManager.fileName(file) == className) [[unlikely]] {
-                                // Don't process the file if it already is or if it's planned for this run
-                                if (_directoryManager.fileStack(file).empty() && _lexingList.find(file) == _lexingList.end()) {
-                                    preprocessFile(_directoryManager.filePath(file).toStdView(), file);
-                                    return true;
-                                }
-                            }
-                        }
-                        return false;
-                    };
-
-                    // Search class in current directory
-                    if (!directoryClassSearch(fileDirectory)) {
-                        // Search class in all imported directories
-                        for (const auto dirIndex : importIndexes) {
-                            if (directoryClassSearch(dirIndex))
-                                break;
-                        }
-                    }
-                    return true;
-                }
-            );
-
-            std::cout << "'" << parserWork->context.c_str() << "':" << std::endl;
-            node->dump();
+            Formatter formatter(STDOUT_FILENO);
+            formatter.write('\'');
+            formatter.write(parserWork->context.toStdView());
+            formatter.write("':\n");
+            formatter.format(tree->root());
         });
     });
 }
 
+void Lang::Interpreter::discoverClass(const std::string_view &className, const DirectoryIndex fileDirectory, const ImportIndexes &importIndexes)
+{
+    const auto directoryClassSearch = [this, &className](const auto dirIndex) {
+        for (const auto file : _directoryManager.directoryFiles(dirIndex)) {
+            if (_directoryManager.fileName(file) == className) [[unlikely]] {
+                // Don't process the file if it already is or if it's planned for this run
+                if (_directoryManager.fileStack(file).empty() && _lexingList.find(file) == _lexingList.end())
+                    preprocessFile(_directoryManager.filePath(file).toStdView(), file);
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // Search class in current directory
+    if (!directoryClassSearch(fileDirectory)) {
+        // Search class in all imported directories
+        for (const auto dirIndex : importIndexes) {
+            if (directoryClassSearch(dirIndex))
+                break;
+        }
+    }
+}
+
 bool Lang::Interpreter::constructGraph(void)
 {
     _graph.clear();
@@ -7,6 +7,7 @@
 
 #include <Kube/Core/String.hpp>
 #include <Kube/Core/SmallString.hpp>
+#include <Kube/Core/SmallVector.hpp>
 #include <Kube/Flow/Graph.hpp>
 
 #include "DirectoryManager.hpp"
@@ -29,6 +30,9 @@ public:
         Flow::NotifyFunc notify {};
     };
 
+    /** @brief Directories imported by a file */
+    using ImportIndexes = Core::TinySmallVector<DirectoryIndex, Core::CacheLineQuarterSize / sizeof(DirectoryIndex)>;
+
     /** @brief Constructor */
     Interpreter(Flow::Scheduler * const scheduler);
 
@@ -54,6 +58,9 @@ private:
         { return preprocessFile(path, _directoryManager.discoverFile(path)); }
     void preprocessFile(const std::string_view &path, const FileIndex fileIndex);
 
+    /** @brief Search a class in current then imported directories and process its file if not already done */
+    void discoverClass(const std::string_view &className, const DirectoryIndex fileDirectory, const ImportIndexes &importIndexes);
+
     /** @brief Construct the next graph */
     [[nodiscard]] bool constructGraph(void);
 };
@@ -15,6 +15,7 @@ void Lang::Lexer::prepare(const FileIndex file, std::istream &istream, const std
     _token.file = file;
     _line = 1u;
     _column = 1u;
+    _commentCount = 0u;
     _context = context;
     istream.seekg(0u, std::ios::end);
     const std::size_t fileSize = istream.tellg();
@@ -32,6 +32,9 @@ public:
     [[nodiscard]] TokenStack run(const FileIndex file, std::istream &istream, const std::string_view &context)
         { prepare(file, istream, context); return TokenStack(std::move(_stack)); }
 
+    /** @brief Get the count of comments skipped by the last process, they are not part of the token stack */
+    [[nodiscard]] std::uint32_t commentCount(void) const noexcept { return _commentCount; }
+
 private:
     Core::AllocatedTinyVector<char, &TokenStack::Allocate, &TokenStack::Deallocate> _buffer {};
     TokenStack _stack {};
@@ -39,6 +42,7 @@ private:
     LineIndex _line { 0u };
     ColumnIndex _column { 0u };
     std::uint32_t _index { 0u };
+    std::uint32_t _commentCount { 0u };
     std::string_view _context {};
     Core::AllocatedSmallStringBase<char, Core::CacheLineSize - Core::CacheLineEighthSize - 2 * sizeof(std::uint16_t),
             &TokenStack::Allocate, &TokenStack::Deallocate, std::uint16_t> _cache {};
@@ -197,7 +197,6 @@ inline bool kF::Lang::Lexer::parseString(void) noexcept
             }
         } else [[unlikely]] {
             feedToken('"');
-            consume<false>();
             endToken();
             return true;
         }
@@ -259,6 +258,7 @@ inline bool kF::Lang::Lexer::parseCharacter(void) noexcept
 
 inline void kF::Lang::Lexer::skipComment(void) noexcept
 {
+    ++_commentCount;
     consumeNext();
     for (char current = peek(); current; current = peek()) [[likely]] {
         if (current != '\n') [[likely]]
@@ -272,6 +272,7 @@ inline void kF::Lang::Lexer::skipComment(void) noexcept
 
 inline bool kF::Lang::Lexer::skipMultilineComment(void) noexcept
 {
+    ++_commentCount;
     consumeNext();
     char current = peek();
     while (current) [[likely]] {
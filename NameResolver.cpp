@@ -0,0 +1,275 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: NameResolver
+ */
+
+#include <stdexcept>
+#include <string>
+
+#include "NameResolver.hpp"
+
+using namespace kF;
+
+void Lang::NameResolver::run(SyntaxTree &tree, const std::string_view &context)
+{
+    _context = context;
+    _scopes.clear();
+    _symbols.clear();
+    _classCount = 0u;
+    _maxFrameSize = 0u;
+    _position = 0u;
+    if (!tree.empty()) [[likely]]
+        resolveSubtree(tree.root());
+}
+
+void Lang::NameResolver::resolveSubtree(AST &node)
+{
+    node.traverse(
+        [this](AST &node) { return enter(node); },
+        [this](AST &node) { leave(node); }
+    );
+}
+
+bool Lang::NameResolver::enter(AST &node)
+{
+    ++_position;
+    switch (node.type()) {
+    case TokenType::Class:
+        openScope(ScopeType::Class);
+        declareMembers(node);
+        return true;
+    case TokenType::Function:
+        openScope(ScopeType::Frame);
+        declareParameters(*node.children()[0]);
+        return true;
+    case TokenType::Signal:
+        // Signal parameters are never referenced
+        openScope(ScopeType::Frame);
+        declareParameters(*node.children()[0]);
+        closeScope();
+        return false;
+    case TokenType::Property:
+    case TokenType::Event:
+    case TokenType::Assignment:
+        openScope(ScopeType::Frame);
+        return true;
+    case TokenType::ParameterList:
+        // Parameters are declared by their function
+        return false;
+    case TokenType::Expression:
+        openScope(ScopeType::Block);
+        return true;
+    case TokenType::Statement:
+        if (node.statementType() == StatementType::While || node.statementType() == StatementType::For)
+            _loops.push(_position);
+        return true;
+    case TokenType::Local:
+    {
+        // The initializer is resolved before the local is declared, but the local already lives while it is evaluated
+        const auto begin = _position;
+        const auto children = node.children();
+        ResolveByHash(*children[0], NameType::Type);
+        if (children.size() > 2u)
+            resolveSubtree(*children[2]);
+        declareLocal(*children[1], begin);
+        return false;
+    }
+    case TokenType::Operator:
+        if (node.operatorType() != OperatorType::Dot)
+            return true;
+        else {
+            // The right hand side of a dot is a member of the left hand side object, or a call of one of its methods
+            const auto children = node.children();
+            auto &rhs = *children[1];
+            resolveSubtree(*children[0]);
+            if (rhs.type() == TokenType::Name)
+                ResolveByHash(rhs, NameType::Member);
+            else if (rhs.type() == TokenType::Operator && rhs.operatorType() == OperatorType::Call && rhs.children()[0]->type() == TokenType::Name) {
+                ResolveByHash(*rhs.children()[0], NameType::Member);
+                for (auto *argument : rhs.children().subspan(1))
+                    resolveSubtree(*argument);
+            } else
+                resolveSubtree(rhs);
+            return false;
+        }
+    case TokenType::Name:
+        resolveName(node);
+        return false;
+    default:
+        return true;
+    }
+}
+
+void Lang::NameResolver::leave(AST &node)
+{
+    switch (node.type()) {
+    case TokenType::Class:
+    case TokenType::Function:
+    case TokenType::Property:
+    case TokenType::Event:
+    case TokenType::Assignment:
+    case TokenType::Expression:
+        closeScope();
+        break;
+    case TokenType::Statement:
+        if (node.statementType() == StatementType::While || node.statementType() == StatementType::For) {
+            // Locals declared before a loop and used in it live until its last iteration
+            const auto begin = _loops.back();
+            ++_position;
+            _loops.pop();
+            for (auto &local : _locals) {
+                if (local.begin < begin && local.end > begin)
+                    local.end = _position;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void Lang::NameResolver::openScope(const ScopeType type)
+{
+    if (type == ScopeType::Class)
+        ++_classCount;
+    else if (type == ScopeType::Frame) {
+        _locals.clear();
+        _localNames.clear();
+    }
+    _scopes.push(Scope {
+        type: type,
+        symbolBegin: _symbols.size(),
+        classIndex: _classCount - 1u
+    });
+}
+
+void Lang::NameResolver::closeScope(void)
+{
+    const auto &scope = _scopes.back();
+
+    if (scope.type == ScopeType::Class)
+        --_classCount;
+    else if (scope.type == ScopeType::Frame)
+        allocateLocals();
+    _symbols.erase(_symbols.begin() + scope.symbolBegin, _symbols.end());
+    _scopes.pop();
+}
+
+void Lang::NameResolver::declareMembers(const AST &classNode)
+{
+    const auto classIndex = _classCount - 1u;
+    std::uint32_t propertyCount = 0u, signalCount = 0u, functionCount = 0u;
+
+    for (const auto *child : classNode.children()) {
+        Symbol symbol {
+            name: child->literal(),
+            type: NameType::None,
+            index: 0u,
+            classIndex: classIndex
+        };
+        switch (child->type()) {
+        case TokenType::Property:
+            symbol.type = NameType::Property;
+            symbol.index = propertyCount++;
+            break;
+        case TokenType::Signal:
+            symbol.type = NameType::Signal;
+            symbol.index = signalCount++;
+            break;
+        case TokenType::Function:
+            symbol.type = NameType::Function;
+            symbol.index = functionCount++;
+            break;
+        default:
+            continue;
+        }
+        _symbols.push(symbol);
+    }
+}
+
+void Lang::NameResolver::declareParameters(AST &parameterList)
+{
+    std::uint32_t index = 0u;
+
+    for (auto *parameter : parameterList.children()) {
+        parameter->resolve(NameType::Parameter, AST::NameSlot { index: index, depth: 0u });
+        _symbols.push(Symbol {
+            name: parameter->literal(),
+            type: NameType::Parameter,
+            index: index++,
+            classIndex: _classCount - 1u
+        });
+    }
+}
+
+void Lang::NameResolver::declareLocal(AST &name, const std::uint32_t begin)
+{
+    const auto literal = name.literal();
+
+    for (auto i = _scopes.back().symbolBegin; i < _symbols.size(); ++i) {
+        if (_symbols[i].name == literal) [[unlikely]] {
+            const auto &token = *name.token();
+            throw std::logic_error("Lang::NameResolver::declareLocal: Local variable already declared in this block\nAt symbol '"
+                + std::string(literal) + "' from " + std::string(_context) + ":l" + std::to_string(token.line) + ":c" + std::to_string(token.column));
+        }
+    }
+    const auto index = static_cast<std::uint32_t>(_locals.size());
+    _locals.push(Local {
+        begin: begin,
+        end: _position
+    });
+    name.resolve(NameType::Local, AST::NameSlot { index: index, depth: 0u });
+    _localNames.push(&name);
+    _symbols.push(Symbol {
+        name: literal,
+        type: NameType::Local,
+        index: index,
+        classIndex: _classCount - 1u
+    });
+}
+
+void Lang::NameResolver::resolveName(AST &name)
+{
+    const auto literal = name.literal();
+
+    for (auto it = _symbols.end(); it != _symbols.begin();) {
+        const auto &symbol = *--it;
+        if (symbol.name != literal)
+            continue;
+        const auto isMember = symbol.type == NameType::Property || symbol.type == NameType::Signal || symbol.type == NameType::Function;
+        name.resolve(symbol.type, AST::NameSlot {
+            index: symbol.index,
+            depth: isMember ? _classCount - 1u - symbol.classIndex : 0u
+        });
+        if (symbol.type == NameType::Local) {
+            _locals[symbol.index].end = _position;
+            _localNames.push(&name);
+        }
+        return;
+    }
+    ResolveByHash(name, NameType::External);
+}
+
+void Lang::NameResolver::allocateLocals(void)
+{
+    Core::TinyVector<std::uint32_t> slots; // Local occupying each slot
+    Core::TinyVector<std::uint32_t> slotOfLocal;
+
+    // Locals are sorted by declaration, each one takes the first slot whose local died before it was declared
+    slotOfLocal.resize(_locals.size(), 0u);
+    for (std::uint32_t index = 0u; index < _locals.size(); ++index) {
+        std::uint32_t slot = 0u;
+        while (slot < slots.size() && _locals[slots[slot]].end >= _locals[index].begin)
+            ++slot;
+        if (slot == slots.size())
+            slots.push(index);
+        else
+            slots[slot] = index;
+        slotOfLocal[index] = slot;
+    }
+    for (auto *name : _localNames)
+        name->resolve(NameType::Local, AST::NameSlot { index: slotOfLocal[name->nameSlot().index], depth: 0u });
+    _maxFrameSize = std::max(_maxFrameSize, static_cast<std::uint32_t>(slots.size()));
+    _locals.clear();
+    _localNames.clear();
+}
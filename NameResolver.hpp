@@ -0,0 +1,111 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: NameResolver
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+
+#include "SyntaxTree.hpp"
+
+namespace kF::Lang
+{
+    class NameResolver;
+}
+
+/** @brief The NameResolver is a semantic pass binding every name of a syntax tree to a slot
+ *  Lookup order is: locals from the innermost block, parameters, then members of each enclosing class
+ *  Members accessed through the dot operator, types and unknown names are bound to their hash for runtime meta lookups
+ *  Local slots are allocated once their frame is resolved: each local lives from its declaration to its last use,
+ *  or to the end of the outermost loop using it which it is declared before, locals that never live together share a slot */
+class alignas_cacheline kF::Lang::NameResolver
+{
+public:
+    /** @brief Kind of a scope */
+    enum class ScopeType : std::uint32_t {
+        Class,
+        Frame,
+        Block
+    };
+
+    /** @brief A scope holding a range of symbols */
+    struct alignas_quarter_cacheline Scope
+    {
+        ScopeType type { ScopeType::Block };
+        std::uint32_t symbolBegin { 0u };
+        std::uint32_t classIndex { 0u };
+    };
+
+    /** @brief A declared name */
+    struct alignas_half_cacheline Symbol
+    {
+        std::string_view name {};
+        NameType type { NameType::None };
+        std::uint32_t index { 0u };
+        std::uint32_t classIndex { 0u };
+    };
+
+    /** @brief A local variable of the frame being resolved, positions are traversal counts */
+    struct alignas_eighth_cacheline Local
+    {
+        std::uint32_t begin { 0u }; // Position of the declaration, before its initializer
+        std::uint32_t end { 0u }; // Position of the last use
+    };
+
+
+    /** @brief Resolve every name of a syntax tree */
+    void run(SyntaxTree &tree, const std::string_view &context);
+
+    /** @brief Get the count of local slots required by the largest frame of the last run, after slot reuse */
+    [[nodiscard]] std::uint32_t maxFrameSize(void) const noexcept { return _maxFrameSize; }
+
+private:
+    // Cacheline 1
+    std::string_view _context {};
+    Core::TinyVector<Scope> _scopes {};
+    Core::TinyVector<Symbol> _symbols {};
+    std::uint32_t _classCount { 0u };
+    std::uint32_t _maxFrameSize { 0u };
+    std::uint32_t _position { 0u };
+    // Cacheline 2
+    Core::TinyVector<Local> _locals {}; // Locals of the current frame, by declaration
+    Core::TinyVector<AST *> _localNames {}; // Declarations and uses of the locals of the current frame
+    Core::TinyVector<std::uint32_t> _loops {}; // Position of each loop being resolved
+
+    /** @brief Resolve names of a subtree */
+    void resolveSubtree(AST &node);
+
+    /** @brief Called when entering a node, returns false if its children must be skipped */
+    [[nodiscard]] bool enter(AST &node);
+
+    /** @brief Called when leaving a node */
+    void leave(AST &node);
+
+    /** @brief Open a scope */
+    void openScope(const ScopeType type);
+
+    /** @brief Close the last opened scope */
+    void closeScope(void);
+
+    /** @brief Declare every member of a class */
+    void declareMembers(const AST &classNode);
+
+    /** @brief Declare every parameter of a parameter list */
+    void declareParameters(AST &parameterList);
+
+    /** @brief Declare a local variable in the current block, 'begin' is the position of its declaration */
+    void declareLocal(AST &name, const std::uint32_t begin);
+
+    /** @brief Resolve a name using the current scopes */
+    void resolveName(AST &name);
+
+    /** @brief Assign a slot to every local of the current frame, locals are bound to their index until then */
+    void allocateLocals(void);
+
+    /** @brief Bind a name to its hash */
+    static void ResolveByHash(AST &name, const NameType type) noexcept
+        { name.resolve(type, AST::NameSlot { index: Hash(name.literal()), depth: 0u }); }
+};
+
+static_assert_fit_double_cacheline(kF::Lang::NameResolver);
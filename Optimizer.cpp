@@ -0,0 +1,512 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Optimizer
+ */
+
+#include <charconv>
+#include <cmath>
+#include <limits>
+
+#include "Optimizer.hpp"
+
+using namespace kF;
+
+void Lang::Optimizer::run(SyntaxTree &tree)
+{
+    if (tree.empty()) [[unlikely]]
+        return;
+    _tree = &tree;
+    _pending.clear();
+    optimizeChildren(tree.root());
+
+    // Tokens are resolved once every literal is pushed as the stack may reallocate on each push
+    for (const auto &constants = tree.constants(); const auto &pending : _pending)
+        pending.node->setToken(constants.at(pending.byteIndex));
+    _pending.clear();
+    // Folded and pruned subtrees invalidate their ancestors hash
+    tree.updateHashes();
+    _tree = nullptr;
+}
+
+Lang::Optimizer::Value Lang::Optimizer::ParseConstant(const AST &node) noexcept
+{
+    Value value;
+
+    if (node.type() != TokenType::Constant || !node.token())
+        return value;
+    const auto literal = node.literal();
+    switch (node.constantType()) {
+    case ConstantType::Numeric:
+    {
+        const auto end = literal.data() + literal.size();
+        if (literal.find_first_of(".e") == std::string_view::npos) {
+            if (const auto res = std::from_chars(literal.data(), end, value.integer); res.ec == std::errc() && res.ptr == end)
+                value.kind = ValueKind::Integer;
+        } else if (const auto res = std::from_chars(literal.data(), end, value.floating); res.ec == std::errc() && res.ptr == end)
+            value.kind = ValueKind::Floating;
+        break;
+    }
+    case ConstantType::Literal:
+        value.kind = ValueKind::Literal;
+        value.literal = literal.substr(1, literal.size() - 2);
+        break;
+    case ConstantType::Boolean:
+        value.kind = ValueKind::Boolean;
+        value.boolean = literal == "true";
+        break;
+    default:
+        break;
+    }
+    return value;
+}
+
+Lang::Optimizer::Value Lang::Optimizer::optimize(AST *&node)
+{
+    switch (node->type()) {
+    case TokenType::Constant:
+        return ParseConstant(*node);
+    case TokenType::Operator:
+        return optimizeOperator(node);
+    case TokenType::Expression:
+        optimizeBlock(*node);
+        return Value();
+    default:
+        optimizeChildren(*node);
+        return Value();
+    }
+}
+
+void Lang::Optimizer::optimizeChildren(AST &node)
+{
+    for (auto &child : node.children())
+        optimizeChild(child);
+}
+
+void Lang::Optimizer::optimizeChild(AST *&child)
+{
+    if (const auto value = optimize(child); value)
+        materialize(child, value);
+}
+
+Lang::Optimizer::Value Lang::Optimizer::optimizeOperator(AST *&node)
+{
+    const auto type = node->operatorType();
+    const auto children = node->children();
+
+    if (type == OperatorType::TernaryIf)
+        return optimizeTernary(node);
+    else if (IsUnary(type)) {
+        if (type == OperatorType::Minus && children[0]->type() == TokenType::Operator
+                && children[0]->operatorType() == OperatorType::Minus) {
+            // Double negation
+            node = children[0]->children()[0];
+            return optimize(node);
+        }
+        const auto value = optimize(children[0]);
+        if (value) {
+            if (auto res = FoldUnary(type, value); res)
+                return res;
+            materialize(children[0], value);
+        }
+        return Value();
+    } else if (!IsBinary(type) || type == OperatorType::Dot || type == OperatorType::Coma
+            || (type >= OperatorType::Assign && type <= OperatorType::BitXorAssign)) {
+        optimizeChildren(*node);
+        return Value();
+    }
+
+    // Binary operator
+    const auto lhs = optimize(children[0]);
+
+    // Short-circuit evaluation is processed before touching the right hand side
+    if (lhs.kind == ValueKind::Boolean && ((type == OperatorType::And && !lhs.boolean) || (type == OperatorType::Or && lhs.boolean)))
+        return lhs;
+
+    const auto rhs = optimize(children[1]);
+    if (lhs && rhs) {
+        if (auto res = FoldBinary(type, lhs, rhs); res)
+            return res;
+    } else if (lhs && IsIdentity(type, lhs, false) && IsInteger(*children[1])) {
+        node = children[1];
+        return Value();
+    } else if (rhs && IsIdentity(type, rhs, true) && IsInteger(*children[0])) {
+        node = children[0];
+        return Value();
+    }
+    if (lhs)
+        materialize(children[0], lhs);
+    if (rhs)
+        materialize(children[1], rhs);
+    return Value();
+}
+
+Lang::Optimizer::Value Lang::Optimizer::optimizeTernary(AST *&node)
+{
+    const auto children = node->children();
+    const auto condition = optimize(children[0]);
+
+    // Children are the condition followed by both branches
+    if (condition.kind == ValueKind::Boolean) {
+        node = children[condition.boolean ? 1 : 2];
+        return optimize(node);
+    }
+    if (condition)
+        materialize(children[0], condition);
+    optimizeChild(children[1]);
+    optimizeChild(children[2]);
+    return Value();
+}
+
+void Lang::Optimizer::optimizeBlock(AST &block)
+{
+    for (AST::ChildIndex i = 0u; i < block.children().size();) {
+        auto &child = block.children()[i];
+        bool keep = true;
+        if (child->type() == TokenType::Statement) {
+            switch (child->statementType()) {
+            case StatementType::If:
+                keep = optimizeIf(child);
+                break;
+            case StatementType::While:
+                keep = optimizeWhile(child);
+                break;
+            default:
+                optimizeChildren(*child);
+                break;
+            }
+        } else
+            optimizeChild(child);
+        if (keep)
+            ++i;
+        else
+            block.eraseChildren(i, i + 1);
+    }
+}
+
+bool Lang::Optimizer::optimizeIf(AST *&node)
+{
+    AST::ChildIndex i = 0u;
+
+    // Children are stored as (condition, body) pairs followed by an optional else body
+    while (i + 1 < node->children().size()) {
+        const auto children = node->children();
+        const auto condition = optimize(children[i]);
+        if (condition.kind != ValueKind::Boolean) {
+            if (condition)
+                materialize(children[i], condition);
+            optimizeChild(children[i + 1]);
+            i += 2;
+        } else if (condition.boolean) {
+            // Every following branch is dead
+            if (!i) {
+                node = children[1];
+                optimizeChild(node);
+                return true;
+            }
+            children[i] = children[i + 1];
+            node->shrinkChildren(i + 1);
+            optimizeChild(children[i]);
+            return true;
+        } else
+            node->eraseChildren(i, i + 2);
+    }
+    if (i == node->children().size()) {
+        // Every branch was dead
+        return i != 0u;
+    } else if (!i) {
+        // Only the else branch is left
+        node = node->children()[0];
+        optimizeChild(node);
+        return true;
+    }
+    optimizeChild(node->children()[i]);
+    return true;
+}
+
+bool Lang::Optimizer::optimizeWhile(AST *&node)
+{
+    const auto children = node->children();
+    const auto condition = optimize(children[0]);
+
+    if (condition.kind == ValueKind::Boolean && !condition.boolean)
+        return false;
+    else if (condition)
+        materialize(children[0], condition);
+    optimizeChild(children[1]);
+    return true;
+}
+
+void Lang::Optimizer::materialize(AST *&node, const Value &value)
+{
+    // Constant leaves already own a valid token
+    if (node->type() == TokenType::Constant && node->children().empty())
+        return;
+
+    char buffer[32];
+    std::string_view literal;
+    ConstantType constantType;
+    std::string cache;
+
+    switch (value.kind) {
+    case ValueKind::Integer:
+        literal = std::string_view(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value.integer).ptr);
+        constantType = ConstantType::Numeric;
+        break;
+    case ValueKind::Floating:
+    {
+        auto end = std::to_chars(buffer, buffer + sizeof(buffer) - 2, value.floating).ptr;
+        // Ensure the literal is still recognized as a floating point number
+        if (std::string_view(buffer, end).find_first_of(".e") == std::string_view::npos) {
+            *end++ = '.';
+            *end++ = '0';
+        }
+        literal = std::string_view(buffer, end);
+        constantType = ConstantType::Numeric;
+        break;
+    }
+    case ValueKind::Boolean:
+        literal = value.boolean ? "true" : "false";
+        constantType = ConstantType::Boolean;
+        break;
+    case ValueKind::Literal:
+        cache.reserve(value.literal.size() + 2);
+        cache += '"';
+        cache += value.literal;
+        cache += '"';
+        literal = cache;
+        constantType = ConstantType::Literal;
+        break;
+    default:
+        return;
+    }
+
+    const auto &origin = *node->token();
+    auto &constants = _tree->constants();
+    const auto byteIndex = constants.byteSize();
+    constants.push(Token {
+        file: origin.file,
+        line: origin.line,
+        column: origin.column,
+        length: static_cast<std::uint16_t>(literal.size())
+    }, literal.data());
+    node = &_tree->make(nullptr, TokenType::Constant, constantType);
+    _pending.push(PendingConstant {
+        node: node,
+        byteIndex: byteIndex
+    });
+}
+
+Lang::Optimizer::Value Lang::Optimizer::FoldUnary(const OperatorType type, const Value &value) noexcept
+{
+    Value res;
+
+    switch (type) {
+    case OperatorType::Not:
+        if (value.kind == ValueKind::Boolean) {
+            res.kind = ValueKind::Boolean;
+            res.boolean = !value.boolean;
+        }
+        break;
+    case OperatorType::Minus:
+        if (value.kind == ValueKind::Integer && value.integer != std::numeric_limits<std::int64_t>::min()) {
+            res.kind = ValueKind::Integer;
+            res.integer = -value.integer;
+        } else if (value.kind == ValueKind::Floating) {
+            res.kind = ValueKind::Floating;
+            res.floating = -value.floating;
+        }
+        break;
+    case OperatorType::BitReverse:
+        if (value.kind == ValueKind::Integer) {
+            res.kind = ValueKind::Integer;
+            res.integer = ~value.integer;
+        }
+        break;
+    default:
+        break;
+    }
+    return res;
+}
+
+Lang::Optimizer::Value Lang::Optimizer::FoldBinary(const OperatorType type, const Value &lhs, const Value &rhs) noexcept
+{
+    Value res;
+
+    // Integer arithmetic, overflows are never folded
+    if (lhs.kind == ValueKind::Integer && rhs.kind == ValueKind::Integer) {
+        bool overflow = false;
+        res.kind = ValueKind::Integer;
+        switch (type) {
+        case OperatorType::Addition:
+            overflow = __builtin_add_overflow(lhs.integer, rhs.integer, &res.integer);
+            break;
+        case OperatorType::Substraction:
+            overflow = __builtin_sub_overflow(lhs.integer, rhs.integer, &res.integer);
+            break;
+        case OperatorType::Multiplication:
+            overflow = __builtin_mul_overflow(lhs.integer, rhs.integer, &res.integer);
+            break;
+        case OperatorType::Division:
+        case OperatorType::Modulo:
+            overflow = !rhs.integer || (rhs.integer == -1 && lhs.integer == std::numeric_limits<std::int64_t>::min());
+            if (!overflow)
+                res.integer = type == OperatorType::Division ? lhs.integer / rhs.integer : lhs.integer % rhs.integer;
+            break;
+        case OperatorType::BitAnd:
+            res.integer = lhs.integer & rhs.integer;
+            break;
+        case OperatorType::BitOr:
+            res.integer = lhs.integer | rhs.integer;
+            break;
+        case OperatorType::BitXor:
+            res.integer = lhs.integer ^ rhs.integer;
+            break;
+        default:
+            res.kind = ValueKind::None;
+            break;
+        }
+        if (overflow)
+            return Value();
+        else if (res)
+            return res;
+    }
+
+    // Floating point arithmetic
+    if (lhs.isNumeric() && rhs.isNumeric()) {
+        const auto left = lhs.asFloating();
+        const auto right = rhs.asFloating();
+        res.kind = ValueKind::Floating;
+        switch (type) {
+        case OperatorType::Addition:
+            res.floating = left + right;
+            break;
+        case OperatorType::Substraction:
+            res.floating = left - right;
+            break;
+        case OperatorType::Multiplication:
+            res.floating = left * right;
+            break;
+        case OperatorType::Division:
+            res.floating = left / right;
+            break;
+        case OperatorType::Modulo:
+            res.floating = std::fmod(left, right);
+            break;
+        default:
+            res.kind = ValueKind::Boolean;
+            switch (type) {
+            case OperatorType::Equal:
+                res.boolean = left == right;
+                break;
+            case OperatorType::Different:
+                res.boolean = left != right;
+                break;
+            case OperatorType::Greater:
+                res.boolean = left > right;
+                break;
+            case OperatorType::GreaterEqual:
+                res.boolean = left >= right;
+                break;
+            case OperatorType::Lighter:
+                res.boolean = left < right;
+                break;
+            case OperatorType::LighterEqual:
+                res.boolean = left <= right;
+                break;
+            default:
+                return Value();
+            }
+            return res;
+        }
+        if (!std::isfinite(res.floating))
+            return Value();
+        return res;
+    }
+
+    // Boolean logic
+    if (lhs.kind == ValueKind::Boolean && rhs.kind == ValueKind::Boolean) {
+        res.kind = ValueKind::Boolean;
+        switch (type) {
+        case OperatorType::And:
+            res.boolean = lhs.boolean && rhs.boolean;
+            break;
+        case OperatorType::Or:
+            res.boolean = lhs.boolean || rhs.boolean;
+            break;
+        case OperatorType::Equal:
+            res.boolean = lhs.boolean == rhs.boolean;
+            break;
+        case OperatorType::Different:
+            res.boolean = lhs.boolean != rhs.boolean;
+            break;
+        default:
+            return Value();
+        }
+        return res;
+    }
+
+    // String literals
+    if (lhs.kind == ValueKind::Literal && rhs.kind == ValueKind::Literal) {
+        switch (type) {
+        case OperatorType::Addition:
+            res.kind = ValueKind::Literal;
+            res.literal.reserve(lhs.literal.size() + rhs.literal.size());
+            res.literal += lhs.literal;
+            res.literal += rhs.literal;
+            // Tokens cannot hold more than 16 bits of length
+            if (res.literal.size() + 2 > std::numeric_limits<std::uint16_t>::max())
+                return Value();
+            break;
+        case OperatorType::Equal:
+            res.kind = ValueKind::Boolean;
+            res.boolean = lhs.literal == rhs.literal;
+            break;
+        case OperatorType::Different:
+            res.kind = ValueKind::Boolean;
+            res.boolean = lhs.literal != rhs.literal;
+            break;
+        default:
+            break;
+        }
+    }
+    return res;
+}
+
+bool Lang::Optimizer::IsIdentity(const OperatorType type, const Value &value, const bool isRightHandSide) noexcept
+{
+    // A floating identity would still turn an integer operand into a floating result
+    if (value.kind != ValueKind::Integer)
+        return false;
+    switch (type) {
+    case OperatorType::Addition:
+        return value.integer == 0;
+    case OperatorType::Substraction:
+        return isRightHandSide && value.integer == 0;
+    case OperatorType::Multiplication:
+        return value.integer == 1;
+    case OperatorType::Division:
+        return isRightHandSide && value.integer == 1;
+    default:
+        return false;
+    }
+}
+
+bool Lang::Optimizer::IsInteger(const AST &node) noexcept
+{
+    if (node.type() != TokenType::Operator)
+        return ParseConstant(node).kind == ValueKind::Integer;
+    const auto children = node.children();
+    switch (node.operatorType()) {
+    case OperatorType::Minus:
+        return IsInteger(*children[0]);
+    case OperatorType::Addition:
+    case OperatorType::Substraction:
+    case OperatorType::Multiplication:
+        return IsInteger(*children[0]) && IsInteger(*children[1]);
+    case OperatorType::TernaryIf:
+        // The condition may hold any type, only both branches matter
+        return IsInteger(*children[1]) && IsInteger(*children[2]);
+    default:
+        return false;
+    }
+}
@@ -0,0 +1,116 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Optimizer
+ */
+
+#pragma once
+
+#include <string>
+
+#include <Kube/Core/Vector.hpp>
+
+#include "SyntaxTree.hpp"
+
+namespace kF::Lang
+{
+    class Optimizer;
+}
+
+/** @brief The Optimizer is a processing class that simplifies an AST at load time
+ *  It folds constant subtrees, removes arithmetic identities and prunes dead 'if' branches
+ *  Folded constants are allocated in the tree and get their token from the tree's constant stack */
+class alignas_cacheline kF::Lang::Optimizer
+{
+public:
+    /** @brief Kind of a constant value */
+    enum class ValueKind : std::uint32_t {
+        None,
+        Integer,
+        Floating,
+        Boolean,
+        Literal
+    };
+
+    /** @brief Value of a constant subtree */
+    struct Value
+    {
+        ValueKind kind { ValueKind::None };
+        union {
+            std::int64_t integer { 0 };
+            double floating;
+            bool boolean;
+        };
+        std::string literal {};
+
+        /** @brief Check if the value is constant */
+        [[nodiscard]] explicit operator bool(void) const noexcept { return kind != ValueKind::None; }
+
+        /** @brief Check if the value is numeric */
+        [[nodiscard]] bool isNumeric(void) const noexcept
+            { return kind == ValueKind::Integer || kind == ValueKind::Floating; }
+
+        /** @brief Get the numeric value as floating point (unsafe if value is not numeric) */
+        [[nodiscard]] double asFloating(void) const noexcept
+            { return kind == ValueKind::Integer ? static_cast<double>(integer) : floating; }
+    };
+
+    /** @brief A folded node waiting for its token to be materialized */
+    struct alignas_quarter_cacheline PendingConstant
+    {
+        AST *node { nullptr };
+        std::size_t byteIndex { 0u };
+    };
+
+    /** @brief Optimize a syntax tree in place */
+    void run(SyntaxTree &tree);
+
+    /** @brief Parse the value of a constant node, returns an invalid value if the node is not constant */
+    [[nodiscard]] static Value ParseConstant(const AST &node) noexcept;
+
+private:
+    SyntaxTree *_tree { nullptr };
+    Core::TinyVector<PendingConstant> _pending {};
+
+    /** @brief Optimize a node, returns its value if the whole subtree is constant
+     *  A constant subtree is never materialized here, it's up to the caller to keep or fold it further */
+    [[nodiscard]] Value optimize(AST *&node);
+
+    /** @brief Optimize each child of a node and materialize constant ones */
+    void optimizeChildren(AST &node);
+
+    /** @brief Optimize a child of a node and materialize it if it is constant */
+    void optimizeChild(AST *&child);
+
+    /** @brief Optimize an operator node */
+    [[nodiscard]] Value optimizeOperator(AST *&node);
+
+    /** @brief Optimize a ternary operator node */
+    [[nodiscard]] Value optimizeTernary(AST *&node);
+
+    /** @brief Optimize a list of statements */
+    void optimizeBlock(AST &block);
+
+    /** @brief Optimize an if statement, returns false if the whole statement must be removed */
+    [[nodiscard]] bool optimizeIf(AST *&node);
+
+    /** @brief Optimize a while statement, returns false if the whole statement must be removed */
+    [[nodiscard]] bool optimizeWhile(AST *&node);
+
+    /** @brief Replace a folded subtree by a single constant node */
+    void materialize(AST *&node, const Value &value);
+
+
+    /** @brief Fold an unary operator */
+    [[nodiscard]] static Value FoldUnary(const OperatorType type, const Value &value) noexcept;
+
+    /** @brief Fold a binary operator */
+    [[nodiscard]] static Value FoldBinary(const OperatorType type, const Value &lhs, const Value &rhs) noexcept;
+
+    /** @brief Check if a value is an integer identity of a binary operator */
+    [[nodiscard]] static bool IsIdentity(const OperatorType type, const Value &value, const bool isRightHandSide) noexcept;
+
+    /** @brief Check if a subtree always evaluates to an integer, names and calls may hold any type at runtime */
+    [[nodiscard]] static bool IsInteger(const AST &node) noexcept;
+};
+
+static_assert_fit_cacheline(kF::Lang::Optimizer);
@@ -0,0 +1,40 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Parallel AST traversal
+ */
+
+#include "ParallelTraversal.hpp"
+
+using namespace kF;
+
+void Lang::ParallelTraversal::computeSizes(const AST &root)
+{
+    _sizes.clear();
+    _openIndexes.clear();
+    root.traverse(
+        [this](const AST &) {
+            _openIndexes.push(_sizes.size());
+            _sizes.push(0u);
+            return true;
+        },
+        [this](const AST &) {
+            const auto index = _openIndexes.back();
+            _openIndexes.pop();
+            _sizes[index] = _sizes.size() - index;
+        }
+    );
+}
+
+void Lang::ParallelTraversal::addTaskRoot(const AST &node, const std::uint32_t size)
+{
+    if (_chunks.empty() || _packedSize >= _threshold) {
+        _chunks.push(Chunk {
+            begin: _roots.size(),
+            end: _roots.size()
+        });
+        _packedSize = 0u;
+    }
+    _roots.push(&node);
+    ++_chunks.back().end;
+    _packedSize += size;
+}
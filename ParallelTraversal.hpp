@@ -0,0 +1,81 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Parallel AST traversal
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+#include <Kube/Flow/Scheduler.hpp>
+
+#include "AST.hpp"
+
+namespace kF::Lang
+{
+    class ParallelTraversal;
+}
+
+/** @brief The ParallelTraversal splits an AST into subtrees traversed concurrently by Flow tasks
+ *  Subtrees smaller than the threshold are packed together into tasks while bigger nodes are visited by the calling thread
+ *  Each task accumulates into its own result, results are then reduced on the calling thread in a deterministic order */
+class alignas_cacheline kF::Lang::ParallelTraversal
+{
+public:
+    /** @brief Default count of nodes a task should traverse */
+    static constexpr std::uint32_t DefaultThreshold = 4096u;
+
+    /** @brief A range of task roots */
+    struct alignas_eighth_cacheline Chunk
+    {
+        std::uint32_t begin { 0u };
+        std::uint32_t end { 0u };
+    };
+
+
+    /** @brief Constructor */
+    ParallelTraversal(Flow::Scheduler * const scheduler, const std::uint32_t threshold = DefaultThreshold) noexcept
+        : _scheduler(scheduler), _threshold(threshold ? threshold : 1u) {}
+
+    /** @brief Destructor */
+    ~ParallelTraversal(void) noexcept = default;
+
+
+    /** @brief Get the count of nodes a task should traverse */
+    [[nodiscard]] std::uint32_t threshold(void) const noexcept { return _threshold; }
+
+    /** @brief Get the count of tasks used by the last traversal */
+    [[nodiscard]] std::uint32_t taskCount(void) const noexcept { return _chunks.size(); }
+
+
+    /** @brief Traverse a tree in pre-order across multiple threads
+     *  There is no ordering guarantee between nodes of different tasks, the visitor must be thread safe
+     *  @tparam Result must be default constructible, the calling thread and each task own a separate instance
+     *  @tparam Visitor must take a constant reference to AST and a reference to Result then return a boolean, false skips the node's children
+     *  @tparam Reducer must take a reference to the calling thread result and a rvalue of a task result */
+    template<typename Result, typename Visitor, typename Reducer>
+    [[nodiscard]] Result run(const AST &root, Visitor &&visitor, Reducer &&reducer);
+
+private:
+    // Cacheline 1
+    Flow::Scheduler *_scheduler { nullptr };
+    Core::TinyVector<std::uint32_t> _sizes {};
+    Core::TinyVector<std::uint32_t> _openIndexes {};
+    Core::TinyVector<const AST *> _roots {};
+    std::uint32_t _threshold { DefaultThreshold };
+    std::uint32_t _packedSize { 0u };
+    // Cacheline 2
+    Core::TinyVector<Chunk> _chunks {};
+    Flow::Graph _graph {};
+
+    /** @brief Compute the size of each subtree in pre-order */
+    void computeSizes(const AST &root);
+
+    /** @brief Add a subtree to the task roots, packing small subtrees together */
+    void addTaskRoot(const AST &node, const std::uint32_t size);
+
+    /** @brief Traverse every subtree of a chunk sequentially */
+    template<typename Result, typename Visitor>
+    void traverseChunk(const Chunk chunk, Visitor &visitor, Result &result) const;
+};
+
+#include "ParallelTraversal.ipp"
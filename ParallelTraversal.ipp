@@ -0,0 +1,69 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Parallel AST traversal
+ */
+
+template<typename Result, typename Visitor, typename Reducer>
+inline Result kF::Lang::ParallelTraversal::run(const AST &root, Visitor &&visitor, Reducer &&reducer)
+{
+    Result result {};
+    std::uint32_t index = 0u;
+
+    computeSizes(root);
+    _roots.clear();
+    _chunks.clear();
+    _packedSize = 0u;
+
+    // Nodes bigger than the threshold are visited by the calling thread while their children are split into tasks
+    root.traverse([this, &visitor, &result, &index](const AST &node) {
+        const auto size = _sizes[index];
+        if (size <= _threshold) {
+            addTaskRoot(node, size);
+            index += size;
+            return false;
+        } else if (!visitor(node, result)) {
+            index += size;
+            return false;
+        }
+        ++index;
+        return true;
+    });
+
+    if (_chunks.empty()) [[unlikely]]
+        return result;
+    else if (_chunks.size() == 1u) {
+        // A single task is not worth scheduling
+        Result partial {};
+        traverseChunk(_chunks[0], visitor, partial);
+        reducer(result, std::move(partial));
+        return result;
+    }
+
+    Core::TinyVector<Result> partials;
+    partials.resize(_chunks.size());
+    _graph.clear();
+    for (auto i = 0u; i < _chunks.size(); ++i) {
+        Flow::StaticFunc work;
+        work.prepare([this, &visitor, partial = &partials[i], chunk = _chunks[i]] {
+            traverseChunk(chunk, visitor, *partial);
+        });
+        _graph.emplace(std::move(work));
+    }
+    _scheduler->schedule(_graph);
+    _graph.wait();
+
+    // Results are reduced in pre-order of their chunk, whatever the order tasks were executed in
+    for (auto &partial : partials)
+        reducer(result, std::move(partial));
+    return result;
+}
+
+template<typename Result, typename Visitor>
+inline void kF::Lang::ParallelTraversal::traverseChunk(const Chunk chunk, Visitor &visitor, Result &result) const
+{
+    for (auto i = chunk.begin; i != chunk.end; ++i) {
+        _roots[i]->traverse([&visitor, &result](const AST &node) {
+            return visitor(node, result);
+        });
+    }
+}
@@ -12,8 +12,9 @@ void Lang::Parser::prepare(const FileIndex file, const TokenStack *stack, const
     _stack = stack;
     _it = _stack->begin();
     _end = _stack->end();
-    _processStack.clear();
-    _root.reset();
+    _childStack.clear();
+    _openStack.clear();
+    _tree = SyntaxTree::Make();
     _imports.clear();
     _context = context;
     _file = file;
@@ -31,15 +32,16 @@ void Lang::Parser::process(void)
         else
             throw std::logic_error("Lang::Parser::process: Unexpected token at global scope\n" + getTokenError(_it));
     }
-    if (!_root)
+    if (_childStack.empty())
         throw std::logic_error("Lang::Parser::process: No class declaration in file '" + std::string(_context) + '\'');
+    _tree->setRoot(*_childStack.front());
 }
 
 void Lang::Parser::processImport(void)
 {
     const auto rootIt = _it;
 
-    if (_root)
+    if (!_childStack.empty())
         throw std::logic_error("Lang::Parser::processImport: Invalid import statement after class declaration");
     else if (++_it == _end) [[unlikely]]
         throw std::logic_error("Lang::Parser::processImport: Unexpected end of file in import declaration\n" + getTokenError(rootIt));
@@ -63,7 +65,9 @@ void Lang::Parser::processClass(void)
         throw std::logic_error(UnexpectedToken + getTokenError(_it));
     else if (++_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
-    insertNode<TokenType::Class>(rootIt);
+    else if (_openStack.empty() && !_childStack.empty()) [[unlikely]]
+        throw std::logic_error("Lang::Parser::processClass: Only one root class can be declared per file\n" + getTokenError(rootIt));
+    openNode<TokenType::Class>(rootIt);
     while (_it != _end) {
         const auto literal = _it.literal();
         if (literal == "function")
@@ -87,7 +91,7 @@ void Lang::Parser::processClass(void)
                 throw std::logic_error(UnexpectedToken + getTokenError(next));
         } else if (literal == "}") [[unlikely]] {
             ++_it;
-            _processStack.pop();
+            closeNode();
             return;
         } else
             throw std::logic_error(UnexpectedToken + getTokenError(_it));
@@ -104,7 +108,7 @@ void Lang::Parser::processFunction(void)
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
     const auto nameIt = _it;
     const auto nameLiteral = nameIt.literal();
-    auto &rootNode = insertNode<TokenType::Function>(nameIt);
+    openNode<TokenType::Function>(nameIt);
 
     if (!IsName(nameLiteral)) [[unlikely]]
         throw std::logic_error("Lang::Parser::processFunction: Invalid function name\n" + getTokenError(nameIt));
@@ -112,12 +116,13 @@ void Lang::Parser::processFunction(void)
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(nameIt));
     else if (_it.literal() != "(") [[unlikely]]
         throw std::logic_error(UnexpectedToken + getTokenError(nameIt));
-    processParameterList(rootNode);
+    processParameterList();
     if (_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(nameIt));
     else if (_it.literal() != "{") [[unlikely]]
         throw std::logic_error(UnexpectedToken + getTokenError(nameIt));
-    processExpression(rootNode, "}");
+    processExpression("}");
+    closeNode();
 }
 
 void Lang::Parser::processSignal(void)
@@ -129,7 +134,7 @@ void Lang::Parser::processSignal(void)
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
     const auto nameIt = _it;
     const auto nameLiteral = nameIt.literal();
-    auto &rootNode = insertNode<TokenType::Signal>(nameIt);
+    openNode<TokenType::Signal>(nameIt);
 
     if (!IsName(nameLiteral)) [[unlikely]]
         throw std::logic_error("Lang::Parser::processSignal: Invalid signal name\n" + getTokenError(nameIt));
@@ -137,12 +142,13 @@ void Lang::Parser::processSignal(void)
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(nameIt));
     else if (_it.literal() != "(") [[unlikely]]
         throw std::logic_error(UnexpectedToken + getTokenError(nameIt));
-    processParameterList(rootNode);
+    processParameterList();
     if (_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(nameIt));
     else if (_it.literal() != ";") [[unlikely]]
         throw std::logic_error("Lang::Parser::processSignal: Signal declaration must end with a ';'" + getTokenError(nameIt));
     ++_it;
+    closeNode();
 }
 
 void Lang::Parser::processProperty(void)
@@ -164,11 +170,12 @@ void Lang::Parser::processProperty(void)
         throw std::logic_error(UnexpectedToken + getTokenError(nameIt));
     else if (++_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(nameIt));
-    auto &rootNode = insertNode<TokenType::Property>(nameIt);
+    openNode<TokenType::Property>(nameIt);
     if (_it.literal() == "{")
-        processExpression(rootNode, "}");
+        processExpression("}");
     else
-        processSingleLineExpression(rootNode);
+        processSingleLineExpression();
+    closeNode();
 }
 
 void Lang::Parser::processEvent(void)
@@ -177,25 +184,26 @@ void Lang::Parser::processEvent(void)
     static const char *UnexpectedToken = "Lang::Parser::processEvent: Unexpected token in event declaration\n";
 
     const auto rootIt = _it;
-    auto &rootNode = insertNode<TokenType::Event>(rootIt);
+    openNode<TokenType::Event>(rootIt);
 
     if (++_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
     if (const auto literal = _it.literal(); literal == "{") {
-        processExpression(rootNode, "}");
+        processExpression("}");
         if (_it == _end)
             throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
         else if (_it.literal() != ":")
             throw std::logic_error(UnexpectedToken + getTokenError(rootIt));
         ++_it;
     } else
-        processOperation(rootNode, ":");
+        processOperation(":");
     if (_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
     if (_it.literal() == "{")
-        processExpression(rootNode, "}");
+        processExpression("}");
     else
-        processSingleLineExpression(rootNode);
+        processSingleLineExpression();
+    closeNode();
 }
 
 void Lang::Parser::processAssignment(void)
@@ -211,20 +219,21 @@ void Lang::Parser::processAssignment(void)
         throw std::logic_error(UnexpectedToken + getTokenError(_it));
     else if (++_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
-    auto &rootNode = insertNode<TokenType::Assignment>(rootIt);
+    openNode<TokenType::Assignment>(rootIt);
     if (_it.literal() == "{")
-        processExpression(rootNode, "}");
+        processExpression("}");
     else
-        processSingleLineExpression(rootNode);
+        processSingleLineExpression();
+    closeNode();
 }
 
-void Lang::Parser::processParameterList(AST &parent)
+void Lang::Parser::processParameterList(void)
 {
     static const char *UnexpectedEndOfFile = "Lang::Parser::processParameterList: Unexpected end of file in parameter list\n";
     static const char *UnexpectedToken = "Lang::Parser::processParameterList: Unexpected token in parameter list\n";
 
     const auto rootIt = _it;
-    auto &rootNode = insertNode<TokenType::ParameterList>(parent, rootIt);
+    openNode<TokenType::ParameterList>(rootIt);
 
     if (++_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
@@ -232,9 +241,10 @@ void Lang::Parser::processParameterList(AST &parent)
         const auto literal = _it.literal();
         if (literal == ")") [[unlikely]] {
             ++_it;
+            closeNode();
             return;
         } else if (IsName(literal)) [[likely]] {
-            insertNode<TokenType::Name>(rootNode, _it);
+            insertNode<TokenType::Name>(_it);
             if (++_it == _end) [[unlikely]]
                 throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
             if (auto nextLiteral = _it.literal(); nextLiteral == ",") {
@@ -247,12 +257,12 @@ void Lang::Parser::processParameterList(AST &parent)
     throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
 }
 
-void Lang::Parser::processExpression(AST &parent, const std::string_view &terminate)
+void Lang::Parser::processExpression(const std::string_view &terminate)
 {
     static const char *UnexpectedEndOfFile = "Lang::Parser::processExpression: Unexpected end of file in expression\n";
 
     const auto rootIt = _it;
-    auto &rootNode = insertNode<TokenType::Expression>(parent, rootIt);
+    openNode<TokenType::Expression>(rootIt);
 
     if (++_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
@@ -260,60 +270,62 @@ void Lang::Parser::processExpression(AST &parent, const std::string_view &termin
         const auto literal = _it.literal();
         if (literal == terminate) [[unlikely]] {
             ++_it;
+            closeNode();
             return;
         }
-        processExpressionToken(rootNode, literal);
+        processExpressionToken(literal);
     }
     throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
 }
 
-void Lang::Parser::processSingleLineExpression(AST &parent)
+void Lang::Parser::processSingleLineExpression(void)
 {
     const auto rootIt = _it;
-    auto &rootNode = insertNode<TokenType::Expression>(parent, rootIt);
+    openNode<TokenType::Expression>(rootIt);
     const auto literal = _it.literal();
 
-    processExpressionToken(rootNode, literal);
+    processExpressionToken(literal);
+    closeNode();
 }
 
-void Lang::Parser::processExpressionToken(AST &parent, const std::string_view &literal)
+void Lang::Parser::processExpressionToken(const std::string_view &literal)
 {
     if (literal == "if")
-        processIf(parent);
+        processIf();
     else if (literal == "while")
-        processWhile(parent);
+        processWhile();
     else if (literal == "for")
-        processFor(parent);
+        processFor();
     else if (literal == "switch")
-        processSwitch(parent);
+        processSwitch();
     else if (literal == "return")
-        processReturn(parent);
+        processReturn();
     else if (literal == "break")
-        processBreak(parent);
+        processBreak();
     else if (literal == "continue")
-        processContinue(parent);
+        processContinue();
     else if (literal == "{")
-        processExpression(parent, "}");
+        processExpression("}");
     else if (literal == "[")
-        processList(parent);
+        processList();
     else if (IsName(literal)) {
         if (auto next = _it; ++next != _end && IsName(next.literal()))
-            processLocal(parent);
+            processLocal();
         else
-            processOperation(parent, ";");
+            processOperation(";");
     } else
-        processOperation(parent, ";");
+        processOperation(";");
 }
 
-void kF::Lang::Parser::processIf(AST &parent)
+void kF::Lang::Parser::processIf(void)
 {
     static const char *UnexpectedEndOfFile = "Lang::Parser::processIf: Unexpected end of file in if statement\n";
     static const char *UnexpectedToken = "Lang::Parser::processIf: Unexpected token in if statement\n";
 
     const auto rootIt = _it;
-    auto &rootNode = insertNode<TokenType::Statement, StatementType::If>(parent, rootIt);
+    openNode<TokenType::Statement, StatementType::If>(rootIt);
 
-    const auto parseIf = [this, &rootNode] {
+    const auto parseIf = [this] {
         const auto rootIt = _it;
         if (++_it == _end) [[unlikely]]
             throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
@@ -321,13 +333,13 @@ void kF::Lang::Parser::processIf(AST &parent)
             throw std::logic_error(UnexpectedToken + getTokenError(rootIt));
         else if (++_it == _end) [[unlikely]]
             throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
-        processOperation(rootNode, ")");
+        processOperation(")");
         if (_it == _end) [[unlikely]]
             throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
         else if (_it.literal() == "{")
-            processExpression(rootNode, "}");
+            processExpression("}");
         else
-            processSingleLineExpression(rootNode);
+            processSingleLineExpression();
     };
 
     parseIf();
@@ -338,22 +350,24 @@ void kF::Lang::Parser::processIf(AST &parent)
             else if (const auto literal = _it.literal(); literal == "if")
                 parseIf();
             else if (literal == "{") {
-                processExpression(rootNode, "}");
+                processExpression("}");
             } else
-                processSingleLineExpression(rootNode);
-        } else
+                processSingleLineExpression();
+        } else {
+            closeNode();
             return;
+        }
     }
     throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
 }
 
-void kF::Lang::Parser::processWhile(AST &parent)
+void kF::Lang::Parser::processWhile(void)
 {
     static const char *UnexpectedEndOfFile = "Lang::Parser::processWhile: Unexpected end of file in while statement\n";
     static const char *UnexpectedToken = "Lang::Parser::processWhile: Unexpected token in while statement\n";
 
     const auto rootIt = _it;
-    auto &rootNode = insertNode<TokenType::Statement, StatementType::While>(parent, rootIt);
+    openNode<TokenType::Statement, StatementType::While>(rootIt);
 
     if (++_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
@@ -361,22 +375,23 @@ void kF::Lang::Parser::processWhile(AST &parent)
         throw std::logic_error(UnexpectedToken + getTokenError(rootIt));
     else if (++_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
-    processOperation(rootNode, ")");
+    processOperation(")");
     if (_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
     else if (_it.literal() == "{")
-        processExpression(rootNode, "}");
+        processExpression("}");
     else
-        processSingleLineExpression(rootNode);
+        processSingleLineExpression();
+    closeNode();
 }
 
-void kF::Lang::Parser::processFor(AST &parent)
+void kF::Lang::Parser::processFor(void)
 {
     static const char *UnexpectedEndOfFile = "Lang::Parser::processFor: Unexpected end of file in for statement\n";
     static const char *UnexpectedToken = "Lang::Parser::processFor: Unexpected token in for statement\n";
 
     const auto rootIt = _it;
-    auto &rootNode = insertNode<TokenType::Statement, StatementType::For>(parent, rootIt);
+    openNode<TokenType::Statement, StatementType::For>(rootIt);
 
     if (++_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
@@ -384,28 +399,29 @@ void kF::Lang::Parser::processFor(AST &parent)
         throw std::logic_error(UnexpectedToken + getTokenError(rootIt));
     else if (++_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
-    processOperation(rootNode, ";");
+    processOperation(";");
     if (_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
-    processOperation(rootNode, ";");
+    processOperation(";");
     if (_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
-    processOperation(rootNode, ")");
+    processOperation(")");
     if (_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
     else if (_it.literal() == "{")
-        processExpression(rootNode, "}");
+        processExpression("}");
     else
-        processSingleLineExpression(rootNode);
+        processSingleLineExpression();
+    closeNode();
 }
 
-void kF::Lang::Parser::processSwitch(AST &parent)
+void kF::Lang::Parser::processSwitch(void)
 {
     static const char *UnexpectedEndOfFile = "Lang::Parser::processSwitch: Unexpected end of file in switch statement\n";
     static const char *UnexpectedToken = "Lang::Parser::processSwitch: Unexpected token in switch statement\n";
 
     const auto rootIt = _it;
-    auto &rootNode = insertNode<TokenType::Statement, StatementType::Switch>(parent, rootIt);
+    openNode<TokenType::Statement, StatementType::Switch>(rootIt);
 
     if (++_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
@@ -413,26 +429,28 @@ void kF::Lang::Parser::processSwitch(AST &parent)
         throw std::logic_error(UnexpectedToken + getTokenError(_it));
     else if (++_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
-    processOperation(rootNode, ")");
+    processOperation(")");
     if (_it == _end) [[unlikely]]
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
     else if (_it.literal() != "{")
         throw std::logic_error(UnexpectedToken + getTokenError(_it));
+    ++_it;
     while (_it != _end) {
         const auto literal = _it.literal();
         if (literal == "}") [[unlikely]] {
             ++_it;
+            closeNode();
             return;
         } else if (literal == "case") {
             if (++_it == _end) [[unlikely]]
                 throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
-            processOperation(rootNode, ":");
+            processOperation(":");
             if (_it == _end) [[unlikely]]
                 throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
             else if (_it.literal() == "{")
-                processExpression(rootNode, "}");
+                processExpression("}");
             else
-                processSingleLineExpression(rootNode);
+                processSingleLineExpression();
         } else if (literal == "default") {
             if (++_it == _end) [[unlikely]]
                 throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
@@ -441,9 +459,15 @@ void kF::Lang::Parser::processSwitch(AST &parent)
             if (++_it == _end) [[unlikely]]
                 throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
             else if (_it.literal() == "{")
-                processExpression(rootNode, "}");
+                processExpression("}");
             else
-                processSingleLineExpression(rootNode);
+                processSingleLineExpression();
+            if (_it == _end) [[unlikely]]
+                throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
+            else if (_it.literal() != "}")
+                throw std::logic_error(UnexpectedToken + getTokenError(_it));
+            ++_it;
+            closeNode();
             return;
         } else
            throw std::logic_error(UnexpectedToken + getTokenError(_it));
@@ -451,52 +475,54 @@ void kF::Lang::Parser::processSwitch(AST &parent)
     throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
 }
 
-void kF::Lang::Parser::processList(AST &parent)
+void kF::Lang::Parser::processList(void)
 {
 
 }
 
-void kF::Lang::Parser::processLocal(AST &parent)
+void kF::Lang::Parser::processLocal(void)
 {
     static const char *UnexpectedEndOfFile = "Lang::Parser::processLocal: Unexpected end of file in local variable\n";
     static const char *UnexpectedToken = "Lang::Parser::processLocal: Unexpected token in local variable\n";
 
     const auto rootIt = _it;
-    auto &rootNode = insertNode<TokenType::Local>(parent, _it);
+    openNode<TokenType::Local>(_it);
 
     if (++_it == _end)
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
-    insertNode<TokenType::Name>(rootNode, rootIt);
-    insertNode<TokenType::Name>(rootNode, _it);
+    insertNode<TokenType::Name>(rootIt);
+    insertNode<TokenType::Name>(_it);
     if (++_it == _end)
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
     else if (_it.literal() != "=")
         throw std::logic_error(UnexpectedToken + getTokenError(_it));
     else if (++_it == _end)
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
-    processOperation(rootNode, ";");
+    processOperation(";");
+    closeNode();
 }
 
-void kF::Lang::Parser::processReturn(AST &parent)
+void kF::Lang::Parser::processReturn(void)
 {
     static const char *UnexpectedEndOfFile = "Lang::Parser::processReturn: Unexpected end of file in return statement\n";
 
     const auto rootIt = _it;
-    auto &rootNode = insertNode<TokenType::Statement, StatementType::Return>(parent, _it);
+    openNode<TokenType::Statement, StatementType::Return>(_it);
 
     if (++_it == _end)
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
-    processOperation(rootNode, ";");
+    processOperation(";");
+    closeNode();
 }
 
-void kF::Lang::Parser::processBreak(AST &parent)
+void kF::Lang::Parser::processBreak(void)
 {
     static const char *UnexpectedEndOfFile = "Lang::Parser::processBreak: Unexpected end of file in break statement\n";
     static const char *UnexpectedToken = "Lang::Parser::processBreak: Unexpected token in break statement\n";
 
     const auto rootIt = _it;
 
-    insertNode<TokenType::Statement, StatementType::Break>(parent, _it);
+    insertNode<TokenType::Statement, StatementType::Break>(_it);
     if (++_it == _end)
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
     else if (_it.literal() != ";")
@@ -504,14 +530,14 @@ void kF::Lang::Parser::processBreak(AST &parent)
     ++_it;
 }
 
-void kF::Lang::Parser::processContinue(AST &parent)
+void kF::Lang::Parser::processContinue(void)
 {
     static const char *UnexpectedEndOfFile = "Lang::Parser::processContinue: Unexpected end of file in continue statement\n";
     static const char *UnexpectedToken = "Lang::Parser::processContinue: Unexpected token in continue statement\n";
 
     const auto rootIt = _it;
 
-    insertNode<TokenType::Statement, StatementType::Continue>(parent, _it);
+    insertNode<TokenType::Statement, StatementType::Continue>(_it);
     if (++_it == _end)
         throw std::logic_error(UnexpectedEndOfFile + getTokenError(rootIt));
     else if (_it.literal() != ";")
@@ -519,7 +545,7 @@ void kF::Lang::Parser::processContinue(AST &parent)
     ++_it;
 }
 
-void kF::Lang::Parser::processOperation(AST &parent, const std::string_view &terminate)
+void kF::Lang::Parser::processOperation(const std::string_view &terminate)
 {
     static const char *UnexpectedEndOfFile = "Lang::Parser::processOperation: Unexpected end of file in operation\n";
 
@@ -533,7 +559,7 @@ void kF::Lang::Parser::processOperation(AST &parent, const std::string_view &ter
             ++_it;
             if (_operationStack.empty())
                 throw std::logic_error("Lang::Parser::processOperation: Invalid empty operation\n" + getTokenError(rootIt));
-            parent.children().push(buildOperation());
+            attachNode(buildOperation());
             return;
         }
     }
@@ -546,7 +572,10 @@ void kF::Lang::Parser::processOperationToken(const std::string_view &literal)
         token: &*_it
     };
 
-    if (IsName(literal))
+    if (literal == "true" || literal == "false") {
+        operationNode.type = TokenType::Constant;
+        operationNode.data.constantType = ConstantType::Boolean;
+    } else if (IsName(literal))
         operationNode.type = TokenType::Name;
     else if (!tryProcessOperator(literal, operationNode) && !tryProcessConstant(literal, operationNode))
         throw std::logic_error("Lang::Parser::processOperationToken: Unexpected token in operation\n" + getTokenError(_it));
@@ -656,17 +685,20 @@ bool kF::Lang::Parser::tryProcessConstant(const std::string_view &literal, Opera
     return true;
 }
 
-kF::Lang::AST::Ptr kF::Lang::Parser::buildOperation(void)
+kF::Lang::AST &kF::Lang::Parser::buildOperation(void)
 {
-    auto rootNode = buildOperator(buildOperand(), 0u);
+    auto &rootNode = buildOperator(&buildOperand(), 0u);
 
+    // Only a ':' without its '?' can stop an operation early
+    if (_operationIndex != _operationStack.size()) [[unlikely]]
+        throw std::logic_error("Lang::Parser::buildOperation: Unexpected token in operation\n" + getTokenError(*_operationStack[_operationIndex].token));
     _operationStack.clear();
     _operationIndex = 0u;
     _openedParenthesis = 0u;
     return rootNode;
 }
 
-kF::Lang::AST::Ptr kF::Lang::Parser::buildOperator(AST::Ptr lhs, const std::size_t minPrecedence)
+kF::Lang::AST &kF::Lang::Parser::buildOperator(AST *lhs, const std::size_t minPrecedence)
 {
     constexpr auto GetPrecedence = [](const OperatorType type) -> std::size_t {
         switch (type) {
@@ -747,14 +779,12 @@ kF::Lang::AST::Ptr kF::Lang::Parser::buildOperator(AST::Ptr lhs, const std::size
             ++_operationIndex;
             if (_operationIndex == _operationStack.size())
                 throw std::logic_error(UnexpectedToken + getTokenError(op.token));
-            auto rootNode = AST::Make(op.token, TokenType::Operator, OperatorType::Call);
-            rootNode->children().push(std::move(lhs));
             // Check if the function call has parameters
             if (_operationStack[_operationIndex].type != TokenType::RightParenthesis) {
-                auto rhs = buildOperator(buildOperand(), 0);
-                rootNode->children().push(std::move(rhs));
-            }
-            lhs = std::move(rootNode);
+                auto &rhs = buildOperator(&buildOperand(), 0);
+                lhs = &_tree->make(op.token, TokenType::Operator, OperatorType::Call, { lhs, &rhs });
+            } else
+                lhs = &_tree->make(op.token, TokenType::Operator, OperatorType::Call, { lhs });
             break;
         }
 
@@ -766,25 +796,17 @@ kF::Lang::AST::Ptr kF::Lang::Parser::buildOperator(AST::Ptr lhs, const std::size
                 throw std::logic_error(UnexpectedToken + getTokenError(*op.token));
             --_openedParenthesis;
             ++_operationIndex;
-            return lhs;
+            return *lhs;
         case TokenType::Operator:
             switch (op.data.operatorType) {
             case OperatorType::Increment:
-            {
-                auto rootNode = AST::Make(op.token, TokenType::Operator, OperatorType::IncrementSuffix);
-                rootNode->children().push(std::move(lhs));
-                lhs = std::move(rootNode);
+                lhs = &_tree->make(op.token, TokenType::Operator, OperatorType::IncrementSuffix, { lhs });
                 ++_operationIndex;
                 continue;
-            }
             case OperatorType::Decrement:
-            {
-                auto rootNode = AST::Make(op.token, TokenType::Operator, OperatorType::DecrementSuffix);
-                rootNode->children().push(std::move(lhs));
-                lhs = std::move(rootNode);
+                lhs = &_tree->make(op.token, TokenType::Operator, OperatorType::DecrementSuffix, { lhs });
                 ++_operationIndex;
                 continue;
-            }
             case OperatorType::Addition:
             case OperatorType::Substraction:
             case OperatorType::Multiplication:
@@ -819,13 +841,30 @@ kF::Lang::AST::Ptr kF::Lang::Parser::buildOperator(AST::Ptr lhs, const std::size
                     break;
                 const auto associativity = GetAssociativity(op.data.operatorType);
                 ++_operationIndex;
-                auto rhs = buildOperator(buildOperand(), precedence + (associativity == AssociativityType::LeftToRight));
-                auto rootNode = AST::Make(op.token, TokenType::Operator, op.data.operatorType);
-                rootNode->children().push(std::move(lhs));
-                rootNode->children().push(std::move(rhs));
-                lhs = std::move(rootNode);
+                auto &rhs = buildOperator(&buildOperand(), precedence + (associativity == AssociativityType::LeftToRight));
+                lhs = &_tree->make(op.token, TokenType::Operator, op.data.operatorType, { lhs, &rhs });
+                continue;
+            }
+            case OperatorType::TernaryIf:
+            {
+                // The body runs until its matching ':', the else body binds to the right
+                const auto precedence = GetPrecedence(op.data.operatorType);
+                if (precedence < minPrecedence)
+                    break;
+                ++_operationIndex;
+                auto &body = buildOperator(&buildOperand(), 0);
+                if (_operationIndex == _operationStack.size()
+                        || _operationStack[_operationIndex].type != TokenType::Operator
+                        || _operationStack[_operationIndex].data.operatorType != OperatorType::TernaryElse) [[unlikely]]
+                    throw std::logic_error(UnexpectedToken + getTokenError(*op.token));
+                ++_operationIndex;
+                auto &elseBody = buildOperator(&buildOperand(), precedence);
+                lhs = &_tree->make(op.token, TokenType::Operator, op.data.operatorType, { lhs, &body, &elseBody });
                 continue;
             }
+            case OperatorType::TernaryElse:
+                // Ends the body of a ternary operator
+                break;
             default:
                 throw std::logic_error(UnexpectedToken + getTokenError(*op.token));
             }
@@ -835,10 +874,10 @@ kF::Lang::AST::Ptr kF::Lang::Parser::buildOperator(AST::Ptr lhs, const std::size
         }
         break;
     }
-    return lhs;
+    return *lhs;
 }
 
-kF::Lang::AST::Ptr kF::Lang::Parser::buildOperand(void)
+kF::Lang::AST &kF::Lang::Parser::buildOperand(void)
 {
     static const char *UnexpectedToken = "Lang::Parser::buildOperand: Unexpected token in operation\n";
     static const char *MissingOperand = "Lang::Parser::buildOperand: Invalid operation, missing operand\n";
@@ -851,15 +890,9 @@ kF::Lang::AST::Ptr kF::Lang::Parser::buildOperand(void)
     ++_operationIndex;
     switch (op.type) {
     case TokenType::Name:
-    {
-        auto node = AST::Make(op.token, TokenType::Name, op.data);
-        // if (_operationIndex != _operationStack.size() && _operationStack[_operationIndex].type == TokenType::Operator
-        //         && _operationStack[_operationIndex].data.operatorType == OperatorType::Dot)
-        //     node = buildComposedName(std::move(node));
-        return node;
-    }
+        return _tree->make(op.token, TokenType::Name, op.data);
     case TokenType::Constant:
-        return AST::Make(op.token, TokenType::Constant, op.data);
+        return _tree->make(op.token, TokenType::Constant, op.data);
     case TokenType::Operator:
         switch (op.data.operatorType) {
         case OperatorType::Not:
@@ -867,23 +900,15 @@ kF::Lang::AST::Ptr kF::Lang::Parser::buildOperand(void)
         case OperatorType::BitReverse:
         case OperatorType::Increment:
         case OperatorType::Decrement:
-        {
-            auto rootNode = AST::Make(op.token, TokenType::Operator, op.data);
-            rootNode->children().push(buildOperand());
-            return rootNode;
-        }
+            return _tree->make(op.token, TokenType::Operator, op.data, { &buildOperand() });
         case OperatorType::Substraction:
-        {
-            auto rootNode = AST::Make(op.token, TokenType::Operator, OperatorType::Minus);
-            rootNode->children().push(buildOperand());
-            return rootNode;
-        }
+            return _tree->make(op.token, TokenType::Operator, OperatorType::Minus, { &buildOperand() });
         default:
             throw std::logic_error(UnexpectedToken + getTokenError(*op.token));
         }
     case TokenType::LeftParenthesis:
         ++_openedParenthesis;
-        return buildOperator(buildOperand(), 0);
+        return buildOperator(&buildOperand(), 0);
     default:
         throw std::logic_error(UnexpectedToken + getTokenError(*op.token));
     }
@@ -13,7 +13,7 @@
 #include <Kube/Core/AllocatedSmallString.hpp>
 
 #include "TokenStack.hpp"
-#include "AST.hpp"
+#include "SyntaxTree.hpp"
 
 namespace kF::Lang
 {
@@ -33,20 +33,35 @@ public:
     };
 
     /** @brief Process the Parser over a input stream */
-    [[nodiscard]] AST::Ptr run(const FileIndex file, const TokenStack *stack, const std::string_view &context)
-        { prepare(file, stack, context); return std::move(_root); }
+    [[nodiscard]] SyntaxTree::Ptr run(const FileIndex file, const TokenStack *stack, const std::string_view &context)
+        { prepare(file, stack, context); return std::move(_tree); }
 
     /** @brief Get import paths */
     [[nodiscard]] auto &imports(void) noexcept { return _imports; }
     [[nodiscard]] const auto &imports(void) const noexcept { return _imports; }
 
+
+    /** @brief Pre-scan a token stack to extract import paths without parsing it
+     *  Imports must appear before the first class so the scan stops at the first non-import token
+     *  Malformed imports are skipped, they are reported later by the parser
+     *  @tparam Callback must take a constant reference to a string view (import path) */
+    template<typename Callback>
+    static void ExtractImports(const TokenStack &stack, Callback &&callback) noexcept_invocable(Callback, const std::string_view &);
+
+    /** @brief Pre-scan a token stack to extract the name of every class declared or instantiated without parsing it
+     *  A class is always declared using a name followed by an opening bracket
+     *  @tparam Callback must take a constant reference to a string view (class name) */
+    template<typename Callback>
+    static void ExtractClassNames(const TokenStack &stack, Callback &&callback) noexcept_invocable(Callback, const std::string_view &);
+
 private:
     // Cacheline 1
-    Core::TinyVector<AST *> _processStack {};
+    Core::TinyVector<AST *> _childStack {};
+    Core::TinyVector<AST::ChildIndex> _openStack {};
     const TokenStack *_stack { nullptr };
     Token::Iterator _it { nullptr };
     Token::Iterator _end { nullptr };
-    AST::Ptr _root {};
+    SyntaxTree::Ptr _tree {};
     // Cacheline 2
     std::string_view _context {};
     Core::TinyVector<Core::TinyString> _imports {};
@@ -83,47 +98,47 @@ private:
     void processAssignment(void);
 
     /** @brief Process a list of parameters */
-    void processParameterList(AST &parent);
+    void processParameterList(void);
 
     /** @brief Process an expression */
-    void processExpression(AST &parent, const std::string_view &terminate);
+    void processExpression(const std::string_view &terminate);
 
     /** @brief Process a single line expression */
-    void processSingleLineExpression(AST &parent);
+    void processSingleLineExpression(void);
 
     /** @brief Process a single token from an expression */
-    void processExpressionToken(AST &parent, const std::string_view &literal);
+    void processExpressionToken(const std::string_view &literal);
 
     /** @brief Process if statement from an expression */
-    void processIf(AST &parent);
+    void processIf(void);
 
     /** @brief Process while statement from an expression */
-    void processWhile(AST &parent);
+    void processWhile(void);
 
     /** @brief Process for statement from an expression */
-    void processFor(AST &parent);
+    void processFor(void);
 
     /** @brief Process switch statement from an expression */
-    void processSwitch(AST &parent);
+    void processSwitch(void);
 
     /** @brief Process list statement from an expression */
-    void processList(AST &parent);
+    void processList(void);
 
     /** @brief Process local statement from an expression */
-    void processLocal(AST &parent);
+    void processLocal(void);
 
     /** @brief Process return statement from an expression */
-    void processReturn(AST &parent);
+    void processReturn(void);
 
     /** @brief Process break statement from an expression */
-    void processBreak(AST &parent);
+    void processBreak(void);
 
     /** @brief Process continue statement from an expression */
-    void processContinue(AST &parent);
+    void processContinue(void);
 
 
     /** @brief Process operation statement from an expression */
-    void processOperation(AST &parent, const std::string_view &terminate);
+    void processOperation(const std::string_view &terminate);
 
     /** @brief Process a single token from an operation */
     void processOperationToken(const std::string_view &literal);
@@ -135,26 +150,36 @@ private:
     [[nodiscard]] bool tryProcessConstant(const std::string_view &literal, OperationNode &operationNode);
 
     /** @brief Build an operation */
-    [[nodiscard]] AST::Ptr buildOperation(void);
+    [[nodiscard]] AST &buildOperation(void);
 
     /** @brief Build an operator */
-    [[nodiscard]] AST::Ptr buildOperator(AST::Ptr lhs, const std::size_t minPrecedence);
+    [[nodiscard]] AST &buildOperator(AST *lhs, const std::size_t minPrecedence);
 
     /** @brief Build an operand */
-    [[nodiscard]] AST::Ptr buildOperand(void);
+    [[nodiscard]] AST &buildOperand(void);
 
 
-    /** @brief Insert a node in higher process node */
+    /** @brief Insert a node as child of the last opened node */
     template<TokenType Type>
     AST &insertNode(const Token::Iterator it) noexcept;
 
-    /** @brief Insert a node in another */
+    /** @brief Insert a node with data as child of the last opened node */
+    template<TokenType Type, auto DataType>
+    AST &insertNode(const Token::Iterator it) noexcept;
+
+    /** @brief Insert a node and open it, every following inserted node is its child until it gets closed */
     template<TokenType Type>
-    AST &insertNode(AST &parent, const Token::Iterator it) noexcept;
+    AST &openNode(const Token::Iterator it) noexcept;
 
-    /** @brief Insert a node in another */
+    /** @brief Insert a node with data and open it */
     template<TokenType Type, auto DataType>
-    AST &insertNode(AST &parent, const Token::Iterator it) noexcept;
+    AST &openNode(const Token::Iterator it) noexcept;
+
+    /** @brief Close the last opened node, moving its children into the tree */
+    void closeNode(void) noexcept;
+
+    /** @brief Attach an already built node as child of the last opened node */
+    void attachNode(AST &node) noexcept { _childStack.push(&node); }
 
 
     /** @brief Return a well formated error from a token */
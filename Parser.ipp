@@ -6,41 +6,44 @@
 template<kF::Lang::TokenType Type>
 inline kF::Lang::AST &kF::Lang::Parser::insertNode(const Token::Iterator it) noexcept
 {
-    auto ptr = AST::Make(&*it, Type);
-    if constexpr (Type == TokenType::Class) {
-        if (_root) {
-            auto &inserted = _processStack.back()->children().push(std::move(ptr));
-            _processStack.push(inserted.get());
-            return *inserted;
-        } else {
-            _root = AST::Make(&*it, Type);
-            _processStack.push(_root.get());
-            return *_root;
-        }
-    } else
-        return *_processStack.back()->children().push(std::move(ptr));
+    auto &node = _tree->make(&*it, Type);
+    attachNode(node);
+    return node;
+}
+
+template<kF::Lang::TokenType Type, auto DataType>
+inline kF::Lang::AST &kF::Lang::Parser::insertNode(const Token::Iterator it) noexcept
+{
+    auto &node = _tree->make(&*it, Type, DataType);
+    attachNode(node);
+    return node;
 }
 
 template<kF::Lang::TokenType Type>
-inline kF::Lang::AST &kF::Lang::Parser::insertNode(AST &parent, const Token::Iterator it) noexcept
+inline kF::Lang::AST &kF::Lang::Parser::openNode(const Token::Iterator it) noexcept
 {
-    if constexpr (Type == TokenType::Class) {
-        auto &inserted = parent.children().push(AST::Make(&*it, Type));
-        _processStack.push(inserted.get());
-        return *inserted;
-    } else
-        return *parent.children().push(AST::Make(&*it, Type));
+    auto &node = insertNode<Type>(it);
+    _openStack.push(_childStack.size());
+    return node;
 }
 
 template<kF::Lang::TokenType Type, auto DataType>
-inline kF::Lang::AST &kF::Lang::Parser::insertNode(AST &parent, const Token::Iterator it) noexcept
+inline kF::Lang::AST &kF::Lang::Parser::openNode(const Token::Iterator it) noexcept
 {
-    if constexpr (Type == TokenType::Class) {
-        auto &inserted = parent.children().push(AST::Make(&*it, Type, DataType));
-        _processStack.push(inserted.get());
-        return *inserted;
-    } else
-        return *parent.children().push(AST::Make(&*it, Type, DataType));
+    auto &node = insertNode<Type, DataType>(it);
+    _openStack.push(_childStack.size());
+    return node;
+}
+
+inline void kF::Lang::Parser::closeNode(void) noexcept
+{
+    const auto begin = _openStack.back();
+    const auto count = _childStack.size() - begin;
+    auto &node = *_childStack[begin - 1];
+
+    _openStack.pop();
+    _tree->setChildren(node, _childStack.begin() + begin, count);
+    _childStack.erase(_childStack.begin() + begin, _childStack.end());
 }
 
 template<bool First>
@@ -50,4 +53,32 @@ inline bool kF::Lang::Parser::IsNameChar(const char c) noexcept
         return std::isalpha(c) || c == '_';
     else
         return std::isalnum(c) || c == '_';
-}
\ No newline at end of file
+}
+
+template<typename Callback>
+inline void kF::Lang::Parser::ExtractImports(const TokenStack &stack, Callback &&callback)
+    noexcept_invocable(Callback, const std::string_view &)
+{
+    for (auto it = stack.begin(), end = stack.end(); it != end && it.literal() == "import";) {
+        if (++it == end) [[unlikely]]
+            return;
+        if (const auto literal = it.literal(); IsLiteral(literal)) [[likely]] {
+            callback(literal.substr(1, literal.size() - 2));
+            ++it;
+        }
+    }
+}
+
+template<typename Callback>
+inline void kF::Lang::Parser::ExtractClassNames(const TokenStack &stack, Callback &&callback)
+    noexcept_invocable(Callback, const std::string_view &)
+{
+    std::string_view previous {};
+
+    for (auto it = stack.begin(), end = stack.end(); it != end; ++it) {
+        const auto literal = it.literal();
+        if (literal == "{" && IsName(previous) && previous != "else" && previous != "on") [[unlikely]]
+            callback(previous);
+        previous = literal;
+    }
+}
@@ -0,0 +1,206 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Helpers shared by processers
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <Kube/Core/Vector.hpp>
+#include <Kube/Object/Object.hpp>
+
+#include "Instructions.hpp"
+#include "InlineCache.hpp"
+#include "ExternalCache.hpp"
+
+// Processers dispatch through a table of label addresses (GCC / Clang extension) unless switch dispatch is requested
+#if !defined(KUBE_INTERPRETER_THREADED_DISPATCH)
+# if (defined(__GNUC__) || defined(__clang__)) && !KUBE_INTERPRETER_SWITCH_DISPATCH
+#  define KUBE_INTERPRETER_THREADED_DISPATCH 1
+# else
+#  define KUBE_INTERPRETER_THREADED_DISPATCH 0
+# endif
+#endif
+
+namespace kF::Lang
+{
+    /** @brief A property read by an expression */
+    struct alignas_quarter_cacheline PropertyDependency
+    {
+        Object *instance { nullptr };
+        HashedName name { 0u };
+    };
+
+    /** @brief A list of read properties */
+    using PropertyDependencies = Core::TinyVector<PropertyDependency>;
+}
+
+namespace kF::Lang::Processer
+{
+    /** @brief Properties read by the expressions running on the calling thread, only recorded while a binding or a predicate is evaluated */
+    inline thread_local PropertyDependencies *RecordedDependencies { nullptr };
+
+    /** @brief Record the properties read on the calling thread while alive, the enclosing recording is restored on destruction */
+    struct DependencyRecord
+    {
+        PropertyDependencies * const previous;
+
+        /** @brief Start recording into a list of dependencies */
+        DependencyRecord(PropertyDependencies &dependencies) noexcept
+            : previous(std::exchange(RecordedDependencies, &dependencies)) {}
+
+        /** @brief Restore the enclosing recording */
+        ~DependencyRecord(void) noexcept { RecordedDependencies = previous; }
+    };
+
+    /** @brief Access the instruction at a given position */
+    template<typename Type>
+    [[nodiscard]] inline const Type &As(const std::byte * const it) noexcept
+        { return *reinterpret_cast<const Type *>(it); }
+
+    /** @brief Rewrite the operation code of an instruction of a running expression
+     *  Generic and quickened variants are valid on any operand, so threads sharing the expression may observe any of them */
+    template<typename Code>
+    inline void Rewrite(const Code &code, const Code to) noexcept
+        { std::atomic_ref(const_cast<Code &>(code)).store(to, std::memory_order_relaxed); }
+
+    /** @brief Read the operation code of an instruction of a running expression, which other threads may rewrite */
+    template<typename Code>
+    [[nodiscard]] inline Code Observe(const Code &code) noexcept
+        { return std::atomic_ref(const_cast<Code &>(code)).load(std::memory_order_relaxed); }
+
+    /** @brief Check if two operands hold a given type */
+    template<typename Type>
+    [[nodiscard]] inline bool Holds(const Var &lhs, const Var &rhs) noexcept
+        { return lhs.is<Type>() && rhs.is<Type>(); }
+
+    /** @brief Throw an error about an unknown name */
+    [[noreturn]] inline void ThrowUnknownName(const char * const where, const char * const what, const HashedName name)
+    {
+        throw std::logic_error(std::string(where) + ": Unknown " + what + " of hash '" + std::to_string(name) + '\'');
+    }
+
+    /** @brief Find a data of an instance through the inline cache of its access */
+    [[nodiscard]] inline Meta::Data FindData(const char * const where, InlineCache &cache, const Object &instance, const HashedName name)
+    {
+        const auto data = cache.findData(instance, name);
+
+        if (!data) [[unlikely]]
+            ThrowUnknownName(where, "property", name);
+        return data;
+    }
+
+    /** @brief Read a data of an instance, recording it as a dependency while recording */
+    [[nodiscard]] inline Var GetVar(Object &instance, const Meta::Data &data, const HashedName name)
+    {
+        if (const auto dependencies = RecordedDependencies; dependencies) [[unlikely]] {
+            dependencies->push(PropertyDependency {
+                instance: &instance,
+                name: name
+            });
+        }
+        return instance.getVar(data);
+    }
+
+    /** @brief Find a function of an instance */
+    [[nodiscard]] inline Meta::Function FindFunction(const char * const where, const Object &instance, const HashedName name)
+    {
+        const auto function = instance.getMetaType().findFunction(name);
+
+        if (!function) [[unlikely]]
+            ThrowUnknownName(where, "function", name);
+        return function;
+    }
+
+    /** @brief Find a signal of an instance */
+    [[nodiscard]] inline Meta::Signal FindSignal(const char * const where, const Object &instance, const HashedName name)
+    {
+        const auto signal = instance.getMetaType().findSignal(name);
+
+        if (!signal) [[unlikely]]
+            ThrowUnknownName(where, "signal", name);
+        return signal;
+    }
+
+    /** @brief Find the innermost instance having a data through the external cache of its access */
+    [[nodiscard]] inline Object &FindExternalData(const char * const where, ExternalCache &cache, Object * const *instances, const HashedName name, Meta::Data &data)
+    {
+        const auto instance = cache.findData(instances, name, data);
+
+        if (!instance) [[unlikely]]
+            ThrowUnknownName(where, "property", name);
+        return *instance;
+    }
+
+    /** @brief Find the innermost instance having a function through the external cache of its call */
+    [[nodiscard]] inline Object &FindExternalFunction(const char * const where, ExternalCache &cache, Object * const *instances, const HashedName name, Meta::Function &function)
+    {
+        const auto instance = cache.findFunction(instances, name, function);
+
+        if (!instance) [[unlikely]]
+            ThrowUnknownName(where, "function", name);
+        return *instance;
+    }
+
+    /** @brief Entry of a table returned for values of another type than its keys */
+    constexpr std::uint32_t NoTableEntry = ~static_cast<std::uint32_t>(0u);
+
+    /** @brief Find the entry of a dense table matching a value, returns the entry count if none matches */
+    template<typename Table>
+    [[nodiscard]] inline std::uint32_t FindDenseEntry(const Table &table, const Var &value) noexcept
+    {
+        if (!value.is<std::int64_t>()) [[unlikely]]
+            return NoTableEntry;
+        const auto offset = static_cast<std::uint64_t>(value.as<std::int64_t>()) - static_cast<std::uint64_t>(table.base);
+        return offset < table.count ? static_cast<std::uint32_t>(offset) : table.count;
+    }
+
+    /** @brief Find the entry of a sorted table matching a value, returns the entry count if none matches */
+    template<typename Table>
+    [[nodiscard]] inline std::uint32_t FindSortedEntry(const Table &table, const Var &value) noexcept
+    {
+        if (!value.is<std::int64_t>()) [[unlikely]]
+            return NoTableEntry;
+        const auto key = value.as<std::int64_t>();
+        const auto keys = TableKeys(table);
+        const auto it = std::lower_bound(keys, keys + table.count, key);
+        return it != keys + table.count && *it == key ? static_cast<std::uint32_t>(it - keys) : table.count;
+    }
+
+    /** @brief Find the entry of a hashed table matching a value, returns the entry count if none matches
+     *  The literal of the entry is compared as different literals may share an entry */
+    template<typename Table>
+    [[nodiscard]] inline std::uint32_t FindHashedEntry(const Table &table, const Var &value, const std::byte * const code)
+    {
+        if (!value.is<std::string>()) [[unlikely]]
+            return NoTableEntry;
+        const auto &string = value.as<std::string>();
+        const auto entry = HashedEntry(Hash(std::string_view(string)), table.seed, table.count);
+        const auto key = TableKeys(table)[entry];
+        if (key < 0)
+            return table.count;
+        const auto literal = code + key;
+        const auto length = As<Instruction>(literal).argument;
+        if (length != string.size() || std::memcmp(literal + sizeof(Instruction), string.data(), length))
+            return table.count;
+        return entry;
+    }
+
+    /** @brief Get the target of an entry of a table, the entry count stands for the default target */
+    template<typename Table>
+    [[nodiscard]] inline ByteIndex TableTarget(const Table &table, const std::uint32_t entry) noexcept
+        { return entry == table.count ? table.defaultTarget : TableTargets(table)[entry]; }
+
+    /** @brief Release a range of variables */
+    inline void Release(Var *from, Var * const to) noexcept
+    {
+        for (; from != to; ++from)
+            from->destruct();
+    }
+}
@@ -0,0 +1,134 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Prototype
+ */
+
+#include <stdexcept>
+
+#include "Prototype.hpp"
+
+using namespace kF;
+
+Lang::Prototype::Prototype(const AST &classNode, const Compiler::Units &units)
+{
+    Core::TinyVector<ObjectIndex> open;
+    auto unit = units.begin();
+    Object * const constantInstances[] = { nullptr };
+
+    if (classNode.type() != TokenType::Class) [[unlikely]]
+        throw std::logic_error("Lang::Prototype::Prototype: Node is not a class");
+    classNode.traverse(
+        [this, &open, &unit, &units, &constantInstances](const AST &node) {
+            switch (node.type()) {
+            case TokenType::Class:
+                open.push(static_cast<ObjectIndex>(_nodes.size()));
+                _nodes.push(Node {
+                    type: Hash(node.literal()),
+                    parent: open.size() > 1u ? open[open.size() - 2u] : NoObject
+                });
+                return true;
+            case TokenType::Property:
+            case TokenType::Assignment:
+                break;
+            default:
+                return false;
+            }
+            // Units are compiled in pre-order, as the members of the classes
+            while (unit != units.end() && unit->node != &node)
+                ++unit;
+            if (unit == units.end()) [[unlikely]]
+                throw std::logic_error("Lang::Prototype::Prototype: Initializer is not compiled");
+            bool isConstant = true;
+            node.children()[0]->traverse([&isConstant](const AST &child) {
+                isConstant &= child.type() != TokenType::Name;
+                return isConstant;
+            });
+            const auto name = Hash(node.literal());
+            if (isConstant) {
+                _defaults.push(Default {
+                    object: open.back(),
+                    name: name,
+                    value: (*unit->expression)(constantInstances, nullptr)
+                });
+            } else {
+                _initializers.push(Initializer {
+                    object: open.back(),
+                    name: name,
+                    expression: unit->expression.get()
+                });
+            }
+            return false;
+        },
+        [&open](const AST &node) {
+            if (node.type() == TokenType::Class)
+                open.pop();
+        }
+    );
+
+    // Each object lists itself then its enclosing objects up to the root
+    for (ObjectIndex object = 0u; object < _nodes.size(); ++object) {
+        _nodes[object].chain = static_cast<std::uint32_t>(_image.size());
+        for (auto enclosing = object; enclosing != NoObject; enclosing = _nodes[enclosing].parent)
+            _image.push(enclosing);
+        _image.push(NoObject);
+    }
+}
+
+Lang::Prototype::Instances Lang::Prototype::instantiate(Object * const *objects, const std::uint32_t count, BindingGraph * const graph) const
+{
+    const auto objectCount = _nodes.size();
+    const auto imageSize = _image.size();
+    Instances instances {
+        count: count
+    };
+
+    if (!count) [[unlikely]]
+        return instances;
+
+    // The image is copied once per instance, each object index is relocated to the object of its instance
+    instances.chains.resize(count * imageSize, nullptr);
+    for (std::uint32_t instance = 0u; instance < count; ++instance) {
+        const auto instanceObjects = objects + instance * objectCount;
+        auto chain = instances.chains.begin() + instance * imageSize;
+        for (const auto object : _image)
+            *chain++ = object == NoObject ? nullptr : instanceObjects[object];
+    }
+
+    // Data are resolved on the first instance, values are then copied into every instance
+    for (const auto &value : _defaults) {
+        const auto data = FindData(*objects[value.object], value.name);
+        for (std::uint32_t instance = 0u; instance < count; ++instance)
+            objects[instance * objectCount + value.object]->setVar(data, value.value);
+    }
+
+    Core::Vector<Object * const *> chains;
+    Core::Vector<Var> values;
+    for (const auto &initializer : _initializers) {
+        if (graph) {
+            for (std::uint32_t instance = 0u; instance < count; ++instance) {
+                (void)graph->add(*objects[instance * objectCount + initializer.object], initializer.name,
+                    *initializer.expression, chainOf(instances, instance, initializer.object));
+            }
+            continue;
+        }
+        // Each initializer is evaluated for the whole batch at once, then its values are stored
+        const auto data = FindData(*objects[initializer.object], initializer.name);
+        chains.resize(count);
+        values.resize(count);
+        for (std::uint32_t instance = 0u; instance < count; ++instance)
+            chains[instance] = chainOf(instances, instance, initializer.object);
+        (*initializer.expression)(chains.data(), nullptr, count, values.data());
+        for (std::uint32_t instance = 0u; instance < count; ++instance)
+            objects[instance * objectCount + initializer.object]->setVar(data, values[instance]);
+    }
+    return instances;
+}
+
+Meta::Data Lang::Prototype::FindData(const Object &object, const HashedName name)
+{
+    const auto data = object.getMetaType().findData(name);
+
+    if (!data) [[unlikely]]
+        Processer::ThrowUnknownName("Lang::Prototype::instantiate", "property", name);
+    return data;
+}
@@ -0,0 +1,109 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Prototype
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+
+#include "Compiler.hpp"
+#include "BindingGraph.hpp"
+
+namespace kF::Lang
+{
+    class Prototype;
+}
+
+/** @brief A Prototype is a class compiled once for bulk instantiation
+ *  The objects of an instance are the class and its nested classes in pre-order, they are created by the caller
+ *  Initializers that don't read any name are evaluated once when the prototype is built, their values are only copied
+ *  The lists of enclosing objects of every object form an image of object indexes, relocated to object pointers on instantiation
+ *  Other initializers are bound to their property, or evaluated in declaration order without binding graph
+ *  The compiled units must outlive the prototype */
+class alignas_cacheline kF::Lang::Prototype
+{
+public:
+    /** @brief Index of an object in an instance */
+    using ObjectIndex = std::uint32_t;
+
+    /** @brief Null object index, terminates the lists of enclosing objects */
+    static constexpr ObjectIndex NoObject = ~static_cast<ObjectIndex>(0u);
+
+    /** @brief An object of an instance */
+    struct alignas_quarter_cacheline Node
+    {
+        HashedName type { 0u };
+        ObjectIndex parent { NoObject };
+        std::uint32_t chain { 0u }; // Offset of the list of enclosing objects in the image
+    };
+
+    /** @brief A batch of instances, it must outlive the bindings of its objects */
+    struct alignas_quarter_cacheline Instances
+    {
+        Core::Vector<Object *> chains {}; // Relocated image of each instance
+        std::uint32_t count { 0u };
+    };
+
+
+    /** @brief Build the prototype of a class from its compiled units */
+    Prototype(const AST &classNode, const Compiler::Units &units);
+
+    /** @brief Prototypes are not copyable */
+    Prototype(const Prototype &other) = delete;
+    Prototype &operator=(const Prototype &other) = delete;
+
+    /** @brief Destructor */
+    ~Prototype(void) noexcept = default;
+
+
+    /** @brief Get the count of objects of an instance */
+    [[nodiscard]] std::uint32_t objectCount(void) const noexcept { return static_cast<std::uint32_t>(_nodes.size()); }
+
+    /** @brief Get an object of an instance */
+    [[nodiscard]] const Node &nodeAt(const ObjectIndex object) const noexcept { return _nodes[object]; }
+
+    /** @brief Get the count of initializers evaluated when the prototype was built */
+    [[nodiscard]] std::uint32_t defaultCount(void) const noexcept { return static_cast<std::uint32_t>(_defaults.size()); }
+
+    /** @brief Get the count of initializers evaluated by instances */
+    [[nodiscard]] std::uint32_t initializerCount(void) const noexcept { return static_cast<std::uint32_t>(_initializers.size()); }
+
+
+    /** @brief Initialize a batch of instances
+     *  'objects' holds the objects of each instance, in pre-order, instance after instance
+     *  Initializers reading names are added to 'graph' when it is not null, they are evaluated at its next update */
+    [[nodiscard]] Instances instantiate(Object * const *objects, const std::uint32_t count, BindingGraph * const graph = nullptr) const;
+
+    /** @brief Get the null terminated list of enclosing objects of an object of an instance */
+    [[nodiscard]] Object * const *chainOf(const Instances &instances, const std::uint32_t instance, const ObjectIndex object) const noexcept
+        { return instances.chains.data() + instance * _image.size() + _nodes[object].chain; }
+
+private:
+    /** @brief A value copied into a property of each instance */
+    struct alignas_quarter_cacheline Default
+    {
+        ObjectIndex object { 0u };
+        HashedName name { 0u };
+        Var value {};
+    };
+
+    /** @brief An expression initializing a property of each instance */
+    struct alignas_quarter_cacheline Initializer
+    {
+        ObjectIndex object { 0u };
+        HashedName name { 0u };
+        const Expression *expression { nullptr };
+    };
+
+    // Cacheline 1
+    Core::Vector<Node> _nodes {};
+    Core::Vector<ObjectIndex> _image {}; // Lists of enclosing objects of each object, in pre-order
+    Core::Vector<Default> _defaults {};
+    Core::Vector<Initializer> _initializers {};
+
+    /** @brief Find the data of an initialized property, the objects of a node share their type */
+    [[nodiscard]] static Meta::Data FindData(const Object &object, const HashedName name);
+};
+
+static_assert_fit_cacheline(kF::Lang::Prototype);
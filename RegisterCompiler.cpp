@@ -0,0 +1,660 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: RegisterCompiler
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "RegisterCompiler.hpp"
+#include "Optimizer.hpp"
+
+using namespace kF;
+
+Lang::RegisterCompiler::Units Lang::RegisterCompiler::run(const SyntaxTree &tree, const std::string_view &context)
+{
+    Units units;
+
+    if (tree.empty()) [[unlikely]]
+        return units;
+    tree.root().traverse([this, &units, &context](const AST &node) {
+        switch (node.type()) {
+        case TokenType::Class:
+            return true;
+        case TokenType::Function:
+        case TokenType::Property:
+        case TokenType::Event:
+        case TokenType::Assignment:
+        {
+            auto &unit = units.push(Unit {
+                node: &node,
+                expression: compile(node, context)
+            });
+            if (node.type() == TokenType::Event && !Compiler::IsSignalEvent(node))
+                unit.condition = compilePredicate(node, context);
+            return false;
+        }
+        default:
+            return false;
+        }
+    });
+    return units;
+}
+
+Lang::Expression::Ptr Lang::RegisterCompiler::compile(const AST &member, const std::string_view &context)
+{
+    switch (member.type()) {
+    case TokenType::Function:
+    case TokenType::Event:
+        return compileBody(member, *member.children()[1], false, context);
+    case TokenType::Property:
+    case TokenType::Assignment:
+        return compileBody(member, *member.children()[0], true, context);
+    default:
+        throwError("compile", "Member has no body", member);
+    }
+}
+
+Lang::Expression::Ptr Lang::RegisterCompiler::compilePredicate(const AST &event, const std::string_view &context)
+{
+    if (event.type() != TokenType::Event || Compiler::IsSignalEvent(event)) [[unlikely]]
+        throwError("compilePredicate", "Member has no predicate", event);
+    return compileBody(event, *event.children()[0], true, context);
+}
+
+Lang::Expression::Ptr Lang::RegisterCompiler::compileBody(const AST &member, const AST &body, const bool isValue, const std::string_view &context)
+{
+    _context = context;
+    _bytecode.clear();
+    _jumps.clear();
+    _loops.clear();
+    _localCount = 0u;
+    _cacheCount = 0u;
+    _externalCacheCount = 0u;
+    _accesses.clear();
+
+    // Locals occupy the first registers of the frame
+    body.traverse([this](const AST &node) {
+        if (node.type() == TokenType::Local)
+            _localCount = std::max(_localCount, node.children()[1]->nameSlot().index + 1u);
+        return true;
+    });
+    _temporary = _localCount;
+    _maxTemporary = _localCount;
+
+    if (isValue)
+        compileValue(body);
+    else
+        compileBlock(body);
+    if (_maxTemporary >= NoRegister || _cacheCount > std::numeric_limits<std::uint16_t>::max()
+            || _externalCacheCount > std::numeric_limits<std::uint16_t>::max()) [[unlikely]]
+        throwError("compile", "Member body is too large", member);
+    return Expression::Ptr(Expression::Construct(
+        _bytecode.data(),
+        static_cast<std::uint32_t>(_bytecode.size()),
+        static_cast<std::uint16_t>(_localCount),
+        static_cast<std::uint16_t>(_maxTemporary - _localCount),
+        _cacheCount,
+        _externalCacheCount,
+        &_accesses
+    ));
+}
+
+void Lang::RegisterCompiler::compileValue(const AST &body)
+{
+    const AST *value = &body;
+
+    if (body.type() == TokenType::Expression) {
+        if (body.children().size() != 1u) {
+            compileBlock(body);
+            return;
+        }
+        value = body.children()[0];
+    }
+    switch (value->type()) {
+    case TokenType::Expression:
+    case TokenType::Local:
+    case TokenType::Statement:
+        compileBlock(body);
+        break;
+    default:
+        emit(RegisterArgumentInstruction {
+            code: RegisterOpCode::Return,
+            reg: visit(*value, NoRegister)
+        });
+        break;
+    }
+}
+
+void Lang::RegisterCompiler::compileBlock(const AST &body)
+{
+    compileStatement(body);
+    const auto output = allocate();
+    emit(RegisterInstruction {
+        code: RegisterOpCode::LoadVoid,
+        output: output
+    });
+    emit(RegisterArgumentInstruction {
+        code: RegisterOpCode::Return,
+        reg: output
+    });
+}
+
+void Lang::RegisterCompiler::compileStatement(const AST &node)
+{
+    const auto mark = _temporary;
+
+    visit(node, NoRegister);
+    _temporary = mark;
+}
+
+void Lang::RegisterCompiler::compileInto(const AST &node, const Register destination)
+{
+    result(visit(node, destination), destination);
+}
+
+Lang::ByteIndex Lang::RegisterCompiler::compileCondition(const AST &condition)
+{
+    const auto mark = _temporary;
+    const auto value = visit(condition, NoRegister);
+
+    _temporary = mark;
+    return emitJump(RegisterOpCode::JumpIfFalse, value);
+}
+
+std::uint16_t Lang::RegisterCompiler::compileArguments(const AST *arguments)
+{
+    if (!arguments)
+        return 0u;
+    auto count = 0u;
+    if (arguments->type() == TokenType::Operator && arguments->operatorType() == OperatorType::Coma) {
+        // Comas are left associative so the last argument is always the right hand side
+        count = compileArguments(arguments->children()[0]);
+        arguments = arguments->children()[1];
+    }
+    // Temporaries used by an argument are released so that the next one is consecutive
+    const auto reg = allocate();
+    compileInto(*arguments, reg);
+    _temporary = reg + 1u;
+    return static_cast<std::uint16_t>(count + 1u);
+}
+
+void Lang::RegisterCompiler::compileStore(const AST &target, const Register value)
+{
+    const auto slot = target.nameSlot();
+
+    switch (target.nameType()) {
+    case NameType::Parameter:
+        emit(RegisterArgumentInstruction {
+            code: RegisterOpCode::StoreParameter,
+            reg: value,
+            argument: slot.index
+        });
+        break;
+    case NameType::Property:
+        emit(RegisterMemberInstruction {
+            code: RegisterOpCode::StoreProperty,
+            value: value,
+            name: Hash(target.literal()),
+            depth: static_cast<std::uint16_t>(slot.depth),
+            cache: nextCache()
+        });
+        break;
+    case NameType::External:
+        emit(RegisterMemberInstruction {
+            code: RegisterOpCode::StoreExternal,
+            value: value,
+            name: slot.index,
+            cache: nextExternalCache()
+        });
+        break;
+    default:
+        throwError("compileStore", "Name is not assignable", target);
+    }
+}
+
+Lang::Register Lang::RegisterCompiler::allocate(void)
+{
+    const auto reg = _temporary++;
+
+    _maxTemporary = std::max(_maxTemporary, _temporary);
+    return static_cast<Register>(reg);
+}
+
+Lang::Register Lang::RegisterCompiler::result(const Register value, const Register destination)
+{
+    if (destination == NoRegister)
+        return value;
+    else if (value != destination) {
+        emit(RegisterInstruction {
+            code: RegisterOpCode::Move,
+            output: destination,
+            lhs: value
+        });
+    }
+    return destination;
+}
+
+Lang::Register Lang::RegisterCompiler::preserve(const Register value, const AST &next)
+{
+    if (!isLocal(value) || !AssignsLocal(next, value))
+        return value;
+    const auto output = allocate();
+    emit(RegisterInstruction {
+        code: RegisterOpCode::Move,
+        output: output,
+        lhs: value
+    });
+    return output;
+}
+
+bool Lang::RegisterCompiler::AssignsLocal(const AST &node, const Register local) noexcept
+{
+    bool assigns = false;
+
+    node.traverse([local, &assigns](const AST &child) noexcept {
+        if (assigns)
+            return false;
+        else if (child.type() != TokenType::Operator)
+            return true;
+        const auto type = child.operatorType();
+        if ((type >= OperatorType::Increment && type <= OperatorType::DecrementSuffix)
+                || (type >= OperatorType::Assign && type <= OperatorType::BitXorAssign)) {
+            const auto &target = *child.children()[0];
+            assigns = target.type() == TokenType::Name && target.nameType() == NameType::Local
+                && static_cast<Register>(target.nameSlot().index) == local;
+        }
+        return !assigns;
+    });
+    return assigns;
+}
+
+void Lang::RegisterCompiler::emitLiteral(const Register output, const std::string_view &literal)
+{
+    emit(RegisterArgumentInstruction {
+        code: RegisterOpCode::LoadLiteral,
+        reg: output,
+        argument: static_cast<std::uint32_t>(literal.size())
+    });
+    const auto unitIndex = _bytecode.size();
+    _bytecode.resize(unitIndex + LiteralUnitCount(static_cast<std::uint32_t>(literal.size())));
+    std::memcpy(static_cast<void *>(&_bytecode[unitIndex]), literal.data(), literal.size());
+}
+
+Lang::ByteIndex Lang::RegisterCompiler::emitTable(const SwitchTable &table, const Register subject)
+{
+    const auto code = table.kind() == SwitchTable::Kind::Dense ? RegisterOpCode::JumpTable
+        : table.kind() == SwitchTable::Kind::Sorted ? RegisterOpCode::JumpSorted : RegisterOpCode::JumpHashed;
+    const RegisterTableInstruction instruction {
+        code: code,
+        reg: subject,
+        count: static_cast<std::uint32_t>(table.entries().size()),
+        seed: table.seed(),
+        base: table.base()
+    };
+    const auto byteIndex = emit(instruction);
+
+    // Targets and keys are appended as raw units
+    _bytecode.resize(_bytecode.size()
+        + (TableSize(instruction, code != RegisterOpCode::JumpTable) - sizeof(RegisterTableInstruction)) / sizeof(RegisterInstruction));
+    return byteIndex;
+}
+
+void Lang::RegisterCompiler::patchTable(const ByteIndex instruction, const SwitchTable &table, const Core::TinyVector<ByteIndex> &values,
+        const Core::TinyVector<ByteIndex> &bodies, const ByteIndex defaultTarget) noexcept
+{
+    auto &header = reinterpret_cast<RegisterTableInstruction &>(_bytecode[instruction / sizeof(RegisterInstruction)]);
+    const auto targets = const_cast<ByteIndex *>(TableTargets(header));
+    const auto keys = const_cast<std::int64_t *>(TableKeys(header));
+    const auto &entries = table.entries();
+
+    header.defaultTarget = defaultTarget;
+    for (auto index = 0u; index < entries.size(); ++index) {
+        const auto caseIndex = entries[index].caseIndex;
+        targets[index] = caseIndex == SwitchTable::NoCase ? defaultTarget : bodies[caseIndex];
+        if (header.code == RegisterOpCode::JumpSorted)
+            keys[index] = entries[index].key;
+        else if (header.code == RegisterOpCode::JumpHashed)
+            keys[index] = caseIndex == SwitchTable::NoCase ? -1 : static_cast<std::int64_t>(values[caseIndex]);
+    }
+}
+
+Lang::ByteIndex Lang::RegisterCompiler::emitJump(const RegisterOpCode code, const Register condition, const ByteIndex target)
+{
+    return emit(RegisterArgumentInstruction {
+        code: code,
+        reg: condition,
+        argument: target
+    });
+}
+
+void Lang::RegisterCompiler::setJumpTarget(const ByteIndex jump, const ByteIndex target) noexcept
+{
+    const auto unit = reinterpret_cast<std::byte *>(&_bytecode[jump / sizeof(RegisterInstruction)]);
+
+    std::memcpy(unit + offsetof(RegisterArgumentInstruction, argument), &target, sizeof(target));
+}
+
+void Lang::RegisterCompiler::openLoop(const bool isSwitch, const ByteIndex continueTarget)
+{
+    _loops.push(Loop {
+        continueTarget: continueTarget,
+        isSwitch: isSwitch
+    });
+}
+
+void Lang::RegisterCompiler::closeLoop(void) noexcept
+{
+    const auto loop = static_cast<std::uint16_t>(_loops.size() - 1u);
+    const auto end = nextByteIndex();
+    const auto continueTarget = _loops.back().continueTarget;
+    auto out = _jumps.begin();
+
+    // Jumps of outer loops are kept in order
+    for (const auto &jump : _jumps) {
+        if (jump.loop == loop)
+            setJumpTarget(jump.instruction, jump.isBreak ? end : continueTarget);
+        else
+            *out++ = jump;
+    }
+    _jumps.erase(out, _jumps.end());
+    _loops.pop();
+}
+
+void Lang::RegisterCompiler::throwError(const char * const where, const char * const what, const AST &node) const
+{
+    std::string error = std::string("Lang::RegisterCompiler::") + where + ": " + what + '\n';
+
+    if (const auto token = node.token(); token) {
+        error += "At symbol '" + std::string(token->literal()) + "' from " + std::string(_context)
+            + ":l" + std::to_string(token->line) + ":c" + std::to_string(token->column);
+    } else
+        error += "From " + std::string(_context);
+    throw std::logic_error(error);
+}
+
+Lang::Register Lang::RegisterCompiler::handle(TokenTag<TokenType::Expression>, const AST &node, const Register)
+{
+    for (const auto *child : node.children())
+        compileStatement(*child);
+    return NoRegister;
+}
+
+Lang::Register Lang::RegisterCompiler::handle(TokenTag<TokenType::Local>, const AST &node, const Register)
+{
+    const auto children = node.children();
+
+    compileInto(*children[2], static_cast<Register>(children[1]->nameSlot().index));
+    return NoRegister;
+}
+
+Lang::Register Lang::RegisterCompiler::handle(TokenTag<TokenType::Name>, const AST &node, const Register destination)
+{
+    const auto slot = node.nameSlot();
+
+    switch (node.nameType()) {
+    case NameType::Local:
+        // Locals are read in place, operators copy them first when a later operand assigns them
+        return result(static_cast<Register>(slot.index), destination);
+    case NameType::Parameter:
+    {
+        const auto output = target(destination);
+        emit(RegisterArgumentInstruction {
+            code: RegisterOpCode::LoadParameter,
+            reg: output,
+            argument: slot.index
+        });
+        return output;
+    }
+    case NameType::Property:
+    {
+        const auto output = target(destination);
+        emit(RegisterMemberInstruction {
+            code: RegisterOpCode::LoadProperty,
+            value: output,
+            name: Hash(node.literal()),
+            depth: static_cast<std::uint16_t>(slot.depth),
+            cache: nextCache()
+        });
+        return output;
+    }
+    case NameType::External:
+    {
+        const auto output = target(destination);
+        emit(RegisterMemberInstruction {
+            code: RegisterOpCode::LoadExternal,
+            value: output,
+            name: slot.index,
+            cache: nextExternalCache()
+        });
+        return output;
+    }
+    default:
+        throwError("handle", "Name can't be used as a value", node);
+    }
+}
+
+Lang::Register Lang::RegisterCompiler::handle(TokenTag<TokenType::Constant>, const AST &node, const Register destination)
+{
+    const auto output = target(destination);
+
+    if (node.constantType() == ConstantType::Char) {
+        const auto literal = node.literal();
+        if (literal.size() < 3u) [[unlikely]]
+            throwError("handle", "Invalid character constant", node);
+        auto character = literal[1];
+        if (character == '\\') {
+            switch (literal[2]) {
+            case 'n':
+                character = '\n';
+                break;
+            case 't':
+                character = '\t';
+                break;
+            case '0':
+                character = '\0';
+                break;
+            default:
+                character = literal[2];
+                break;
+            }
+        }
+        emit(RegisterImmediateInstruction {
+            code: RegisterOpCode::LoadInteger,
+            output: output,
+            integer: character
+        });
+        return output;
+    }
+    const auto value = Optimizer::ParseConstant(node);
+    switch (value.kind) {
+    case Optimizer::ValueKind::Integer:
+        emit(RegisterImmediateInstruction {
+            code: RegisterOpCode::LoadInteger,
+            output: output,
+            integer: value.integer
+        });
+        break;
+    case Optimizer::ValueKind::Floating:
+        emit(RegisterImmediateInstruction {
+            code: RegisterOpCode::LoadFloating,
+            output: output,
+            floating: value.floating
+        });
+        break;
+    case Optimizer::ValueKind::Boolean:
+        emit(RegisterArgumentInstruction {
+            code: RegisterOpCode::LoadBoolean,
+            reg: output,
+            argument: value.boolean
+        });
+        break;
+    case Optimizer::ValueKind::Literal:
+        emitLiteral(output, value.literal);
+        break;
+    default:
+        throwError("handle", "Invalid constant", node);
+    }
+    return output;
+}
+
+Lang::Register Lang::RegisterCompiler::handle(StatementTag<StatementType::If>, const AST &node, const Register)
+{
+    const auto children = node.children();
+    Core::TinyVector<ByteIndex> ends;
+
+    // Children are stored as (condition, body) pairs followed by an optional else body
+    for (auto i = 0u; i < children.size();) {
+        if (i + 1 < children.size()) {
+            const auto jump = compileCondition(*children[i]);
+            compileStatement(*children[i + 1]);
+            if (i + 2 < children.size())
+                ends.push(emitJump(RegisterOpCode::Jump));
+            patchJump(jump);
+            i += 2;
+        } else {
+            compileStatement(*children[i]);
+            ++i;
+        }
+    }
+    for (const auto end : ends)
+        patchJump(end);
+    return NoRegister;
+}
+
+Lang::Register Lang::RegisterCompiler::handle(StatementTag<StatementType::While>, const AST &node, const Register)
+{
+    const auto children = node.children();
+    const auto begin = nextByteIndex();
+
+    openLoop(false, begin);
+    const auto jump = compileCondition(*children[0]);
+    compileStatement(*children[1]);
+    emitJump(RegisterOpCode::Jump, NoRegister, begin);
+    patchJump(jump);
+    closeLoop();
+    return NoRegister;
+}
+
+Lang::Register Lang::RegisterCompiler::handle(StatementTag<StatementType::For>, const AST &node, const Register)
+{
+    const auto children = node.children();
+
+    compileStatement(*children[0]);
+    const auto begin = nextByteIndex();
+    openLoop(false);
+    const auto jump = compileCondition(*children[1]);
+    compileStatement(*children[3]);
+    _loops.back().continueTarget = nextByteIndex();
+    compileStatement(*children[2]);
+    emitJump(RegisterOpCode::Jump, NoRegister, begin);
+    patchJump(jump);
+    closeLoop();
+    return NoRegister;
+}
+
+Lang::Register Lang::RegisterCompiler::handle(StatementTag<StatementType::Switch>, const AST &node, const Register)
+{
+    const auto children = node.children();
+    const SwitchTable table(node);
+    Core::TinyVector<ByteIndex> ends;
+    Core::TinyVector<ByteIndex> values;
+    Core::TinyVector<ByteIndex> bodies;
+    auto defaultTarget = NoByteIndex;
+
+    // The tested value is copied as case bodies may modify it
+    // A table jumps to the body of the matching case, values of another type are compared one case at a time
+    const auto subject = allocate();
+    compileInto(*children[0], subject);
+    _temporary = subject + 1u;
+    const auto dispatch = table.kind() != SwitchTable::Kind::None ? emitTable(table, subject) : NoByteIndex;
+    openLoop(true);
+    for (auto i = 1u; i < children.size();) {
+        if (i + 1 < children.size()) {
+            values.push(nextByteIndex());
+            const auto value = visit(*children[i], NoRegister);
+            const auto test = allocate();
+            emit(RegisterInstruction {
+                code: RegisterOpCode::Equal,
+                output: test,
+                lhs: subject,
+                rhs: value
+            });
+            const auto jump = emitJump(RegisterOpCode::JumpIfFalse, test);
+            _temporary = subject + 1u;
+            bodies.push(nextByteIndex());
+            compileStatement(*children[i + 1]);
+            ends.push(emitJump(RegisterOpCode::Jump));
+            patchJump(jump);
+            i += 2;
+        } else {
+            defaultTarget = nextByteIndex();
+            compileStatement(*children[i]);
+            ++i;
+        }
+    }
+    if (defaultTarget == NoByteIndex)
+        defaultTarget = nextByteIndex();
+    for (const auto end : ends)
+        patchJump(end);
+    if (dispatch != NoByteIndex)
+        patchTable(dispatch, table, values, bodies, defaultTarget);
+    closeLoop();
+    return NoRegister;
+}
+
+Lang::Register Lang::RegisterCompiler::handle(StatementTag<StatementType::Break>, const AST &node, const Register)
+{
+    if (_loops.empty()) [[unlikely]]
+        throwError("handle", "Break statement outside of a loop or a switch", node);
+    _jumps.push(PendingJump {
+        instruction: emitJump(RegisterOpCode::Jump),
+        loop: static_cast<std::uint16_t>(_loops.size() - 1u),
+        isBreak: true
+    });
+    return NoRegister;
+}
+
+Lang::Register Lang::RegisterCompiler::handle(StatementTag<StatementType::Continue>, const AST &node, const Register)
+{
+    auto loop = _loops.size();
+
+    while (loop && _loops[loop - 1u].isSwitch)
+        --loop;
+    if (!loop) [[unlikely]]
+        throwError("handle", "Continue statement outside of a loop", node);
+    _jumps.push(PendingJump {
+        instruction: emitJump(RegisterOpCode::Jump),
+        loop: static_cast<std::uint16_t>(loop - 1u),
+        isBreak: false
+    });
+    return NoRegister;
+}
+
+Lang::Register Lang::RegisterCompiler::handle(StatementTag<StatementType::Return>, const AST &node, const Register)
+{
+    emit(RegisterArgumentInstruction {
+        code: RegisterOpCode::Return,
+        reg: visit(*node.children()[0], NoRegister)
+    });
+    return NoRegister;
+}
+
+Lang::Register Lang::RegisterCompiler::handle(StatementTag<StatementType::Emit>, const AST &node, const Register)
+{
+    const auto &call = *node.children()[0];
+
+    if (call.type() != TokenType::Operator || call.operatorType() != OperatorType::Call
+            || call.children()[0]->type() != TokenType::Name || call.children()[0]->nameType() != NameType::Signal) [[unlikely]]
+        throwError("handle", "Only signals can be emitted", node);
+    visit(call, NoRegister);
+    return NoRegister;
+}
+
+Lang::Register Lang::RegisterCompiler::handleDefault(const AST &node, const Register)
+{
+    throwError("handleDefault", "Node can't be compiled", node);
+}
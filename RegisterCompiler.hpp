@@ -0,0 +1,186 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: RegisterCompiler
+ */
+
+#pragma once
+
+#include "Compiler.hpp"
+
+namespace kF::Lang
+{
+    class RegisterCompiler;
+}
+
+/** @brief The RegisterCompiler lowers the bodies of a resolved syntax tree into register machine expressions
+ *  Locals live in the first registers of the frame, temporaries are allocated above them in a stack-like fashion
+ *  Every expression handler returns the register holding its value, it is written in 'destination' unless it is 'NoRegister'
+ *  Statements return 'NoRegister' */
+class alignas_cacheline kF::Lang::RegisterCompiler : public Visitor<RegisterCompiler, Register, Register>
+{
+public:
+    /** @brief Compiled members share the layout of the stack machine ones */
+    using Unit = Compiler::Unit;
+    using Units = Compiler::Units;
+
+    /** @brief Instruction stream under construction */
+    using Bytecode = Core::Vector<RegisterInstruction>;
+
+
+    /** @brief Compile every member with a body of a syntax tree, the tree must be resolved */
+    [[nodiscard]] Units run(const SyntaxTree &tree, const std::string_view &context);
+
+    /** @brief Compile the body of a single member */
+    [[nodiscard]] Expression::Ptr compile(const AST &member, const std::string_view &context);
+
+    /** @brief Compile the condition of an event that is not connected to a signal into a predicate */
+    [[nodiscard]] Expression::Ptr compilePredicate(const AST &event, const std::string_view &context);
+
+private:
+    /** @brief A break or continue waiting for its loop to be closed */
+    struct alignas_eighth_cacheline PendingJump
+    {
+        ByteIndex instruction { 0u };
+        std::uint16_t loop { 0u };
+        bool isBreak { false };
+    };
+
+    /** @brief A loop (or switch) being compiled */
+    struct alignas_eighth_cacheline Loop
+    {
+        ByteIndex continueTarget { 0u };
+        bool isSwitch { false };
+    };
+
+    // Cacheline 1
+    std::string_view _context {};
+    Bytecode _bytecode {};
+    Core::TinyVector<PendingJump> _jumps {};
+    Core::TinyVector<Loop> _loops {};
+    std::uint32_t _localCount { 0u };
+    std::uint32_t _temporary { 0u };
+    std::uint32_t _maxTemporary { 0u };
+    CacheIndex _cacheCount { 0u };
+    CacheIndex _externalCacheCount { 0u };
+    NameAccesses _accesses {};
+
+    friend Visitor<RegisterCompiler, Register, Register>;
+
+    /** @brief Compile a body of a member into an expression */
+    [[nodiscard]] Expression::Ptr compileBody(const AST &member, const AST &body, const bool isValue, const std::string_view &context);
+
+    /** @brief Compile a body whose value is returned when it holds a single expression */
+    void compileValue(const AST &body);
+
+    /** @brief Compile a body that returns nothing unless it uses a return statement */
+    void compileBlock(const AST &body);
+
+    /** @brief Compile a statement or an expression whose value is discarded */
+    void compileStatement(const AST &node);
+
+    /** @brief Compile an expression whose value must be written in 'destination' */
+    void compileInto(const AST &node, const Register destination);
+
+    /** @brief Compile a condition followed by a jump taken when it is false, returns the byte index of the jump */
+    [[nodiscard]] ByteIndex compileCondition(const AST &condition);
+
+    /** @brief Compile the arguments of a call into consecutive temporaries, returns their count */
+    [[nodiscard]] std::uint16_t compileArguments(const AST *arguments);
+
+    /** @brief Compile a store of a register into an assignable name */
+    void compileStore(const AST &target, const Register value);
+
+    /** @brief Compile an assignment whose value is computed by 'value' out of the previous value register (or 'NoRegister')
+     *  Returns the register holding the assigned value */
+    template<typename Value>
+    [[nodiscard]] Register compileAssignment(const AST &target, const bool loadTarget, Value &&value);
+
+
+    /** @brief Allocate a temporary register */
+    [[nodiscard]] Register allocate(void);
+
+    /** @brief Get the register an expression writes its value into */
+    [[nodiscard]] Register target(const Register destination)
+        { return destination != NoRegister ? destination : allocate(); }
+
+    /** @brief Move a value into 'destination' when required, returns the register holding the value */
+    Register result(const Register value, const Register destination);
+
+    /** @brief Copy a local read in place into a temporary when a later operand may assign it, returns the register holding the value */
+    [[nodiscard]] Register preserve(const Register value, const AST &next);
+
+    /** @brief Check if a subtree may assign or step a local */
+    [[nodiscard]] static bool AssignsLocal(const AST &node, const Register local) noexcept;
+
+    /** @brief Allocate an inline cache, its overflow is checked once the member is compiled */
+    [[nodiscard]] std::uint16_t nextCache(void) noexcept { return static_cast<std::uint16_t>(_cacheCount++); }
+
+    /** @brief Allocate an external cache, its overflow is checked once the member is compiled */
+    [[nodiscard]] std::uint16_t nextExternalCache(void) noexcept { return static_cast<std::uint16_t>(_externalCacheCount++); }
+
+    /** @brief Check if a register holds a local */
+    [[nodiscard]] bool isLocal(const Register reg) const noexcept { return reg < _localCount; }
+
+
+    /** @brief Append an instruction made of one or more units */
+    template<typename Type>
+    ByteIndex emit(const Type &instruction);
+    void emitLiteral(const Register output, const std::string_view &literal);
+
+    /** @brief Emit the table instruction of a switch on 'subject', its targets are patched once its cases are compiled */
+    ByteIndex emitTable(const SwitchTable &table, const Register subject);
+
+    /** @brief Patch the targets of a table instruction out of the byte index of the value and of the body of each case */
+    void patchTable(const ByteIndex instruction, const SwitchTable &table, const Core::TinyVector<ByteIndex> &values,
+            const Core::TinyVector<ByteIndex> &bodies, const ByteIndex defaultTarget) noexcept;
+
+    /** @brief Get the byte index of the next instruction */
+    [[nodiscard]] ByteIndex nextByteIndex(void) const noexcept
+        { return static_cast<ByteIndex>(_bytecode.size() * sizeof(RegisterInstruction)); }
+
+    /** @brief Emit a jump, taken when 'condition' is false (or true) if it is not 'NoRegister' */
+    ByteIndex emitJump(const RegisterOpCode code, const Register condition = NoRegister, const ByteIndex target = 0u);
+
+    /** @brief Make a jump target the next instruction */
+    void patchJump(const ByteIndex jump) noexcept { setJumpTarget(jump, nextByteIndex()); }
+
+    /** @brief Set the target of a jump */
+    void setJumpTarget(const ByteIndex jump, const ByteIndex target) noexcept;
+
+    /** @brief Open a loop, 'continueTarget' may be set later */
+    void openLoop(const bool isSwitch, const ByteIndex continueTarget = 0u);
+
+    /** @brief Close the last loop and patch its pending jumps */
+    void closeLoop(void) noexcept;
+
+    /** @brief Throw a compilation error on a node */
+    [[noreturn]] void throwError(const char * const where, const char * const what, const AST &node) const;
+
+
+    /** @brief Blocks, locals and leaves */
+    Register handle(TokenTag<TokenType::Expression>, const AST &node, const Register destination);
+    Register handle(TokenTag<TokenType::Local>, const AST &node, const Register destination);
+    Register handle(TokenTag<TokenType::Name>, const AST &node, const Register destination);
+    Register handle(TokenTag<TokenType::Constant>, const AST &node, const Register destination);
+
+    /** @brief Operators */
+    template<OperatorType Type>
+    Register handle(OperatorTag<Type>, const AST &node, const Register destination);
+
+    /** @brief Statements */
+    Register handle(StatementTag<StatementType::If>, const AST &node, const Register destination);
+    Register handle(StatementTag<StatementType::While>, const AST &node, const Register destination);
+    Register handle(StatementTag<StatementType::For>, const AST &node, const Register destination);
+    Register handle(StatementTag<StatementType::Switch>, const AST &node, const Register destination);
+    Register handle(StatementTag<StatementType::Break>, const AST &node, const Register destination);
+    Register handle(StatementTag<StatementType::Continue>, const AST &node, const Register destination);
+    Register handle(StatementTag<StatementType::Return>, const AST &node, const Register destination);
+    Register handle(StatementTag<StatementType::Emit>, const AST &node, const Register destination);
+
+    /** @brief Any other node can't be compiled */
+    Register handleDefault(const AST &node, const Register destination);
+};
+
+static_assert_fit_cacheline(kF::Lang::RegisterCompiler);
+
+#include "RegisterCompiler.ipp"
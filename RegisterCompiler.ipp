@@ -0,0 +1,253 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: RegisterCompiler
+ */
+
+#include <cstring>
+#include <type_traits>
+
+namespace kF::Lang
+{
+    /** @brief Get the register machine operation code of an unary or binary stack machine one, both enumerations share their order */
+    [[nodiscard]] constexpr RegisterOpCode ToRegisterOpCode(const OpCode code) noexcept
+    {
+        return static_cast<RegisterOpCode>(static_cast<std::uint32_t>(RegisterOpCode::Not)
+            + static_cast<std::uint32_t>(code) - static_cast<std::uint32_t>(OpCode::Not));
+    }
+
+    static_assert(ToRegisterOpCode(OpCode::ToBoolean) == RegisterOpCode::ToBoolean, "Lang::ToRegisterOpCode: Unary operation codes are not in sync");
+    static_assert(ToRegisterOpCode(OpCode::BitXor) == RegisterOpCode::BitXor, "Lang::ToRegisterOpCode: Binary operation codes are not in sync");
+}
+
+template<typename Type>
+inline kF::Lang::ByteIndex kF::Lang::RegisterCompiler::emit(const Type &instruction)
+{
+    static_assert(sizeof(Type) % sizeof(RegisterInstruction) == 0u, "Lang::RegisterCompiler::emit: Instruction must be made of whole units");
+
+    const auto byteIndex = nextByteIndex();
+    const auto unitIndex = _bytecode.size();
+
+    // Stores and calls may trigger any access
+    if constexpr (std::is_same_v<Type, RegisterMemberInstruction>) {
+        const auto code = instruction.code;
+        if (code == RegisterOpCode::LoadProperty || code == RegisterOpCode::LoadExternal || code == RegisterOpCode::GetMember)
+            _accesses.read(instruction.name);
+        else
+            _accesses.accessAny();
+    }
+
+    _bytecode.resize(unitIndex + sizeof(Type) / sizeof(RegisterInstruction));
+    std::memcpy(static_cast<void *>(&_bytecode[unitIndex]), &instruction, sizeof(Type));
+    return byteIndex;
+}
+
+template<typename Value>
+inline kF::Lang::Register kF::Lang::RegisterCompiler::compileAssignment(const AST &target, const bool loadTarget, Value &&value)
+{
+    if (target.type() == TokenType::Name) {
+        // Locals are computed in place
+        if (target.nameType() == NameType::Local) {
+            const auto local = static_cast<Register>(target.nameSlot().index);
+            value(loadTarget ? local : NoRegister, local);
+            return local;
+        }
+        const auto previous = loadTarget ? visit(target, NoRegister) : NoRegister;
+        const auto assigned = value(previous, NoRegister);
+        compileStore(target, assigned);
+        return assigned;
+    } else if (target.type() == TokenType::Operator && target.operatorType() == OperatorType::Dot) {
+        const auto &member = *target.children()[1];
+        if (member.type() != TokenType::Name) [[unlikely]]
+            throwError("compileAssignment", "Invalid member access", target);
+        const auto object = allocate();
+        compileInto(*target.children()[0], object);
+        _temporary = object + 1u;
+        auto previous = NoRegister;
+        if (loadTarget) {
+            previous = allocate();
+            emit(RegisterMemberInstruction {
+                code: RegisterOpCode::GetMember,
+                value: previous,
+                name: member.nameSlot().index,
+                arguments: object,
+                cache: nextCache()
+            });
+        }
+        const auto assigned = value(previous, NoRegister);
+        emit(RegisterMemberInstruction {
+            code: RegisterOpCode::SetMember,
+            value: assigned,
+            name: member.nameSlot().index,
+            arguments: object,
+            cache: nextCache()
+        });
+        return assigned;
+    } else
+        throwError("compileAssignment", "Expression is not assignable", target);
+}
+
+template<kF::Lang::OperatorType Type>
+inline kF::Lang::Register kF::Lang::RegisterCompiler::handle(OperatorTag<Type>, const AST &node, const Register destination)
+{
+    const auto children = node.children();
+    const auto mark = _temporary;
+
+    if constexpr (Type == OperatorType::Not || Type == OperatorType::Minus || Type == OperatorType::BitReverse) {
+        const auto value = visit(*children[0], NoRegister);
+        _temporary = mark;
+        const auto output = target(destination);
+        emit(RegisterInstruction {
+            code: ToRegisterOpCode(GetOperatorOpCode(Type)),
+            output: output,
+            lhs: value
+        });
+        return output;
+    } else if constexpr (Type == OperatorType::Increment || Type == OperatorType::Decrement
+            || Type == OperatorType::IncrementSuffix || Type == OperatorType::DecrementSuffix) {
+        constexpr bool IsIncrement = Type == OperatorType::Increment || Type == OperatorType::IncrementSuffix;
+        const auto assigned = compileAssignment(*children[0], true, [this](const Register previous, const Register output) {
+            const auto value = target(output);
+            emit(RegisterInstruction {
+                code: IsIncrement ? RegisterOpCode::Increment : RegisterOpCode::Decrement,
+                output: value,
+                lhs: previous
+            });
+            return value;
+        });
+        if constexpr (Type == OperatorType::Increment || Type == OperatorType::Decrement)
+            return result(assigned, destination);
+        else {
+            // The previous value is recomputed from the stored one
+            const auto output = target(destination);
+            emit(RegisterInstruction {
+                code: IsIncrement ? RegisterOpCode::Decrement : RegisterOpCode::Increment,
+                output: output,
+                lhs: assigned
+            });
+            return output;
+        }
+    } else if constexpr (Type == OperatorType::And || Type == OperatorType::Or) {
+        // A local destination could be read by the right hand side after being written
+        const auto output = destination != NoRegister && !isLocal(destination) ? destination : allocate();
+        compileInto(*children[0], output);
+        const auto jump = emitJump(Type == OperatorType::And ? RegisterOpCode::JumpIfFalse : RegisterOpCode::JumpIfTrue, output);
+        compileInto(*children[1], output);
+        patchJump(jump);
+        emit(RegisterInstruction {
+            code: RegisterOpCode::ToBoolean,
+            output: output,
+            lhs: output
+        });
+        return result(output, destination);
+    } else if constexpr (Type == OperatorType::Assign) {
+        return result(compileAssignment(*children[0], false, [this, &children](const Register, const Register output) {
+            return result(visit(*children[1], output), output);
+        }), destination);
+    } else if constexpr (Type >= OperatorType::AdditionAssign && Type <= OperatorType::BitXorAssign) {
+        return result(compileAssignment(*children[0], true, [this, &children](const Register previous, const Register output) {
+            const auto lhs = preserve(previous, *children[1]);
+            const auto rhs = visit(*children[1], NoRegister);
+            const auto value = target(output);
+            emit(RegisterInstruction {
+                code: ToRegisterOpCode(GetOperatorOpCode(Type)),
+                output: value,
+                lhs: lhs,
+                rhs: rhs
+            });
+            return value;
+        }), destination);
+    } else if constexpr (GetOperatorOpCode(Type) != OpCode::None) {
+        const auto lhs = preserve(visit(*children[0], NoRegister), *children[1]);
+        const auto rhs = visit(*children[1], NoRegister);
+        _temporary = mark;
+        const auto output = target(destination);
+        emit(RegisterInstruction {
+            code: ToRegisterOpCode(GetOperatorOpCode(Type)),
+            output: output,
+            lhs: lhs,
+            rhs: rhs
+        });
+        return output;
+    } else if constexpr (Type == OperatorType::Coma) {
+        compileStatement(*children[0]);
+        return visit(*children[1], destination);
+    } else if constexpr (Type == OperatorType::Dot) {
+        // Method calls are parsed as a dot whose right hand side is a call
+        const auto &member = *children[1];
+        if (member.type() == TokenType::Name) {
+            const auto object = visit(*children[0], NoRegister);
+            _temporary = mark;
+            const auto output = target(destination);
+            emit(RegisterMemberInstruction {
+                code: RegisterOpCode::GetMember,
+                value: output,
+                name: member.nameSlot().index,
+                arguments: object,
+                cache: nextCache()
+            });
+            return output;
+        } else if (member.type() == TokenType::Operator && member.operatorType() == OperatorType::Call
+                && member.children()[0]->type() == TokenType::Name) {
+            const auto arguments = member.children();
+            const auto object = allocate();
+            compileInto(*children[0], object);
+            _temporary = object + 1u;
+            const auto argumentCount = compileArguments(arguments.size() > 1u ? arguments[1] : nullptr);
+            _temporary = mark;
+            const auto output = target(destination);
+            emit(RegisterMemberInstruction {
+                code: RegisterOpCode::CallMember,
+                value: output,
+                name: arguments[0]->nameSlot().index,
+                argumentCount: argumentCount,
+                arguments: static_cast<Register>(object + 1u)
+            });
+            return output;
+        } else [[unlikely]]
+            throwError("handle", "Invalid member access", node);
+    } else if constexpr (Type == OperatorType::Call) {
+        const auto &callee = *children[0];
+        const auto *arguments = children.size() > 1u ? children[1] : nullptr;
+        if (callee.type() != TokenType::Name) [[unlikely]]
+            throwError("handle", "Expression is not callable", node);
+        const auto slot = callee.nameSlot();
+        auto code = RegisterOpCode::None;
+        switch (callee.nameType()) {
+        case NameType::Function:
+            code = RegisterOpCode::CallFunction;
+            break;
+        case NameType::Signal:
+            code = RegisterOpCode::Emit;
+            break;
+        case NameType::External:
+            code = RegisterOpCode::CallExternal;
+            break;
+        default:
+            throwError("handle", "Variable is not callable", callee);
+        }
+        const auto first = static_cast<Register>(_temporary);
+        const auto argumentCount = compileArguments(arguments);
+        _temporary = mark;
+        const auto output = target(destination);
+        emit(RegisterMemberInstruction {
+            code: code,
+            value: output,
+            name: code == RegisterOpCode::CallExternal ? slot.index : Hash(callee.literal()),
+            depth: static_cast<std::uint16_t>(slot.depth),
+            argumentCount: argumentCount,
+            arguments: first,
+            cache: code == RegisterOpCode::CallExternal ? nextExternalCache() : std::uint16_t {}
+        });
+        return output;
+    } else if constexpr (Type == OperatorType::TernaryIf) {
+        const auto output = destination != NoRegister && !isLocal(destination) ? destination : allocate();
+        const auto jump = compileCondition(*children[0]);
+        compileInto(*children[1], output);
+        const auto end = emitJump(RegisterOpCode::Jump);
+        patchJump(jump);
+        compileInto(*children[2], output);
+        patchJump(end);
+        return result(output, destination);
+    } else
+        return handleDefault(node, destination);
+}
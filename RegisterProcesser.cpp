@@ -0,0 +1,459 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: RegisterProcesser
+ */
+
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+
+#include "RegisterProcesser.hpp"
+#include "Processer.hpp"
+
+using namespace kF;
+using namespace kF::Lang::Processer;
+
+namespace kF::Lang
+{
+    /** @brief Name of the processing function used by errors */
+    constexpr auto Where = "Lang::RegisterProcesser::process";
+}
+
+Lang::RegisterProcesser &Lang::RegisterProcesser::Local(void) noexcept
+{
+    thread_local RegisterProcesser processer;
+
+    return processer;
+}
+
+Var Lang::RegisterProcesser::process(const Expression &expression, Object * const *instances, Var *args)
+{
+    const auto base = _top;
+    const auto top = base + expression.frameSize() + expression.stackSize();
+
+    // The register file can only grow when no frame is running as frames reference their arguments by address
+    if (top > _registers.size()) [[unlikely]] {
+        if (base) [[unlikely]]
+            throw std::logic_error("Lang::RegisterProcesser::process: Register file overflow");
+        _registers.resize(top);
+    }
+    _top = top;
+
+    Var * const registers = _registers.data() + base;
+    const auto * const code = reinterpret_cast<const std::byte *>(expression.data());
+    const auto *it = code;
+
+    // The frame is released on return as on error
+    struct FrameGuard
+    {
+        RegisterProcesser &processer;
+        Var * const registers;
+        const std::uint32_t base;
+        const std::uint32_t top;
+
+        ~FrameGuard(void) noexcept { Release(registers, registers + (top - base)); processer._top = base; }
+    } guard { *this, registers, base, top };
+
+    const auto unary = [registers](const RegisterInstruction &instruction, auto &&operation) {
+        registers[instruction.output] = operation(registers[instruction.lhs]);
+    };
+    const auto binary = [registers](const RegisterInstruction &instruction, auto &&operation) {
+        registers[instruction.output] = operation(registers[instruction.lhs], registers[instruction.rhs]);
+    };
+    const auto quicken = [registers](const RegisterInstruction &instruction, const RegisterOpCode integer, const RegisterOpCode floating) {
+        if (Holds<std::int64_t>(registers[instruction.lhs], registers[instruction.rhs]))
+            Rewrite(instruction.code, integer);
+        else if (Holds<double>(registers[instruction.lhs], registers[instruction.rhs]))
+            Rewrite(instruction.code, floating);
+    };
+    const auto table = [&it, code](const RegisterTableInstruction &instruction, const std::uint32_t entry) {
+        if (entry == NoTableEntry) [[unlikely]]
+            it += TableSize(instruction, instruction.code != RegisterOpCode::JumpTable);
+        else
+            it = code + TableTarget(instruction, entry);
+    };
+    const auto call = [registers](const RegisterMemberInstruction &member, const Meta::Function &function, Object &instance) {
+        registers[member.value] = function.invoke(&instance, registers + member.arguments);
+    };
+
+    // Each handler ends with its own indirect jump when threaded, so that every jump is predicted on its own
+#if KUBE_INTERPRETER_THREADED_DISPATCH
+    static const void * const Labels[] = {
+        &&LabelNone,
+        &&LabelMove,
+        &&LabelLoadVoid,
+        &&LabelLoadBoolean,
+        &&LabelLoadInteger,
+        &&LabelLoadFloating,
+        &&LabelLoadLiteral,
+        &&LabelLoadParameter,
+        &&LabelStoreParameter,
+        &&LabelLoadProperty,
+        &&LabelStoreProperty,
+        &&LabelLoadExternal,
+        &&LabelStoreExternal,
+        &&LabelGetMember,
+        &&LabelSetMember,
+        &&LabelNot,
+        &&LabelMinus,
+        &&LabelBitReverse,
+        &&LabelIncrement,
+        &&LabelDecrement,
+        &&LabelToBoolean,
+        &&LabelAddition,
+        &&LabelSubstraction,
+        &&LabelMultiplication,
+        &&LabelDivision,
+        &&LabelModulo,
+        &&LabelEqual,
+        &&LabelDifferent,
+        &&LabelGreater,
+        &&LabelGreaterEqual,
+        &&LabelLighter,
+        &&LabelLighterEqual,
+        &&LabelBitAnd,
+        &&LabelBitOr,
+        &&LabelBitXor,
+        &&LabelJump,
+        &&LabelJumpIfFalse,
+        &&LabelJumpIfTrue,
+        &&LabelJumpTable,
+        &&LabelJumpSorted,
+        &&LabelJumpHashed,
+        &&LabelIntegerAddition,
+        &&LabelIntegerSubstraction,
+        &&LabelIntegerMultiplication,
+        &&LabelIntegerGreater,
+        &&LabelIntegerGreaterEqual,
+        &&LabelIntegerLighter,
+        &&LabelIntegerLighterEqual,
+        &&LabelFloatingAddition,
+        &&LabelFloatingSubstraction,
+        &&LabelFloatingMultiplication,
+        &&LabelFloatingGreater,
+        &&LabelFloatingGreaterEqual,
+        &&LabelFloatingLighter,
+        &&LabelFloatingLighterEqual,
+        &&LabelCallFunction,
+        &&LabelCallExternal,
+        &&LabelCallMember,
+        &&LabelEmit,
+        &&LabelReturn
+    };
+    static_assert(std::size(Labels) == RegisterOpCodeCount, "Lang::RegisterProcesser::process: Dispatch table is not in sync with operation codes");
+
+# define TARGET(Name) case RegisterOpCode::Name: Label##Name
+# define DISPATCH() instruction = &As<RegisterInstruction>(it); goto *Labels[static_cast<std::size_t>(Observe(instruction->code))]
+#else
+# define TARGET(Name) case RegisterOpCode::Name
+# define DISPATCH() continue
+#endif
+
+    const RegisterInstruction *instruction;
+    while (true) {
+        instruction = &As<RegisterInstruction>(it);
+        switch (Observe(instruction->code)) {
+        // Loads and stores
+        TARGET(Move):
+            registers[instruction->output].assign(registers[instruction->lhs]);
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(LoadVoid):
+            registers[instruction->output].destruct();
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(LoadBoolean):
+        {
+            const auto &load = As<RegisterArgumentInstruction>(it);
+            registers[load.reg] = Var(static_cast<bool>(load.argument));
+            it += sizeof(RegisterArgumentInstruction);
+            DISPATCH();
+        }
+        TARGET(LoadInteger):
+        {
+            const auto &load = As<RegisterImmediateInstruction>(it);
+            registers[load.output] = Var(load.integer);
+            it += sizeof(RegisterImmediateInstruction);
+            DISPATCH();
+        }
+        TARGET(LoadFloating):
+        {
+            const auto &load = As<RegisterImmediateInstruction>(it);
+            registers[load.output] = Var(load.floating);
+            it += sizeof(RegisterImmediateInstruction);
+            DISPATCH();
+        }
+        TARGET(LoadLiteral):
+        {
+            const auto &load = As<RegisterArgumentInstruction>(it);
+            registers[load.reg] = Var(std::string(reinterpret_cast<const char *>(it + sizeof(RegisterArgumentInstruction)), load.argument));
+            it += sizeof(RegisterArgumentInstruction) * (1u + LiteralUnitCount(load.argument));
+            DISPATCH();
+        }
+        TARGET(LoadParameter):
+        {
+            const auto &load = As<RegisterArgumentInstruction>(it);
+            registers[load.reg].assign(args[load.argument]);
+            it += sizeof(RegisterArgumentInstruction);
+            DISPATCH();
+        }
+        TARGET(StoreParameter):
+        {
+            const auto &store = As<RegisterArgumentInstruction>(it);
+            args[store.argument].assign(registers[store.reg]);
+            it += sizeof(RegisterArgumentInstruction);
+            DISPATCH();
+        }
+        TARGET(LoadProperty):
+        {
+            const auto &member = As<RegisterMemberInstruction>(it);
+            auto &instance = *instances[member.depth];
+            registers[member.value] = GetVar(instance, FindData(Where, expression.cacheAt(member.cache), instance, member.name), member.name);
+            it += sizeof(RegisterMemberInstruction);
+            DISPATCH();
+        }
+        TARGET(StoreProperty):
+        {
+            const auto &member = As<RegisterMemberInstruction>(it);
+            auto &instance = *instances[member.depth];
+            instance.setVar(FindData(Where, expression.cacheAt(member.cache), instance, member.name), registers[member.value]);
+            it += sizeof(RegisterMemberInstruction);
+            DISPATCH();
+        }
+        TARGET(LoadExternal):
+        {
+            const auto &member = As<RegisterMemberInstruction>(it);
+            Meta::Data data;
+            auto &instance = FindExternalData(Where, expression.externalCacheAt(member.cache), instances, member.name, data);
+            registers[member.value] = GetVar(instance, data, member.name);
+            it += sizeof(RegisterMemberInstruction);
+            DISPATCH();
+        }
+        TARGET(StoreExternal):
+        {
+            const auto &member = As<RegisterMemberInstruction>(it);
+            Meta::Data data;
+            auto &instance = FindExternalData(Where, expression.externalCacheAt(member.cache), instances, member.name, data);
+            instance.setVar(data, registers[member.value]);
+            it += sizeof(RegisterMemberInstruction);
+            DISPATCH();
+        }
+        TARGET(GetMember):
+        {
+            const auto &member = As<RegisterMemberInstruction>(it);
+            auto &object = *registers[member.arguments].as<Object *>();
+            registers[member.value] = GetVar(object, FindData(Where, expression.cacheAt(member.cache), object, member.name), member.name);
+            it += sizeof(RegisterMemberInstruction);
+            DISPATCH();
+        }
+        TARGET(SetMember):
+        {
+            const auto &member = As<RegisterMemberInstruction>(it);
+            auto &object = *registers[member.arguments].as<Object *>();
+            object.setVar(FindData(Where, expression.cacheAt(member.cache), object, member.name), registers[member.value]);
+            it += sizeof(RegisterMemberInstruction);
+            DISPATCH();
+        }
+
+        // Unary
+        TARGET(Not):
+            unary(*instruction, std::logical_not<>());
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(Minus):
+            unary(*instruction, std::negate<>());
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(BitReverse):
+            unary(*instruction, std::bit_not<>());
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(Increment):
+            unary(*instruction, [](const Var &value) { return value + Var(static_cast<std::int64_t>(1)); });
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(Decrement):
+            unary(*instruction, [](const Var &value) { return value - Var(static_cast<std::int64_t>(1)); });
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(ToBoolean):
+            unary(*instruction, [](const Var &value) { return Var(value.toBool()); });
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+
+        // Binary
+        TARGET(Addition):
+            quicken(*instruction, RegisterOpCode::IntegerAddition, RegisterOpCode::FloatingAddition);
+            binary(*instruction, std::plus<>());
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(Substraction):
+            quicken(*instruction, RegisterOpCode::IntegerSubstraction, RegisterOpCode::FloatingSubstraction);
+            binary(*instruction, std::minus<>());
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(Multiplication):
+            quicken(*instruction, RegisterOpCode::IntegerMultiplication, RegisterOpCode::FloatingMultiplication);
+            binary(*instruction, std::multiplies<>());
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(Division):
+            binary(*instruction, std::divides<>());
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(Modulo):
+            binary(*instruction, std::modulus<>());
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(Equal):
+            binary(*instruction, std::equal_to<>());
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(Different):
+            binary(*instruction, std::not_equal_to<>());
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(Greater):
+            quicken(*instruction, RegisterOpCode::IntegerGreater, RegisterOpCode::FloatingGreater);
+            binary(*instruction, std::greater<>());
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(GreaterEqual):
+            quicken(*instruction, RegisterOpCode::IntegerGreaterEqual, RegisterOpCode::FloatingGreaterEqual);
+            binary(*instruction, std::greater_equal<>());
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(Lighter):
+            quicken(*instruction, RegisterOpCode::IntegerLighter, RegisterOpCode::FloatingLighter);
+            binary(*instruction, std::less<>());
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(LighterEqual):
+            quicken(*instruction, RegisterOpCode::IntegerLighterEqual, RegisterOpCode::FloatingLighterEqual);
+            binary(*instruction, std::less_equal<>());
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(BitAnd):
+            binary(*instruction, std::bit_and<>());
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(BitOr):
+            binary(*instruction, std::bit_or<>());
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+        TARGET(BitXor):
+            binary(*instruction, std::bit_xor<>());
+            it += sizeof(RegisterInstruction);
+            DISPATCH();
+
+        // Control flow
+        TARGET(Jump):
+            it = code + As<RegisterArgumentInstruction>(it).argument;
+            DISPATCH();
+        TARGET(JumpIfFalse):
+        {
+            const auto &jump = As<RegisterArgumentInstruction>(it);
+            it = registers[jump.reg].toBool() ? it + sizeof(RegisterArgumentInstruction) : code + jump.argument;
+            DISPATCH();
+        }
+        TARGET(JumpIfTrue):
+        {
+            const auto &jump = As<RegisterArgumentInstruction>(it);
+            it = registers[jump.reg].toBool() ? code + jump.argument : it + sizeof(RegisterArgumentInstruction);
+            DISPATCH();
+        }
+        TARGET(JumpTable):
+        {
+            const auto &jump = As<RegisterTableInstruction>(it);
+            table(jump, FindDenseEntry(jump, registers[jump.reg]));
+            DISPATCH();
+        }
+        TARGET(JumpSorted):
+        {
+            const auto &jump = As<RegisterTableInstruction>(it);
+            table(jump, FindSortedEntry(jump, registers[jump.reg]));
+            DISPATCH();
+        }
+        TARGET(JumpHashed):
+        {
+            const auto &jump = As<RegisterTableInstruction>(it);
+            table(jump, FindHashedEntry(jump, registers[jump.reg], code));
+            DISPATCH();
+        }
+
+        // Quickened instructions operate on unboxed values and de-quicken once their operands change of type
+#define QUICKENED_BINARY(Name, Type, Value, Operation) \
+        TARGET(Type##Name): \
+            if (Holds<Value>(registers[instruction->lhs], registers[instruction->rhs])) [[likely]] \
+                registers[instruction->output] = Var(Operation<Value>()(registers[instruction->lhs].as<Value>(), registers[instruction->rhs].as<Value>())); \
+            else { \
+                Rewrite(instruction->code, RegisterOpCode::Name); \
+                binary(*instruction, Operation<>()); \
+            } \
+            it += sizeof(RegisterInstruction); \
+            DISPATCH();
+
+        QUICKENED_BINARY(Addition, Integer, std::int64_t, std::plus)
+        QUICKENED_BINARY(Substraction, Integer, std::int64_t, std::minus)
+        QUICKENED_BINARY(Multiplication, Integer, std::int64_t, std::multiplies)
+        QUICKENED_BINARY(Greater, Integer, std::int64_t, std::greater)
+        QUICKENED_BINARY(GreaterEqual, Integer, std::int64_t, std::greater_equal)
+        QUICKENED_BINARY(Lighter, Integer, std::int64_t, std::less)
+        QUICKENED_BINARY(LighterEqual, Integer, std::int64_t, std::less_equal)
+        QUICKENED_BINARY(Addition, Floating, double, std::plus)
+        QUICKENED_BINARY(Substraction, Floating, double, std::minus)
+        QUICKENED_BINARY(Multiplication, Floating, double, std::multiplies)
+        QUICKENED_BINARY(Greater, Floating, double, std::greater)
+        QUICKENED_BINARY(GreaterEqual, Floating, double, std::greater_equal)
+        QUICKENED_BINARY(Lighter, Floating, double, std::less)
+        QUICKENED_BINARY(LighterEqual, Floating, double, std::less_equal)
+
+#undef QUICKENED_BINARY
+
+        // Calls
+        TARGET(CallFunction):
+        {
+            const auto &member = As<RegisterMemberInstruction>(it);
+            auto &instance = *instances[member.depth];
+            call(member, FindFunction(Where, instance, member.name), instance);
+            it += sizeof(RegisterMemberInstruction);
+            DISPATCH();
+        }
+        TARGET(CallExternal):
+        {
+            const auto &member = As<RegisterMemberInstruction>(it);
+            Meta::Function function;
+            auto &instance = FindExternalFunction(Where, expression.externalCacheAt(member.cache), instances, member.name, function);
+            call(member, function, instance);
+            it += sizeof(RegisterMemberInstruction);
+            DISPATCH();
+        }
+        TARGET(CallMember):
+        {
+            const auto &member = As<RegisterMemberInstruction>(it);
+            auto &object = *registers[member.arguments - 1].as<Object *>();
+            call(member, FindFunction(Where, object, member.name), object);
+            it += sizeof(RegisterMemberInstruction);
+            DISPATCH();
+        }
+        TARGET(Emit):
+        {
+            const auto &member = As<RegisterMemberInstruction>(it);
+            auto &instance = *instances[member.depth];
+            instance.emitSignal(FindSignal(Where, instance, member.name), registers + member.arguments, member.argumentCount);
+            registers[member.value].destruct();
+            it += sizeof(RegisterMemberInstruction);
+            DISPATCH();
+        }
+        TARGET(Return):
+            return std::move(registers[As<RegisterArgumentInstruction>(it).reg]);
+
+        TARGET(None):
+        default:
+            throw std::logic_error("Lang::RegisterProcesser::process: Invalid instruction");
+        }
+    }
+
+#undef TARGET
+#undef DISPATCH
+}
@@ -0,0 +1,55 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: RegisterProcesser
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+
+#include "Expression.hpp"
+
+namespace kF::Lang
+{
+    class RegisterProcesser;
+}
+
+/** @brief The RegisterProcesser executes register machine expressions produced by the RegisterCompiler
+ *  Each thread owns a processer whose register file is preallocated once and reused by every call, nested calls included
+ *  A call frame is made of the expression's locals followed by its temporaries, instructions read and write them in place
+ *  Registers outside of running frames are always void */
+class alignas_cacheline kF::Lang::RegisterProcesser
+{
+public:
+    /** @brief Count of registers preallocated in a processer */
+    static constexpr std::size_t DefaultRegisterCount = 4096u;
+
+
+    /** @brief Get the processer of the calling thread */
+    [[nodiscard]] static RegisterProcesser &Local(void) noexcept;
+
+    /** @brief Construct a processer and preallocate its registers */
+    RegisterProcesser(const std::size_t registerCount = DefaultRegisterCount) { _registers.resize(registerCount); }
+
+    /** @brief Processers are not copyable */
+    RegisterProcesser(const RegisterProcesser &other) = delete;
+    RegisterProcesser &operator=(const RegisterProcesser &other) = delete;
+
+    /** @brief Destructor */
+    ~RegisterProcesser(void) noexcept = default;
+
+
+    /** @brief Execute an expression
+     *  'instances' is a null terminated list of the instance of each enclosing class, innermost first
+     *  'args' holds the parameters of the expression */
+    [[nodiscard]] Var process(const Expression &expression, Object * const *instances, Var *args);
+
+    /** @brief Get the count of registers used by running frames */
+    [[nodiscard]] std::uint32_t registerCount(void) const noexcept { return _top; }
+
+private:
+    Core::Vector<Var> _registers {};
+    std::uint32_t _top { 0u };
+};
+
+static_assert_fit_cacheline(kF::Lang::RegisterProcesser);
@@ -0,0 +1,601 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: StackJit
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include <Kube/Core/Vector.hpp>
+
+#include "StackJit.hpp"
+#include "Processer.hpp"
+
+#if KUBE_INTERPRETER_JIT
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
+using namespace kF;
+using namespace kF::Lang::Processer;
+
+#if KUBE_INTERPRETER_JIT
+
+namespace kF::Lang
+{
+    /** @brief Name of the processing function used by errors */
+    constexpr auto JitWhere = "Lang::StackJit::run";
+
+    /** @brief Status returned by a stencil to its call sequence, table jumps return 'Case' plus the index of their entry */
+    enum class JitStatus : std::uint32_t {
+        Continue,
+        Branch,
+        Leave,
+        Case
+    };
+
+    /** @brief Get the operation of an arithmetic or comparison instruction, its superinstructions and quickened variants included */
+    template<OpCode Code>
+    [[nodiscard]] constexpr auto JitOperation(void) noexcept
+    {
+        using enum OpCode;
+
+        if constexpr (Code == Addition || Code == AdditionInteger || Code == IntegerAddition || Code == IntegerAdditionInteger || Code == FloatingAddition)
+            return std::plus<>();
+        else if constexpr (Code == Substraction || Code == SubstractionInteger || Code == IntegerSubstraction || Code == IntegerSubstractionInteger || Code == FloatingSubstraction)
+            return std::minus<>();
+        else if constexpr (Code == Multiplication || Code == MultiplicationInteger || Code == IntegerMultiplication || Code == IntegerMultiplicationInteger || Code == FloatingMultiplication)
+            return std::multiplies<>();
+        else if constexpr (Code == Division)
+            return std::divides<>();
+        else if constexpr (Code == Modulo)
+            return std::modulus<>();
+        else if constexpr (Code == Equal || Code == JumpUnlessEqual)
+            return std::equal_to<>();
+        else if constexpr (Code == Different || Code == JumpUnlessDifferent)
+            return std::not_equal_to<>();
+        else if constexpr (Code == Greater || Code == JumpUnlessGreater || Code == IntegerJumpUnlessGreater || Code == FloatingJumpUnlessGreater)
+            return std::greater<>();
+        else if constexpr (Code == GreaterEqual || Code == JumpUnlessGreaterEqual || Code == IntegerJumpUnlessGreaterEqual || Code == FloatingJumpUnlessGreaterEqual)
+            return std::greater_equal<>();
+        else if constexpr (Code == Lighter || Code == JumpUnlessLighter || Code == IntegerJumpUnlessLighter || Code == FloatingJumpUnlessLighter)
+            return std::less<>();
+        else if constexpr (Code == LighterEqual || Code == JumpUnlessLighterEqual || Code == IntegerJumpUnlessLighterEqual || Code == FloatingJumpUnlessLighterEqual)
+            return std::less_equal<>();
+        else if constexpr (Code == BitAnd)
+            return std::bit_and<>();
+        else if constexpr (Code == BitOr)
+            return std::bit_or<>();
+        else if constexpr (Code == BitXor)
+            return std::bit_xor<>();
+        else
+            return nullptr;
+    }
+
+    /** @brief Get the operand type of a quickened instruction, void if the instruction is generic */
+    template<OpCode Code>
+    [[nodiscard]] constexpr auto JitOperand(void) noexcept
+    {
+        if constexpr (Code >= OpCode::IntegerAddition && Code <= OpCode::IntegerJumpUnlessLighterEqual)
+            return std::int64_t {};
+        else if constexpr (Code >= OpCode::FloatingAddition && Code <= OpCode::FloatingJumpUnlessLighterEqual)
+            return double {};
+    }
+
+    /** @brief Execute a single instruction on a frame
+     *  Quickened instructions keep their guard but can't be rewritten anymore, they fall back to their generic operation */
+    template<OpCode Code>
+    [[nodiscard]] JitStatus JitExecute(JitFrame &frame, const Instruction &instruction)
+    {
+        using enum OpCode;
+        using Operand = decltype(JitOperand<Code>());
+        constexpr auto Operation = JitOperation<Code>();
+
+        auto &sp = frame.sp;
+        const auto &member = reinterpret_cast<const MemberInstruction &>(instruction);
+        const auto &immediate = reinterpret_cast<const ImmediateInstruction &>(instruction);
+        const auto binary = [&sp](auto &&operation) {
+            sp[-2] = operation(sp[-2], sp[-1]);
+            (--sp)->destruct();
+        };
+        const auto call = [&sp](const Meta::Function &function, Object &instance, const std::uint16_t argumentCount) {
+            Var * const arguments = sp - argumentCount;
+            Var result = function.invoke(&instance, arguments);
+            Release(arguments, sp);
+            sp = arguments;
+            *sp++ = std::move(result);
+        };
+
+        // Constants
+        if constexpr (Code == PushVoid)
+            ++sp;
+        else if constexpr (Code == PushBoolean)
+            *sp++ = Var(static_cast<bool>(instruction.argument));
+        else if constexpr (Code == PushInteger)
+            *sp++ = Var(immediate.integer);
+        else if constexpr (Code == PushFloating)
+            *sp++ = Var(immediate.floating);
+        else if constexpr (Code == PushLiteral)
+            *sp++ = Var(std::string(reinterpret_cast<const char *>(&instruction + 1), instruction.argument));
+
+        // Operand stack
+        else if constexpr (Code == Pop)
+            (--sp)->destruct();
+        else if constexpr (Code == Duplicate) {
+            sp->assign(sp[-1]);
+            ++sp;
+        }
+
+        // Variables
+        else if constexpr (Code == PushParameter)
+            (sp++)->assign(frame.args[instruction.argument]);
+        else if constexpr (Code == StoreParameter)
+            frame.args[instruction.argument].assign(sp[-1]);
+        else if constexpr (Code == PushLocal)
+            (sp++)->assign(frame.locals[instruction.argument]);
+        else if constexpr (Code == StoreLocal)
+            frame.locals[instruction.argument].assign(sp[-1]);
+        else if constexpr (Code == PushProperty) {
+            auto &instance = *frame.instances[member.depth];
+            *sp++ = GetVar(instance, FindData(JitWhere, frame.expression->cacheAt(member.cache), instance, member.name), member.name);
+        } else if constexpr (Code == StoreProperty) {
+            auto &instance = *frame.instances[member.depth];
+            instance.setVar(FindData(JitWhere, frame.expression->cacheAt(member.cache), instance, member.name), sp[-1]);
+        } else if constexpr (Code == PushExternal) {
+            Meta::Data data;
+            auto &instance = FindExternalData(JitWhere, frame.expression->externalCacheAt(member.cache), frame.instances, member.name, data);
+            *sp++ = GetVar(instance, data, member.name);
+        } else if constexpr (Code == StoreExternal) {
+            Meta::Data data;
+            auto &instance = FindExternalData(JitWhere, frame.expression->externalCacheAt(member.cache), frame.instances, member.name, data);
+            instance.setVar(data, sp[-1]);
+        } else if constexpr (Code == GetMember) {
+            auto &object = *sp[-1].as<Object *>();
+            sp[-1] = GetVar(object, FindData(JitWhere, frame.expression->cacheAt(member.cache), object, member.name), member.name);
+        } else if constexpr (Code == SetMember) {
+            auto &object = *sp[-2].as<Object *>();
+            object.setVar(FindData(JitWhere, frame.expression->cacheAt(member.cache), object, member.name), sp[-1]);
+            sp[-2] = std::move(sp[-1]);
+            (--sp)->destruct();
+        }
+
+        // Unary
+        else if constexpr (Code == Not)
+            sp[-1] = !sp[-1];
+        else if constexpr (Code == Minus)
+            sp[-1] = -sp[-1];
+        else if constexpr (Code == BitReverse)
+            sp[-1] = ~sp[-1];
+        else if constexpr (Code == Increment)
+            sp[-1] = sp[-1] + Var(static_cast<std::int64_t>(1));
+        else if constexpr (Code == Decrement)
+            sp[-1] = sp[-1] - Var(static_cast<std::int64_t>(1));
+        else if constexpr (Code == ToBoolean)
+            sp[-1] = Var(sp[-1].toBool());
+
+        // Binary, generic or quickened
+        else if constexpr ((Code >= Addition && Code <= BitXor) || Code == IntegerAddition || Code == IntegerSubstraction
+                || Code == IntegerMultiplication || Code == FloatingAddition || Code == FloatingSubstraction || Code == FloatingMultiplication) {
+            if constexpr (!std::is_void_v<Operand>) {
+                if (Holds<Operand>(sp[-2], sp[-1])) [[likely]] {
+                    sp[-2] = Var(Operation(sp[-2].as<Operand>(), sp[-1].as<Operand>()));
+                    (--sp)->destruct();
+                    return JitStatus::Continue;
+                }
+            }
+            binary(Operation);
+        }
+
+        // Binary with an immediate integer, generic or quickened
+        else if constexpr ((Code >= AdditionInteger && Code <= MultiplicationInteger)
+                || (Code >= IntegerAdditionInteger && Code <= IntegerMultiplicationInteger)) {
+            if constexpr (!std::is_void_v<Operand>) {
+                if (sp[-1].is<std::int64_t>()) [[likely]] {
+                    sp[-1] = Var(Operation(sp[-1].as<std::int64_t>(), immediate.integer));
+                    return JitStatus::Continue;
+                }
+            }
+            sp[-1] = Operation(sp[-1], Var(immediate.integer));
+        }
+        else if constexpr (Code == IncrementLocal || Code == DecrementLocal) {
+            auto &local = frame.locals[instruction.argument];
+            if constexpr (Code == IncrementLocal)
+                local = local + Var(static_cast<std::int64_t>(1));
+            else
+                local = local - Var(static_cast<std::int64_t>(1));
+            (sp++)->assign(local);
+        }
+
+        // Control flow, the branch is taken by the machine code
+        else if constexpr (Code == Jump)
+            return JitStatus::Branch;
+        else if constexpr (Code == JumpIfFalse) {
+            const auto condition = sp[-1].toBool();
+            (--sp)->destruct();
+            return condition ? JitStatus::Continue : JitStatus::Branch;
+        } else if constexpr (Code == JumpIfTrueOrPop || Code == JumpIfFalseOrPop) {
+            if (sp[-1].toBool() == (Code == JumpIfTrueOrPop))
+                return JitStatus::Branch;
+            (--sp)->destruct();
+        } else if constexpr ((Code >= JumpUnlessEqual && Code <= JumpUnlessLighterEqual)
+                || (Code >= IntegerJumpUnlessGreater && Code <= IntegerJumpUnlessLighterEqual)
+                || (Code >= FloatingJumpUnlessGreater && Code <= FloatingJumpUnlessLighterEqual)) {
+            bool condition;
+            if constexpr (!std::is_void_v<Operand>) {
+                if (Holds<Operand>(sp[-2], sp[-1])) [[likely]]
+                    condition = Operation(sp[-2].as<Operand>(), sp[-1].as<Operand>());
+                else
+                    condition = Var(Operation(sp[-2], sp[-1])).toBool();
+            } else
+                condition = Var(Operation(sp[-2], sp[-1])).toBool();
+            Release(sp - 2, sp);
+            sp -= 2;
+            return condition ? JitStatus::Continue : JitStatus::Branch;
+        } else if constexpr (Code == JumpTable || Code == JumpSorted || Code == JumpHashed) {
+            const auto &table = reinterpret_cast<const TableInstruction &>(instruction);
+            std::uint32_t entry;
+            if constexpr (Code == JumpTable)
+                entry = FindDenseEntry(table, sp[-1]);
+            else if constexpr (Code == JumpSorted)
+                entry = FindSortedEntry(table, sp[-1]);
+            else
+                entry = FindHashedEntry(table, sp[-1], reinterpret_cast<const std::byte *>(frame.expression->data()));
+            if (entry == NoTableEntry) [[unlikely]]
+                return JitStatus::Continue;
+            (--sp)->destruct();
+            return static_cast<JitStatus>(static_cast<std::uint32_t>(JitStatus::Case) + entry);
+        }
+
+        // Calls
+        else if constexpr (Code == CallFunction) {
+            auto &instance = *frame.instances[member.depth];
+            call(FindFunction(JitWhere, instance, member.name), instance, member.argumentCount);
+        } else if constexpr (Code == CallExternal) {
+            Meta::Function function;
+            auto &instance = FindExternalFunction(JitWhere, frame.expression->externalCacheAt(member.cache), frame.instances, member.name, function);
+            call(function, instance, member.argumentCount);
+        } else if constexpr (Code == CallMember) {
+            auto &object = *sp[-member.argumentCount - 1].as<Object *>();
+            call(FindFunction(JitWhere, object, member.name), object, member.argumentCount);
+            // The result replaces the object
+            sp[-2] = std::move(sp[-1]);
+            (--sp)->destruct();
+        } else if constexpr (Code == Emit) {
+            auto &instance = *frame.instances[member.depth];
+            Var * const arguments = sp - member.argumentCount;
+            instance.emitSignal(FindSignal(JitWhere, instance, member.name), arguments, member.argumentCount);
+            Release(arguments, sp);
+            sp = arguments + 1;
+        } else if constexpr (Code == Return) {
+            frame.result = std::move(sp[-1]);
+            return JitStatus::Leave;
+        } else
+            throw std::logic_error("Lang::StackJit::run: Invalid instruction");
+        return JitStatus::Continue;
+    }
+
+    /** @brief Stencil of an instruction kind, called by the machine code with the frame and the patched instruction address */
+    template<OpCode Code>
+    JitStatus JitStencil(JitFrame &frame, const Instruction &instruction) noexcept
+    {
+        try {
+            return JitExecute<Code>(frame, instruction);
+        } catch (...) {
+            frame.error = std::current_exception();
+            return JitStatus::Leave;
+        }
+    }
+
+    /** @brief Stencil of every operation code */
+    template<std::size_t ...Indexes>
+    [[nodiscard]] constexpr auto MakeJitStencils(std::index_sequence<Indexes...>) noexcept
+    {
+        using Stencil = JitStatus(*)(JitFrame &, const Instruction &) noexcept;
+        return std::array<Stencil, sizeof...(Indexes)> { &JitStencil<static_cast<OpCode>(Indexes)>... };
+    }
+
+    constexpr auto JitStencils = MakeJitStencils(std::make_index_sequence<OpCodeCount>());
+
+    /** @brief Writes x86-64 machine code */
+    class JitAssembler
+    {
+    public:
+        /** @brief A rel32 displacement waiting for its target */
+        struct Fixup
+        {
+            std::uint32_t position { 0u };
+            ByteIndex target { 0u }; // 'NoByteIndex' targets the epilogue
+            std::uint32_t base { 0u }; // Offset the displacement is relative to
+        };
+
+        /** @brief Get the offset of the next byte */
+        [[nodiscard]] std::uint32_t offset(void) const noexcept { return static_cast<std::uint32_t>(_code.size()); }
+
+        /** @brief Get the machine code */
+        [[nodiscard]] const Core::Vector<std::uint8_t> &code(void) const noexcept { return _code; }
+
+        /** @brief Append raw bytes */
+        void bytes(const std::initializer_list<std::uint8_t> values)
+        {
+            for (const auto value : values)
+                _code.push(value);
+        }
+
+        /** @brief Append a 64 bits immediate */
+        void immediate(const std::uint64_t value)
+        {
+            for (auto i = 0u; i < sizeof(value); ++i)
+                _code.push(static_cast<std::uint8_t>(value >> (i * 8u)));
+        }
+
+        /** @brief Append a rel32 displacement to an instruction or to the epilogue */
+        void displacement(const ByteIndex target)
+        {
+            _fixups.push(Fixup { position: offset(), target: target, base: offset() + static_cast<std::uint32_t>(sizeof(std::int32_t)) });
+            bytes({ 0x00, 0x00, 0x00, 0x00 });
+        }
+
+        /** @brief Append the 32 bits offset of an instruction from an offset of the machine code, for tables of targets */
+        void entry(const ByteIndex target, const std::uint32_t base)
+        {
+            _fixups.push(Fixup { position: offset(), target: target, base: base });
+            bytes({ 0x00, 0x00, 0x00, 0x00 });
+        }
+
+        /** @brief Resolve every displacement out of the machine offset of each instruction */
+        void resolve(const Core::Vector<std::uint32_t> &offsets, const std::uint32_t epilogue) noexcept
+        {
+            for (const auto &fixup : _fixups) {
+                const auto target = fixup.target == NoByteIndex ? epilogue : offsets[fixup.target / sizeof(Instruction)];
+                const auto value = static_cast<std::int32_t>(target - fixup.base);
+                std::memcpy(_code.data() + fixup.position, &value, sizeof(value));
+            }
+        }
+
+    private:
+        Core::Vector<std::uint8_t> _code {};
+        Core::Vector<Fixup> _fixups {};
+    };
+
+    /** @brief Executable memory shared by the machine code of every expression
+     *  Chunks are mapped twice out of a memory file: code is written through a writable view and runs from an executable one,
+     *  so no page is ever writable and executable and translating never changes the protection of running code
+     *  Blocks are cacheline aligned, released ones are merged with their free neighbours and reused by first fit */
+    class JitArena
+    {
+    public:
+        /** @brief Minimum size of a chunk, larger machine codes get a chunk of their own */
+        static constexpr std::size_t ChunkSize = 256u * 1024u;
+
+
+        /** @brief Get the arena, it is never destroyed as expressions may be released during static destruction */
+        [[nodiscard]] static JitArena &Get(void)
+        {
+            static auto * const arena = new JitArena();
+            return *arena;
+        }
+
+        /** @brief Copy machine code into a new block, returns its executable address or null if no memory could be mapped */
+        [[nodiscard]] const std::uint8_t *allocate(const Core::Vector<std::uint8_t> &code)
+        {
+            const auto size = BlockSize(code.size());
+            std::lock_guard guard(_mutex);
+
+            auto block = std::find_if(_free.begin(), _free.end(), [size](const Block &block) { return block.size >= size; });
+            if (block == _free.end()) {
+                block = map(size);
+                if (!block) [[unlikely]]
+                    return nullptr;
+            }
+            const auto address = block->address;
+            const auto &chunk = _chunks[block->chunk];
+            if (block->size == size)
+                _free.erase(block, block + 1);
+            else {
+                block->address += size;
+                block->size -= size;
+            }
+            std::memcpy(chunk.writable + (address - chunk.executable), code.data(), code.size());
+            return address;
+        }
+
+        /** @brief Release a block returned by 'allocate' */
+        void release(const std::uint8_t * const address, const std::size_t codeSize) noexcept
+        {
+            const auto size = BlockSize(codeSize);
+            std::lock_guard guard(_mutex);
+
+            const auto chunk = static_cast<std::uint32_t>(std::find_if(_chunks.begin(), _chunks.end(), [address](const Chunk &chunk) {
+                return address >= chunk.executable && address < chunk.executable + chunk.size;
+            }) - _chunks.begin());
+            auto next = std::find_if(_free.begin(), _free.end(), [address](const Block &block) { return block.address > address; });
+            const auto mergesNext = next != _free.end() && next->chunk == chunk && address + size == next->address;
+            const auto previous = next != _free.begin() ? next - 1 : nullptr;
+            if (previous && previous->chunk == chunk && previous->address + previous->size == address) {
+                previous->size += size;
+                if (mergesNext) {
+                    previous->size += next->size;
+                    _free.erase(next, next + 1);
+                }
+            } else if (mergesNext) {
+                next->address = const_cast<std::uint8_t *>(address);
+                next->size += size;
+            } else {
+                const Block block { address: const_cast<std::uint8_t *>(address), size: size, chunk: chunk };
+                _free.insert(next, &block, &block + 1);
+            }
+        }
+
+    private:
+        /** @brief A chunk of memory and its two views */
+        struct Chunk
+        {
+            std::uint8_t *executable { nullptr };
+            std::uint8_t *writable { nullptr };
+            std::size_t size { 0u };
+        };
+
+        /** @brief A free range of a chunk, addressed through its executable view */
+        struct Block
+        {
+            std::uint8_t *address { nullptr };
+            std::size_t size { 0u };
+            std::uint32_t chunk { 0u };
+        };
+
+        std::mutex _mutex {};
+        Core::Vector<Chunk> _chunks {};
+        Core::Vector<Block> _free {}; // Sorted by address
+
+
+        /** @brief Get the size of the block holding machine code */
+        [[nodiscard]] static constexpr std::size_t BlockSize(const std::size_t size) noexcept
+            { return (size + Core::CacheLineSize - 1u) & ~(Core::CacheLineSize - 1u); }
+
+        /** @brief Map a new chunk able to hold 'size' bytes, returns its free block or null */
+        [[nodiscard]] Block *map(const std::size_t size)
+        {
+            const auto pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            const auto chunkSize = (std::max(size, ChunkSize) + pageSize - 1u) & ~(pageSize - 1u);
+            const auto file = ::memfd_create("Kube::Lang::StackJit", MFD_CLOEXEC);
+            if (file < 0) [[unlikely]]
+                return nullptr;
+            void *executable = MAP_FAILED;
+            void *writable = MAP_FAILED;
+            if (!::ftruncate(file, static_cast<off_t>(chunkSize))) [[likely]] {
+                executable = ::mmap(nullptr, chunkSize, PROT_READ | PROT_EXEC, MAP_SHARED, file, 0);
+                writable = ::mmap(nullptr, chunkSize, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+            }
+            ::close(file);
+            if (executable == MAP_FAILED || writable == MAP_FAILED) [[unlikely]] {
+                if (executable != MAP_FAILED)
+                    ::munmap(executable, chunkSize);
+                if (writable != MAP_FAILED)
+                    ::munmap(writable, chunkSize);
+                return nullptr;
+            }
+
+            const auto chunk = static_cast<std::uint32_t>(_chunks.size());
+            _chunks.push(Chunk {
+                executable: static_cast<std::uint8_t *>(executable),
+                writable: static_cast<std::uint8_t *>(writable),
+                size: chunkSize
+            });
+            const Block block { address: static_cast<std::uint8_t *>(executable), size: chunkSize, chunk: chunk };
+            const auto next = std::find_if(_free.begin(), _free.end(), [&block](const Block &other) { return other.address > block.address; });
+            return _free.insert(next, &block, &block + 1);
+        }
+    };
+
+    /** @brief Check if an operation code branches conditionally */
+    [[nodiscard]] constexpr bool IsConditionalJump(const OpCode code) noexcept
+    {
+        return code == OpCode::JumpIfFalse || code == OpCode::JumpIfTrueOrPop || code == OpCode::JumpIfFalseOrPop
+            || (code >= OpCode::JumpUnlessEqual && code <= OpCode::JumpUnlessLighterEqual)
+            || (code >= OpCode::IntegerJumpUnlessGreater && code <= OpCode::IntegerJumpUnlessLighterEqual)
+            || (code >= OpCode::FloatingJumpUnlessGreater && code <= OpCode::FloatingJumpUnlessLighterEqual);
+    }
+}
+
+const Lang::JitCode *Lang::StackJit::Compile(const Expression &expression)
+{
+    JitAssembler assembler;
+    Core::Vector<std::uint32_t> offsets;
+
+    offsets.resize(expression.size() / sizeof(Instruction), 0u);
+
+    // The frame is kept in a callee saved register, pushing it also aligns the stack for calls
+    assembler.bytes({ 0x53 });                  // push rbx
+    assembler.bytes({ 0x48, 0x89, 0xFB });      // mov rbx, rdi
+    for (ByteIndex index = 0u; index < expression.size(); ) {
+        // Interpreters may quicken the instruction while it is translated
+        const auto &instruction = *expression.at(index);
+        const auto code = Observe(instruction.code);
+        offsets[index / sizeof(Instruction)] = assembler.offset();
+        index += InstructionSize(instruction, code);
+        if (code == OpCode::Jump) {
+            assembler.bytes({ 0xE9 });          // jmp target
+            assembler.displacement(instruction.argument);
+            continue;
+        }
+        assembler.bytes({ 0x48, 0x89, 0xDF });  // mov rdi, rbx
+        assembler.bytes({ 0x48, 0xBE });        // movabs rsi, instruction
+        assembler.immediate(reinterpret_cast<std::uint64_t>(&instruction));
+        assembler.bytes({ 0x48, 0xB8 });        // movabs rax, stencil
+        assembler.immediate(reinterpret_cast<std::uint64_t>(JitStencils[static_cast<std::size_t>(code)]));
+        assembler.bytes({ 0xFF, 0xD0 });        // call rax
+        if (code == OpCode::JumpTable || code == OpCode::JumpSorted || code == OpCode::JumpHashed) {
+            // The entries follow the indirect jump, each one holding the offset of its target from the first entry
+            static_assert(JitStatus::Case == static_cast<JitStatus>(3), "Lang::StackJit::Compile: Table jumps expect entries to start at status 3");
+            const auto &table = reinterpret_cast<const TableInstruction &>(instruction);
+            assembler.bytes({ 0x85, 0xC0 });    // test eax, eax
+            assembler.bytes({ 0x0F, 0x84 });    // je next
+            assembler.displacement(index);
+            assembler.bytes({ 0x83, 0xF8, static_cast<std::uint8_t>(JitStatus::Case) }); // cmp eax, Case
+            assembler.bytes({ 0x0F, 0x82 });    // jb epilogue
+            assembler.displacement(NoByteIndex);
+            assembler.bytes({ 0x89, 0xC0 });    // mov eax, eax (the upper half of rax is undefined after returning a status)
+            assembler.bytes({ 0x48, 0x8D, 0x0D, 0x0A, 0x00, 0x00, 0x00 }); // lea rcx, [rip + 10]
+            assembler.bytes({ 0x48, 0x63, 0x44, 0x81, 0xF4 }); // movsxd rax, dword [rcx + rax * 4 - Case * 4]
+            assembler.bytes({ 0x48, 0x01, 0xC8 }); // add rax, rcx
+            assembler.bytes({ 0xFF, 0xE0 });    // jmp rax
+            const auto entries = assembler.offset();
+            for (auto entry = 0u; entry <= table.count; ++entry)
+                assembler.entry(TableTarget(table, entry), entries);
+        } else if (IsConditionalJump(code)) {
+            assembler.bytes({ 0x83, 0xF8, 0x01 }); // cmp eax, Branch
+            assembler.bytes({ 0x0F, 0x84 });    // je target
+            assembler.displacement(instruction.argument);
+            assembler.bytes({ 0x0F, 0x87 });    // ja epilogue
+            assembler.displacement(NoByteIndex);
+        } else {
+            assembler.bytes({ 0x85, 0xC0 });    // test eax, eax
+            assembler.bytes({ 0x0F, 0x85 });    // jnz epilogue
+            assembler.displacement(NoByteIndex);
+        }
+    }
+    const auto epilogue = assembler.offset();
+    assembler.bytes({ 0x5B });                  // pop rbx
+    assembler.bytes({ 0xC3 });                  // ret
+    assembler.resolve(offsets, epilogue);
+
+    const auto &bytes = assembler.code();
+    const auto entry = JitArena::Get().allocate(bytes);
+    if (!entry) [[unlikely]]
+        return nullptr;
+
+    const auto code = new JitCode {
+        entry: reinterpret_cast<JitCode::Entry>(entry),
+        size: bytes.size()
+    };
+    if (!expression.attachJitCode(code)) {
+        ReleaseJitCode(code);
+        return expression.jitCode();
+    }
+    return code;
+}
+
+void Lang::ReleaseJitCode(JitCode * const code) noexcept
+{
+    JitArena::Get().release(reinterpret_cast<const std::uint8_t *>(code->entry), code->size);
+    delete code;
+}
+
+#else
+
+const Lang::JitCode *Lang::StackJit::Compile(const Expression &)
+{
+    return nullptr;
+}
+
+void Lang::ReleaseJitCode(JitCode * const code) noexcept
+{
+    delete code;
+}
+
+#endif
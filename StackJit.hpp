@@ -0,0 +1,65 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: StackJit
+ */
+
+#pragma once
+
+#include <exception>
+
+#include "Expression.hpp"
+
+// Machine code is only generated for Linux x86-64, other targets keep interpreting every expression
+#if !defined(KUBE_INTERPRETER_JIT)
+# if defined(__x86_64__) && defined(__linux__) && !KUBE_INTERPRETER_DISABLE_JIT
+#  define KUBE_INTERPRETER_JIT 1
+# else
+#  define KUBE_INTERPRETER_JIT 0
+# endif
+#endif
+
+namespace kF::Lang
+{
+    class StackJit;
+    struct JitFrame;
+}
+
+/** @brief Frame of a stack machine expression running as machine code
+ *  It shares the layout of the interpreter's frames so both tiers use the same processer stack */
+struct alignas_cacheline kF::Lang::JitFrame
+{
+    Var *sp { nullptr };
+    Var *locals { nullptr };
+    Var *args { nullptr };
+    Object * const *instances { nullptr };
+    const Expression *expression { nullptr };
+    Var result {};
+    std::exception_ptr error {};
+};
+
+/** @brief Machine code of an expression, it lives in a block of the executable memory shared by every expression */
+struct kF::Lang::JitCode
+{
+    /** @brief Entry of the machine code, it runs a whole expression */
+    using Entry = void(*)(JitFrame &frame);
+
+    Entry entry { nullptr };
+    std::size_t size { 0u }; // Size of the machine code starting at 'entry'
+};
+
+/** @brief The StackJit is the second tier of the stack machine, it translates hot expressions into machine code
+ *  Each instruction kind has a stencil, a function instantiated at build time out of a template
+ *  Translation copies a call sequence per instruction, patching in the address of its stencil and of its operands,
+ *  and turns jumps into native branches so no dispatch remains between instructions
+ *  Stencils never throw, errors are stored in the frame and rethrown once the machine code returned */
+class kF::Lang::StackJit
+{
+public:
+    /** @brief Check if machine code can be generated on this target */
+    static constexpr bool IsAvailable = KUBE_INTERPRETER_JIT;
+
+
+    /** @brief Translate an expression and attach its machine code
+     *  Returns the attached code, which may come from another thread, or null if the expression can't be translated */
+    [[nodiscard]] static const JitCode *Compile(const Expression &expression);
+};
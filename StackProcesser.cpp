@@ -0,0 +1,664 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: StackProcesser
+ */
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+
+#include "StackProcesser.hpp"
+#include "StackJit.hpp"
+#include "Processer.hpp"
+
+using namespace kF;
+using namespace kF::Lang::Processer;
+
+namespace kF::Lang
+{
+    /** @brief Name of the processing function used by errors */
+    constexpr auto Where = "Lang::StackProcesser::process";
+}
+
+Lang::StackProcesser &Lang::StackProcesser::Local(void) noexcept
+{
+    thread_local StackProcesser processer;
+
+    return processer;
+}
+
+Lang::StackProcesser::StackProcesser(const std::size_t stackSize)
+{
+    _stack.resize(stackSize);
+#if KUBE_INTERPRETER_PROFILE
+    _sequenceCounts.resize(OpCodeCount * OpCodeCount);
+#endif
+}
+
+Var Lang::StackProcesser::process(const Expression &expression, Object * const *instances, Var *args)
+{
+#if KUBE_INTERPRETER_JIT
+    auto jitCode = expression.jitCode();
+    if (!jitCode && _jitThreshold != NoJit && expression.heat(_jitThreshold)) [[unlikely]]
+        jitCode = StackJit::Compile(expression);
+#endif
+
+    const auto base = _top;
+    const auto top = base + expression.frameSize() + expression.stackSize();
+
+    // The stack can only grow when no frame is running as frames reference their arguments by address
+    if (top > _stack.size()) [[unlikely]] {
+        if (base) [[unlikely]]
+            throw std::logic_error("Lang::StackProcesser::process: Stack overflow");
+        _stack.resize(top);
+    }
+    _top = top;
+
+    Var * const locals = _stack.data() + base;
+    Var *sp = locals + expression.frameSize();
+    const auto * const code = reinterpret_cast<const std::byte *>(expression.data());
+    const auto *it = code;
+
+    // The frame is released on return as on error
+    struct FrameGuard
+    {
+        StackProcesser &processer;
+        Var * const locals;
+        Var *&sp;
+        const std::uint32_t base;
+
+        ~FrameGuard(void) noexcept { Release(locals, sp); processer._top = base; }
+    } guard { *this, locals, sp, base };
+
+#if KUBE_INTERPRETER_JIT
+    // Machine code runs on the same frame, its errors are rethrown once the stack pointer is restored
+    if (jitCode) {
+        JitFrame frame {
+            sp: sp,
+            locals: locals,
+            args: args,
+            instances: instances,
+            expression: &expression
+        };
+        jitCode->entry(frame);
+        sp = frame.sp;
+        if (frame.error) [[unlikely]]
+            std::rethrow_exception(frame.error);
+        return std::move(frame.result);
+    }
+#endif
+
+    const Instruction *instruction;
+
+    const auto unary = [&sp](auto &&operation) {
+        sp[-1] = operation(sp[-1]);
+    };
+    const auto binary = [&sp](auto &&operation) {
+        sp[-2] = operation(sp[-2], sp[-1]);
+        (--sp)->destruct();
+    };
+    const auto immediate = [&sp, &it](auto &&operation) {
+        sp[-1] = operation(sp[-1], Var(As<ImmediateInstruction>(it).integer));
+    };
+    const auto branch = [&sp, &it, code](auto &&operation, const ByteIndex target) {
+        const auto condition = Var(operation(sp[-2], sp[-1])).toBool();
+        Release(sp - 2, sp);
+        sp -= 2;
+        it = condition ? it + sizeof(Instruction) : code + target;
+    };
+    const auto table = [&sp, &it, code](const TableInstruction &instruction, const std::uint32_t entry) {
+        if (entry == NoTableEntry) [[unlikely]]
+            it += TableSize(instruction, instruction.code != OpCode::JumpTable);
+        else {
+            (--sp)->destruct();
+            it = code + TableTarget(instruction, entry);
+        }
+    };
+    const auto quicken = [&sp, &instruction](const OpCode integer, const OpCode floating) {
+        if (Holds<std::int64_t>(sp[-2], sp[-1]))
+            Rewrite(instruction->code, integer);
+        else if (Holds<double>(sp[-2], sp[-1]))
+            Rewrite(instruction->code, floating);
+    };
+    const auto call = [&sp](const Meta::Function &function, Object &instance, const std::uint16_t argumentCount) {
+        Var * const arguments = sp - argumentCount;
+        Var result = function.invoke(&instance, arguments);
+        Release(arguments, sp);
+        sp = arguments;
+        *sp++ = std::move(result);
+    };
+
+    // Each handler ends with its own indirect jump when threaded, so that every jump is predicted on its own
+#if KUBE_INTERPRETER_THREADED_DISPATCH
+    static const void * const Labels[] = {
+        &&LabelNone,
+        &&LabelPushVoid,
+        &&LabelPushBoolean,
+        &&LabelPushInteger,
+        &&LabelPushFloating,
+        &&LabelPushLiteral,
+        &&LabelPop,
+        &&LabelDuplicate,
+        &&LabelPushParameter,
+        &&LabelStoreParameter,
+        &&LabelPushLocal,
+        &&LabelStoreLocal,
+        &&LabelPushProperty,
+        &&LabelStoreProperty,
+        &&LabelPushExternal,
+        &&LabelStoreExternal,
+        &&LabelGetMember,
+        &&LabelSetMember,
+        &&LabelNot,
+        &&LabelMinus,
+        &&LabelBitReverse,
+        &&LabelIncrement,
+        &&LabelDecrement,
+        &&LabelToBoolean,
+        &&LabelAddition,
+        &&LabelSubstraction,
+        &&LabelMultiplication,
+        &&LabelDivision,
+        &&LabelModulo,
+        &&LabelEqual,
+        &&LabelDifferent,
+        &&LabelGreater,
+        &&LabelGreaterEqual,
+        &&LabelLighter,
+        &&LabelLighterEqual,
+        &&LabelBitAnd,
+        &&LabelBitOr,
+        &&LabelBitXor,
+        &&LabelJump,
+        &&LabelJumpIfFalse,
+        &&LabelJumpIfTrueOrPop,
+        &&LabelJumpIfFalseOrPop,
+        &&LabelJumpTable,
+        &&LabelJumpSorted,
+        &&LabelJumpHashed,
+        &&LabelAdditionInteger,
+        &&LabelSubstractionInteger,
+        &&LabelMultiplicationInteger,
+        &&LabelIncrementLocal,
+        &&LabelDecrementLocal,
+        &&LabelJumpUnlessEqual,
+        &&LabelJumpUnlessDifferent,
+        &&LabelJumpUnlessGreater,
+        &&LabelJumpUnlessGreaterEqual,
+        &&LabelJumpUnlessLighter,
+        &&LabelJumpUnlessLighterEqual,
+        &&LabelIntegerAddition,
+        &&LabelIntegerSubstraction,
+        &&LabelIntegerMultiplication,
+        &&LabelIntegerAdditionInteger,
+        &&LabelIntegerSubstractionInteger,
+        &&LabelIntegerMultiplicationInteger,
+        &&LabelIntegerJumpUnlessGreater,
+        &&LabelIntegerJumpUnlessGreaterEqual,
+        &&LabelIntegerJumpUnlessLighter,
+        &&LabelIntegerJumpUnlessLighterEqual,
+        &&LabelFloatingAddition,
+        &&LabelFloatingSubstraction,
+        &&LabelFloatingMultiplication,
+        &&LabelFloatingJumpUnlessGreater,
+        &&LabelFloatingJumpUnlessGreaterEqual,
+        &&LabelFloatingJumpUnlessLighter,
+        &&LabelFloatingJumpUnlessLighterEqual,
+        &&LabelCallFunction,
+        &&LabelCallExternal,
+        &&LabelCallMember,
+        &&LabelEmit,
+        &&LabelReturn
+    };
+    static_assert(std::size(Labels) == OpCodeCount, "Lang::StackProcesser::process: Dispatch table is not in sync with operation codes");
+
+# define TARGET(Name) case OpCode::Name: Label##Name
+# define DISPATCH() instruction = &As<Instruction>(it); PROFILE(); goto *Labels[static_cast<std::size_t>(Observe(instruction->code))]
+#else
+# define TARGET(Name) case OpCode::Name
+# define DISPATCH() continue
+#endif
+
+    // Profiling counts each executed sequence of two instructions
+#if KUBE_INTERPRETER_PROFILE
+    auto previous = OpCode::None;
+# define PROFILE() ++_sequenceCounts[static_cast<std::size_t>(previous) * OpCodeCount + static_cast<std::size_t>(Observe(instruction->code))]; \
+    previous = Observe(instruction->code)
+#else
+# define PROFILE()
+#endif
+
+    while (true) {
+        instruction = &As<Instruction>(it);
+        PROFILE();
+        switch (Observe(instruction->code)) {
+        // Constants
+        TARGET(PushVoid):
+            ++sp;
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(PushBoolean):
+            *sp++ = Var(static_cast<bool>(instruction->argument));
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(PushInteger):
+            *sp++ = Var(As<ImmediateInstruction>(it).integer);
+            it += sizeof(ImmediateInstruction);
+            DISPATCH();
+        TARGET(PushFloating):
+            *sp++ = Var(As<ImmediateInstruction>(it).floating);
+            it += sizeof(ImmediateInstruction);
+            DISPATCH();
+        TARGET(PushLiteral):
+            *sp++ = Var(std::string(reinterpret_cast<const char *>(it + sizeof(Instruction)), instruction->argument));
+            it += sizeof(Instruction) * (1u + LiteralUnitCount(instruction->argument));
+            DISPATCH();
+
+        // Operand stack
+        TARGET(Pop):
+            (--sp)->destruct();
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(Duplicate):
+            sp->assign(sp[-1]);
+            ++sp;
+            it += sizeof(Instruction);
+            DISPATCH();
+
+        // Variables
+        TARGET(PushParameter):
+            (sp++)->assign(args[instruction->argument]);
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(StoreParameter):
+            args[instruction->argument].assign(sp[-1]);
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(PushLocal):
+            (sp++)->assign(locals[instruction->argument]);
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(StoreLocal):
+            locals[instruction->argument].assign(sp[-1]);
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(PushProperty):
+        {
+            const auto &member = As<MemberInstruction>(it);
+            auto &instance = *instances[member.depth];
+            *sp++ = GetVar(instance, FindData(Where, expression.cacheAt(member.cache), instance, member.name), member.name);
+            it += sizeof(MemberInstruction);
+            DISPATCH();
+        }
+        TARGET(StoreProperty):
+        {
+            const auto &member = As<MemberInstruction>(it);
+            auto &instance = *instances[member.depth];
+            instance.setVar(FindData(Where, expression.cacheAt(member.cache), instance, member.name), sp[-1]);
+            it += sizeof(MemberInstruction);
+            DISPATCH();
+        }
+        TARGET(PushExternal):
+        {
+            const auto &member = As<MemberInstruction>(it);
+            Meta::Data data;
+            auto &instance = FindExternalData(Where, expression.externalCacheAt(member.cache), instances, member.name, data);
+            *sp++ = GetVar(instance, data, member.name);
+            it += sizeof(MemberInstruction);
+            DISPATCH();
+        }
+        TARGET(StoreExternal):
+        {
+            const auto &member = As<MemberInstruction>(it);
+            Meta::Data data;
+            auto &instance = FindExternalData(Where, expression.externalCacheAt(member.cache), instances, member.name, data);
+            instance.setVar(data, sp[-1]);
+            it += sizeof(MemberInstruction);
+            DISPATCH();
+        }
+        TARGET(GetMember):
+        {
+            const auto &member = As<MemberInstruction>(it);
+            auto &object = *sp[-1].as<Object *>();
+            sp[-1] = GetVar(object, FindData(Where, expression.cacheAt(member.cache), object, member.name), member.name);
+            it += sizeof(MemberInstruction);
+            DISPATCH();
+        }
+        TARGET(SetMember):
+        {
+            const auto &member = As<MemberInstruction>(it);
+            auto &object = *sp[-2].as<Object *>();
+            object.setVar(FindData(Where, expression.cacheAt(member.cache), object, member.name), sp[-1]);
+            sp[-2] = std::move(sp[-1]);
+            (--sp)->destruct();
+            it += sizeof(MemberInstruction);
+            DISPATCH();
+        }
+
+        // Unary
+        TARGET(Not):
+            unary(std::logical_not<>());
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(Minus):
+            unary(std::negate<>());
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(BitReverse):
+            unary(std::bit_not<>());
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(Increment):
+            unary([](const Var &value) { return value + Var(static_cast<std::int64_t>(1)); });
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(Decrement):
+            unary([](const Var &value) { return value - Var(static_cast<std::int64_t>(1)); });
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(ToBoolean):
+            unary([](const Var &value) { return Var(value.toBool()); });
+            it += sizeof(Instruction);
+            DISPATCH();
+
+        // Binary
+        TARGET(Addition):
+            quicken(OpCode::IntegerAddition, OpCode::FloatingAddition);
+            binary(std::plus<>());
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(Substraction):
+            quicken(OpCode::IntegerSubstraction, OpCode::FloatingSubstraction);
+            binary(std::minus<>());
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(Multiplication):
+            quicken(OpCode::IntegerMultiplication, OpCode::FloatingMultiplication);
+            binary(std::multiplies<>());
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(Division):
+            binary(std::divides<>());
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(Modulo):
+            binary(std::modulus<>());
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(Equal):
+            binary(std::equal_to<>());
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(Different):
+            binary(std::not_equal_to<>());
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(Greater):
+            binary(std::greater<>());
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(GreaterEqual):
+            binary(std::greater_equal<>());
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(Lighter):
+            binary(std::less<>());
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(LighterEqual):
+            binary(std::less_equal<>());
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(BitAnd):
+            binary(std::bit_and<>());
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(BitOr):
+            binary(std::bit_or<>());
+            it += sizeof(Instruction);
+            DISPATCH();
+        TARGET(BitXor):
+            binary(std::bit_xor<>());
+            it += sizeof(Instruction);
+            DISPATCH();
+
+        // Control flow
+        TARGET(Jump):
+            it = code + instruction->argument;
+            DISPATCH();
+        TARGET(JumpIfFalse):
+        {
+            const auto condition = sp[-1].toBool();
+            (--sp)->destruct();
+            it = condition ? it + sizeof(Instruction) : code + instruction->argument;
+            DISPATCH();
+        }
+        TARGET(JumpIfTrueOrPop):
+            if (sp[-1].toBool())
+                it = code + instruction->argument;
+            else {
+                (--sp)->destruct();
+                it += sizeof(Instruction);
+            }
+            DISPATCH();
+        TARGET(JumpIfFalseOrPop):
+            if (!sp[-1].toBool())
+                it = code + instruction->argument;
+            else {
+                (--sp)->destruct();
+                it += sizeof(Instruction);
+            }
+            DISPATCH();
+        TARGET(JumpTable):
+        {
+            const auto &jump = As<TableInstruction>(it);
+            table(jump, FindDenseEntry(jump, sp[-1]));
+            DISPATCH();
+        }
+        TARGET(JumpSorted):
+        {
+            const auto &jump = As<TableInstruction>(it);
+            table(jump, FindSortedEntry(jump, sp[-1]));
+            DISPATCH();
+        }
+        TARGET(JumpHashed):
+        {
+            const auto &jump = As<TableInstruction>(it);
+            table(jump, FindHashedEntry(jump, sp[-1], code));
+            DISPATCH();
+        }
+
+        // Superinstructions
+        TARGET(AdditionInteger):
+            if (sp[-1].is<std::int64_t>())
+                Rewrite(instruction->code, OpCode::IntegerAdditionInteger);
+            immediate(std::plus<>());
+            it += sizeof(ImmediateInstruction);
+            DISPATCH();
+        TARGET(SubstractionInteger):
+            if (sp[-1].is<std::int64_t>())
+                Rewrite(instruction->code, OpCode::IntegerSubstractionInteger);
+            immediate(std::minus<>());
+            it += sizeof(ImmediateInstruction);
+            DISPATCH();
+        TARGET(MultiplicationInteger):
+            if (sp[-1].is<std::int64_t>())
+                Rewrite(instruction->code, OpCode::IntegerMultiplicationInteger);
+            immediate(std::multiplies<>());
+            it += sizeof(ImmediateInstruction);
+            DISPATCH();
+        TARGET(IncrementLocal):
+        {
+            auto &local = locals[instruction->argument];
+            local = local + Var(static_cast<std::int64_t>(1));
+            (sp++)->assign(local);
+            it += sizeof(Instruction);
+            DISPATCH();
+        }
+        TARGET(DecrementLocal):
+        {
+            auto &local = locals[instruction->argument];
+            local = local - Var(static_cast<std::int64_t>(1));
+            (sp++)->assign(local);
+            it += sizeof(Instruction);
+            DISPATCH();
+        }
+        TARGET(JumpUnlessEqual):
+            branch(std::equal_to<>(), instruction->argument);
+            DISPATCH();
+        TARGET(JumpUnlessDifferent):
+            branch(std::not_equal_to<>(), instruction->argument);
+            DISPATCH();
+        TARGET(JumpUnlessGreater):
+            quicken(OpCode::IntegerJumpUnlessGreater, OpCode::FloatingJumpUnlessGreater);
+            branch(std::greater<>(), instruction->argument);
+            DISPATCH();
+        TARGET(JumpUnlessGreaterEqual):
+            quicken(OpCode::IntegerJumpUnlessGreaterEqual, OpCode::FloatingJumpUnlessGreaterEqual);
+            branch(std::greater_equal<>(), instruction->argument);
+            DISPATCH();
+        TARGET(JumpUnlessLighter):
+            quicken(OpCode::IntegerJumpUnlessLighter, OpCode::FloatingJumpUnlessLighter);
+            branch(std::less<>(), instruction->argument);
+            DISPATCH();
+        TARGET(JumpUnlessLighterEqual):
+            quicken(OpCode::IntegerJumpUnlessLighterEqual, OpCode::FloatingJumpUnlessLighterEqual);
+            branch(std::less_equal<>(), instruction->argument);
+            DISPATCH();
+
+        // Quickened instructions operate on unboxed values and de-quicken once their operands change of type
+#define QUICKENED_BINARY(Name, Type, Value, Operation) \
+        TARGET(Type##Name): \
+            if (Holds<Value>(sp[-2], sp[-1])) [[likely]] { \
+                sp[-2] = Var(Operation<Value>()(sp[-2].as<Value>(), sp[-1].as<Value>())); \
+                (--sp)->destruct(); \
+            } else { \
+                Rewrite(instruction->code, OpCode::Name); \
+                binary(Operation<>()); \
+            } \
+            it += sizeof(Instruction); \
+            DISPATCH();
+#define QUICKENED_IMMEDIATE(Name, Operation) \
+        TARGET(Integer##Name): \
+            if (sp[-1].is<std::int64_t>()) [[likely]] \
+                sp[-1] = Var(Operation<std::int64_t>()(sp[-1].as<std::int64_t>(), As<ImmediateInstruction>(it).integer)); \
+            else { \
+                Rewrite(instruction->code, OpCode::Name); \
+                immediate(Operation<>()); \
+            } \
+            it += sizeof(ImmediateInstruction); \
+            DISPATCH();
+#define QUICKENED_BRANCH(Name, Type, Value, Operation) \
+        TARGET(Type##Name): \
+            if (Holds<Value>(sp[-2], sp[-1])) [[likely]] { \
+                const bool condition = Operation<Value>()(sp[-2].as<Value>(), sp[-1].as<Value>()); \
+                Release(sp - 2, sp); \
+                sp -= 2; \
+                it = condition ? it + sizeof(Instruction) : code + instruction->argument; \
+            } else { \
+                Rewrite(instruction->code, OpCode::Name); \
+                branch(Operation<>(), instruction->argument); \
+            } \
+            DISPATCH();
+
+        QUICKENED_BINARY(Addition, Integer, std::int64_t, std::plus)
+        QUICKENED_BINARY(Substraction, Integer, std::int64_t, std::minus)
+        QUICKENED_BINARY(Multiplication, Integer, std::int64_t, std::multiplies)
+        QUICKENED_IMMEDIATE(AdditionInteger, std::plus)
+        QUICKENED_IMMEDIATE(SubstractionInteger, std::minus)
+        QUICKENED_IMMEDIATE(MultiplicationInteger, std::multiplies)
+        QUICKENED_BRANCH(JumpUnlessGreater, Integer, std::int64_t, std::greater)
+        QUICKENED_BRANCH(JumpUnlessGreaterEqual, Integer, std::int64_t, std::greater_equal)
+        QUICKENED_BRANCH(JumpUnlessLighter, Integer, std::int64_t, std::less)
+        QUICKENED_BRANCH(JumpUnlessLighterEqual, Integer, std::int64_t, std::less_equal)
+        QUICKENED_BINARY(Addition, Floating, double, std::plus)
+        QUICKENED_BINARY(Substraction, Floating, double, std::minus)
+        QUICKENED_BINARY(Multiplication, Floating, double, std::multiplies)
+        QUICKENED_BRANCH(JumpUnlessGreater, Floating, double, std::greater)
+        QUICKENED_BRANCH(JumpUnlessGreaterEqual, Floating, double, std::greater_equal)
+        QUICKENED_BRANCH(JumpUnlessLighter, Floating, double, std::less)
+        QUICKENED_BRANCH(JumpUnlessLighterEqual, Floating, double, std::less_equal)
+
+#undef QUICKENED_BINARY
+#undef QUICKENED_IMMEDIATE
+#undef QUICKENED_BRANCH
+
+        // Calls
+        TARGET(CallFunction):
+        {
+            const auto &member = As<MemberInstruction>(it);
+            auto &instance = *instances[member.depth];
+            call(FindFunction(Where, instance, member.name), instance, member.argumentCount);
+            it += sizeof(MemberInstruction);
+            DISPATCH();
+        }
+        TARGET(CallExternal):
+        {
+            const auto &member = As<MemberInstruction>(it);
+            Meta::Function function;
+            auto &instance = FindExternalFunction(Where, expression.externalCacheAt(member.cache), instances, member.name, function);
+            call(function, instance, member.argumentCount);
+            it += sizeof(MemberInstruction);
+            DISPATCH();
+        }
+        TARGET(CallMember):
+        {
+            const auto &member = As<MemberInstruction>(it);
+            auto &object = *sp[-member.argumentCount - 1].as<Object *>();
+            call(FindFunction(Where, object, member.name), object, member.argumentCount);
+            // The result replaces the object
+            sp[-2] = std::move(sp[-1]);
+            (--sp)->destruct();
+            it += sizeof(MemberInstruction);
+            DISPATCH();
+        }
+        TARGET(Emit):
+        {
+            const auto &member = As<MemberInstruction>(it);
+            auto &instance = *instances[member.depth];
+            Var * const arguments = sp - member.argumentCount;
+            instance.emitSignal(FindSignal(Where, instance, member.name), arguments, member.argumentCount);
+            Release(arguments, sp);
+            sp = arguments + 1;
+            it += sizeof(MemberInstruction);
+            DISPATCH();
+        }
+        TARGET(Return):
+            return std::move(sp[-1]);
+
+        TARGET(None):
+        default:
+            throw std::logic_error("Lang::StackProcesser::process: Invalid instruction");
+        }
+    }
+
+#undef TARGET
+#undef DISPATCH
+#undef PROFILE
+}
+
+Lang::StackProcesser::Sequences Lang::StackProcesser::profile(const std::size_t count) const
+{
+    Sequences sequences;
+
+    for (auto i = 0u; i < _sequenceCounts.size(); ++i) {
+        if (!_sequenceCounts[i])
+            continue;
+        sequences.push(Sequence {
+            first: static_cast<OpCode>(i / OpCodeCount),
+            second: static_cast<OpCode>(i % OpCodeCount),
+            count: _sequenceCounts[i]
+        });
+    }
+    const auto kept = std::min<std::size_t>(count, sequences.size());
+    std::partial_sort(sequences.begin(), sequences.begin() + kept, sequences.end(),
+        [](const Sequence &lhs, const Sequence &rhs) { return lhs.count > rhs.count; });
+    sequences.resize(kept);
+    return sequences;
+}
+
+void Lang::StackProcesser::resetProfile(void) noexcept
+{
+    std::fill(_sequenceCounts.begin(), _sequenceCounts.end(), 0u);
+}
@@ -0,0 +1,90 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: StackProcesser
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+
+#include "Expression.hpp"
+
+namespace kF::Lang
+{
+    class StackProcesser;
+}
+
+/** @brief The StackProcesser executes expressions using an explicit operand stack instead of recursion
+ *  Each thread owns a processer whose stack is preallocated once and reused by every call, nested calls included
+ *  A call frame is made of the expression's local slots followed by its operand stack
+ *  Slots above the top of the operand stack are always void
+ *  Hot expressions are translated by the StackJit where it is available, their machine code runs on the same frames */
+class alignas_cacheline kF::Lang::StackProcesser
+{
+public:
+    /** @brief Count of variables preallocated in the stack of a processer */
+    static constexpr std::size_t DefaultStackSize = 4096u;
+
+    /** @brief Count of executions after which an expression is translated into machine code */
+    static constexpr std::uint32_t DefaultJitThreshold = 64u;
+
+    /** @brief Threshold disabling machine code translation */
+    static constexpr std::uint32_t NoJit = ~static_cast<std::uint32_t>(0u);
+
+    /** @brief Execution count of a sequence of two instructions */
+    struct alignas_quarter_cacheline Sequence
+    {
+        OpCode first { OpCode::None };
+        OpCode second { OpCode::None };
+        std::uint64_t count { 0u };
+    };
+
+    /** @brief A list of sequences */
+    using Sequences = Core::Vector<Sequence>;
+
+
+    /** @brief Get the processer of the calling thread */
+    [[nodiscard]] static StackProcesser &Local(void) noexcept;
+
+    /** @brief Construct a processer and preallocate its stack */
+    StackProcesser(const std::size_t stackSize = DefaultStackSize);
+
+    /** @brief Processers are not copyable */
+    StackProcesser(const StackProcesser &other) = delete;
+    StackProcesser &operator=(const StackProcesser &other) = delete;
+
+    /** @brief Destructor */
+    ~StackProcesser(void) noexcept = default;
+
+
+    /** @brief Execute an expression
+     *  'instances' is a null terminated list of the instance of each enclosing class, innermost first
+     *  'args' holds the parameters of the expression */
+    [[nodiscard]] Var process(const Expression &expression, Object * const *instances, Var *args);
+
+    /** @brief Get the count of stack variables used by running frames */
+    [[nodiscard]] std::uint32_t stackSize(void) const noexcept { return _top; }
+
+
+    /** @brief Get the count of executions after which an expression is translated into machine code */
+    [[nodiscard]] std::uint32_t jitThreshold(void) const noexcept { return _jitThreshold; }
+
+    /** @brief Set the count of executions after which an expression is translated, 'NoJit' only interprets */
+    void setJitThreshold(const std::uint32_t threshold) noexcept { _jitThreshold = threshold; }
+
+
+    /** @brief Get the 'count' most executed sequences of two instructions, which are candidates to superinstructions
+     *  Sequences are only recorded when the library is built with 'KUBE_INTERPRETER_PROFILE' */
+    [[nodiscard]] Sequences profile(const std::size_t count) const;
+
+    /** @brief Forget every recorded sequence */
+    void resetProfile(void) noexcept;
+
+private:
+    Core::Vector<Var> _stack {};
+    Core::Vector<std::uint64_t> _sequenceCounts {};
+    std::uint32_t _top { 0u };
+    std::uint32_t _jitThreshold { DefaultJitThreshold };
+};
+
+static_assert_fit_cacheline(kF::Lang::StackProcesser);
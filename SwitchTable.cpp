@@ -0,0 +1,104 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: SwitchTable
+ */
+
+#include <algorithm>
+#include <bit>
+#include <string>
+
+#include "SwitchTable.hpp"
+#include "Optimizer.hpp"
+#include "Instructions.hpp"
+
+using namespace kF;
+
+Lang::SwitchTable::SwitchTable(const AST &node)
+{
+    const auto children = node.children();
+    Core::TinyVector<Entry> keys;
+    Core::TinyVector<std::string> literals;
+    auto kind = Optimizer::ValueKind::None;
+
+    // Children are the subject followed by (value, body) pairs and an optional default body
+    _caseCount = static_cast<std::uint32_t>((children.size() - 1u) / 2u);
+    if (_caseCount < MinCaseCount)
+        return;
+    for (auto index = 0u; index < _caseCount; ++index) {
+        auto value = Optimizer::ParseConstant(*children[1u + index * 2u]);
+        if (value.kind != Optimizer::ValueKind::Integer && value.kind != Optimizer::ValueKind::Literal)
+            return;
+        else if (kind == Optimizer::ValueKind::None)
+            kind = value.kind;
+        else if (kind != value.kind)
+            return;
+        if (kind == Optimizer::ValueKind::Integer) {
+            keys.push(Entry {
+                key: value.integer,
+                caseIndex: index
+            });
+        } else if (std::find(literals.begin(), literals.end(), value.literal) == literals.end()) {
+            keys.push(Entry {
+                key: static_cast<std::int64_t>(Hash(std::string_view(value.literal))),
+                caseIndex: index
+            });
+            literals.push(std::move(value.literal));
+        }
+    }
+
+    // Only the first case of a value can match, distinct literals sharing a hash can't be told apart by a table
+    const auto isSameKey = [](const Entry &lhs, const Entry &rhs) { return lhs.key == rhs.key; };
+    std::stable_sort(keys.begin(), keys.end(), [](const Entry &lhs, const Entry &rhs) { return lhs.key < rhs.key; });
+    if (kind == Optimizer::ValueKind::Integer) {
+        keys.erase(std::unique(keys.begin(), keys.end(), isSameKey), keys.end());
+        buildIntegers(keys);
+    } else if (std::adjacent_find(keys.begin(), keys.end(), isSameKey) == keys.end() && buildHashed(keys))
+        _kind = Kind::Hashed;
+}
+
+void Lang::SwitchTable::buildIntegers(const Core::TinyVector<Entry> &keys)
+{
+    const auto range = static_cast<std::uint64_t>(keys.back().key) - static_cast<std::uint64_t>(keys.front().key);
+
+    if (range < MaxDenseCount && range < keys.size() * 2u) {
+        _kind = Kind::Dense;
+        _base = keys.front().key;
+        _entries.resize(static_cast<std::size_t>(range) + 1u);
+        for (auto index = 0u; index < _entries.size(); ++index)
+            _entries[index].key = _base + index;
+        for (const auto &key : keys)
+            _entries[static_cast<std::size_t>(key.key - _base)].caseIndex = key.caseIndex;
+    } else {
+        _kind = Kind::Sorted;
+        _entries.insert(_entries.end(), keys.begin(), keys.end());
+    }
+}
+
+bool Lang::SwitchTable::buildHashed(const Core::TinyVector<Entry> &hashes)
+{
+    const auto caseCount = static_cast<std::uint32_t>(hashes.size());
+    Core::TinyVector<std::uint8_t> used;
+
+    for (auto count = std::bit_ceil(caseCount); count <= std::bit_ceil(caseCount) * MaxHashedLoad; count *= 2u) {
+        for (auto attempt = 0u; attempt < HashedSeedCount; ++attempt) {
+            const auto seed = 0x9E3779B1u + attempt * 2u;
+            used.clear();
+            used.resize(count, 0u);
+            const auto collides = std::any_of(hashes.begin(), hashes.end(), [&used, seed, count](const Entry &entry) {
+                const auto slot = HashedEntry(static_cast<HashedName>(entry.key), seed, count);
+                if (used[slot])
+                    return true;
+                used[slot] = 1u;
+                return false;
+            });
+            if (collides)
+                continue;
+            _seed = seed;
+            _entries.resize(count);
+            for (const auto &entry : hashes)
+                _entries[HashedEntry(static_cast<HashedName>(entry.key), seed, count)] = entry;
+            return true;
+        }
+    }
+    return false;
+}
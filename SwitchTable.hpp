@@ -0,0 +1,97 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: SwitchTable
+ */
+
+#pragma once
+
+#include <Kube/Core/Vector.hpp>
+
+#include "AST.hpp"
+
+namespace kF::Lang
+{
+    class SwitchTable;
+}
+
+/** @brief The SwitchTable analyses the cases of a switch statement to dispatch it with a single lookup instead of chained compares
+ *  Compact integer constants are dispatched through a dense table indexed by value, sparse ones by a binary search
+ *  over sorted keys and literals through a perfect hash table, a literal being still compared to its entry once found
+ *  Compilers keep the chained compares after the table for subjects of another type, so that comparisons stay the same
+ *  Duplicated values keep their first case, as chained compares would do */
+class alignas_half_cacheline kF::Lang::SwitchTable
+{
+public:
+    /** @brief Kind of table */
+    enum class Kind : std::uint32_t {
+        None,
+        Dense,
+        Sorted,
+        Hashed
+    };
+
+    /** @brief Case index of the entries matching no case */
+    static constexpr std::uint32_t NoCase = ~static_cast<std::uint32_t>(0u);
+
+    /** @brief Minimum count of cases to build a table, fewer compares are as fast as a lookup */
+    static constexpr std::uint32_t MinCaseCount = 4u;
+
+    /** @brief Maximum count of entries of a dense table, it must also hold at least one case every two entries */
+    static constexpr std::uint32_t MaxDenseCount = 1024u;
+
+    /** @brief Maximum count of entries of a hashed table, relative to its count of cases */
+    static constexpr std::uint32_t MaxHashedLoad = 4u;
+
+    /** @brief Count of seeds tried per size of hashed table */
+    static constexpr std::uint32_t HashedSeedCount = 64u;
+
+    /** @brief An entry of the table, 'key' is the value (or the literal hash) of its case */
+    struct alignas_quarter_cacheline Entry
+    {
+        std::int64_t key { 0 };
+        std::uint32_t caseIndex { NoCase };
+    };
+
+
+    /** @brief Analyse a switch statement node, the table kind is None if its cases can't be dispatched through a table */
+    SwitchTable(const AST &node);
+
+    /** @brief Tables are not copyable */
+    SwitchTable(const SwitchTable &other) = delete;
+    SwitchTable &operator=(const SwitchTable &other) = delete;
+
+    /** @brief Destructor */
+    ~SwitchTable(void) noexcept = default;
+
+
+    /** @brief Get the kind of table */
+    [[nodiscard]] Kind kind(void) const noexcept { return _kind; }
+
+    /** @brief Get the count of cases of the switch */
+    [[nodiscard]] std::uint32_t caseCount(void) const noexcept { return _caseCount; }
+
+    /** @brief Get the value of the first entry of a dense table */
+    [[nodiscard]] std::int64_t base(void) const noexcept { return _base; }
+
+    /** @brief Get the seed of a hashed table */
+    [[nodiscard]] std::uint32_t seed(void) const noexcept { return _seed; }
+
+    /** @brief Get the entries of the table */
+    [[nodiscard]] const Core::TinyVector<Entry> &entries(void) const noexcept { return _entries; }
+
+private:
+    // Cacheline 1
+    Core::TinyVector<Entry> _entries {};
+    std::int64_t _base { 0 };
+    Kind _kind { Kind::None };
+    std::uint32_t _caseCount { 0u };
+    std::uint32_t _seed { 0u };
+
+    /** @brief Build a dense or a sorted table out of unique keys sorted in ascending order */
+    void buildIntegers(const Core::TinyVector<Entry> &keys);
+
+    /** @brief Build a hashed table out of unique literal hashes, fails if no seed gives each hash its own entry */
+    [[nodiscard]] bool buildHashed(const Core::TinyVector<Entry> &hashes);
+};
+
+static_assert_fit_half_cacheline(kF::Lang::SwitchTable);
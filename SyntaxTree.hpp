@@ -0,0 +1,104 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Syntax tree of a file
+ */
+
+#pragma once
+
+#include <memory>
+#include <memory_resource>
+#include <initializer_list>
+
+#include "TokenStack.hpp"
+#include "AST.hpp"
+
+namespace kF::Lang
+{
+    class SyntaxTree;
+}
+
+/** @brief A syntax tree owns every AST node and child array of a file
+ *  Nodes and child arrays are bump allocated in creation order and released all at once with the tree
+ *  Nodes are never moved so they can be referenced by address until the tree is destroyed */
+class alignas_cacheline kF::Lang::SyntaxTree
+{
+public:
+    /** @brief An unique pointer to a tree */
+    using Ptr = std::unique_ptr<SyntaxTree>;
+
+    /** @brief Size of the first memory block of a tree */
+    static constexpr std::size_t InitialBufferSize = 4096u;
+
+
+    /** @brief Create a new tree */
+    [[nodiscard]] static inline Ptr Make(void) { return std::make_unique<SyntaxTree>(); }
+
+    /** @brief Default constructor */
+    SyntaxTree(void) = default;
+
+    /** @brief Trees are not copyable nor movable as nodes reference each other by address */
+    SyntaxTree(const SyntaxTree &other) = delete;
+    SyntaxTree &operator=(const SyntaxTree &other) = delete;
+
+    /** @brief Destructor */
+    ~SyntaxTree(void) noexcept = default;
+
+
+    /** @brief Get the root node (unsafe if the tree is empty) */
+    [[nodiscard]] AST &root(void) noexcept { return *_root; }
+    [[nodiscard]] const AST &root(void) const noexcept { return *_root; }
+
+    /** @brief Set the root node */
+    void setRoot(AST &root) noexcept { _root = &root; }
+
+    /** @brief Check if the tree has a root */
+    [[nodiscard]] bool empty(void) const noexcept { return !_root; }
+
+    /** @brief Get the count of node created within the tree */
+    [[nodiscard]] std::size_t nodeCount(void) const noexcept { return _nodeCount; }
+
+    /** @brief Get the stack holding tokens generated after parsing (folded constants) */
+    [[nodiscard]] TokenStack &constants(void) noexcept { return _constants; }
+    [[nodiscard]] const TokenStack &constants(void) const noexcept { return _constants; }
+
+
+    /** @brief Create a detached node */
+    [[nodiscard]] AST &make(const Token *token, const TokenType type) noexcept
+        { return construct(new (allocateNode()) AST(token, type)); }
+
+    /** @brief Create a detached node using a data type */
+    template<typename DataType>
+    [[nodiscard]] AST &make(const Token *token, const TokenType type, const DataType data) noexcept
+        { return construct(new (allocateNode()) AST(token, type, data)); }
+
+    /** @brief Create a detached node using a data type and a list of children */
+    template<typename DataType>
+    [[nodiscard]] AST &make(const Token *token, const TokenType type, const DataType data, const std::initializer_list<AST *> children) noexcept
+    {
+        auto &node = make(token, type, data);
+        setChildren(node, children.begin(), static_cast<AST::ChildIndex>(children.size()));
+        return node;
+    }
+
+    /** @brief Set the children of a node, they are copied into the tree's child storage
+     *  The node's hash is updated so it must be called once every child hash is final */
+    void setChildren(AST &node, AST * const *children, const AST::ChildIndex count) noexcept;
+
+    /** @brief Update the hash of every node, must be called after modifying the tree */
+    void updateHashes(void) noexcept;
+
+private:
+    std::pmr::monotonic_buffer_resource _resource { InitialBufferSize };
+    AST *_root { nullptr };
+    TokenStack _constants {};
+    std::size_t _nodeCount { 0u };
+
+    /** @brief Finalize a newly constructed node */
+    [[nodiscard]] AST &construct(AST * const node) noexcept { node->updateHash(); return *node; }
+
+    /** @brief Allocate memory for a single node */
+    [[nodiscard]] void *allocateNode(void) noexcept
+        { ++_nodeCount; return _resource.allocate(sizeof(AST), alignof(AST)); }
+};
+
+#include "SyntaxTree.ipp"
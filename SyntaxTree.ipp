@@ -0,0 +1,27 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Syntax tree of a file
+ */
+
+inline void kF::Lang::SyntaxTree::setChildren(AST &node, AST * const *children, const AST::ChildIndex count) noexcept
+{
+    if (!count) {
+        node._children = nullptr;
+        node._childrenCount = 0u;
+    } else {
+        node._children = reinterpret_cast<AST **>(_resource.allocate(sizeof(AST *) * count, alignof(AST *)));
+        node._childrenCount = count;
+        std::copy(children, children + count, node._children);
+    }
+    node.updateHash();
+}
+
+inline void kF::Lang::SyntaxTree::updateHashes(void) noexcept
+{
+    if (!_root) [[unlikely]]
+        return;
+    _root->traverse(
+        [](AST &) noexcept { return true; },
+        [](AST &node) noexcept { node.updateHash(); }
+    );
+}
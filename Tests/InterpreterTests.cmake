@@ -3,11 +3,28 @@ project(KubeInterpreterTests)
 get_filename_component(KubeInterpreterTestsDir ${CMAKE_CURRENT_LIST_FILE} PATH)
 
 set(KubeInterpreterTestsSources
+    ${KubeInterpreterTestsDir}/Program.hpp
     ${KubeInterpreterTestsDir}/tests_Interpreter.cpp
     ${KubeInterpreterTestsDir}/tests_TokenStack.cpp
     ${KubeInterpreterTestsDir}/tests_Lexer.cpp
     ${KubeInterpreterTestsDir}/tests_DirectoryManager.cpp
-    # ${KubeInterpreterTestsDir}/tests_AST.cpp
+    ${KubeInterpreterTestsDir}/tests_Parser.cpp
+    ${KubeInterpreterTestsDir}/tests_Optimizer.cpp
+    ${KubeInterpreterTestsDir}/tests_NameResolver.cpp
+    ${KubeInterpreterTestsDir}/tests_Compiler.cpp
+    ${KubeInterpreterTestsDir}/tests_StackProcesser.cpp
+    ${KubeInterpreterTestsDir}/tests_StackJit.cpp
+    ${KubeInterpreterTestsDir}/tests_BatchProcesser.cpp
+    ${KubeInterpreterTestsDir}/tests_RegisterProcesser.cpp
+    ${KubeInterpreterTestsDir}/tests_ClosureProcesser.cpp
+    ${KubeInterpreterTestsDir}/tests_SwitchTable.cpp
+    ${KubeInterpreterTestsDir}/tests_BindingGraph.cpp
+    ${KubeInterpreterTestsDir}/tests_EventTable.cpp
+    ${KubeInterpreterTestsDir}/tests_Prototype.cpp
+    ${KubeInterpreterTestsDir}/tests_ColumnStorage.cpp
+    ${KubeInterpreterTestsDir}/tests_AST.cpp
+    ${KubeInterpreterTestsDir}/tests_Visitor.cpp
+    ${KubeInterpreterTestsDir}/tests_Formatter.cpp
 )
 
 add_executable(${CMAKE_PROJECT_NAME} ${KubeInterpreterTestsSources})
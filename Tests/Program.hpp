@@ -0,0 +1,61 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Program fixture shared by unit tests
+ */
+
+#pragma once
+
+#include <sstream>
+
+#include <Kube/Interpreter/Lexer.hpp>
+#include <Kube/Interpreter/Parser.hpp>
+#include <Kube/Interpreter/NameResolver.hpp>
+
+#if KUBE_INTERPRETER_CLOSURES
+# include <Kube/Interpreter/ClosureCompiler.hpp>
+#elif KUBE_INTERPRETER_REGISTER_MACHINE
+# include <Kube/Interpreter/RegisterCompiler.hpp>
+#else
+# include <Kube/Interpreter/Compiler.hpp>
+#endif
+
+namespace kF::Lang::Tests
+{
+    struct Program;
+
+    template<typename Compiler>
+    struct CompiledProgram;
+
+    /** @brief Compiler of the processer selected at build time */
+#if KUBE_INTERPRETER_CLOSURES
+    using BuildCompiler = ClosureCompiler;
+#elif KUBE_INTERPRETER_REGISTER_MACHINE
+    using BuildCompiler = RegisterCompiler;
+#else
+    using BuildCompiler = Compiler;
+#endif
+}
+
+/** @brief Parse and resolve a code snippet */
+struct kF::Lang::Tests::Program
+{
+    TokenStack stack;
+    SyntaxTree::Ptr tree;
+
+    Program(const char *code)
+    {
+        std::istringstream iss(code);
+        stack = Lexer().run(0, iss, "Root");
+        tree = Parser().run(0, &stack, "Root");
+        NameResolver().run(*tree, "Root");
+    }
+};
+
+/** @brief Compile every member of a code snippet */
+template<typename Compiler>
+struct kF::Lang::Tests::CompiledProgram : public Program
+{
+    typename Compiler::Units units;
+
+    CompiledProgram(const char *code) : Program(code), units(Compiler().run(*tree, "Root")) {}
+};
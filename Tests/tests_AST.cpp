@@ -0,0 +1,97 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of AST
+ */
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include <Kube/Interpreter/Lexer.hpp>
+#include <Kube/Interpreter/Parser.hpp>
+#include <Kube/Interpreter/ParallelTraversal.hpp>
+
+using namespace kF;
+
+static constexpr auto TraverseCode = "Item { property x: a + b * c; function f(y) { y = -y; } }";
+
+TEST(AST, Traverse)
+{
+    std::istringstream iss(TraverseCode);
+    auto stack = Lang::Lexer().run(0, iss, "Root");
+    auto tree = Lang::Parser().run(0, &stack, "Root");
+    std::string preOrder, postOrder;
+
+    tree->root().traverse(
+        [&preOrder](const Lang::AST &node) {
+            if (node.type() == Lang::TokenType::Operator || node.type() == Lang::TokenType::Name)
+                preOrder += node.literal();
+            // Skip the function's body
+            return node.type() != Lang::TokenType::Function;
+        },
+        [&postOrder](const Lang::AST &node) {
+            if (node.type() == Lang::TokenType::Operator || node.type() == Lang::TokenType::Name)
+                postOrder += node.literal();
+        }
+    );
+    ASSERT_EQ(preOrder, "+a*bc");
+    ASSERT_EQ(postOrder, "abc*+");
+
+    std::size_t count = 0u;
+    tree->root().traverse([&count](const Lang::AST &) { ++count; return true; });
+    ASSERT_EQ(count, tree->nodeCount());
+}
+
+TEST(AST, ParallelTraverse)
+{
+    std::string code = "Item {";
+    for (auto i = 0u; i < 256u; ++i)
+        code += " property p" + std::to_string(i) + ": a + b * c;";
+    code += " }";
+    std::istringstream iss(code);
+    auto stack = Lang::Lexer().run(0, iss, "Root");
+    auto tree = Lang::Parser().run(0, &stack, "Root");
+
+    Flow::Scheduler scheduler;
+    Lang::ParallelTraversal traversal(&scheduler, 64u);
+    const auto count = traversal.run<std::size_t>(tree->root(),
+        [](const Lang::AST &, std::size_t &count) { ++count; return true; },
+        [](std::size_t &count, std::size_t &&partial) { count += partial; }
+    );
+    ASSERT_EQ(count, tree->nodeCount());
+    ASSERT_GT(traversal.taskCount(), 1u);
+
+    const auto operators = traversal.run<std::size_t>(tree->root(),
+        [](const Lang::AST &node, std::size_t &count) {
+            count += node.type() == Lang::TokenType::Operator;
+            return node.type() != Lang::TokenType::Property;
+        },
+        [](std::size_t &count, std::size_t &&partial) { count += partial; }
+    );
+    ASSERT_EQ(operators, 0u);
+}
+
+TEST(AST, Hash)
+{
+    const auto parse = [](const char *code, Lang::TokenStack &stack) {
+        std::istringstream iss(code);
+        stack = Lang::Lexer().run(0, iss, "Root");
+        return Lang::Parser().run(0, &stack, "Root");
+    };
+    Lang::TokenStack stack1, stack2, stack3;
+    auto tree1 = parse("Item { property x: a + b; function f(y) { return y * 2; } }", stack1);
+    auto tree2 = parse("Item {\n  property x:a+b;\n\n  function f(y) {\n    return y*2;\n  }\n}", stack2);
+    auto tree3 = parse("Item { property x: a + b; function f(y) { return y * 3; } }", stack3);
+
+    // Formatting doesn't change any hash
+    ASSERT_EQ(tree1->root().hash(), tree2->root().hash());
+
+    // Only the modified member and its ancestors change
+    ASSERT_NE(tree1->root().hash(), tree3->root().hash());
+    ASSERT_EQ(tree1->root().children()[0]->hash(), tree3->root().children()[0]->hash());
+    ASSERT_NE(tree1->root().children()[1]->hash(), tree3->root().children()[1]->hash());
+
+    // Literals are part of the hash
+    auto &sum = *tree1->root().children()[0]->children()[0]->children()[0];
+    ASSERT_NE(sum.children()[0]->hash(), sum.children()[1]->hash());
+}
@@ -0,0 +1,141 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of BatchProcesser
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/Interpreter/Compiler.hpp>
+#include <Kube/Interpreter/StackProcesser.hpp>
+#include <Kube/Interpreter/BatchProcesser.hpp>
+
+#include "Program.hpp"
+
+using namespace kF;
+
+namespace
+{
+    using Program = Lang::Tests::CompiledProgram<Lang::Compiler>;
+
+    /** @brief Argument sets of a batch */
+    struct Batch
+    {
+        static constexpr std::uint32_t Count = 1000u;
+
+        Var args[Count][2] {};
+        Var *sets[Count] {};
+        Object * const *instances[Count] {};
+        Var results[Count] {};
+
+        Batch(Object * const *chain)
+        {
+            for (auto i = 0u; i < Count; ++i) {
+                args[i][0] = Var(static_cast<std::int64_t>(i));
+                args[i][1] = Var(static_cast<std::int64_t>(i % 7) + 1);
+                sets[i] = args[i];
+                instances[i] = chain;
+            }
+        }
+
+        /** @brief Check the results against the stack processer */
+        void check(const Lang::Expression &expression)
+        {
+            for (auto i = 0u; i < Count; ++i) {
+                const auto expected = Lang::StackProcesser::Local().process(expression, instances[i], args[i]);
+                ASSERT_EQ(results[i].storage(), expected.storage());
+            }
+        }
+    };
+}
+
+TEST(BatchProcesser, Vectorized)
+{
+    Program program(
+        "Item {"
+        "  function arith(a, b) { return (a + b) * 3 - a / b + a % b; }"
+        "  function mixed(a, b) { return a / 2.0 + b; }"
+        "  function compare(a, b) { return a * 2 >= b + 10; }"
+        "  function logic(a, b) { return !(a - b * 100 < 0.5) == (a > 1); }"
+        "}"
+    );
+    Object *chain[] = { nullptr };
+    auto &processer = Lang::BatchProcesser::Local();
+
+    for (const auto &unit : program.units) {
+        ASSERT_TRUE(Lang::BatchProcesser::IsVectorizable(*unit.expression));
+        Batch batch(chain);
+        const auto vectorized = processer.vectorizedCount();
+        processer.process(*unit.expression, batch.instances, batch.sets, Batch::Count, batch.results);
+        ASSERT_EQ(processer.vectorizedCount(), vectorized + Batch::Count);
+        batch.check(*unit.expression);
+    }
+}
+
+TEST(BatchProcesser, Properties)
+{
+    Program program(
+        "Item {"
+        "  property x: 0;"
+        "  function scaled(a) { return x * a + 1; }"
+        "  Child { function offset(a) { return x - a; } }"
+        "}"
+    );
+    constexpr auto Count = 10u;
+    Object items[Count];
+    Object child;
+    Object *chains[Count][3];
+    Object * const *instances[Count];
+    Var args[Count][1];
+    Var *sets[Count];
+    Var results[Count];
+    for (auto i = 0u; i < Count; ++i) {
+        items[i].properties[Hash("x")] = Var(static_cast<std::int64_t>(i));
+        chains[i][0] = &child;
+        chains[i][1] = &items[i];
+        chains[i][2] = nullptr;
+        args[i][0] = Var(3);
+        sets[i] = args[i];
+    }
+    auto &processer = Lang::BatchProcesser::Local();
+
+    // Properties of the innermost instance are read through their inline cache, others are found by name
+    for (auto i = 0u; i < Count; ++i)
+        instances[i] = chains[i] + 1;
+    processer.process(*program.units[1].expression, instances, sets, Count, results);
+    for (auto i = 0u; i < Count; ++i)
+        ASSERT_EQ(results[i].as<std::int64_t>(), i * 3 + 1);
+    for (auto i = 0u; i < Count; ++i)
+        instances[i] = chains[i];
+    processer.process(*program.units[2].expression, instances, sets, Count, results);
+    for (auto i = 0u; i < Count; ++i)
+        ASSERT_EQ(results[i].as<std::int64_t>(), static_cast<std::int64_t>(i) - 3);
+}
+
+TEST(BatchProcesser, Fallback)
+{
+    Program program(
+        "Item {"
+        "  function arith(a, b) { return a * b - 1; }"
+        "  function branch(a, b) { if (a > b) { return a; } return b; }"
+        "}"
+    );
+    Object *chain[] = { nullptr };
+    auto &processer = Lang::BatchProcesser::Local();
+
+    // A lane of another type evaluates its whole chunk set by set
+    Batch batch(chain);
+    batch.args[300][0] = Var(2.5);
+    auto vectorized = processer.vectorizedCount();
+    auto scalar = processer.scalarCount();
+    processer.process(*program.units[0].expression, batch.instances, batch.sets, Batch::Count, batch.results);
+    ASSERT_EQ(processer.scalarCount(), scalar + Lang::BatchProcesser::LaneCount);
+    ASSERT_EQ(processer.vectorizedCount(), vectorized + Batch::Count - Lang::BatchProcesser::LaneCount);
+    batch.check(*program.units[0].expression);
+
+    // Expressions that branch are evaluated set by set
+    ASSERT_FALSE(Lang::BatchProcesser::IsVectorizable(*program.units[1].expression));
+    vectorized = processer.vectorizedCount();
+    processer.process(*program.units[1].expression, batch.instances, batch.sets, Batch::Count, batch.results);
+    ASSERT_EQ(processer.vectorizedCount(), vectorized);
+    batch.check(*program.units[1].expression);
+}
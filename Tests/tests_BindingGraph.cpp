@@ -0,0 +1,209 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of BindingGraph
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/Flow/Scheduler.hpp>
+#include <Kube/Interpreter/BindingGraph.hpp>
+
+#include "Program.hpp"
+
+using namespace kF;
+
+namespace
+{
+    using Program = Lang::Tests::CompiledProgram<Lang::Tests::BuildCompiler>;
+}
+
+TEST(BindingGraph, Incremental)
+{
+    Program program(
+        "Item {"
+        "  property x: y * 2;"
+        "  property z: x + target.w;"
+        "  property u: target.w;"
+        "  property y: 1;"
+        "  property target: 0;"
+        "}"
+    );
+    Object item, target;
+    item.properties[Hash("x")] = Var(0);
+    item.properties[Hash("y")] = Var(3);
+    item.properties[Hash("z")] = Var(0);
+    item.properties[Hash("u")] = Var(0);
+    item.properties[Hash("target")] = Var(&target);
+    target.properties[Hash("w")] = Var(10);
+    Object *instances[] = { &item, nullptr };
+    Lang::BindingGraph graph;
+
+    // Dependencies are discovered on first evaluation, a binding that read a dirty binding is evaluated again after it
+    graph.add(item, Hash("z"), *program.units[1].expression, instances);
+    graph.add(item, Hash("x"), *program.units[0].expression, instances);
+    graph.add(item, Hash("u"), *program.units[2].expression, instances);
+    ASSERT_EQ(graph.dirtyCount(), 3u);
+    graph.update();
+    ASSERT_EQ(graph.evaluationCount(), 4u);
+    ASSERT_EQ(item.properties[Hash("z")].as<int>(), 16);
+    graph.update();
+    ASSERT_EQ(graph.evaluationCount(), 4u);
+
+    // Only the readers of a changed property and their own readers are evaluated, once each
+    item.properties[Hash("y")] = Var(5);
+    graph.invalidate(item, Hash("y"));
+    ASSERT_EQ(graph.dirtyCount(), 1u);
+    graph.update();
+    ASSERT_EQ(graph.evaluationCount(), 6u);
+    ASSERT_EQ(item.properties[Hash("z")].as<int>(), 20);
+
+    // Dependencies are tracked across objects
+    target.properties[Hash("w")] = Var(1);
+    graph.invalidate(target, Hash("w"));
+    ASSERT_EQ(graph.dirtyCount(), 2u);
+    graph.update();
+    ASSERT_EQ(graph.evaluationCount(), 8u);
+    ASSERT_EQ(item.properties[Hash("z")].as<int>(), 11);
+    ASSERT_EQ(item.properties[Hash("u")].as<int>(), 1);
+    ASSERT_EQ(graph.dirtyCount(), 0u);
+}
+
+TEST(BindingGraph, Loops)
+{
+    Program program(
+        "Item {"
+        "  property a: b + 1;"
+        "  property b: a + 1;"
+        "}"
+    );
+    Object item;
+    item.properties[Hash("a")] = Var(0);
+    item.properties[Hash("b")] = Var(0);
+    Object *instances[] = { &item, nullptr };
+    Lang::BindingGraph graph;
+
+    // Loops are detected as soon as their dependencies are discovered
+    graph.add(item, Hash("a"), *program.units[0].expression, instances);
+    graph.add(item, Hash("b"), *program.units[1].expression, instances);
+    ASSERT_ANY_THROW(graph.update());
+    ASSERT_ANY_THROW(graph.add(item, Hash("a"), *program.units[1].expression, instances));
+    ASSERT_EQ(graph.dirtyCount(), 2u);
+
+    // Loops stay detected once dependencies are known
+    graph.invalidate(item, Hash("a"));
+    ASSERT_ANY_THROW(graph.update());
+    ASSERT_EQ(graph.dirtyCount(), 2u);
+}
+
+TEST(BindingGraph, Levels)
+{
+    constexpr auto ItemCount = 8u;
+
+    Program program(
+        "Item {"
+        "  property x: y * 2;"
+        "  property z: x + target.w;"
+        "  property u: target.w;"
+        "  property y: 1;"
+        "  property target: 0;"
+        "}"
+    );
+    Flow::Scheduler scheduler;
+    Lang::BindingGraph graph(&scheduler, 2u);
+    Object target;
+    Object items[ItemCount];
+    Object *instances[ItemCount][2];
+    target.properties[Hash("w")] = Var(10);
+    for (auto i = 0u; i < ItemCount; ++i) {
+        auto &item = items[i];
+        item.properties[Hash("x")] = Var(0);
+        item.properties[Hash("y")] = Var(static_cast<int>(i));
+        item.properties[Hash("z")] = Var(0);
+        item.properties[Hash("u")] = Var(0);
+        item.properties[Hash("target")] = Var(&target);
+        instances[i][0] = &item;
+        instances[i][1] = nullptr;
+        for (auto j = 0u; j < 3u; ++j)
+            graph.add(item, Hash(j == 0u ? "x" : j == 1u ? "z" : "u"), *program.units[j].expression, instances[i]);
+    }
+
+    // Bindings never evaluated are not scheduled as they may read any property
+    graph.update();
+    ASSERT_EQ(graph.taskCount(), 0u);
+    ASSERT_EQ(graph.bindingCount(), 3u * ItemCount);
+
+    // Changes of a frame are coalesced, each dependent is evaluated once
+    target.properties[Hash("w")] = Var(1);
+    graph.invalidate(target, Hash("w"));
+    graph.invalidate(target, Hash("w"));
+    const auto count = graph.evaluationCount();
+    graph.update();
+    ASSERT_EQ(graph.evaluationCount(), count + 2u * ItemCount);
+    ASSERT_EQ(graph.levelCount(), 1u);
+    ASSERT_EQ(graph.taskCount(), ItemCount);
+
+    // Levels follow the dependency depth, the bindings of an object are never split between tasks
+    for (auto i = 0u; i < ItemCount; ++i) {
+        items[i].properties[Hash("y")] = Var(static_cast<int>(i * 2u));
+        graph.invalidate(items[i], Hash("y"));
+    }
+    graph.update();
+    ASSERT_EQ(graph.evaluationCount(), count + 4u * ItemCount);
+    ASSERT_EQ(graph.levelCount(), 2u);
+    ASSERT_EQ(graph.taskCount(), ItemCount);
+    for (auto i = 0u; i < ItemCount; ++i) {
+        ASSERT_EQ(items[i].properties[Hash("z")].as<int>(), static_cast<int>(i * 4u + 1u));
+        ASSERT_EQ(items[i].properties[Hash("u")].as<int>(), 1);
+    }
+    ASSERT_EQ(graph.dirtyCount(), 0u);
+}
+
+TEST(BindingGraph, ConditionalReads)
+{
+    constexpr auto ItemCount = 8u;
+
+    Program program(
+        "Item {"
+        "  property a: b + 1;"
+        "  property c: flag ? target.a : -1;"
+        "  property b: 0;"
+        "  property flag: 0;"
+        "  property target: 0;"
+        "}"
+    );
+    Flow::Scheduler scheduler;
+    Lang::BindingGraph graph(&scheduler, 1u);
+    Object items[ItemCount];
+    Object *instances[ItemCount][2];
+    for (auto i = 0u; i < ItemCount; ++i) {
+        auto &item = items[i];
+        item.properties[Hash("a")] = Var(0);
+        item.properties[Hash("b")] = Var(static_cast<int>(i));
+        item.properties[Hash("c")] = Var(0);
+        item.properties[Hash("flag")] = Var(false);
+        item.properties[Hash("target")] = Var(&items[(i + 1u) % ItemCount]);
+        instances[i][0] = &item;
+        instances[i][1] = nullptr;
+        graph.add(item, Hash("a"), *program.units[0].expression, instances[i]);
+        graph.add(item, Hash("c"), *program.units[1].expression, instances[i]);
+    }
+    graph.update();
+    for (auto i = 0u; i < ItemCount; ++i)
+        ASSERT_EQ(items[i].properties[Hash("c")].as<int>(), -1);
+
+    // The recorded dependencies of 'c' don't hold 'a' yet, it is still never evaluated by a task as its branch may read it
+    for (auto i = 0u; i < ItemCount; ++i) {
+        items[i].properties[Hash("b")] = Var(static_cast<int>(i * 10u));
+        items[i].properties[Hash("flag")] = Var(true);
+        graph.invalidate(items[i], Hash("b"));
+        graph.invalidate(items[i], Hash("flag"));
+    }
+    const auto count = graph.evaluationCount();
+    graph.update();
+    ASSERT_EQ(graph.levelCount(), 1u);
+    ASSERT_EQ(graph.taskCount(), ItemCount);
+    ASSERT_EQ(graph.evaluationCount(), count + 2u * ItemCount);
+    for (auto i = 0u; i < ItemCount; ++i)
+        ASSERT_EQ(items[i].properties[Hash("c")].as<int>(), static_cast<int>((i + 1u) % ItemCount * 10u + 1u));
+    ASSERT_EQ(graph.dirtyCount(), 0u);
+}
@@ -0,0 +1,110 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of ClosureProcesser
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/Interpreter/ClosureCompiler.hpp>
+#include <Kube/Interpreter/ClosureProcesser.hpp>
+
+#include "Program.hpp"
+
+using namespace kF;
+
+namespace
+{
+    using Program = Lang::Tests::CompiledProgram<Lang::ClosureCompiler>;
+}
+
+TEST(ClosureProcesser, Statements)
+{
+    Program program(
+        "Item {"
+        "  function sum(n) { int total = 0; int i = 0; while (i < n) { i += 1; if (i == 3) { continue; } total += i; } return total; }"
+        "  function loop(n) { int x = 1; for (n; x < 100; x *= 2) { if (x == n) { break; } } return x; }"
+        "  function logic(a, b) { return !(a && b) || a - b > 2; }"
+        "  function text() { return \"ab\" + \"cd\"; }"
+        "  function steps(a) { int x = a; int y = x++ * 10; if (x > 4) { y += 100; } else if (x > 3) { y += 200; } else { y += 300; } return y + ++x; }"
+        "  function choose(a) { return a > 1 ? a * 10 : a > 0 ? 5 : -5; }"
+        "}"
+    );
+    Object *instances[] = { nullptr };
+
+    Var args[2] { Var(5) };
+    ASSERT_EQ(Lang::ClosureProcesser::Local().process(*program.units[0].expression, instances, args).as<int>(), 12);
+    args[0] = Var(16);
+    ASSERT_EQ(Lang::ClosureProcesser::Local().process(*program.units[1].expression, instances, args).as<int>(), 16);
+    args[0] = Var(true);
+    args[1] = Var(true);
+    ASSERT_EQ(Lang::ClosureProcesser::Local().process(*program.units[2].expression, instances, args).as<bool>(), false);
+    ASSERT_EQ(Lang::ClosureProcesser::Local().process(*program.units[3].expression, instances, nullptr).as<std::string>(), "abcd");
+    args[0] = Var(3);
+    ASSERT_EQ(Lang::ClosureProcesser::Local().process(*program.units[4].expression, instances, args).as<int>(), 235);
+    args[0] = Var(3);
+    ASSERT_EQ(Lang::ClosureProcesser::Local().process(*program.units[5].expression, instances, args).as<int>(), 30);
+    args[0] = Var(1);
+    ASSERT_EQ(Lang::ClosureProcesser::Local().process(*program.units[5].expression, instances, args).as<int>(), 5);
+    args[0] = Var(0);
+    ASSERT_EQ(Lang::ClosureProcesser::Local().process(*program.units[5].expression, instances, args).as<int>(), -5);
+    ASSERT_EQ(Lang::ClosureProcesser::Local().stackSize(), 0u);
+}
+
+TEST(ClosureProcesser, Objects)
+{
+    Program program(
+        "Item {"
+        "  property x: y * 3 + width;"
+        "  property y: 4;"
+        "  function f(a) { x = a; target.value += 2; return target.twice(x) + scale(a); }"
+        "  Child { property z: x + y; }"
+        "}"
+    );
+    Object item, child, target;
+    item.properties[Hash("x")] = Var(0);
+    item.properties[Hash("y")] = Var(4);
+    item.properties[Hash("width")] = Var(1);
+    item.properties[Hash("target")] = Var(&target);
+    item.functions[Hash("scale")] = [](Object *, Var *args) { return Var(args[0].as<int>() * 10); };
+    target.properties[Hash("value")] = Var(5);
+    target.functions[Hash("twice")] = [](Object *, Var *args) { return Var(args[0].as<int>() * 2); };
+    child.properties[Hash("z")] = Var(0);
+    Object *itemInstances[] = { &item, nullptr };
+    Object *childInstances[] = { &child, &item, nullptr };
+
+    ASSERT_EQ(Lang::ClosureProcesser::Local().process(*program.units[0].expression, itemInstances, nullptr).as<int>(), 13);
+
+    Var args[1] { Var(3) };
+    ASSERT_EQ(Lang::ClosureProcesser::Local().process(*program.units[2].expression, itemInstances, args).as<int>(), 36);
+    ASSERT_EQ(item.properties[Hash("x")].as<int>(), 3);
+    ASSERT_EQ(target.properties[Hash("value")].as<int>(), 7);
+
+    // Members of enclosing classes are reached by depth
+    ASSERT_EQ(Lang::ClosureProcesser::Local().process(*program.units[3].expression, childInstances, nullptr).as<int>(), 7);
+
+    // Errors release the frame
+    item.properties.erase(Hash("width"));
+    ASSERT_ANY_THROW((void)Lang::ClosureProcesser::Local().process(*program.units[0].expression, itemInstances, nullptr));
+    ASSERT_EQ(Lang::ClosureProcesser::Local().stackSize(), 0u);
+}
+
+TEST(ClosureProcesser, Nodes)
+{
+    Program program(
+        "Item {"
+        "  function f(a, b) { int x = a * 2; return scale(x, scale(b, 2)); }"
+        "}"
+    );
+    Object item;
+    item.functions[Hash("scale")] = [](Object *, Var *args) { return Var(args[0].as<int>() * args[1].as<int>()); };
+    Object *instances[] = { &item, nullptr };
+    const auto &expression = *program.units[0].expression;
+
+    // Nested calls reserve their arguments above the ones of the enclosing call, constants are bound to their operator
+    ASSERT_EQ(expression.frameSize(), 1u);
+    ASSERT_EQ(expression.stackSize(), 4u);
+    ASSERT_EQ(expression.size() % sizeof(Lang::ClosureNode), 0u);
+    Var args[2] { Var(3), Var(5) };
+    ASSERT_EQ(Lang::ClosureProcesser::Local().process(expression, instances, args).as<int>(), 60);
+    ASSERT_EQ(Lang::ClosureProcesser::Local().stackSize(), 0u);
+}
@@ -0,0 +1,138 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of ColumnStorage
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/Interpreter/ColumnStorage.hpp>
+
+#include "Program.hpp"
+
+using namespace kF;
+
+namespace
+{
+    /** @brief Parse and resolve a code snippet, then find its members */
+    struct Program : public Lang::Tests::Program
+    {
+        using Lang::Tests::Program::Program;
+
+        /** @brief Find a member of the root class */
+        const Lang::AST &member(const char *name) const
+        {
+            const Lang::AST *found = nullptr;
+            tree->root().traverse([name, &found](const Lang::AST &node) {
+                if ((node.type() == Lang::TokenType::Property || node.type() == Lang::TokenType::Assignment)
+                        && node.literal() == name)
+                    found = &node;
+                return !found;
+            });
+            return *found;
+        }
+    };
+
+    constexpr const char *ItemCode =
+        "Item {"
+        "  property x: 0;"
+        "  property y: x * 2 + 1;"
+        "  property z: y / 2.0;"
+        "  property w: x > 2 && !(z < 0.0);"
+        "  property v: -x % 3;"
+        "}";
+
+    /** @brief Add the columns of 'Item' */
+    void AddColumns(Lang::ColumnStorage &storage)
+    {
+        using ColumnType = Lang::ColumnStorage::ColumnType;
+
+        storage.addColumn(Hash("x"), ColumnType::Integer);
+        storage.addColumn(Hash("y"), ColumnType::Integer);
+        storage.addColumn(Hash("z"), ColumnType::Floating);
+        storage.addColumn(Hash("w"), ColumnType::Integer);
+        storage.addColumn(Hash("v"), ColumnType::Integer);
+    }
+}
+
+TEST(ColumnStorage, Rows)
+{
+    Lang::ColumnStorage storage;
+
+    storage.addColumn(Hash("x"), Lang::ColumnStorage::ColumnType::Integer);
+    ASSERT_EQ(storage.addRows(3u), 0u);
+    ASSERT_EQ(storage.addRows(2u), 3u);
+    ASSERT_EQ(storage.rowCount(), 5u);
+    const auto ratio = storage.addColumn(Hash("ratio"), Lang::ColumnStorage::ColumnType::Floating);
+    ASSERT_EQ(storage.columnCount(), 2u);
+    ASSERT_EQ(storage.findColumn(Hash("ratio")), ratio);
+    ASSERT_EQ(storage.findColumn(Hash("missing")), Lang::ColumnStorage::NoColumn);
+    ASSERT_EQ(storage.data<double>(ratio)[4], 0.0);
+    storage.set(ratio, 4u, Var(3));
+    ASSERT_EQ(storage.get(ratio, 4u).as<double>(), 3.0);
+    EXPECT_ANY_THROW(storage.addColumn(Hash("x"), Lang::ColumnStorage::ColumnType::Integer));
+}
+
+TEST(ColumnStorage, Update)
+{
+    constexpr auto RowCount = 100u;
+
+    Program program(ItemCode);
+    Lang::ColumnStorage storage;
+    AddColumns(storage);
+    storage.addRows(RowCount);
+    const auto x = storage.findColumn(Hash("x"));
+    for (auto row = 0u; row < RowCount; ++row)
+        storage.set(x, row, Var(static_cast<std::int64_t>(row)));
+
+    // Bindings are bound in reverse order, they are sorted by dependencies on update
+    for (const auto name : { "v", "w", "z", "y" })
+        storage.bind(program.member(name));
+    ASSERT_EQ(storage.bindingCount(), 4u);
+    storage.update();
+    const auto y = storage.data<std::int64_t>(storage.findColumn(Hash("y")));
+    const auto z = storage.data<double>(storage.findColumn(Hash("z")));
+    const auto w = storage.data<std::int64_t>(storage.findColumn(Hash("w")));
+    const auto v = storage.data<std::int64_t>(storage.findColumn(Hash("v")));
+    for (std::int64_t row = 0; row < RowCount; ++row) {
+        ASSERT_EQ(y[row], row * 2 + 1);
+        ASSERT_EQ(z[row], static_cast<double>(row * 2 + 1) / 2.0);
+        ASSERT_EQ(w[row], row > 2);
+        ASSERT_EQ(v[row], -row % 3);
+    }
+
+    // Rows added after the first update are computed with the others
+    storage.addRows(1u);
+    storage.set(x, RowCount, Var(7));
+    storage.update();
+    ASSERT_EQ(storage.get(storage.findColumn(Hash("y")), RowCount).as<std::int64_t>(), 15);
+    ASSERT_EQ(storage.get(storage.findColumn(Hash("z")), RowCount).as<double>(), 7.5);
+}
+
+TEST(ColumnStorage, Errors)
+{
+    Program program(
+        "Item {"
+        "  property x: y + 1;"
+        "  property y: x - 1;"
+        "  property a: a + 1;"
+        "  property b: 1 / x;"
+        "  property d: abs(x);"
+        "}"
+    );
+    Lang::ColumnStorage storage;
+    for (const auto name : { "x", "y", "a", "b", "d" })
+        storage.addColumn(Hash(name), Lang::ColumnStorage::ColumnType::Integer);
+    storage.addRows(2u);
+
+    EXPECT_ANY_THROW(storage.bind(program.member("a")));
+    EXPECT_ANY_THROW(storage.bind(program.member("d")));
+    storage.bind(program.member("b"));
+    EXPECT_ANY_THROW(storage.bind(program.member("b")));
+    EXPECT_ANY_THROW(storage.update());
+    storage.set(storage.findColumn(Hash("x")), 0u, Var(1));
+    storage.set(storage.findColumn(Hash("x")), 1u, Var(2));
+    storage.update();
+    storage.bind(program.member("x"));
+    storage.bind(program.member("y"));
+    EXPECT_ANY_THROW(storage.update());
+}
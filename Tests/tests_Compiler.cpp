@@ -0,0 +1,179 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of Compiler
+ */
+
+#include <sstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Kube/Interpreter/Lexer.hpp>
+#include <Kube/Interpreter/Parser.hpp>
+#include <Kube/Interpreter/NameResolver.hpp>
+#include <Kube/Interpreter/Compiler.hpp>
+#include <Kube/Interpreter/StackProcesser.hpp>
+
+using namespace kF;
+
+namespace
+{
+    /** @brief Compile every member of a code snippet */
+    Lang::Compiler::Units Compile(const char *code, Lang::TokenStack &stack, Lang::SyntaxTree::Ptr &tree)
+    {
+        std::istringstream iss(code);
+        stack = Lang::Lexer().run(0, iss, "Root");
+        tree = Lang::Parser().run(0, &stack, "Root");
+        Lang::NameResolver().run(*tree, "Root");
+        return Lang::Compiler().run(*tree, "Root");
+    }
+
+    /** @brief Decode the instructions of an expression */
+    std::vector<const Lang::Instruction *> Decode(const Lang::Expression &expression)
+    {
+        std::vector<const Lang::Instruction *> instructions;
+        for (Lang::ByteIndex index = 0u; index < expression.size(); index += Lang::InstructionSize(*expression.at(index)))
+            instructions.push_back(expression.at(index));
+        return instructions;
+    }
+}
+
+TEST(Compiler, Expressions)
+{
+    Lang::TokenStack stack;
+    Lang::SyntaxTree::Ptr tree;
+    auto units = Compile(
+        "Item {"
+        "  property x: y * 2 + width;"
+        "  property y: x > 1 && x < 4;"
+        "  function f(a, b) { int c = a + b; a += c; return obj.call(c, 3); }"
+        "}", stack, tree);
+
+    ASSERT_EQ(units.size(), 3u);
+
+    using Lang::OpCode;
+    const auto expect = [](const Lang::Expression &expression, const std::vector<OpCode> &codes) {
+        const auto instructions = Decode(expression);
+        ASSERT_EQ(instructions.size(), codes.size());
+        for (auto i = 0u; i < codes.size(); ++i)
+            ASSERT_EQ(instructions[i]->code, codes[i]);
+    };
+
+    expect(*units[0].expression, {
+        OpCode::PushProperty, OpCode::MultiplicationInteger, OpCode::PushExternal, OpCode::Addition, OpCode::Return
+    });
+    ASSERT_EQ(units[0].expression->stackSize(), 2u);
+    ASSERT_EQ(units[0].expression->frameSize(), 0u);
+
+    const auto logical = Decode(*units[1].expression);
+    expect(*units[1].expression, {
+        OpCode::PushProperty, OpCode::PushInteger, OpCode::Greater, OpCode::JumpIfFalseOrPop,
+        OpCode::PushProperty, OpCode::PushInteger, OpCode::Lighter, OpCode::ToBoolean, OpCode::Return
+    });
+    // Short-circuit jumps over the right hand side
+    ASSERT_EQ(units[1].expression->at(logical[3]->argument), logical[7]);
+
+    expect(*units[2].expression, {
+        OpCode::PushParameter, OpCode::PushParameter, OpCode::Addition, OpCode::StoreLocal, OpCode::Pop,
+        OpCode::PushParameter, OpCode::PushLocal, OpCode::Addition, OpCode::StoreParameter, OpCode::Pop,
+        OpCode::PushExternal, OpCode::PushLocal, OpCode::PushInteger, OpCode::CallMember, OpCode::Return,
+        OpCode::PushVoid, OpCode::Return
+    });
+    ASSERT_EQ(units[2].expression->frameSize(), 1u);
+    const auto call = reinterpret_cast<const Lang::MemberInstruction *>(Decode(*units[2].expression)[13]);
+    ASSERT_EQ(call->name, Hash("call"));
+    ASSERT_EQ(call->argumentCount, 2u);
+}
+
+TEST(Compiler, ControlFlow)
+{
+    Lang::TokenStack stack;
+    Lang::SyntaxTree::Ptr tree;
+    auto units = Compile(
+        "Item {"
+        "  function f(a) { while (a) { if (a > 2) { break; } else { continue; } } return a; }"
+        "}", stack, tree);
+
+    ASSERT_EQ(units.size(), 1u);
+    const auto &expression = *units[0].expression;
+    const auto instructions = Decode(expression);
+
+    using Lang::OpCode;
+    // begin: a; JumpIfFalse end; a; 2; JumpUnlessGreater else; Jump end (break); Jump next; else: Jump begin (continue); next: Jump begin; end: ...
+    ASSERT_EQ(instructions[1]->code, OpCode::JumpIfFalse);
+    ASSERT_EQ(instructions[4]->code, OpCode::JumpUnlessGreater);
+    ASSERT_EQ(instructions[5]->code, OpCode::Jump);
+    ASSERT_EQ(instructions[7]->code, OpCode::Jump);
+    ASSERT_EQ(instructions[8]->code, OpCode::Jump);
+    ASSERT_EQ(expression.at(instructions[1]->argument), instructions[9]);
+    ASSERT_EQ(expression.at(instructions[4]->argument), instructions[7]);
+    ASSERT_EQ(expression.at(instructions[5]->argument), instructions[9]);
+    ASSERT_EQ(expression.at(instructions[7]->argument), instructions[0]);
+    ASSERT_EQ(expression.at(instructions[8]->argument), instructions[0]);
+    ASSERT_EQ(instructions[9]->code, OpCode::PushParameter);
+}
+
+TEST(Compiler, Switch)
+{
+    Lang::TokenStack stack;
+    Lang::SyntaxTree::Ptr tree;
+    auto units = Compile(
+        "Item {"
+        "  function f(n) { int r = 0; switch (n) { case 1: r = 10; case 2: { r = 20; break; r = 25; } case n * 2: r = 30; default: r = -1; } return r; }"
+        "  function g(n) { int r = 0; switch (n) { case 1: r = 10; case 2: r = 20; } return r; }"
+        "}", stack, tree);
+
+    ASSERT_EQ(units.size(), 2u);
+    Object *instances[] = { nullptr };
+    const auto run = [&units, &instances](const std::size_t unit, const std::int64_t value) {
+        Var args[1] { Var(value) };
+        return Lang::StackProcesser::Local().process(*units[unit].expression, instances, args).as<std::int64_t>();
+    };
+
+    // Matching cases, 'break' leaves the switch and unmatched values fall to the default body
+    ASSERT_EQ(run(0u, 1), 10);
+    ASSERT_EQ(run(0u, 2), 20);
+    ASSERT_EQ(run(0u, 0), 30);
+    ASSERT_EQ(run(0u, 7), -1);
+    // Without default nothing runs
+    ASSERT_EQ(run(1u, 2), 20);
+    ASSERT_EQ(run(1u, 3), 0);
+    ASSERT_EQ(Lang::StackProcesser::Local().stackSize(), 0u);
+}
+
+TEST(Compiler, Superinstructions)
+{
+    Lang::TokenStack stack;
+    Lang::SyntaxTree::Ptr tree;
+    auto units = Compile(
+        "Item {"
+        "  function f(n) { int i = 0; while (i < n) { i += 1; } return i * 3; }"
+        "}", stack, tree);
+
+    ASSERT_EQ(units.size(), 1u);
+    const auto instructions = Decode(*units[0].expression);
+
+    using Lang::OpCode;
+    const std::vector<OpCode> codes {
+        OpCode::PushInteger, OpCode::StoreLocal, OpCode::Pop,
+        OpCode::PushLocal, OpCode::PushParameter, OpCode::JumpUnlessLighter,
+        OpCode::IncrementLocal, OpCode::Pop, OpCode::Jump,
+        OpCode::PushLocal, OpCode::MultiplicationInteger, OpCode::Return,
+        OpCode::PushVoid, OpCode::Return
+    };
+    ASSERT_EQ(instructions.size(), codes.size());
+    for (auto i = 0u; i < codes.size(); ++i)
+        ASSERT_EQ(instructions[i]->code, codes[i]);
+    ASSERT_EQ(reinterpret_cast<const Lang::ImmediateInstruction *>(instructions[10])->integer, 3);
+    // The loop jumps back to the condition, which is the first instruction of its fused sequence
+    ASSERT_EQ(units[0].expression->at(instructions[8]->argument), instructions[3]);
+}
+
+TEST(Compiler, Errors)
+{
+    Lang::TokenStack stack;
+    Lang::SyntaxTree::Ptr tree;
+
+    ASSERT_ANY_THROW(Compile("Item { function f() { 1 = 2; } }", stack, tree));
+    ASSERT_ANY_THROW(Compile("Item { function f() { break; } }", stack, tree));
+}
@@ -0,0 +1,89 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of EventTable
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/Interpreter/EventTable.hpp>
+
+#include "Program.hpp"
+
+using namespace kF;
+
+namespace
+{
+    using Program = Lang::Tests::CompiledProgram<Lang::Tests::BuildCompiler>;
+}
+
+TEST(EventTable, Signals)
+{
+    Program program(
+        "Item {"
+        "  signal clicked(a);"
+        "  signal moved();"
+        "  property count: 0;"
+        "  on clicked: count += 1;"
+        "  on moved: count += 10;"
+        "  on clicked: count += 100;"
+        "}"
+    );
+    Object item;
+    item.properties[Hash("count")] = Var(0);
+    Object *instances[] = { &item, nullptr };
+    const Lang::EventTable table(program.tree->root(), program.units);
+
+    ASSERT_EQ(table.signalCount(), 2u);
+    ASSERT_EQ(table.predicateCount(), 0u);
+    ASSERT_EQ(table.findSignal(Hash("moved")), 1u);
+    ASSERT_EQ(table.findSignal(Hash("pressed")), Lang::EventTable::NoSignal);
+    ASSERT_EQ(table.slotCount(0u), 2u);
+    ASSERT_EQ(table.slotCount(1u), 1u);
+
+    Var args[1] { Var(0) };
+    table.emit(table.findSignal(Hash("clicked")), instances, args);
+    ASSERT_EQ(item.properties[Hash("count")].as<int>(), 101);
+    table.emit(1u, instances, nullptr);
+    ASSERT_EQ(item.properties[Hash("count")].as<int>(), 111);
+}
+
+TEST(EventTable, Predicates)
+{
+    Program program(
+        "Item {"
+        "  property x: 1;"
+        "  property count: 0;"
+        "  on x > 3: count += 1;"
+        "}"
+    );
+    Object item;
+    item.properties[Hash("x")] = Var(1);
+    item.properties[Hash("count")] = Var(0);
+    Object *instances[] = { &item, nullptr };
+    const Lang::EventTable table(program.tree->root(), program.units);
+    auto state = table.makeState();
+
+    ASSERT_EQ(table.predicateCount(), 1u);
+    ASSERT_EQ(table.update(state, instances), 0u);
+
+    // Predicates are only evaluated again once a property they read changed
+    item.properties[Hash("x")] = Var(5);
+    ASSERT_EQ(table.update(state, instances), 0u);
+    table.invalidate(state, item, Hash("count"));
+    ASSERT_EQ(table.update(state, instances), 0u);
+    table.invalidate(state, item, Hash("x"));
+    ASSERT_EQ(table.update(state, instances), 1u);
+    ASSERT_EQ(item.properties[Hash("count")].as<int>(), 1);
+
+    // Events only run when their predicate becomes true
+    item.properties[Hash("x")] = Var(6);
+    table.invalidate(state, item, Hash("x"));
+    ASSERT_EQ(table.update(state, instances), 0u);
+    item.properties[Hash("x")] = Var(2);
+    table.invalidate(state, item, Hash("x"));
+    ASSERT_EQ(table.update(state, instances), 0u);
+    item.properties[Hash("x")] = Var(4);
+    table.invalidate(state, item, Hash("x"));
+    ASSERT_EQ(table.update(state, instances), 1u);
+    ASSERT_EQ(item.properties[Hash("count")].as<int>(), 2);
+}
@@ -0,0 +1,95 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of Formatter
+ */
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include <Kube/Interpreter/Lexer.hpp>
+#include <Kube/Interpreter/Parser.hpp>
+#include <Kube/Interpreter/Formatter.hpp>
+
+using namespace kF;
+
+/** @brief Parse and format a source code */
+static std::string Format(const std::string &code, const Lang::Formatter::Options options = Lang::Formatter::Options())
+{
+    std::istringstream iss(code);
+    Lang::Parser parser;
+    auto stack = Lang::Lexer().run(0, iss, "Root");
+    auto tree = parser.run(0, &stack, "Root");
+    Lang::Formatter::Buffer buffer;
+
+    Lang::Formatter(buffer, options).format(parser.imports(), tree->root());
+    return std::string(buffer.data(), buffer.size());
+}
+
+/** @brief Count the comments of a source code */
+static std::uint32_t CountComments(const std::string &code)
+{
+    std::istringstream iss(code);
+    Lang::Lexer lexer;
+
+    (void)lexer.run(0, iss, "Root");
+    return lexer.commentCount();
+}
+
+TEST(Formatter, Basics)
+{
+    const auto formatted = Format(
+        "Item { property x: a+b*c; Child { y: -x; } function f(z) { if (z) { return z; } else { z = 1; } while (z < 2) z++; } }"
+    );
+    ASSERT_EQ(formatted,
+        "Item {\n"
+        "  property x: a + (b * c);\n"
+        "  Child {\n"
+        "    y: -x;\n"
+        "  }\n"
+        "  function f(z) {\n"
+        "    if (z) return z;\n"
+        "    else z = 1;\n"
+        "    while (z < 2) z++;\n"
+        "  }\n"
+        "}\n"
+    );
+
+    // Formatting must be stable
+    ASSERT_EQ(Format(formatted), formatted);
+
+    const auto tabulated = Format("Item { Child { y: x; } }", Lang::Formatter::Options { indentWidth: 1u, indentChar: '\t' });
+    ASSERT_EQ(tabulated, "Item {\n\tChild {\n\t\ty: x;\n\t}\n}\n");
+
+    const auto function = Format("Item { function f() { return 1; } }");
+    ASSERT_EQ(function, "Item {\n  function f() {\n    return 1;\n  }\n}\n");
+    ASSERT_EQ(Format(function), function);
+}
+
+TEST(Formatter, RoundTrip)
+{
+    const auto formatted = Format("import \"Kube.UI\" import \"Shapes/Rect\" Item { property x: 1; }");
+    ASSERT_EQ(formatted,
+        "import \"Kube.UI\"\n"
+        "import \"Shapes/Rect\"\n"
+        "\n"
+        "Item {\n"
+        "  property x: 1;\n"
+        "}\n"
+    );
+
+    // Imports are parsed back from the formatted code
+    std::istringstream iss(formatted);
+    Lang::Parser parser;
+    auto stack = Lang::Lexer().run(0, iss, "Root");
+    auto tree = parser.run(0, &stack, "Root");
+    ASSERT_EQ(parser.imports().size(), 2u);
+    ASSERT_EQ(parser.imports()[0].toStdView(), "Kube.UI");
+    ASSERT_EQ(parser.imports()[1].toStdView(), "Shapes/Rect");
+    ASSERT_EQ(Format(formatted), formatted);
+
+    // Comments are not part of the tree, so files holding some can't be formatted in place
+    const std::string commented = "import \"Kube.UI\"\n// keep me\nItem { property x: 1; /* trailing */ }";
+    ASSERT_EQ(CountComments(commented), 2u);
+    ASSERT_EQ(CountComments(Format(commented)), 0u);
+}
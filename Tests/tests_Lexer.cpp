@@ -11,7 +11,7 @@
 
 using namespace kF;
 
-static void TestToken(const Lang::TokenStack::Iterator it,
+static void TestToken(const Lang::Token::Iterator it,
         const Lang::FileIndex file, const Lang::LineIndex line, const Lang::ColumnIndex column, const std::string_view &word)
 {
     ASSERT_EQ(it->file, file);
@@ -41,9 +41,9 @@ TEST(Lexer, BasicString)
     Lang::Lexer lexer;
     auto stack = lexer.run(0, iss, "Root");
     auto it = stack.begin();
-    TestToken(it++, 0, 1, 2, "\0");
-    TestToken(it++, 0, 2, 2, "Hello");
-    TestToken(it++, 0, 3, 2, "4\n2");
+    TestToken(it++, 0, 1, 1, "\"\"");
+    TestToken(it++, 0, 2, 1, "\"Hello\"");
+    TestToken(it++, 0, 3, 1, "\"4\n2\"");
 }
 
 TEST(Lexer, BasicCharacter)
@@ -74,5 +74,21 @@ TEST(Lexer, Compact)
             TestToken(it++, 42, 1, 50, "y_01"); TestToken(it++, 42, 1, 54, ":"); TestToken(it++, 42, 1, 55, "42.24");
         TestToken(it++, 42, 1, 60, "}");
     TestToken(it++, 42, 1, 61, "}");
+}
+
+TEST(Lexer, StringFollowedBySymbol)
+{
+    std::istringstream iss("case \"idle\": x = \"a\";");
 
-}
\ No newline at end of file
+    Lang::Lexer lexer;
+    auto stack = lexer.run(0, iss, "Root");
+    auto it = stack.begin();
+    TestToken(it++, 0, 1, 1, "case");
+    TestToken(it++, 0, 1, 6, "\"idle\"");
+    TestToken(it++, 0, 1, 12, ":");
+    TestToken(it++, 0, 1, 14, "x");
+    TestToken(it++, 0, 1, 16, "=");
+    TestToken(it++, 0, 1, 18, "\"a\"");
+    TestToken(it++, 0, 1, 21, ";");
+    ASSERT_EQ(it, stack.end());
+}
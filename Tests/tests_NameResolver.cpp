@@ -0,0 +1,118 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of NameResolver
+ */
+
+#include <sstream>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#include <Kube/Interpreter/Lexer.hpp>
+#include <Kube/Interpreter/Parser.hpp>
+#include <Kube/Interpreter/NameResolver.hpp>
+
+using namespace kF;
+
+TEST(NameResolver, Scopes)
+{
+    std::istringstream iss(
+        "Item {"
+        "  property x: y;"
+        "  property y: x + width;"
+        "  function f(a, b) { int c = a + b; if (c) { int d = c * x; } return obj.x + c; }"
+        "  Child { property z: x + y; }"
+        "}"
+    );
+    auto stack = Lang::Lexer().run(0, iss, "Root");
+    auto tree = Lang::Parser().run(0, &stack, "Root");
+    Lang::NameResolver resolver;
+    resolver.run(*tree, "Root");
+
+    std::vector<const Lang::AST *> names;
+    tree->root().traverse([&names](const Lang::AST &node) {
+        if (node.type() == Lang::TokenType::Name)
+            names.push_back(&node);
+        return true;
+    });
+    const auto expect = [&names](const std::size_t index, const std::string_view &literal,
+            const Lang::NameType type, const std::uint32_t slot, const std::uint32_t depth = 0u) {
+        ASSERT_EQ(names[index]->literal(), literal);
+        ASSERT_EQ(names[index]->nameType(), type);
+        if (type != Lang::NameType::External && type != Lang::NameType::Member && type != Lang::NameType::Type)
+            ASSERT_EQ(names[index]->nameSlot().index, slot);
+        else
+            ASSERT_EQ(names[index]->nameSlot().index, Hash(literal));
+        ASSERT_EQ(names[index]->nameSlot().depth, depth);
+    };
+
+    auto i = 0u;
+    expect(i++, "y", Lang::NameType::Property, 1u);
+    expect(i++, "x", Lang::NameType::Property, 0u);
+    expect(i++, "width", Lang::NameType::External, 0u);
+    expect(i++, "a", Lang::NameType::Parameter, 0u);
+    expect(i++, "b", Lang::NameType::Parameter, 1u);
+    expect(i++, "int", Lang::NameType::Type, 0u);
+    expect(i++, "c", Lang::NameType::Local, 0u);
+    expect(i++, "a", Lang::NameType::Parameter, 0u);
+    expect(i++, "b", Lang::NameType::Parameter, 1u);
+    expect(i++, "c", Lang::NameType::Local, 0u);
+    expect(i++, "int", Lang::NameType::Type, 0u);
+    expect(i++, "d", Lang::NameType::Local, 1u);
+    expect(i++, "c", Lang::NameType::Local, 0u);
+    expect(i++, "x", Lang::NameType::Property, 0u);
+    expect(i++, "obj", Lang::NameType::External, 0u);
+    expect(i++, "x", Lang::NameType::Member, 0u);
+    expect(i++, "c", Lang::NameType::Local, 0u);
+    expect(i++, "x", Lang::NameType::Property, 0u, 1u);
+    expect(i++, "y", Lang::NameType::Property, 1u, 1u);
+    ASSERT_EQ(names.size(), i);
+    ASSERT_EQ(resolver.maxFrameSize(), 2u);
+}
+
+TEST(NameResolver, Redeclaration)
+{
+    std::istringstream iss("Item { function f() { int a = 1; int a = 2; } }");
+    auto stack = Lang::Lexer().run(0, iss, "Root");
+    auto tree = Lang::Parser().run(0, &stack, "Root");
+
+    ASSERT_ANY_THROW(Lang::NameResolver().run(*tree, "Root"));
+}
+
+TEST(NameResolver, SlotReuse)
+{
+    std::istringstream iss(
+        "Item {"
+        "  function f(n) { if (n) { int a = 1; } else { int b = 2; } int c = 3; int d = c + 1; int e = d; return e; }"
+        "  function g(n) { int i = 0; while (i < n) { i += 1; int t = 2; n -= t; } int u = 0; return u; }"
+        "}"
+    );
+    auto stack = Lang::Lexer().run(0, iss, "Root");
+    auto tree = Lang::Parser().run(0, &stack, "Root");
+    Lang::NameResolver resolver;
+    resolver.run(*tree, "Root");
+
+    std::unordered_map<std::string_view, std::uint32_t> slots;
+    bool consistent = true;
+    tree->root().traverse([&slots, &consistent](const Lang::AST &node) {
+        if (node.type() == Lang::TokenType::Name && node.nameType() == Lang::NameType::Local) {
+            const auto [it, inserted] = slots.insert({ node.literal(), node.nameSlot().index });
+            consistent &= it->second == node.nameSlot().index;
+        }
+        return true;
+    });
+    ASSERT_TRUE(consistent);
+
+    // Blocks that don't overlap share their slots, as locals that died before a declaration
+    ASSERT_EQ(slots["a"], 0u);
+    ASSERT_EQ(slots["b"], 0u);
+    ASSERT_EQ(slots["c"], 0u);
+    ASSERT_EQ(slots["d"], 1u);
+    ASSERT_EQ(slots["e"], 0u);
+
+    // A local used in a loop lives until its last iteration
+    ASSERT_EQ(slots["i"], 0u);
+    ASSERT_EQ(slots["t"], 1u);
+    ASSERT_EQ(slots["u"], 0u);
+    ASSERT_EQ(resolver.maxFrameSize(), 2u);
+}
@@ -0,0 +1,108 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of Optimizer
+ */
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include <Kube/Interpreter/Lexer.hpp>
+#include <Kube/Interpreter/Parser.hpp>
+#include <Kube/Interpreter/Optimizer.hpp>
+
+using namespace kF;
+
+/** @brief Parse and optimize a class, then return the expression node of its first member */
+static const Lang::AST &OptimizeFirstMember(const char *code, Lang::TokenStack &stack, Lang::SyntaxTree::Ptr &tree)
+{
+    std::istringstream iss(code);
+
+    stack = Lang::Lexer().run(0, iss, "Root");
+    tree = Lang::Parser().run(0, &stack, "Root");
+    Lang::Optimizer().run(*tree);
+    return *tree->root().children()[0]->children()[0];
+}
+
+TEST(Optimizer, Folding)
+{
+    Lang::TokenStack stack;
+    Lang::SyntaxTree::Ptr tree;
+
+    auto &integer = OptimizeFirstMember("Item { property x: 10 * 60 * 1000; }", stack, tree);
+    ASSERT_EQ(integer.children().size(), 1);
+    ASSERT_EQ(integer.children()[0]->type(), Lang::TokenType::Constant);
+    ASSERT_EQ(integer.children()[0]->literal(), "600000");
+
+    auto &floating = OptimizeFirstMember("Item { property x: -(1 + 0.5); }", stack, tree);
+    ASSERT_EQ(floating.children()[0]->literal(), "-1.5");
+
+    auto &boolean = OptimizeFirstMember("Item { property x: !true || 2 > 1; }", stack, tree);
+    ASSERT_EQ(boolean.children()[0]->constantType(), Lang::ConstantType::Boolean);
+    ASSERT_EQ(boolean.children()[0]->literal(), "true");
+
+    auto &literal = OptimizeFirstMember("Item { property x: \"ab\" + \"cd\"; }", stack, tree);
+    ASSERT_EQ(literal.children()[0]->literal(), "\"abcd\"");
+
+    auto &division = OptimizeFirstMember("Item { property x: 1 / 0; }", stack, tree);
+    ASSERT_EQ(division.children()[0]->type(), Lang::TokenType::Operator);
+}
+
+TEST(Optimizer, Identities)
+{
+    Lang::TokenStack stack;
+    Lang::SyntaxTree::Ptr tree;
+
+    auto &expr = OptimizeFirstMember("Item { property x: (-(y ? 2 : 3) * 1 + 0) / (3 - 2); }", stack, tree);
+    ASSERT_EQ(expr.children()[0]->operatorType(), Lang::OperatorType::Minus);
+    ASSERT_EQ(expr.children()[0]->children()[0]->operatorType(), Lang::OperatorType::TernaryIf);
+
+    // Identities are kept when the other operand may not be an integer, as 'true + 0' is not 'true'
+    auto &boolean = OptimizeFirstMember("Item { property x: (y > 2) + 0; }", stack, tree);
+    ASSERT_EQ(boolean.children()[0]->operatorType(), Lang::OperatorType::Addition);
+    ASSERT_EQ(boolean.children()[0]->children()[0]->operatorType(), Lang::OperatorType::Greater);
+
+    auto &name = OptimizeFirstMember("Item { property x: 1 * y; }", stack, tree);
+    ASSERT_EQ(name.children()[0]->operatorType(), Lang::OperatorType::Multiplication);
+
+    // Floating identities are kept as they change the type of integer operands
+    auto &multiplication = OptimizeFirstMember("Item { property x: y * 1.0 / 2; }", stack, tree);
+    ASSERT_EQ(multiplication.children()[0]->operatorType(), Lang::OperatorType::Division);
+    ASSERT_EQ(multiplication.children()[0]->children()[0]->operatorType(), Lang::OperatorType::Multiplication);
+
+    auto &addition = OptimizeFirstMember("Item { property x: (y + 0.0) / 2; }", stack, tree);
+    ASSERT_EQ(addition.children()[0]->operatorType(), Lang::OperatorType::Division);
+    ASSERT_EQ(addition.children()[0]->children()[0]->operatorType(), Lang::OperatorType::Addition);
+}
+
+TEST(Optimizer, Ternary)
+{
+    Lang::TokenStack stack;
+    Lang::SyntaxTree::Ptr tree;
+
+    auto &folded = OptimizeFirstMember("Item { property x: 1 > 2 ? y : 3 + 4; }", stack, tree);
+    ASSERT_EQ(folded.children()[0]->type(), Lang::TokenType::Constant);
+    ASSERT_EQ(folded.children()[0]->literal(), "7");
+
+    auto &kept = OptimizeFirstMember("Item { property x: y ? 1 + 1 : z; }", stack, tree);
+    ASSERT_EQ(kept.children()[0]->operatorType(), Lang::OperatorType::TernaryIf);
+    ASSERT_EQ(kept.children()[0]->children()[1]->literal(), "2");
+    ASSERT_EQ(kept.children()[0]->children()[2]->literal(), "z");
+}
+
+TEST(Optimizer, DeadBranches)
+{
+    Lang::TokenStack stack;
+    Lang::SyntaxTree::Ptr tree;
+
+    auto &body = OptimizeFirstMember(
+        "Item { function f(x) { if (false) { x = 1; } else if (1 < 2) { x = 2; } else { x = 3; } while (false) { x = 4; } } }",
+        stack, tree
+    );
+    auto &function = *tree->root().children()[0];
+    ASSERT_EQ(body.type(), Lang::TokenType::ParameterList);
+    auto &block = *function.children()[1];
+    ASSERT_EQ(block.children().size(), 1);
+    ASSERT_EQ(block.children()[0]->type(), Lang::TokenType::Expression);
+    ASSERT_EQ(block.children()[0]->children()[0]->children()[1]->literal(), "2");
+}
@@ -0,0 +1,82 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of Parser
+ */
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include <Kube/Interpreter/Lexer.hpp>
+#include <Kube/Interpreter/Parser.hpp>
+
+using namespace kF;
+
+TEST(Parser, ExtractImports)
+{
+    std::istringstream iss("import \"A\" import \"B/C\" Item { Child { x: 1; } function f() { if (x) { } else { } } }");
+
+    auto stack = Lang::Lexer().run(0, iss, "Root");
+    std::vector<std::string> imports, classes;
+    Lang::Parser::ExtractImports(stack, [&imports](const std::string_view &path) { imports.emplace_back(path); });
+    Lang::Parser::ExtractClassNames(stack, [&classes](const std::string_view &name) { classes.emplace_back(name); });
+    ASSERT_EQ(imports.size(), 2);
+    ASSERT_EQ(imports[0], "A");
+    ASSERT_EQ(imports[1], "B/C");
+    ASSERT_EQ(classes.size(), 2);
+    ASSERT_EQ(classes[0], "Item");
+    ASSERT_EQ(classes[1], "Child");
+
+    Lang::Parser parser;
+    auto root = parser.run(0, &stack, "Root");
+    ASSERT_EQ(parser.imports().size(), imports.size());
+}
+
+TEST(Parser, Switch)
+{
+    std::istringstream iss("Item { function f(n) { switch (n) { case 1: n = 2; case \"a\": { n = 3; break; } default: n = 4; } return n; } }");
+
+    auto stack = Lang::Lexer().run(0, iss, "Root");
+    auto tree = Lang::Parser().run(0, &stack, "Root");
+    const Lang::AST *switchNode = nullptr;
+    const Lang::AST *returnNode = nullptr;
+    tree->root().traverse([&switchNode, &returnNode](const Lang::AST &node) {
+        if (node.type() == Lang::TokenType::Statement && node.statementType() == Lang::StatementType::Switch)
+            switchNode = &node;
+        else if (node.type() == Lang::TokenType::Statement && node.statementType() == Lang::StatementType::Return)
+            returnNode = &node;
+        return true;
+    });
+
+    // The subject, two (value, body) pairs and the default body
+    ASSERT_NE(switchNode, nullptr);
+    ASSERT_EQ(switchNode->children().size(), 6u);
+    ASSERT_EQ(switchNode->children()[3]->literal(), "\"a\"");
+    // The statement after the switch belongs to the function
+    ASSERT_NE(returnNode, nullptr);
+    const auto body = tree->root().children()[0]->children()[1]->children();
+    ASSERT_EQ(body[body.size() - 2u], switchNode);
+    ASSERT_EQ(body[body.size() - 1u], returnNode);
+}
+
+TEST(Parser, Ternary)
+{
+    std::istringstream iss("Item { property x: a > 1 ? b ? 1 : 2 : c = 3 ? 4 : 5; }");
+
+    auto stack = Lang::Lexer().run(0, iss, "Root");
+    auto tree = Lang::Parser().run(0, &stack, "Root");
+    const auto &root = *tree->root().children()[0]->children()[0]->children()[0];
+
+    // Ternary nodes hold the condition and both branches
+    ASSERT_EQ(root.operatorType(), Lang::OperatorType::TernaryIf);
+    ASSERT_EQ(root.children().size(), 3u);
+    ASSERT_EQ(root.children()[0]->operatorType(), Lang::OperatorType::Greater);
+    ASSERT_EQ(root.children()[1]->operatorType(), Lang::OperatorType::TernaryIf);
+    ASSERT_EQ(root.children()[1]->children()[2]->literal(), "2");
+    ASSERT_EQ(root.children()[2]->operatorType(), Lang::OperatorType::Assign);
+    ASSERT_EQ(root.children()[2]->children()[1]->operatorType(), Lang::OperatorType::TernaryIf);
+
+    std::istringstream missing("Item { property x: a ? 1; }");
+    auto missingStack = Lang::Lexer().run(0, missing, "Root");
+    ASSERT_ANY_THROW(Lang::Parser().run(0, &missingStack, "Root"));
+}
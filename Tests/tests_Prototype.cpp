@@ -0,0 +1,115 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of Prototype
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/Interpreter/Prototype.hpp>
+
+#include "Program.hpp"
+
+using namespace kF;
+
+namespace
+{
+    using Program = Lang::Tests::CompiledProgram<Lang::Tests::BuildCompiler>;
+
+    /** @brief The objects of an instance of 'Item' */
+    struct ItemObjects
+    {
+        Object item;
+        Object first;
+        Object second;
+
+        ItemObjects(void)
+        {
+            for (const auto name : { "x", "y", "ratio" })
+                item.properties[Hash(name)] = Var(0);
+            first.properties[Hash("z")] = Var(0);
+            second.properties[Hash("w")] = Var(0);
+        }
+    };
+
+    constexpr const char *ItemCode =
+        "Item {"
+        "  property x: 2 * 3;"
+        "  property y: x + 1;"
+        "  property ratio: 3.0 / 4.0;"
+        "  Child { property z: x * 2; }"
+        "  Child { w: 5; }"
+        "}";
+}
+
+TEST(Prototype, Layout)
+{
+    Program program(ItemCode);
+    const Lang::Prototype prototype(program.tree->root(), program.units);
+
+    ASSERT_EQ(prototype.objectCount(), 3u);
+    ASSERT_EQ(prototype.nodeAt(0u).type, Hash("Item"));
+    ASSERT_EQ(prototype.nodeAt(0u).parent, Lang::Prototype::NoObject);
+    ASSERT_EQ(prototype.nodeAt(1u).type, Hash("Child"));
+    ASSERT_EQ(prototype.nodeAt(1u).parent, 0u);
+    ASSERT_EQ(prototype.nodeAt(2u).parent, 0u);
+    ASSERT_EQ(prototype.defaultCount(), 3u);
+    ASSERT_EQ(prototype.initializerCount(), 2u);
+}
+
+TEST(Prototype, Instantiate)
+{
+    constexpr auto InstanceCount = 4u;
+
+    Program program(ItemCode);
+    const Lang::Prototype prototype(program.tree->root(), program.units);
+    ItemObjects objects[InstanceCount];
+    Object *pointers[InstanceCount * 3u];
+    for (auto i = 0u; i < InstanceCount; ++i) {
+        pointers[i * 3u] = &objects[i].item;
+        pointers[i * 3u + 1u] = &objects[i].first;
+        pointers[i * 3u + 2u] = &objects[i].second;
+    }
+
+    // Enclosing objects are relocated into each instance
+    const auto instances = prototype.instantiate(pointers, InstanceCount);
+    ASSERT_EQ(instances.count, InstanceCount);
+    const auto chain = prototype.chainOf(instances, 2u, 1u);
+    ASSERT_EQ(chain[0], &objects[2].first);
+    ASSERT_EQ(chain[1], &objects[2].item);
+    ASSERT_EQ(chain[2], nullptr);
+
+    for (auto &instance : objects) {
+        ASSERT_EQ(instance.item.properties[Hash("x")].as<int>(), 6);
+        ASSERT_EQ(instance.item.properties[Hash("y")].as<int>(), 7);
+        ASSERT_EQ(instance.item.properties[Hash("ratio")].as<double>(), 0.75);
+        ASSERT_EQ(instance.first.properties[Hash("z")].as<int>(), 12);
+        ASSERT_EQ(instance.second.properties[Hash("w")].as<int>(), 5);
+    }
+}
+
+TEST(Prototype, Bindings)
+{
+    constexpr auto InstanceCount = 3u;
+
+    Program program(ItemCode);
+    const Lang::Prototype prototype(program.tree->root(), program.units);
+    ItemObjects objects[InstanceCount];
+    Object *pointers[InstanceCount * 3u];
+    for (auto i = 0u; i < InstanceCount; ++i) {
+        pointers[i * 3u] = &objects[i].item;
+        pointers[i * 3u + 1u] = &objects[i].first;
+        pointers[i * 3u + 2u] = &objects[i].second;
+    }
+    Lang::BindingGraph graph;
+
+    // Initializers reading names are bound, the instances must outlive their bindings
+    const auto instances = prototype.instantiate(pointers, InstanceCount, &graph);
+    ASSERT_EQ(graph.bindingCount(), 2u * InstanceCount);
+    graph.update();
+    objects[1].item.properties[Hash("x")] = Var(10);
+    graph.invalidate(objects[1].item, Hash("x"));
+    graph.update();
+    ASSERT_EQ(objects[0].first.properties[Hash("z")].as<int>(), 12);
+    ASSERT_EQ(objects[1].item.properties[Hash("y")].as<int>(), 11);
+    ASSERT_EQ(objects[1].first.properties[Hash("z")].as<int>(), 20);
+}
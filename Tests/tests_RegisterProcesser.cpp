@@ -0,0 +1,163 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of RegisterProcesser
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/Interpreter/Compiler.hpp>
+#include <Kube/Interpreter/StackProcesser.hpp>
+#include <Kube/Interpreter/RegisterCompiler.hpp>
+#include <Kube/Interpreter/RegisterProcesser.hpp>
+#include <Kube/Interpreter/ClosureCompiler.hpp>
+#include <Kube/Interpreter/ClosureProcesser.hpp>
+
+#include "Program.hpp"
+
+using namespace kF;
+
+namespace
+{
+    using Program = Lang::Tests::CompiledProgram<Lang::RegisterCompiler>;
+}
+
+TEST(RegisterProcesser, Statements)
+{
+    Program program(
+        "Item {"
+        "  function sum(n) { int total = 0; int i = 0; while (i < n) { i += 1; if (i == 3) { continue; } total += i; } return total; }"
+        "  function loop(n) { int x = 1; for (n; x < 100; x *= 2) { if (x == n) { break; } } return x; }"
+        "  function logic(a, b) { return !(a && b) || a - b > 2; }"
+        "  function text() { return \"ab\" + \"cd\"; }"
+        "  function choose(a) { return a > 1 ? a * 10 : a > 0 ? 5 : -5; }"
+        "}"
+    );
+    Object *instances[] = { nullptr };
+
+    Var args[2] { Var(5) };
+    ASSERT_EQ(Lang::RegisterProcesser::Local().process(*program.units[0].expression, instances, args).as<int>(), 12);
+    args[0] = Var(16);
+    ASSERT_EQ(Lang::RegisterProcesser::Local().process(*program.units[1].expression, instances, args).as<int>(), 16);
+    args[0] = Var(true);
+    args[1] = Var(true);
+    ASSERT_EQ(Lang::RegisterProcesser::Local().process(*program.units[2].expression, instances, args).as<bool>(), false);
+    ASSERT_EQ(Lang::RegisterProcesser::Local().process(*program.units[3].expression, instances, nullptr).as<std::string>(), "abcd");
+    args[0] = Var(3);
+    ASSERT_EQ(Lang::RegisterProcesser::Local().process(*program.units[4].expression, instances, args).as<int>(), 30);
+    args[0] = Var(1);
+    ASSERT_EQ(Lang::RegisterProcesser::Local().process(*program.units[4].expression, instances, args).as<int>(), 5);
+    args[0] = Var(0);
+    ASSERT_EQ(Lang::RegisterProcesser::Local().process(*program.units[4].expression, instances, args).as<int>(), -5);
+    ASSERT_EQ(Lang::RegisterProcesser::Local().registerCount(), 0u);
+}
+
+TEST(RegisterProcesser, Objects)
+{
+    Program program(
+        "Item {"
+        "  property x: y * 3 + width;"
+        "  property y: 4;"
+        "  function f(a) { x = a; target.value += 2; return target.twice(x) + scale(a); }"
+        "  Child { property z: x + y; }"
+        "}"
+    );
+    Object item, child, target;
+    item.properties[Hash("x")] = Var(0);
+    item.properties[Hash("y")] = Var(4);
+    item.properties[Hash("width")] = Var(1);
+    item.properties[Hash("target")] = Var(&target);
+    item.functions[Hash("scale")] = [](Object *, Var *args) { return Var(args[0].as<int>() * 10); };
+    target.properties[Hash("value")] = Var(5);
+    target.functions[Hash("twice")] = [](Object *, Var *args) { return Var(args[0].as<int>() * 2); };
+    child.properties[Hash("z")] = Var(0);
+    Object *itemInstances[] = { &item, nullptr };
+    Object *childInstances[] = { &child, &item, nullptr };
+
+    ASSERT_EQ(Lang::RegisterProcesser::Local().process(*program.units[0].expression, itemInstances, nullptr).as<int>(), 13);
+
+    Var args[1] { Var(3) };
+    ASSERT_EQ(Lang::RegisterProcesser::Local().process(*program.units[2].expression, itemInstances, args).as<int>(), 36);
+    ASSERT_EQ(item.properties[Hash("x")].as<int>(), 3);
+    ASSERT_EQ(target.properties[Hash("value")].as<int>(), 7);
+
+    // Members of enclosing classes are reached by depth
+    ASSERT_EQ(Lang::RegisterProcesser::Local().process(*program.units[3].expression, childInstances, nullptr).as<int>(), 7);
+
+    // Errors release the frame
+    item.properties.erase(Hash("width"));
+    ASSERT_ANY_THROW((void)Lang::RegisterProcesser::Local().process(*program.units[0].expression, itemInstances, nullptr));
+    ASSERT_EQ(Lang::RegisterProcesser::Local().registerCount(), 0u);
+}
+
+TEST(RegisterProcesser, Registers)
+{
+    Program program(
+        "Item {"
+        "  function f(a) { int x = a; int y = x * x; y += x++; return y - x; }"
+        "}"
+    );
+    Object *instances[] = { nullptr };
+    const auto &expression = *program.units[0].expression;
+
+    // Locals own the first registers and are operated in place
+    ASSERT_EQ(expression.frameSize(), 2u);
+    Var args[1] { Var(3) };
+    ASSERT_EQ(Lang::RegisterProcesser::Local().process(expression, instances, args).as<int>(), 8);
+    ASSERT_EQ(Lang::RegisterProcesser::Local().registerCount(), 0u);
+}
+
+TEST(RegisterProcesser, Quickening)
+{
+    Program program(
+        "Item {"
+        "  function f(n) { int i = 0; while (i < n) { i += 1; } return i; }"
+        "}"
+    );
+    const auto &expression = *program.units[0].expression;
+    Object *instances[] = { nullptr };
+    const auto count = [&expression](const Lang::RegisterOpCode code) {
+        auto found = 0u;
+        for (Lang::ByteIndex index = 0u; index < expression.size(); ) {
+            const auto &instruction = *reinterpret_cast<const Lang::RegisterInstruction *>(expression.at(index));
+            found += instruction.code == code;
+            index += Lang::InstructionSize(instruction);
+        }
+        return found;
+    };
+
+    Var integers[1] { Var(10) };
+    ASSERT_EQ(Lang::RegisterProcesser::Local().process(expression, instances, integers).as<int>(), 10);
+    ASSERT_EQ(count(Lang::RegisterOpCode::IntegerLighter), 1u);
+    ASSERT_EQ(count(Lang::RegisterOpCode::IntegerAddition), 1u);
+
+    // Floating operands de-quicken the comparison then quicken it again
+    Var floatings[1] { Var(2.5) };
+    ASSERT_EQ(Lang::RegisterProcesser::Local().process(expression, instances, floatings).as<int>(), 3);
+    ASSERT_EQ(count(Lang::RegisterOpCode::IntegerLighter), 0u);
+    ASSERT_EQ(count(Lang::RegisterOpCode::Lighter), 1u);
+    ASSERT_EQ(count(Lang::RegisterOpCode::IntegerAddition), 1u);
+}
+
+TEST(RegisterProcesser, AssignedLocals)
+{
+    // Locals read in place must keep their value when a later operand assigns them
+    constexpr auto Code =
+        "Item {"
+        "  function product(a) { int x = a; return x * (x = 5); }"
+        "  function suffix(a) { int x = a; return x + x++; }"
+        "  function compound(a) { int x = a; x += x++; return x; }"
+        "  function untouched(a) { int x = a; int y = 1; return x * (y = 5); }"
+        "}";
+    Lang::Tests::CompiledProgram<Lang::Compiler> stack(Code);
+    Program registers(Code);
+    Lang::Tests::CompiledProgram<Lang::ClosureCompiler> closures(Code);
+    Object *instances[] = { nullptr };
+    constexpr int Expected[] = { 10, 4, 4, 10 };
+
+    for (auto i = 0u; i < std::size(Expected); ++i) {
+        Var args[1] { Var(2) };
+        ASSERT_EQ(Lang::StackProcesser::Local().process(*stack.units[i].expression, instances, args).as<int>(), Expected[i]);
+        ASSERT_EQ(Lang::RegisterProcesser::Local().process(*registers.units[i].expression, instances, args).as<int>(), Expected[i]);
+        ASSERT_EQ(Lang::ClosureProcesser::Local().process(*closures.units[i].expression, instances, args).as<int>(), Expected[i]);
+    }
+}
@@ -0,0 +1,125 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of StackJit
+ */
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Kube/Interpreter/Compiler.hpp>
+#include <Kube/Interpreter/StackProcesser.hpp>
+#include <Kube/Interpreter/StackJit.hpp>
+
+#include "Program.hpp"
+
+using namespace kF;
+
+namespace
+{
+    using Program = Lang::Tests::CompiledProgram<Lang::Compiler>;
+
+    /** @brief Translate every expression on its first execution */
+    struct JitScope
+    {
+        JitScope(void) noexcept { Lang::StackProcesser::Local().setJitThreshold(1u); }
+        ~JitScope(void) noexcept { Lang::StackProcesser::Local().setJitThreshold(Lang::StackProcesser::DefaultJitThreshold); }
+    };
+}
+
+TEST(StackJit, Statements)
+{
+    JitScope scope;
+    Program program(
+        "Item {"
+        "  function sum(n) { int total = 0; int i = 0; while (i < n) { i += 1; if (i == 3) { continue; } total += i; } return total; }"
+        "  function loop(n) { int x = 1; for (n; x < 100; x *= 2) { if (x == n) { break; } } return x; }"
+        "  function logic(a, b) { return !(a && b) || a - b > 2; }"
+        "  function text() { return \"ab\" + \"cd\"; }"
+        "}"
+    );
+    auto &processer = Lang::StackProcesser::Local();
+    Object *instances[] = { nullptr };
+
+    for (auto i = 0; i < 2; ++i) {
+        Var args[2] { Var(5) };
+        ASSERT_EQ(processer.process(*program.units[0].expression, instances, args).as<int>(), 12);
+        args[0] = Var(16);
+        ASSERT_EQ(processer.process(*program.units[1].expression, instances, args).as<int>(), 16);
+        args[0] = Var(true);
+        args[1] = Var(true);
+        ASSERT_EQ(processer.process(*program.units[2].expression, instances, args).as<bool>(), false);
+        ASSERT_EQ(processer.process(*program.units[3].expression, instances, nullptr).as<std::string>(), "abcd");
+        ASSERT_EQ(processer.stackSize(), 0u);
+    }
+    for (const auto &unit : program.units)
+        ASSERT_EQ(unit.expression->jitCode() != nullptr, Lang::StackJit::IsAvailable);
+}
+
+TEST(StackJit, Objects)
+{
+    JitScope scope;
+    Program program(
+        "Item {"
+        "  property x: y * 3 + width;"
+        "  property y: 4;"
+        "  function f(a) { x = a; target.value += 2; return target.twice(x) + scale(a); }"
+        "}"
+    );
+    auto &processer = Lang::StackProcesser::Local();
+    Object item, target;
+    item.properties[Hash("x")] = Var(0);
+    item.properties[Hash("y")] = Var(4);
+    item.properties[Hash("width")] = Var(1);
+    item.properties[Hash("target")] = Var(&target);
+    item.functions[Hash("scale")] = [](Object *, Var *args) { return Var(args[0].as<int>() * 10); };
+    target.properties[Hash("value")] = Var(5);
+    target.functions[Hash("twice")] = [](Object *, Var *args) { return Var(args[0].as<int>() * 2); };
+    Object *instances[] = { &item, nullptr };
+
+    ASSERT_EQ(processer.process(*program.units[0].expression, instances, nullptr).as<int>(), 13);
+    Var args[1] { Var(3) };
+    ASSERT_EQ(processer.process(*program.units[2].expression, instances, args).as<int>(), 36);
+    ASSERT_EQ(item.properties[Hash("x")].as<int>(), 3);
+    ASSERT_EQ(target.properties[Hash("value")].as<int>(), 7);
+
+    // Errors of the machine code release the frame
+    item.properties.erase(Hash("width"));
+    ASSERT_ANY_THROW((void)processer.process(*program.units[0].expression, instances, nullptr));
+    ASSERT_EQ(processer.stackSize(), 0u);
+}
+
+TEST(StackJit, SharedMemory)
+{
+    JitScope scope;
+    constexpr auto Code =
+        "Item {"
+        "  function a(n) { return n + 1; }"
+        "  function b(n) { return n * 2; }"
+        "  function c(n) { switch (n) { case 0: return 4; case 1: return 5; case 2: return 6; } return 7; }"
+        "}";
+    auto &processer = Lang::StackProcesser::Local();
+    Object *instances[] = { nullptr };
+    std::vector<const void *> entries;
+
+    for (auto i = 0; i < 2; ++i) {
+        Program program(Code);
+        const std::int64_t results[] = { 3, 4, 6 };
+        for (auto unit = 0u; unit < program.units.size(); ++unit) {
+            Var args[1] { Var(2) };
+            ASSERT_EQ(processer.process(*program.units[unit].expression, instances, args).as<std::int64_t>(), results[unit]);
+        }
+        if constexpr (!Lang::StackJit::IsAvailable)
+            continue;
+        // Expressions share the executable memory, blocks of released expressions are reused
+        for (auto unit = 0u; unit < program.units.size(); ++unit) {
+            const auto entry = reinterpret_cast<const void *>(program.units[unit].expression->jitCode()->entry);
+            if (!i)
+                entries.push_back(entry);
+            else
+                ASSERT_EQ(entry, entries[unit]);
+        }
+        for (auto unit = 1u; unit < entries.size(); ++unit)
+            ASSERT_NE(entries[unit - 1], entries[unit]);
+    }
+}
@@ -0,0 +1,203 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of StackProcesser
+ */
+
+#include <gtest/gtest.h>
+
+#include <Kube/Interpreter/Compiler.hpp>
+#include <Kube/Interpreter/StackProcesser.hpp>
+
+#include "Program.hpp"
+
+using namespace kF;
+
+namespace
+{
+    using Program = Lang::Tests::CompiledProgram<Lang::Compiler>;
+}
+
+TEST(StackProcesser, Statements)
+{
+    Program program(
+        "Item {"
+        "  function sum(n) { int total = 0; int i = 0; while (i < n) { i += 1; if (i == 3) { continue; } total += i; } return total; }"
+        "  function loop(n) { int x = 1; for (n; x < 100; x *= 2) { if (x == n) { break; } } return x; }"
+        "  function logic(a, b) { return !(a && b) || a - b > 2; }"
+        "  function text() { return \"ab\" + \"cd\"; }"
+        "  function choose(a) { return a > 1 ? a * 10 : a > 0 ? 5 : -5; }"
+        "}"
+    );
+    Object *instances[] = { nullptr };
+
+    Var args[2] { Var(5) };
+    ASSERT_EQ(Lang::StackProcesser::Local().process(*program.units[0].expression, instances, args).as<int>(), 12);
+    args[0] = Var(16);
+    ASSERT_EQ(Lang::StackProcesser::Local().process(*program.units[1].expression, instances, args).as<int>(), 16);
+    args[0] = Var(true);
+    args[1] = Var(true);
+    ASSERT_EQ(Lang::StackProcesser::Local().process(*program.units[2].expression, instances, args).as<bool>(), false);
+    ASSERT_EQ(Lang::StackProcesser::Local().process(*program.units[3].expression, instances, nullptr).as<std::string>(), "abcd");
+    args[0] = Var(3);
+    ASSERT_EQ(Lang::StackProcesser::Local().process(*program.units[4].expression, instances, args).as<int>(), 30);
+    args[0] = Var(1);
+    ASSERT_EQ(Lang::StackProcesser::Local().process(*program.units[4].expression, instances, args).as<int>(), 5);
+    args[0] = Var(0);
+    ASSERT_EQ(Lang::StackProcesser::Local().process(*program.units[4].expression, instances, args).as<int>(), -5);
+    ASSERT_EQ(Lang::StackProcesser::Local().stackSize(), 0u);
+}
+
+TEST(StackProcesser, Objects)
+{
+    Program program(
+        "Item {"
+        "  property x: y * 3 + width;"
+        "  property y: 4;"
+        "  function f(a) { x = a; target.value += 2; return target.twice(x) + scale(a); }"
+        "  Child { property z: x + y; }"
+        "}"
+    );
+    Object item, child, target;
+    item.properties[Hash("x")] = Var(0);
+    item.properties[Hash("y")] = Var(4);
+    item.properties[Hash("width")] = Var(1);
+    item.properties[Hash("target")] = Var(&target);
+    item.functions[Hash("scale")] = [](Object *, Var *args) { return Var(args[0].as<int>() * 10); };
+    target.properties[Hash("value")] = Var(5);
+    target.functions[Hash("twice")] = [](Object *, Var *args) { return Var(args[0].as<int>() * 2); };
+    child.properties[Hash("z")] = Var(0);
+    Object *itemInstances[] = { &item, nullptr };
+    Object *childInstances[] = { &child, &item, nullptr };
+
+    ASSERT_EQ(Lang::StackProcesser::Local().process(*program.units[0].expression, itemInstances, nullptr).as<int>(), 13);
+
+    Var args[1] { Var(3) };
+    ASSERT_EQ(Lang::StackProcesser::Local().process(*program.units[2].expression, itemInstances, args).as<int>(), 36);
+    ASSERT_EQ(item.properties[Hash("x")].as<int>(), 3);
+    ASSERT_EQ(target.properties[Hash("value")].as<int>(), 7);
+
+    // Members of enclosing classes are reached by depth
+    ASSERT_EQ(Lang::StackProcesser::Local().process(*program.units[3].expression, childInstances, nullptr).as<int>(), 7);
+
+    // Errors release the frame
+    item.properties.erase(Hash("width"));
+    ASSERT_ANY_THROW((void)Lang::StackProcesser::Local().process(*program.units[0].expression, itemInstances, nullptr));
+    ASSERT_EQ(Lang::StackProcesser::Local().stackSize(), 0u);
+}
+
+TEST(StackProcesser, Profile)
+{
+    Program program(
+        "Item {"
+        "  function f(n) { int i = 0; while (i < n) { i += 1; } return i; }"
+        "}"
+    );
+    Object *instances[] = { nullptr };
+    auto &processer = Lang::StackProcesser::Local();
+
+    processer.resetProfile();
+    Var args[1] { Var(100) };
+    ASSERT_EQ(processer.process(*program.units[0].expression, instances, args).as<int>(), 100);
+    const auto sequences = processer.profile(3);
+#if KUBE_INTERPRETER_PROFILE
+    ASSERT_EQ(sequences.size(), 3u);
+    ASSERT_GE(sequences[0].count, 100u);
+    ASSERT_GE(sequences[0].count, sequences[1].count);
+    ASSERT_GE(sequences[1].count, sequences[2].count);
+#else
+    ASSERT_TRUE(sequences.empty());
+#endif
+}
+
+TEST(StackProcesser, InlineCaches)
+{
+    Program program(
+        "Item {"
+        "  function f(o) { o.value += 1; return o.value; }"
+        "}"
+    );
+    const auto &expression = *program.units[0].expression;
+    Object *instances[] = { nullptr };
+    Object objects[Lang::InlineCache::EntryCount + 2u];
+
+    // Both accesses of the compound assignment and the returned one own a cache
+    ASSERT_EQ(expression.cacheCount(), 3u);
+    for (auto i = 0; i < 2; ++i) {
+        // Past its entry count a cache keeps resolving its accesses
+        for (auto &object : objects) {
+            object.properties[Hash("value")] = Var(i);
+            Var args[1] { Var(&object) };
+            ASSERT_EQ(Lang::StackProcesser::Local().process(expression, instances, args).as<int>(), i + 1);
+        }
+    }
+}
+
+TEST(StackProcesser, ExternalCaches)
+{
+    Program program(
+        "Item {"
+        "  function f() { width += 1; return width + scale(width); }"
+        "}"
+    );
+    const auto &expression = *program.units[0].expression;
+    Object shallow, inner, outer, deep[Lang::ExternalCache::MaxDepth + 1u];
+    for (auto *owner : { &shallow, &outer, &deep[Lang::ExternalCache::MaxDepth] }) {
+        owner->properties[Hash("width")] = Var(0);
+        owner->functions[Hash("scale")] = [](Object *, Var *args) { return Var(args[0].as<int>() * 10); };
+    }
+    Object *shallowInstances[] = { &shallow, nullptr };
+    Object *nestedInstances[] = { &inner, &outer, nullptr };
+    Object *siblingInstances[] = { &inner, &shallow, nullptr };
+    Object *deepInstances[] = { &deep[0], &deep[1], &deep[2], &deep[3], nullptr };
+    const std::pair<Object **, Object *> chains[] = {
+        { shallowInstances, &shallow }, { nestedInstances, &outer }, { siblingInstances, &shallow }, { deepInstances, &deep[3] }
+    };
+
+    // Each access and call owns a cache
+    ASSERT_EQ(expression.externalCacheCount(), 5u);
+    for (auto i = 0; i < 2; ++i) {
+        // Chains sharing their first instance, past the entry count of a cache or deeper than its maximum depth still resolve
+        for (const auto &[instances, owner] : chains) {
+            const auto width = owner->properties[Hash("width")].as<int>() + 1;
+            ASSERT_EQ(Lang::StackProcesser::Local().process(expression, instances, nullptr).as<int>(), width * 11);
+            ASSERT_EQ(owner->properties[Hash("width")].as<int>(), width);
+        }
+    }
+
+    // A chain shorter than the cached ones misses, then fails to resolve the name
+    Object *missingInstances[] = { &inner, nullptr };
+    ASSERT_ANY_THROW((void)Lang::StackProcesser::Local().process(expression, missingInstances, nullptr));
+    ASSERT_EQ(Lang::StackProcesser::Local().stackSize(), 0u);
+}
+
+TEST(StackProcesser, Quickening)
+{
+    Program program(
+        "Item {"
+        "  function f(a, b) { return a + b; }"
+        "}"
+    );
+    const auto &expression = *program.units[0].expression;
+    const auto &addition = *expression.at(2u * sizeof(Lang::Instruction));
+    Object *instances[] = { nullptr };
+    const auto run = [&](Var &&lhs, Var &&rhs) {
+        Var args[2] { std::move(lhs), std::move(rhs) };
+        return Lang::StackProcesser::Local().process(expression, instances, args);
+    };
+
+    ASSERT_EQ(addition.code, Lang::OpCode::Addition);
+    ASSERT_EQ(run(Var(1), Var(2)).as<int>(), 3);
+    ASSERT_EQ(addition.code, Lang::OpCode::IntegerAddition);
+    ASSERT_EQ(run(Var(3), Var(4)).as<int>(), 7);
+
+    // A type change de-quickens the instruction which is quickened again on its next execution
+    ASSERT_EQ(run(Var(1.5), Var(2.0)).as<double>(), 3.5);
+    ASSERT_EQ(addition.code, Lang::OpCode::Addition);
+    ASSERT_EQ(run(Var(1.5), Var(2.0)).as<double>(), 3.5);
+    ASSERT_EQ(addition.code, Lang::OpCode::FloatingAddition);
+
+    // Mixed operands stay generic
+    ASSERT_EQ(run(Var(1), Var(0.5)).as<double>(), 1.5);
+    ASSERT_EQ(run(Var(1), Var(0.5)).as<double>(), 1.5);
+    ASSERT_EQ(addition.code, Lang::OpCode::Addition);
+}
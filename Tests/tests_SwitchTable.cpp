@@ -0,0 +1,167 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of SwitchTable
+ */
+
+#include <functional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Kube/Interpreter/SwitchTable.hpp>
+#include <Kube/Interpreter/Compiler.hpp>
+#include <Kube/Interpreter/StackProcesser.hpp>
+#include <Kube/Interpreter/RegisterCompiler.hpp>
+#include <Kube/Interpreter/RegisterProcesser.hpp>
+#include <Kube/Interpreter/ClosureCompiler.hpp>
+#include <Kube/Interpreter/ClosureProcesser.hpp>
+
+#include "Program.hpp"
+
+using namespace kF;
+
+namespace
+{
+    constexpr auto Code =
+        "Item {"
+        "  function dense(n) { int r = 0; switch (n) { case 1: r = 10; case 2: r = 20; case 3: { r = 30; break; } case 5: r = 50; default: r = -1; } return r; }"
+        "  function sparse(n) { int r = 0; switch (n) { case 1: r = 1; case 100: r = 2; case 1000: r = 3; case 5000: r = 4; } return r; }"
+        "  function hashed(s) { int r = 0; switch (s) { case \"idle\": r = 1; case \"walk\": r = 2; case \"run\": r = 3; case \"jump\": r = 4; case \"walk\": r = 5; default: r = -1; } return r; }"
+        "  function chained(n) { int r = 0; switch (n) { case 1: r = 1; case 2: r = 2; default: r = 3; } return r; }"
+        "}";
+
+    /** @brief Parse and resolve a code snippet, then find its switch statements */
+    struct Program : public Lang::Tests::Program
+    {
+        using Lang::Tests::Program::Program;
+
+        /** @brief Get every switch statement in declaration order */
+        std::vector<const Lang::AST *> switches(void) const
+        {
+            std::vector<const Lang::AST *> nodes;
+            tree->root().traverse([&nodes](const Lang::AST &node) {
+                if (node.type() == Lang::TokenType::Statement && node.statementType() == Lang::StatementType::Switch)
+                    nodes.push_back(&node);
+                return true;
+            });
+            return nodes;
+        }
+    };
+
+    /** @brief Run each function of 'Code' on a machine and check its results */
+    void CheckDispatch(const std::function<Var(std::size_t, Var)> &run)
+    {
+        using namespace std::string_literals;
+
+        const std::int64_t dense[] = { -1, 10, 20, 30, -1, 50, -1 };
+        for (auto i = 0; i < 7; ++i)
+            ASSERT_EQ(run(0u, Var(static_cast<std::int64_t>(i))).as<std::int64_t>(), dense[i]);
+        // Subjects of another type are compared to each case
+        ASSERT_EQ(run(0u, Var(2.0)).as<std::int64_t>(), 20);
+        ASSERT_EQ(run(0u, Var("2"s)).as<std::int64_t>(), -1);
+
+        ASSERT_EQ(run(1u, Var(static_cast<std::int64_t>(1000))).as<std::int64_t>(), 3);
+        ASSERT_EQ(run(1u, Var(static_cast<std::int64_t>(5000))).as<std::int64_t>(), 4);
+        ASSERT_EQ(run(1u, Var(static_cast<std::int64_t>(7))).as<std::int64_t>(), 0);
+        ASSERT_EQ(run(1u, Var(100.0)).as<std::int64_t>(), 2);
+
+        // The first case of a value matches
+        ASSERT_EQ(run(2u, Var("walk"s)).as<std::int64_t>(), 2);
+        ASSERT_EQ(run(2u, Var("jump"s)).as<std::int64_t>(), 4);
+        ASSERT_EQ(run(2u, Var("fly"s)).as<std::int64_t>(), -1);
+        ASSERT_EQ(run(2u, Var(3)).as<std::int64_t>(), -1);
+
+        ASSERT_EQ(run(3u, Var(2)).as<std::int64_t>(), 2);
+        ASSERT_EQ(run(3u, Var(4)).as<std::int64_t>(), 3);
+    }
+}
+
+TEST(SwitchTable, Analysis)
+{
+    Program program(Code);
+    const auto nodes = program.switches();
+
+    ASSERT_EQ(nodes.size(), 4u);
+    const Lang::SwitchTable dense(*nodes[0]);
+    ASSERT_EQ(dense.kind(), Lang::SwitchTable::Kind::Dense);
+    ASSERT_EQ(dense.base(), 1);
+    ASSERT_EQ(dense.entries().size(), 5u);
+    ASSERT_EQ(dense.entries()[2].caseIndex, 2u);
+    ASSERT_EQ(dense.entries()[3].caseIndex, Lang::SwitchTable::NoCase);
+    ASSERT_EQ(dense.entries()[4].caseIndex, 3u);
+
+    const Lang::SwitchTable sparse(*nodes[1]);
+    ASSERT_EQ(sparse.kind(), Lang::SwitchTable::Kind::Sorted);
+    ASSERT_EQ(sparse.entries().size(), 4u);
+    for (auto i = 1u; i < sparse.entries().size(); ++i)
+        ASSERT_LT(sparse.entries()[i - 1].key, sparse.entries()[i].key);
+
+    // Each literal has its own entry, the duplicated one is dropped
+    const Lang::SwitchTable hashed(*nodes[2]);
+    ASSERT_EQ(hashed.kind(), Lang::SwitchTable::Kind::Hashed);
+    auto used = 0u;
+    for (const auto &entry : hashed.entries()) {
+        ASSERT_NE(entry.caseIndex, 4u);
+        used += entry.caseIndex != Lang::SwitchTable::NoCase;
+    }
+    ASSERT_EQ(used, 4u);
+
+    const Lang::SwitchTable chained(*nodes[3]);
+    ASSERT_EQ(chained.kind(), Lang::SwitchTable::Kind::None);
+}
+
+TEST(SwitchTable, StackMachine)
+{
+    Program program(Code);
+    const auto units = Lang::Compiler().run(*program.tree, "Root");
+    const Lang::OpCode codes[] = { Lang::OpCode::JumpTable, Lang::OpCode::JumpSorted, Lang::OpCode::JumpHashed, Lang::OpCode::None };
+    Object *instances[] = { nullptr };
+    auto &processer = Lang::StackProcesser::Local();
+
+    for (auto i = 0u; i < units.size(); ++i) {
+        const auto &expression = *units[i].expression;
+        auto found = Lang::OpCode::None;
+        for (Lang::ByteIndex index = 0u; index < expression.size(); index += Lang::InstructionSize(*expression.at(index))) {
+            const auto code = expression.at(index)->code;
+            if (code == Lang::OpCode::JumpTable || code == Lang::OpCode::JumpSorted || code == Lang::OpCode::JumpHashed)
+                found = code;
+        }
+        ASSERT_EQ(found, codes[i]);
+    }
+
+    // Machine code dispatches through the same tables
+    for (const auto threshold : { Lang::StackProcesser::DefaultJitThreshold, 1u }) {
+        processer.setJitThreshold(threshold);
+        CheckDispatch([&units, &instances, &processer](const std::size_t unit, Var value) {
+            Var args[1] { std::move(value) };
+            return processer.process(*units[unit].expression, instances, args);
+        });
+    }
+    processer.setJitThreshold(Lang::StackProcesser::DefaultJitThreshold);
+    ASSERT_EQ(processer.stackSize(), 0u);
+}
+
+TEST(SwitchTable, RegisterMachine)
+{
+    Program program(Code);
+    const auto units = Lang::RegisterCompiler().run(*program.tree, "Root");
+    Object *instances[] = { nullptr };
+
+    CheckDispatch([&units, &instances](const std::size_t unit, Var value) {
+        Var args[1] { std::move(value) };
+        return Lang::RegisterProcesser::Local().process(*units[unit].expression, instances, args);
+    });
+    ASSERT_EQ(Lang::RegisterProcesser::Local().registerCount(), 0u);
+}
+
+TEST(SwitchTable, Closures)
+{
+    Program program(Code);
+    const auto units = Lang::ClosureCompiler().run(*program.tree, "Root");
+    Object *instances[] = { nullptr };
+
+    CheckDispatch([&units, &instances](const std::size_t unit, Var value) {
+        Var args[1] { std::move(value) };
+        return Lang::ClosureProcesser::Local().process(*units[unit].expression, instances, args);
+    });
+}
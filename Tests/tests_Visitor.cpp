@@ -0,0 +1,77 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Unit tests of Visitor
+ */
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include <Kube/Interpreter/Lexer.hpp>
+#include <Kube/Interpreter/Parser.hpp>
+#include <Kube/Interpreter/Visitor.hpp>
+
+using namespace kF;
+
+namespace
+{
+    /** @brief Evaluate integer arithmetic, any other node evaluates to zero */
+    struct Evaluator : public Lang::Visitor<Evaluator, std::int64_t>
+    {
+        std::size_t defaultCount { 0u };
+
+        std::int64_t handle(Lang::TokenTag<Lang::TokenType::Constant>, const Lang::AST &node)
+            { return std::stoll(std::string(node.literal())); }
+
+        std::int64_t handle(Lang::OperatorTag<Lang::OperatorType::Addition>, const Lang::AST &node)
+            { return visit(*node.children()[0]) + visit(*node.children()[1]); }
+
+        std::int64_t handle(Lang::OperatorTag<Lang::OperatorType::Multiplication>, const Lang::AST &node)
+            { return visit(*node.children()[0]) * visit(*node.children()[1]); }
+
+        std::int64_t handle(Lang::OperatorTag<Lang::OperatorType::Minus>, const Lang::AST &node)
+            { return -visit(*node.children()[0]); }
+
+        std::int64_t handleDefault(const Lang::AST &) { ++defaultCount; return 0; }
+    };
+
+    /** @brief Count statements and operators with argument forwarding */
+    struct Counter : public Lang::Visitor<Counter, void, std::size_t &>
+    {
+        void handle(Lang::TokenTag<Lang::TokenType::Statement>, const Lang::AST &node, std::size_t &count)
+            { ++count; visitChildren(node, count); }
+
+        void handle(Lang::TokenTag<Lang::TokenType::Operator>, const Lang::AST &node, std::size_t &count)
+            { ++count; visitChildren(node, count); }
+
+        void handleDefault(const Lang::AST &node, std::size_t &count)
+            { visitChildren(node, count); }
+    };
+
+    /** @brief Visitor without default handler */
+    struct Partial : public Lang::Visitor<Partial>
+    {
+        void handle(Lang::TokenTag<Lang::TokenType::Class>, const Lang::AST &) {}
+    };
+}
+
+static_assert(Evaluator::HasDefaultHandler);
+static_assert(Evaluator::HasHandler<Lang::OperatorTag<Lang::OperatorType::Addition>>);
+static_assert(!Evaluator::HasHandler<Lang::OperatorTag<Lang::OperatorType::Division>>);
+static_assert(!Partial::HasDefaultHandler);
+
+TEST(Visitor, Dispatch)
+{
+    std::istringstream iss("Item { property x: -(1 + 2) * 3 + y; function f(z) { if (z) { return z + 1; } } }");
+    auto stack = Lang::Lexer().run(0, iss, "Root");
+    auto tree = Lang::Parser().run(0, &stack, "Root");
+    auto &expression = *tree->root().children()[0]->children()[0]->children()[0];
+
+    Evaluator evaluator;
+    ASSERT_EQ(evaluator.visit(expression), -9);
+    ASSERT_EQ(evaluator.defaultCount, 1u);
+
+    std::size_t count = 0u;
+    Counter().visit(tree->root(), count);
+    ASSERT_EQ(count, 7u);
+}
@@ -31,6 +31,13 @@ public:
     [[nodiscard]] Token::Iterator end(void) const noexcept
         { return Token::Iterator(reinterpret_cast<const Token *>(_data.end())); }
 
+    /** @brief Get the token at a given byte index (invalidated on the next push) */
+    [[nodiscard]] const Token *at(const std::size_t byteIndex) const noexcept
+        { return reinterpret_cast<const Token *>(_data.begin() + byteIndex); }
+
+    /** @brief Get the byte size of the stack (byte index of the next pushed token) */
+    [[nodiscard]] std::size_t byteSize(void) const noexcept { return _data.size(); }
+
     /** @brief Release all owned memory */
     void release(void) { _data.release(); }
 
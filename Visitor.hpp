@@ -0,0 +1,95 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Compile-time dispatched AST visitor
+ */
+
+#pragma once
+
+#include <array>
+#include <utility>
+
+#include "AST.hpp"
+
+namespace kF::Lang
+{
+    template<typename Derived, typename Return, typename ...Args>
+    class Visitor;
+
+    /** @brief Tag of a token type handler */
+    template<TokenType Type>
+    struct TokenTag { static constexpr TokenType Value = Type; };
+
+    /** @brief Tag of an operator type handler */
+    template<OperatorType Type>
+    struct OperatorTag { static constexpr OperatorType Value = Type; };
+
+    /** @brief Tag of a statement type handler */
+    template<StatementType Type>
+    struct StatementTag { static constexpr StatementType Value = Type; };
+
+    /** @brief Check if a token type can be held by an AST node */
+    [[nodiscard]] constexpr bool IsNodeType(const TokenType type) noexcept
+        { return type != TokenType::None && type != TokenType::LeftParenthesis && type != TokenType::RightParenthesis; }
+}
+
+/** @brief Visitor dispatching AST nodes to the handlers of 'Derived' through jump tables generated at compile time
+ *  Handlers are overloads of 'handle' taking a tag, the node and 'Args':
+ *      Return handle(TokenTag<TokenType::Property>, const AST &node, Args ...args);
+ *      Return handle(OperatorTag<OperatorType::Addition>, const AST &node, Args ...args);
+ *      Return handle(StatementTag<StatementType::If>, const AST &node, Args ...args);
+ *  A 'TokenTag<TokenType::Operator>' (or 'Statement') handler takes precedence over every operator (or statement) handler
+ *  Kinds without handler fall back to 'Return handleDefault(const AST &node, Args ...args)'
+ *  If 'Derived' has no default handler, any unhandled kind is a compilation error
+ *  Handlers must be accessible to the visitor (public or friend) */
+template<typename Derived, typename Return = void, typename ...Args>
+class kF::Lang::Visitor
+{
+public:
+    /** @brief Signature of a dispatched handler */
+    using Handler = Return(*)(Derived &, const AST &, Args...);
+
+
+    /** @brief Dispatch a node to its handler */
+    Return visit(const AST &node, Args ...args);
+
+    /** @brief Dispatch each child of a node to its handler */
+    void visitChildren(const AST &node, Args ...args);
+
+
+    /** @brief Check if 'Derived' has a handler for a given tag */
+    template<typename Tag>
+    static constexpr bool HasHandler = requires(Derived &derived, const AST &node, Args ...args) {
+        derived.handle(Tag {}, node, args...);
+    };
+
+    /** @brief Check if 'Derived' has a default handler */
+    static constexpr bool HasDefaultHandler = requires(Derived &derived, const AST &node, Args ...args) {
+        derived.handleDefault(node, args...);
+    };
+
+private:
+    /** @brief Dispatch functions of each kind */
+    template<TokenType Type>
+    static Return DispatchToken(Derived &derived, const AST &node, Args ...args);
+    template<OperatorType Type>
+    static Return DispatchOperator(Derived &derived, const AST &node, Args ...args);
+    template<StatementType Type>
+    static Return DispatchStatement(Derived &derived, const AST &node, Args ...args);
+
+    /** @brief Dispatch a kind without handler */
+    template<typename Tag, bool Reachable>
+    static Return DispatchDefault(Derived &derived, const AST &node, Args ...args);
+
+    /** @brief Generate the jump table of each kind */
+    template<std::size_t ...Indexes>
+    [[nodiscard]] static consteval auto MakeTokenTable(const std::index_sequence<Indexes...>) noexcept
+        { return std::array<Handler, sizeof...(Indexes)> { &DispatchToken<static_cast<TokenType>(Indexes)>... }; }
+    template<std::size_t ...Indexes>
+    [[nodiscard]] static consteval auto MakeOperatorTable(const std::index_sequence<Indexes...>) noexcept
+        { return std::array<Handler, sizeof...(Indexes)> { &DispatchOperator<static_cast<OperatorType>(Indexes)>... }; }
+    template<std::size_t ...Indexes>
+    [[nodiscard]] static consteval auto MakeStatementTable(const std::index_sequence<Indexes...>) noexcept
+        { return std::array<Handler, sizeof...(Indexes)> { &DispatchStatement<static_cast<StatementType>(Indexes)>... }; }
+};
+
+#include "Visitor.ipp"
@@ -0,0 +1,68 @@
+/**
+ * @ Author: Matthieu Moinvaziri
+ * @ Description: Compile-time dispatched AST visitor
+ */
+
+template<typename Derived, typename Return, typename ...Args>
+inline Return kF::Lang::Visitor<Derived, Return, Args...>::visit(const AST &node, Args ...args)
+{
+    static constexpr auto Table = MakeTokenTable(std::make_index_sequence<TokenTypeCount>());
+
+    return Table[static_cast<std::size_t>(node.type())](static_cast<Derived &>(*this), node, args...);
+}
+
+template<typename Derived, typename Return, typename ...Args>
+inline void kF::Lang::Visitor<Derived, Return, Args...>::visitChildren(const AST &node, Args ...args)
+{
+    for (const auto *child : node.children())
+        visit(*child, args...);
+}
+
+template<typename Derived, typename Return, typename ...Args>
+template<kF::Lang::TokenType Type>
+inline Return kF::Lang::Visitor<Derived, Return, Args...>::DispatchToken(Derived &derived, const AST &node, Args ...args)
+{
+    if constexpr (HasHandler<TokenTag<Type>>)
+        return derived.handle(TokenTag<Type> {}, node, args...);
+    else if constexpr (Type == TokenType::Operator) {
+        static constexpr auto Table = MakeOperatorTable(std::make_index_sequence<OperatorTypeCount>());
+        return Table[static_cast<std::size_t>(node.operatorType())](derived, node, args...);
+    } else if constexpr (Type == TokenType::Statement) {
+        static constexpr auto Table = MakeStatementTable(std::make_index_sequence<StatementTypeCount>());
+        return Table[static_cast<std::size_t>(node.statementType())](derived, node, args...);
+    } else
+        return DispatchDefault<TokenTag<Type>, IsNodeType(Type)>(derived, node, args...);
+}
+
+template<typename Derived, typename Return, typename ...Args>
+template<kF::Lang::OperatorType Type>
+inline Return kF::Lang::Visitor<Derived, Return, Args...>::DispatchOperator(Derived &derived, const AST &node, Args ...args)
+{
+    if constexpr (HasHandler<OperatorTag<Type>>)
+        return derived.handle(OperatorTag<Type> {}, node, args...);
+    else
+        return DispatchDefault<OperatorTag<Type>, Type != OperatorType::None>(derived, node, args...);
+}
+
+template<typename Derived, typename Return, typename ...Args>
+template<kF::Lang::StatementType Type>
+inline Return kF::Lang::Visitor<Derived, Return, Args...>::DispatchStatement(Derived &derived, const AST &node, Args ...args)
+{
+    if constexpr (HasHandler<StatementTag<Type>>)
+        return derived.handle(StatementTag<Type> {}, node, args...);
+    else
+        return DispatchDefault<StatementTag<Type>, Type != StatementType::None>(derived, node, args...);
+}
+
+template<typename Derived, typename Return, typename ...Args>
+template<typename Tag, bool Reachable>
+inline Return kF::Lang::Visitor<Derived, Return, Args...>::DispatchDefault(Derived &derived, const AST &node, Args ...args)
+{
+    if constexpr (HasDefaultHandler)
+        return derived.handleDefault(node, args...);
+    else {
+        // Kinds that never appear in a tree don't require any handler
+        static_assert(!Reachable, "Lang::Visitor: Unhandled node kind, implement its handler or a default handler");
+        __builtin_unreachable();
+    }
+}